@@ -0,0 +1,360 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of class CompactGraphAttributes, a memory-saving
+ *        variant of GraphAttributes for layout-only jobs, and of the
+ *        string interning table StringTable.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_COMPACT_GRAPH_ATTRIBUTES_H
+#define OGDF_COMPACT_GRAPH_ATTRIBUTES_H
+
+#include <ogdf/basic/GraphAttributes.h>
+#include <ogdf/basic/ArrayBuffer.h>
+#include <ogdf/basic/Hashing.h>
+
+
+namespace ogdf
+{
+
+    //! Hash function for strings used by StringTable.
+    /**
+     * The default hash function for strings only sums up the characters,
+     * which produces many collisions for typical generated labels
+     * (like "n12" and "n21"); this one implements FNV-1a.
+     */
+    class StringTableHashFunc
+    {
+    public:
+        size_t hash(const string & key) const
+        {
+            __uint32 h = 2166136261u;
+            for(string::size_type i = 0; i < key.size(); ++i)
+            {
+                h ^= (unsigned char)key[i];
+                h *= 16777619u;
+            }
+            return h;
+        }
+    };
+
+
+    //! A table of interned strings.
+    /**
+     * Every distinct string is stored only once and identified by an integer id.
+     * The id 0 is reserved for the empty string, so zero-initialized id arrays
+     * represent empty strings.
+     */
+    class OGDF_EXPORT StringTable
+    {
+        //! The interned strings, indexed by id.
+        /**
+         * The strings themselves are the keys of \a m_ids; the buffer only
+         * points to them, since it grows by reallocation.
+         */
+        ArrayBuffer<const string*> m_strings;
+        Hashing<string, int, StringTableHashFunc> m_ids; //!< maps strings to their ids
+
+    public:
+        //! Creates a string table containing only the empty string.
+        StringTable();
+
+        //! Creates a copy of \a table; ids are preserved.
+        StringTable(const StringTable & table);
+
+        //! Assignment operator; ids are preserved.
+        StringTable & operator=(const StringTable & table);
+
+        //! Returns the id of \a str, inserting \a str if it is not yet contained.
+        int intern(const string & str);
+
+        //! Returns the id of \a str, or -1 if \a str is not contained.
+        int lookup(const string & str) const;
+
+        //! Returns the string with id \a id.
+        const string & operator[](int id) const
+        {
+            return *m_strings[id];
+        }
+
+        //! Returns the number of distinct strings (including the empty string).
+        int size() const
+        {
+            return m_strings.size();
+        }
+
+        //! Removes all strings except the empty string.
+        void clear();
+    };
+
+
+    //---------------------------------------------------------
+    // CompactGraphAttributes
+    // memory-saving graph attributes for layout-only jobs
+    //---------------------------------------------------------
+    //! Stores positions and a few other attributes of a graph in a compact form.
+    /**
+     * This class is a light-weight alternative to GraphAttributes for jobs that
+     * only need node positions (and possibly sizes and labels) of very large graphs.
+     *
+     * - Coordinates are stored in single precision; x- and y-coordinate of a node
+     *   are interleaved in one node array, so that coordinateData() can be passed
+     *   directly to vectorized code.
+     * - Widths and heights are stored in single precision.
+     * - String-valued attributes (node labels, node templates and edge labels) are
+     *   interned in a shared StringTable; each element only stores an integer id.
+     *
+     * The supported attributes are selected with the bits
+     * GraphAttributes::nodeGraphics, GraphAttributes::nodeLabel,
+     * GraphAttributes::nodeTemplate and GraphAttributes::edgeLabel; all other
+     * bits are ignored. Only the columns of the selected attributes are
+     * allocated; they are allocated when the attribute is initialized, not on
+     * first access.
+     *
+     * FastMultipoleEmbedder::call(CompactGraphAttributes&) computes a layout
+     * directly on this class. For all other layout modules, use transferTo()
+     * and transferFrom() to exchange data with a full GraphAttributes object.
+     */
+    class OGDF_EXPORT CompactGraphAttributes
+    {
+    public:
+        //! Single precision point; used for interleaved x/y-storage.
+        typedef GenericPoint<float> FPoint;
+
+    protected:
+        const Graph* m_pGraph; //!< associated graph
+
+        NodeArray<FPoint> m_xy;        //!< interleaved coordinates of nodes
+        NodeArray<float>  m_width;     //!< width of a node's bounding box
+        NodeArray<float>  m_height;    //!< height of a node's bounding box
+        NodeArray<int>    m_nodeLabel;    //!< id of the label of a node
+        NodeArray<int>    m_nodeTemplate; //!< id of the template name of a node
+        EdgeArray<int>    m_edgeLabel;    //!< id of the label of an edge
+
+        StringTable m_strings; //!< shared table of all string values
+
+        long m_attributes; //!< bit vector of currently used attributes
+
+    public:
+        //! Bit mask of all attributes supported by this class.
+        enum { supportedAttributes = GraphAttributes::nodeGraphics
+                                     | GraphAttributes::nodeLabel
+                                     | GraphAttributes::nodeTemplate
+                                     | GraphAttributes::edgeLabel
+             };
+
+        /**
+         * @name Construction and management of attributes
+         */
+        //@{
+
+        //! Constructs compact graph attributes for no associated graph.
+        CompactGraphAttributes();
+
+        //! Constructs compact graph attributes associated with the graph \a G.
+        /**
+         * @param G is the associated graph.
+         * @param initAttributes specifies the set of attributes that can be accessed;
+         *        unsupported bits are ignored.
+         */
+        explicit CompactGraphAttributes(const Graph & G, long initAttributes = GraphAttributes::nodeGraphics);
+
+        //! Returns currently accessible attributes.
+        long attributes() const
+        {
+            return m_attributes;
+        }
+
+        //! Initializes the attributes for graph \a G; all previously allocated attributes are destroyed.
+        void init(const Graph & G, long initAttr);
+
+        //! Initializes attributes in \a attr for usage.
+        void initAttributes(long attr);
+
+        //! Destroys attributes in \a attr.
+        void destroyAttributes(long attr);
+
+        //! Returns a reference to the associated graph.
+        const Graph & constGraph() const
+        {
+            return *m_pGraph;
+        }
+
+        //! Returns the shared table of string values.
+        const StringTable & stringTable() const
+        {
+            return m_strings;
+        }
+
+        //@}
+        /**
+         * @name Node attributes
+         */
+        //@{
+
+        //! Returns the x-coordinate of node \a v.
+        float x(node v) const
+        {
+            return m_xy[v].m_x;
+        }
+        //! Returns the x-coordinate of node \a v.
+        float & x(node v)
+        {
+            return m_xy[v].m_x;
+        }
+
+        //! Returns the y-coordinate of node \a v.
+        float y(node v) const
+        {
+            return m_xy[v].m_y;
+        }
+        //! Returns the y-coordinate of node \a v.
+        float & y(node v)
+        {
+            return m_xy[v].m_y;
+        }
+
+        //! Returns the interleaved coordinates array.
+        const NodeArray<FPoint> & coordinates() const
+        {
+            return m_xy;
+        }
+        //! Returns the interleaved coordinates array.
+        NodeArray<FPoint> & coordinates()
+        {
+            return m_xy;
+        }
+
+        //! Returns a pointer to the interleaved coordinates x_0, y_0, x_1, y_1, ... (indexed by node index).
+        /**
+         * The pointer becomes invalid if the node array table of the graph grows.
+         */
+        const float* coordinateData() const;
+
+        //! Returns the width of the bounding box of node \a v.
+        float width(node v) const
+        {
+            return m_width[v];
+        }
+        //! Returns the width of the bounding box of node \a v.
+        float & width(node v)
+        {
+            return m_width[v];
+        }
+
+        //! Returns the height of the bounding box of node \a v.
+        float height(node v) const
+        {
+            return m_height[v];
+        }
+        //! Returns the height of the bounding box of node \a v.
+        float & height(node v)
+        {
+            return m_height[v];
+        }
+
+        //! Returns the label of node \a v.
+        const string & label(node v) const
+        {
+            return m_strings[m_nodeLabel[v]];
+        }
+        //! Sets the label of node \a v to \a str.
+        void setLabel(node v, const string & str)
+        {
+            m_nodeLabel[v] = m_strings.intern(str);
+        }
+
+        //! Returns the template name of node \a v.
+        const string & templateNode(node v) const
+        {
+            return m_strings[m_nodeTemplate[v]];
+        }
+        //! Sets the template name of node \a v to \a str.
+        void setTemplateNode(node v, const string & str)
+        {
+            m_nodeTemplate[v] = m_strings.intern(str);
+        }
+
+        //@}
+        /**
+         * @name Edge attributes
+         */
+        //@{
+
+        //! Returns the label of edge \a e.
+        const string & label(edge e) const
+        {
+            return m_strings[m_edgeLabel[e]];
+        }
+        //! Sets the label of edge \a e to \a str.
+        void setLabel(edge e, const string & str)
+        {
+            m_edgeLabel[e] = m_strings.intern(str);
+        }
+
+        //@}
+        /**
+         * @name Utility functions
+         */
+        //@{
+
+        //! Returns the bounding box of the graph (without edge bends).
+        const DRect boundingBox() const;
+
+        //! Copies all attributes that are enabled in both \a GA and this object from \a GA.
+        /**
+         * \pre \a GA is associated with the same graph.
+         */
+        void transferFrom(const GraphAttributes & GA);
+
+        //! Copies all attributes that are enabled in both \a GA and this object to \a GA.
+        /**
+         * \pre \a GA is associated with the same graph.
+         */
+        void transferTo(GraphAttributes & GA) const;
+
+        //@}
+    };
+
+} // end namespace ogdf
+
+
+#endif
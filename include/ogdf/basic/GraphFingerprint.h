@@ -0,0 +1,92 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of structural hash functions for graphs
+ *        and graph attributes.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_GRAPH_FINGERPRINT_H
+#define OGDF_GRAPH_FINGERPRINT_H
+
+#include <ogdf/basic/GraphAttributes.h>
+
+
+namespace ogdf
+{
+
+    //! Attributes of GraphAttributes that are considered by graphFingerprint() by default.
+    /**
+     * These are the attributes layout algorithms read as input: node sizes
+     * (GraphAttributes::nodeGraphics; coordinates are ignored), node weights
+     * and types, and edge weights and types.
+     */
+    const long fingerprintAttributes =
+        GraphAttributes::nodeGraphics | GraphAttributes::nodeWeight | GraphAttributes::nodeType
+        | GraphAttributes::edgeIntWeight | GraphAttributes::edgeDoubleWeight | GraphAttributes::edgeType;
+
+    //! Returns a 64-bit hash of the structure of \a G.
+    /**
+     * Nodes are identified by their position in the node list of \a G, so the
+     * hash does not depend on node or edge indices (e.g., holes left by
+     * deleted elements). Two graphs have the same fingerprint if they have the
+     * same number of nodes and the same edge sequence with respect to these
+     * positions; different fingerprints imply different graphs.
+     *
+     * The fingerprint is not canonical: it depends on the order of the node
+     * and edge lists, so isomorphic graphs whose lists are ordered differently
+     * get different fingerprints. This is intended, since the result of most
+     * layout algorithms depends on this order as well, and LayoutCache stores
+     * layouts by list position.
+     */
+    OGDF_EXPORT __uint64 graphFingerprint(const Graph & G);
+
+    //! Returns a 64-bit hash of the structure of the graph of \a GA and of its attributes \a attributes.
+    /**
+     * Only attributes in \a attributes that are enabled in \a GA and listed in
+     * ogdf::fingerprintAttributes are hashed; in particular, labels and
+     * coordinates never contribute to the fingerprint.
+     */
+    OGDF_EXPORT __uint64 graphFingerprint(const GraphAttributes & GA, long attributes = fingerprintAttributes);
+
+} // end namespace ogdf
+
+
+#endif
@@ -0,0 +1,207 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of class LayoutCache, which stores the results
+ *        of a layout module for repeated inputs.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_LAYOUT_CACHE_H
+#define OGDF_LAYOUT_CACHE_H
+
+#include <ogdf/basic/ModuleOption.h>
+#include <ogdf/basic/GraphFingerprint.h>
+#include <ogdf/module/LayoutModule.h>
+
+
+namespace ogdf
+{
+
+    //! Layout module that reuses the results of another layout module for repeated inputs.
+    /**
+     * A layout cache wraps a layout module (set with setLayoutModule()). When
+     * it is called, it computes a fingerprint of the input (see
+     * graphFingerprint()) and looks it up together with a key describing the
+     * layout module and its configuration. On a hit, the stored node coordinates (and bend points,
+     * if GraphAttributes::edgeGraphics is enabled) are copied to the graph
+     * attributes; otherwise the wrapped module is called and its result is
+     * stored.
+     *
+     * The module key has to be given by the caller together with the layout
+     * module. Layout modules do not expose their options in a generic way, so
+     * the cache cannot detect changes of the configuration: the key has to
+     * identify the module and every option that has been changed from its
+     * default, and it has to be changed (with setModuleKey()) whenever the
+     * configuration of the wrapped module changes. Otherwise, layouts computed
+     * with the old configuration are returned.
+     *
+     * Stored results refer to nodes and edges by their position in the node
+     * and edge lists, so they carry over to graphs with the same structure but
+     * different labels or indices. The contents of the cache can be written to
+     * and read from a binary stream with save() and load().
+     *
+     * <H3>Optional parameters</H3>
+     *
+     * <table>
+     *   <tr>
+     *     <th><i>Option</i><th><i>Type</i><th><i>Default</i><th><i>Description</i>
+     *   </tr><tr>
+     *     <td><i>maxEntries</i><td>int<td>1024
+     *     <td>The maximal number of stored layouts; the oldest ones are evicted first.
+     *   </tr><tr>
+     *     <td><i>attributes</i><td>long<td>ogdf::fingerprintAttributes
+     *     <td>The attributes that are part of the fingerprint.
+     *   </tr>
+     * </table>
+     */
+    class OGDF_EXPORT LayoutCache : public LayoutModule
+    {
+        struct Entry;
+
+        ModuleOption<LayoutModule> m_layout; //!< the wrapped layout module
+        string m_moduleKey;  //!< identifies the wrapped module and its configuration
+
+        Hashing<__uint64, Entry*> m_entries; //!< stored layouts, by key hash
+        List<Entry*> m_order;  //!< stored layouts, oldest first
+        int  m_maxEntries;     //!< maximal number of stored layouts
+        long m_attributes;     //!< attributes that are part of the fingerprint
+
+        long m_hits;   //!< number of calls answered from the cache
+        long m_misses; //!< number of calls of the wrapped module
+
+    public:
+        //! Creates a layout cache without a layout module.
+        LayoutCache();
+
+        ~LayoutCache();
+
+        //! Computes a layout of \a GA, or copies a stored one.
+        void call(GraphAttributes & GA);
+
+        //! Sets the wrapped layout module to \a pLayout; \a moduleKey identifies the module and its configuration.
+        /**
+         * \pre \a moduleKey is not empty if \a pLayout is not 0.
+         */
+        void setLayoutModule(LayoutModule* pLayout, const string & moduleKey);
+
+        //! Sets the key identifying the wrapped layout module and its configuration to \a moduleKey.
+        /**
+         * Call this whenever the options of the wrapped module are changed.
+         * \pre \a moduleKey is not empty.
+         */
+        void setModuleKey(const string & moduleKey);
+
+        //! Returns the key identifying the wrapped layout module and its configuration.
+        const string & moduleKey() const
+        {
+            return m_moduleKey;
+        }
+
+        //! Returns the maximal number of stored layouts.
+        int maxEntries() const
+        {
+            return m_maxEntries;
+        }
+
+        //! Sets the maximal number of stored layouts to \a n (n >= 1).
+        void maxEntries(int n);
+
+        //! Returns the attributes that are part of the fingerprint.
+        long attributes() const
+        {
+            return m_attributes;
+        }
+
+        //! Sets the attributes that are part of the fingerprint.
+        void attributes(long attr)
+        {
+            m_attributes = attr;
+        }
+
+        //! Returns the number of stored layouts.
+        int size() const
+        {
+            return m_order.size();
+        }
+
+        //! Returns the number of calls answered from the cache.
+        long hits() const
+        {
+            return m_hits;
+        }
+
+        //! Returns the number of calls passed to the wrapped layout module.
+        long misses() const
+        {
+            return m_misses;
+        }
+
+        //! Removes all stored layouts and resets the statistics.
+        void clear();
+
+        //! Writes all stored layouts to the binary stream \a os.
+        /**
+         * @return true if successful, false otherwise.
+         */
+        bool save(ostream & os) const;
+
+        //! Reads stored layouts from the binary stream \a is (as written by save()).
+        /**
+         * The layouts are added to the layouts already stored. The stream is
+         * checked for consistency, so corrupted streams are rejected.
+         * @return true if successful, false otherwise (in this case, the layouts
+         *         read so far are kept).
+         */
+        bool load(istream & is);
+
+    private:
+        static __uint64 keyHash(const string & moduleKey, __uint64 fingerprint);
+
+        Entry* lookup(const string & moduleKey, __uint64 fingerprint, const Graph & G) const;
+        void insert(Entry* pEntry);
+
+        LayoutCache(const LayoutCache &); // = delete
+        LayoutCache & operator=(const LayoutCache &); // = delete
+    };
+
+} // end namespace ogdf
+
+
+#endif
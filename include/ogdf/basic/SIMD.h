@@ -0,0 +1,183 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of class SIMD and class template SIMDKernel for
+ *        runtime selection of vectorized kernels.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_SIMD_H
+#define OGDF_SIMD_H
+
+#include <ogdf/basic/basic.h>
+
+
+namespace ogdf
+{
+
+    //! Instruction set levels for which SIMD kernels can be compiled.
+    /**
+     * The levels are ordered; a CPU supporting a level usually supports all
+     * lower levels as well.
+     */
+    enum SIMDLevel
+    {
+        simdScalar, //!< portable code without SIMD instructions
+        simdSSE2,   //!< Streaming SIMD Extensions 2 (SSE2)
+        simdSSE3,   //!< Streaming SIMD Extensions 3 (SSE3)
+        simdAVX2,   //!< Advanced Vector Extensions 2 (AVX2) with FMA3
+        simdAVX512, //!< AVX-512 Foundation instructions (AVX-512F)
+        simdNumberOfLevels
+    };
+
+
+    //! Selection of the instruction set level used by SIMD kernels.
+    /**
+     * SIMD kernels are compiled per function for each instruction set level
+     * (see OGDF_TARGET_AVX2 and OGDF_TARGET_AVX512 in internal/basic/intrinsics.h),
+     * independent of the compiler flags for the whole library. Hence, a single
+     * binary contains kernels for several levels, and the kernels are selected
+     * at run time (see SIMDKernel).
+     *
+     * At startup, level() is set to supportedLevel(), the highest level supported by
+     * the compiler and by the CPU (as reported by System::cpuFeatures()). The level
+     * can be lowered (e.g., in order to test every kernel) by
+     *   - setting the environment variable <tt>OGDF_SIMD</tt> to one of
+     *     <tt>scalar</tt>, <tt>sse2</tt>, <tt>sse3</tt>, <tt>avx2</tt>, <tt>avx512</tt>; or
+     *   - calling maxLevel().
+     */
+    class OGDF_EXPORT SIMD
+    {
+    public:
+        //! Returns the instruction set level used by SIMD kernels.
+        static SIMDLevel level()
+        {
+            return s_level;
+        }
+
+        //! Returns the highest instruction set level supported by the compiler and the CPU.
+        static SIMDLevel supportedLevel()
+        {
+            return s_supportedLevel;
+        }
+
+        //! Restricts the level used by SIMD kernels to \a maxLevel.
+        /**
+         * The level is set to the minimum of \a maxLevel and supportedLevel(). Must not
+         * be called while an algorithm using SIMD kernels is running.
+         * @return the new level.
+         */
+        static SIMDLevel maxLevel(SIMDLevel maxLevel);
+
+        //! Returns the name of \a level (as used for <tt>OGDF_SIMD</tt>).
+        static const char* name(SIMDLevel level);
+
+        //! Converts the name \a str into the \a level; returns false if \a str is not a valid name.
+        static bool fromName(const char* str, SIMDLevel & level);
+
+        //! Static initilization routine (automatically called).
+        static void init();
+
+    private:
+        static SIMDLevel s_level;          //!< The level used by SIMD kernels.
+        static SIMDLevel s_supportedLevel; //!< The highest supported level.
+    };
+
+
+    //! A kernel function with variants for several instruction set levels.
+    /**
+     * A SIMDKernel stores a function pointer of type \a Function for each
+     * instruction set level; only the scalar variant is mandatory. Typically,
+     * a SIMDKernel is a static object in the translation unit implementing the
+     * variants, and get() is called once before calling the kernel in a loop.
+     *
+     * \code
+     * static SIMDKernel<KernelFunction> s_kernel = SIMDKernel<KernelFunction>(kernel)
+     * #ifdef OGDF_AVX2_EXTENSIONS
+     *     .add(simdAVX2, kernel_avx2)
+     * #endif
+     *     ;
+     * ...
+     * KernelFunction f = s_kernel.get();
+     * \endcode
+     */
+    template<class Function>
+    class SIMDKernel
+    {
+    public:
+        //! Creates a kernel with the scalar variant \a scalar.
+        explicit SIMDKernel(Function scalar)
+        {
+            m_variant[simdScalar] = scalar;
+            for(int l = simdScalar + 1; l < simdNumberOfLevels; ++l)
+                m_variant[l] = 0;
+        }
+
+        //! Adds the variant \a f for instruction set level \a level.
+        SIMDKernel & add(SIMDLevel level, Function f)
+        {
+            m_variant[level] = f;
+            return *this;
+        }
+
+        //! Returns the level of the variant returned by get().
+        SIMDLevel selectedLevel() const
+        {
+            int l = SIMD::level();
+            while(l > simdScalar && m_variant[l] == 0)
+                --l;
+            return SIMDLevel(l);
+        }
+
+        //! Returns the variant for the highest level not exceeding SIMD::level().
+        Function get() const
+        {
+            return m_variant[selectedLevel()];
+        }
+
+    private:
+        Function m_variant[simdNumberOfLevels]; //!< The variants (0 if not available).
+    };
+
+} // end namespace ogdf
+
+
+#endif
@@ -123,7 +123,8 @@ namespace ogdf
     /**
      * This enumeration is used to specify spcial additional features that
      * are supported by the CPU, in particular extended instruction sets
-     * such as SSE.
+     * such as SSE. The AVX features are only reported if the operating
+     * system also saves the corresponding registers.
      */
     enum CPUFeature
     {
@@ -137,7 +138,11 @@ namespace ogdf
         cpufVMX,    //!< Virtual Machine Extensions
         cpufSMX,    //!< Safer Mode Extensions
         cpufEST,    //!< Enhanced Intel SpeedStep Technology
-        cpufMONITOR //!< Processor supports MONITOR/MWAIT instructions
+        cpufMONITOR, //!< Processor supports MONITOR/MWAIT instructions
+        cpufAVX,    //!< Advanced Vector Extensions (AVX)
+        cpufAVX2,   //!< Advanced Vector Extensions 2 (AVX2)
+        cpufFMA,    //!< Fused multiply-add instructions (FMA3)
+        cpufAVX512F //!< AVX-512 Foundation instructions (AVX-512F)
     };
 
     //! Bit mask for CPU features.
@@ -153,7 +158,11 @@ namespace ogdf
         cpufmVMX     = 1 << cpufVMX,    //!< Virtual Machine Extensions
         cpufmSMX     = 1 << cpufSMX,    //!< Safer Mode Extensions
         cpufmEST     = 1 << cpufEST,    //!< Enhanced Intel SpeedStep Technology
-        cpufmMONITOR = 1 << cpufMONITOR //!< Processor supports MONITOR/MWAIT instructions
+        cpufmMONITOR = 1 << cpufMONITOR, //!< Processor supports MONITOR/MWAIT instructions
+        cpufmAVX     = 1 << cpufAVX,    //!< Advanced Vector Extensions (AVX)
+        cpufmAVX2    = 1 << cpufAVX2,   //!< Advanced Vector Extensions 2 (AVX2)
+        cpufmFMA     = 1 << cpufFMA,    //!< Fused multiply-add instructions (FMA3)
+        cpufmAVX512F = 1 << cpufAVX512F //!< AVX-512 Foundation instructions (AVX-512F)
     };
 
 
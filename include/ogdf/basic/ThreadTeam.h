@@ -0,0 +1,260 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of class ThreadTeam and function runKernelThreads,
+ *        which run member functions of an object in several threads.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_THREAD_TEAM_H
+#define OGDF_THREAD_TEAM_H
+
+#include <ogdf/basic/Thread.h>
+#include <ogdf/basic/Barrier.h>
+#include <ogdf/basic/Array.h>
+
+
+namespace ogdf
+{
+
+    //! Thread executing a kernel (a member function taking the thread number) of an object.
+    template<class T>
+    class KernelThread : public Thread
+    {
+    public:
+        typedef void (T::*Kernel)(int);
+
+        KernelThread(T* pObject, Kernel kernel, int threadNr)
+            : m_pObject(pObject), m_kernel(kernel), m_threadNr(threadNr) { }
+
+    protected:
+        void doWork()
+        {
+            (m_pObject->*m_kernel)(m_threadNr);
+        }
+
+    private:
+        T*     m_pObject;
+        Kernel m_kernel;
+        int    m_threadNr;
+    };
+
+
+    //! Calls (pObject->*kernel)(t) for t = 0,...,numThreads-1 in parallel.
+    /**
+     * Kernel 0 is executed by the calling thread; the function returns when
+     * all kernels have finished.
+     */
+    template<class T>
+    void runKernelThreads(T* pObject, void (T::*kernel)(int), int numThreads)
+    {
+        Array<KernelThread<T>*> thread(1, numThreads - 1);
+        for(int t = 1; t < numThreads; ++t)
+        {
+            thread[t] = new KernelThread<T>(pObject, kernel, t);
+            thread[t]->start();
+        }
+
+        (pObject->*kernel)(0);
+
+        for(int t = 1; t < numThreads; ++t)
+        {
+            thread[t]->join();
+            delete thread[t];
+        }
+    }
+
+
+    //! Team of threads executing kernels of an object, kept alive between the kernels.
+    /**
+     * Algorithms that run many short parallel phases use a team instead of
+     * runKernelThreads(), which starts new threads for every phase. The threads
+     * wait at a barrier between the phases.
+     */
+    template<class T>
+    class ThreadTeam
+    {
+    public:
+        typedef void (T::*Kernel)(int);
+
+        //! Starts \a numThreads - 1 threads; thread 0 is the calling thread.
+        ThreadTeam(T* pObject, int numThreads)
+            : m_pObject(pObject), m_numThreads(numThreads), m_barrier(0), m_kernel(0)
+        {
+            if(m_numThreads > 1)
+            {
+                m_barrier = new Barrier(m_numThreads);
+                m_thread.init(1, m_numThreads - 1);
+                for(int t = 1; t < m_numThreads; ++t)
+                {
+                    m_thread[t] = new KernelThread<ThreadTeam>(this, &ThreadTeam::workerLoop, t);
+                    m_thread[t]->start();
+                }
+            }
+        }
+
+        //! Stops the threads.
+        ~ThreadTeam()
+        {
+            if(m_numThreads > 1)
+            {
+                m_kernel = 0;
+                m_barrier->threadSync();
+                for(int t = 1; t < m_numThreads; ++t)
+                {
+                    m_thread[t]->join();
+                    delete m_thread[t];
+                }
+                delete m_barrier;
+            }
+        }
+
+        //! Returns the number of threads of the team.
+        int numThreads() const
+        {
+            return m_numThreads;
+        }
+
+        //! Calls (pObject->*kernel)(t) for t = 0,...,numThreads()-1 in parallel.
+        /**
+         * Kernel 0 is executed by the calling thread; the function returns when
+         * all kernels have finished.
+         */
+        void run(Kernel kernel)
+        {
+            m_kernel = kernel;
+            if(m_numThreads > 1)
+                m_barrier->threadSync();
+            (m_pObject->*kernel)(0);
+            if(m_numThreads > 1)
+                m_barrier->threadSync();
+        }
+
+    private:
+        T*       m_pObject;
+        int      m_numThreads;
+        Barrier* m_barrier;
+        Kernel   m_kernel; //!< the current kernel (0 if the threads shall stop)
+        Array<KernelThread<ThreadTeam>*> m_thread;
+
+        void workerLoop(int t)
+        {
+            for(;;)
+            {
+                m_barrier->threadSync();
+                if(m_kernel == 0)
+                    return;
+                (m_pObject->*m_kernel)(t);
+                m_barrier->threadSync();
+            }
+        }
+
+        ThreadTeam(const ThreadTeam &); // = delete
+        ThreadTeam & operator=(const ThreadTeam &); // = delete
+    };
+
+
+    //! Team of threads executing kernels of arbitrary objects, kept alive between the kernels.
+    /**
+     * Unlike ThreadTeam, the team is not bound to a single object, so an
+     * algorithm can keep one team for all its phases and pass it to the
+     * classes that do the work. A kernel that needs fewer threads than the
+     * team has returns immediately for the other thread numbers.
+     */
+    class KernelTeam
+    {
+    public:
+        //! Starts \a numThreads - 1 threads; thread 0 is the calling thread.
+        explicit KernelTeam(int numThreads)
+            : m_team(this, numThreads), m_pObject(0), m_pKernel(0), m_call(0) { }
+
+        //! Returns the number of threads of the team.
+        int numThreads() const
+        {
+            return m_team.numThreads();
+        }
+
+        //! Calls (pObject->*kernel)(t) for t = 0,...,numThreads()-1 in parallel.
+        /**
+         * Kernel 0 is executed by the calling thread; the function returns when
+         * all kernels have finished.
+         */
+        template<class T>
+        void run(T* pObject, void (T::*kernel)(int))
+        {
+            m_pObject = pObject;
+            m_pKernel = &kernel;
+            m_call = &callKernel<T>;
+            m_team.run(&KernelTeam::dispatch);
+        }
+
+    private:
+        ThreadTeam<KernelTeam> m_team;
+        void*       m_pObject; //!< the object of the current kernel
+        const void* m_pKernel; //!< points to the current kernel (a member function pointer)
+        void (*m_call)(void*, const void*, int); //!< calls the current kernel
+
+        template<class T>
+        static void callKernel(void* pObject, const void* pKernel, int t)
+        {
+            typedef void (T::*Kernel)(int);
+            (static_cast<T*>(pObject)->*(*static_cast<const Kernel*>(pKernel)))(t);
+        }
+
+        void dispatch(int t)
+        {
+            m_call(m_pObject, m_pKernel, t);
+        }
+
+        KernelTeam(const KernelTeam &); // = delete
+        KernelTeam & operator=(const KernelTeam &); // = delete
+    };
+
+
+    //! Returns the first index of the \a t-th of \a numThreads parts of 0,...,\a n-1.
+    inline int threadRangeBegin(int n, int t, int numThreads)
+    {
+        return (int)((__int64)n * t / numThreads);
+    }
+
+} // end namespace ogdf
+
+#endif
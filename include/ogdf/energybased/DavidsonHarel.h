@@ -72,6 +72,40 @@ namespace ogdf
         //! Sets the number of iterations for each temperature step to \a steps.
         void setNumberOfIterations(int steps);
 
+        //! Sets the number of candidates that are evaluated together to \a size.
+        /**
+         * If \a size is greater than 1, \a size candidates are drawn from the
+         * current layout and their energies are computed at once, in parallel if
+         * more than one thread is used. The candidates are then tested in the
+         * order they were drawn; after the first accepted candidate, the remaining
+         * ones are discarded, since their energies refer to the old layout. Each
+         * tested candidate counts as an iteration. The result does not depend on
+         * the number of threads. Default is 1 (no batches).
+         * Throws an AlgorithmFailureException if \a size is less than 1.
+         */
+        void setBatchSize(int size);
+
+        //! Returns the number of candidates that are evaluated together.
+        int batchSize() const
+        {
+            return m_batchSize;
+        }
+
+        //! Sets the number of threads evaluating the candidates of a batch to \a n.
+        /**
+         * Energy functions that do not support concurrent evaluation (see
+         * EnergyFunction::prepareConcurrentCandidates()) are evaluated by the
+         * calling thread. At most batchSize() threads are used. Throws an
+         * AlgorithmFailureException if \a n is less than 1.
+         */
+        void setNumberOfThreads(int n);
+
+        //! Returns the number of threads evaluating the candidates of a batch.
+        int numberOfThreads() const
+        {
+            return m_numberOfThreads;
+        }
+
         //! Adds an energy function \a F with a certain weight.
         void addEnergyFunction(EnergyFunction* F, double weight);
 
@@ -101,12 +135,16 @@ namespace ogdf
         double m_diskRadius;        //!< The radius of the disk around the old position of a vertex where the new position will be.
         double m_energy;            //!< The current energy of the system.
         int m_numberOfIterations;   //!< The number of iterations per temperature step.
+        int m_batchSize;            //!< The number of candidates evaluated together.
+        int m_numberOfThreads;      //!< The number of threads evaluating a batch.
 
         List<EnergyFunction*> m_energyFunctions; //!< The list of the energy functions.
         List<double> m_weightsOfEnergyFunctions; //!< The list of the weights for the energy functions.
 
         List<node> m_nonIsolatedNodes; //!< The list of nodes with degree greater 0.
 
+        class CandidateBatch;
+
         //! Resets the parameters for subsequent runs.
         void initParameters();
 
@@ -116,6 +154,16 @@ namespace ogdf
         //! Tests if new energy value satisfies annealing property (only better if m_fineTune).
         bool testEnergyValue(double newVal);
 
+        //! Performs the iterations of a temperature step with candidates evaluated in batches.
+        void batchedIterations(GraphAttributes & AG, CandidateBatch & batch);
+
+        //! Moves \a v to \a newPos and informs the energy functions.
+        /**
+         * Requires that the candidate energies of all energy functions were
+         * computed for this move last.
+         */
+        void takeCandidate(GraphAttributes & AG, node v, const DPoint & newPos, double newEnergy);
+
         //! Computes a random number between zero and one
         double randNum() const;
 
@@ -171,6 +171,24 @@ namespace ogdf
             m_itAsFactor = b;
         }
 
+        //! Sets the number of candidates that are evaluated together (see DavidsonHarel::setBatchSize()).
+        void setBatchSize(int size);
+
+        //! Returns the number of candidates that are evaluated together.
+        int getBatchSize() const
+        {
+            return m_batchSize;
+        }
+
+        //! Sets the number of threads evaluating the candidates of a batch.
+        void setNumberOfThreads(int n);
+
+        //! Returns the number of threads evaluating the candidates of a batch.
+        int getNumberOfThreads() const
+        {
+            return m_numberOfThreads;
+        }
+
     private:
         double m_repulsionWeight;   //!< The weight for repulsion energy.
         double m_attractionWeight;  //!< The weight for attraction energy.
@@ -183,6 +201,8 @@ namespace ogdf
         double m_prefEdgeLength;    //!< Preferred edge length (abs value), only used if > 0
         bool m_crossings;           //!< Should crossings be computed?
         bool m_itAsFactor;          //!< Should m_numberOfIterations be factor (true) or fixed number
+        int m_batchSize;            //!< The number of candidates evaluated together.
+        int m_numberOfThreads;      //!< The number of threads evaluating a batch.
     };
 
 }
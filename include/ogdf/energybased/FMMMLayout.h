@@ -54,6 +54,8 @@
 #include <ogdf/basic/geometry.h>
 #include <ogdf/internal/energybased/FruchtermanReingold.h>
 #include <ogdf/internal/energybased/NMM.h>
+#include <ogdf/energybased/WarmStart.h>
+#include <ogdf/energybased/IterationMonitor.h>
 
 
 namespace ogdf
@@ -124,6 +126,9 @@ namespace ogdf
      *     <td><i>maxIntPosExponent</i><td>int<td>40
      *     <td>Defines the exponent used if allowedPositions == apExponent.
      *   </tr><tr>
+     *     <td><i>numberOfThreads</i><td>int<td>1
+     *     <td>The number of threads used for the force calculation.
+     *   </tr><tr>
      *     <th colspan="4" align="center"><b>Divide et impera step</b>
      *   </tr><tr>
      *     <td><i>pageRatio</i><td>double<td>1.0
@@ -357,8 +362,9 @@ namespace ogdf
         //! Specifies how the reduced bucket quadtree is constructed.
         enum ReducedTreeConstruction
         {
-            rtcPathByPath,      //!< Path-by-path construction.
-            rtcSubtreeBySubtree //!< Subtree-by-subtree construction.
+            rtcPathByPath,       //!< Path-by-path construction.
+            rtcSubtreeBySubtree, //!< Subtree-by-subtree construction.
+            rtcLinear            //!< Array based quadtree of particles sorted by Morton numbers.
         };
 
         //! Specifies how to calculate the smallest quadratic cell surrounding particles of a node in the reduced bucket quadtree.
@@ -423,6 +429,24 @@ namespace ogdf
             const EdgeArray<double> & edgeLength, //factor for desired edge lengths
             char* ps_file);
 
+        //! Incremental algorithm call: Improves the current layout of \a GA after a small change of the graph.
+        /**
+         * \a ws must have been initialized for \a GA (see WarmStart). No multilevel
+         * hierarchy is created and the connected components are neither packed nor
+         * is the drawing resized; instead, the force calculation step is applied to
+         * the current layout with ws.iterations() of the iterations of the finest
+         * level, and the displacement of every node is scaled by its mobility.
+         * A node outside the affected region moves at most ws.frozenMobility()
+         * average ideal edge lengths away from its initial position.
+         */
+        void callIncremental(GraphAttributes & GA, const WarmStart & ws);
+
+        //! Incremental algorithm call: Allows to pass desired lengths of the edges.
+        void callIncremental(
+            GraphAttributes & GA,
+            const EdgeArray<double> & edgeLength,
+            const WarmStart & ws);
+
         /** @}
          *  @name Further information.
          *  @{
@@ -434,6 +458,26 @@ namespace ogdf
             return time_total;
         }
 
+        //! Returns the monitor observing the iterations (or 0).
+        IterationMonitor* iterationMonitor() const
+        {
+            return m_pMonitor;
+        }
+
+        //! Sets the monitor observing the iterations to \a pMonitor (0 = none).
+        /**
+         * The monitor is not deleted by the algorithm. The iterations of all levels
+         * and of the postprocessing step are reported, the displacements in units of
+         * the average ideal edge length. If the monitor stops the iterations of a
+         * level, the algorithm continues with the next level; once its time limit
+         * is exceeded, no further iterations are performed, but the drawing is still
+         * resized and packed.
+         */
+        void setIterationMonitor(IterationMonitor* pMonitor)
+        {
+            m_pMonitor = pMonitor;
+        }
+
 
         /** @}
          *  @name High-level options
@@ -604,6 +648,24 @@ namespace ogdf
             m_maxIntPosExponent = (((e >= 31) && (e <= 51)) ? e : 31);
         }
 
+        //! Returns the current setting of option numberOfThreads.
+        /**
+         * This option defines the number of threads used for calculating the
+         * repulsive and attractive forces. For a fixed random seed, the resulting
+         * layout does not depend on the number of threads as long as it is greater
+         * than one; with a single thread the sequential algorithm is used.
+         */
+        int numberOfThreads() const
+        {
+            return m_numberOfThreads;
+        }
+
+        //! Sets the option numberOfThreads to \a n.
+        void numberOfThreads(int n)
+        {
+            m_numberOfThreads = ((n >= 1) ? n : 1);
+        }
+
 
         /** @}
          *  @name Options for the divide et impera step
@@ -1123,6 +1185,8 @@ namespace ogdf
          * Possible values:
          *   - \a rtcPathByPath: path by path construction
          *   - \a rtcSubtreeBySubtree: subtree by subtree construction
+         *   - \a rtcLinear: the particles are sorted by their Morton numbers and the tree
+         *     is stored in arrays that are reused in every iteration
          */
         ReducedTreeConstruction nmTreeConstruction() const
         {
@@ -1199,6 +1263,7 @@ namespace ogdf
         EdgeLengthMeasurement m_edgeLengthMeasurement; //!< The option for edge length measurement.
         AllowedPositions      m_allowedPositions; //!< The option for allowed positions.
         int                   m_maxIntPosExponent; //!< The option for the used exponent.
+        int                   m_numberOfThreads; //!< The number of threads for the force calculation.
 
         //options for divide et impera step
         double                m_pageRatio; //!< The desired page ratio.
@@ -1260,6 +1325,21 @@ namespace ogdf
 
         FruchtermanReingold FR; //!< Class for repulsive force calculation (Fruchterman, Reingold).
         NMM NM; //!< Class for repulsive force calculation.
+        KernelTeam* m_pTeam; //!< The threads of the force calculation during a call (or 0).
+
+        //the state of the parallel calculation of attractive forces
+        Array<node>                nodes; //!< The nodes of the current graph.
+        NodeArray<NodeAttributes>* A_ptr; //!< The node attributes of the current graph.
+        EdgeArray<EdgeAttributes>* E_ptr; //!< The edge attributes of the current graph.
+        NodeArray<DPoint>*         F_attr_ptr; //!< The attractive forces.
+        int                        attr_number_of_threads; //!< The number of threads for attractive forces.
+
+        //the state of an incremental call
+        const WarmStart*  m_warmStart; //!< The warm start of an incremental call (or 0).
+        NodeArray<double> m_mobility;  //!< The mobility of the nodes of the current graph.
+        NodeArray<DPoint> m_startPosition; //!< The initial positions of the nodes of the current graph.
+
+        IterationMonitor* m_pMonitor; //!< The monitor observing the iterations (or 0).
 
 
         //------------------- most important functions ----------------------------
@@ -1270,6 +1350,12 @@ namespace ogdf
             NodeArray<NodeAttributes> & A,
             EdgeArray<EdgeAttributes> & E);
 
+        //! Calls the force calculation step for the current layout of \a G (incremental call).
+        void call_INCREMENTAL_step(
+            Graph & G,
+            NodeArray<NodeAttributes> & A,
+            EdgeArray<EdgeAttributes> & E);
+
         //! Calls the multilevel step for subGraph \a G.
         void call_MULTILEVEL_step_for_subGraph(
             Graph & G,
@@ -1497,6 +1583,9 @@ namespace ogdf
 
         //------------------  functions for force calculation ---------------------------
 
+        //! Reports the movements \a F of the last iteration to the monitor; returns true if it stops the iterations.
+        bool report_iteration(Graph & G, NodeArray<DPoint> & F);
+
         //! The forces are calculated here.
         void calculate_forces(
             Graph & G,
@@ -1553,6 +1642,19 @@ namespace ogdf
             EdgeArray<EdgeAttributes> & E,
             NodeArray<DPoint> & F_attr);
 
+        //! Calculates attractive forces for each node using numberOfThreads() threads.
+        void calculate_attractive_forces_in_parallel(
+            Graph & G,
+            NodeArray<NodeAttributes> & A,
+            EdgeArray<EdgeAttributes> & E,
+            NodeArray<DPoint> & F_attr);
+
+        //! Calculates the attractive forces of the \a t-th part of the nodes.
+        void attractive_forces_kernel(int t);
+
+        //! Returns the attractive force of edge \a e on its source.
+        DPoint f_attr_on_source(NodeArray<NodeAttributes> & A, EdgeArray<EdgeAttributes> & E, edge e);
+
         //! Returns the attractive force scalar.
         double f_attr_scalar(double d, double ind_ideal_edge_length);
 
@@ -1565,7 +1667,7 @@ namespace ogdf
             int iter,
             int fine_tuning_step);
 
-        //! Move the nodes.
+        //! Move the nodes (scaled by their mobility in an incremental call); \a F is set to the applied movements.
         void move_nodes(Graph & G, NodeArray<NodeAttributes> & A, NodeArray<DPoint> & F);
 
         //! Computes a new tight computational square-box.
@@ -49,7 +49,10 @@
 
 #include <ogdf/basic/Graph.h>
 #include <ogdf/module/LayoutModule.h>
+#include <ogdf/basic/CompactGraphAttributes.h>
 #include <ogdf/internal/energybased/MultilevelGraph.h>
+#include <ogdf/energybased/WarmStart.h>
+#include <ogdf/energybased/IterationMonitor.h>
 
 namespace ogdf
 {
@@ -94,18 +97,54 @@ namespace ogdf
         //! Calls the algorithm for graph \a GA and returns the layout information in \a GA.
         void call(GraphAttributes & GA);
 
+        //! Calls the algorithm for graph \a CGA and returns the layout information in \a CGA.
+        /**
+         * The node sizes are derived from the widths and heights in \a CGA like in
+         * call(GraphAttributes&). The single precision coordinates are read and
+         * written directly, so no GraphAttributes of the graph is required.
+         * \pre \a CGA contains GraphAttributes::nodeGraphics.
+         */
+        void call(CompactGraphAttributes & CGA);
+
+        //! Calls the algorithm incrementally for graph \a GA and returns the layout information in \a GA.
+        /**
+         * The current positions in \a GA are used as initial layout (regardless
+         * of setRandomize()); \a ws must have been initialized for \a GA. The
+         * displacement of a node is scaled by its mobility and the numbers of
+         * preprocessing and main iterations are reduced by ws.iterations().
+         */
+        void callIncremental(GraphAttributes & GA, const WarmStart & ws);
+
         //! sets the maximum number of iterations
         void setNumIterations(__uint32 numIterations)
         {
             m_numIterations = numIterations;
         }
 
+        //! returns the monitor observing the iterations (or 0)
+        IterationMonitor* iterationMonitor() const
+        {
+            return m_pMonitor;
+        }
+
+        //! sets the monitor observing the iterations of the main step to \a pMonitor (0 = none); it is not deleted by the algorithm
+        void setIterationMonitor(IterationMonitor* pMonitor)
+        {
+            m_pMonitor = pMonitor;
+        }
+
         //! sets the number of coefficients for the expansions. default = 4
         void setMultipolePrec(__uint32 precision)
         {
             m_precisionParameter = precision;
         }
 
+        //! if true, the multipole-to-local translation is computed in single precision. default = false
+        void setMultipoleSinglePrecision(bool b)
+        {
+            m_multipoleSinglePrecision = b;
+        }
+
         //! if true, layout algorithm will randomize the layout in the beginning
         void setRandomize(bool b)
         {
@@ -132,6 +171,23 @@ namespace ogdf
 #endif
         }
 
+        //! uses the thread pool \a pThreadPool instead of an own pool (0 = own pool)
+        /**
+         * The pool is not deleted by the embedder; the thread count is then only
+         * bounded by the size of the pool and by the number of nodes. As for an own
+         * pool, only one thread is used if OGDF_MEMORY_POOL_NTS is defined.
+         */
+        void setThreadPool(FMEThreadPool* pThreadPool)
+        {
+            m_pExternalThreadPool = pThreadPool;
+        }
+
+        //! creates a thread pool with \a numThreads threads which can be shared by several embedders
+        static FMEThreadPool* createThreadPool(__uint32 numThreads);
+
+        //! destroys a thread pool created with createThreadPool()
+        static void destroyThreadPool(FMEThreadPool* pThreadPool);
+
         //void setEnablePostProcessing(bool b) { m_doPostProcessing = b; }
     private:
         void initOptions();
@@ -149,16 +205,23 @@ namespace ogdf
         //! frees the memory
         void deallocate();
 
+        //! returns the pool used by the next run (creates the own pool if required)
+        FMEThreadPool* threadPool();
+
         __uint32 m_numIterations;
 
         ArrayGraph* m_pGraph;
 
         FMEThreadPool* m_threadPool;
 
+        FMEThreadPool* m_pExternalThreadPool;
+
         FMEGlobalOptions* m_pOptions;
 
         __uint32 m_precisionParameter;
 
+        bool m_multipoleSinglePrecision;
+
         bool m_randomize;
 
         float m_defaultEdgeLength;
@@ -168,6 +231,13 @@ namespace ogdf
         __uint32 m_numberOfThreads;
 
         __uint32 m_maxNumberOfThreads;
+
+        const WarmStart* m_warmStart; //!< the warm start of an incremental call (or 0)
+
+        IterationMonitor* m_pMonitor; //!< the monitor observing the iterations (or 0)
+
+        FastMultipoleEmbedder(const FastMultipoleEmbedder &); // = delete
+        FastMultipoleEmbedder & operator=(const FastMultipoleEmbedder &); // = delete
     };
 
 
@@ -175,7 +245,10 @@ namespace ogdf
     {
     public:
         //! Constructor, just sets number of maximum threads
-        FastMultipoleMultilevelEmbedder() : m_iMaxNumThreads(1) {}
+        FastMultipoleMultilevelEmbedder() : m_iMaxNumThreads(1), m_multipoleSinglePrecision(false), m_pThreadPool(0) {}
+
+        ~FastMultipoleMultilevelEmbedder();
+
         //! Calls the algorithm for graph \a GA and returns the layout information in \a GA.
         void call(GraphAttributes & GA);
 
@@ -189,6 +262,12 @@ namespace ogdf
         {
             m_iMaxNumThreads = numThreads;
         }
+
+        //! if true, the multipole-to-local translation is computed in single precision
+        void multipoleSinglePrecision(bool b)
+        {
+            m_multipoleSinglePrecision = b;
+        }
     private:
         //! internal function to compute a good edgelength
         void computeAutoEdgeLength(const GraphAttributes & GA, EdgeArray<float> & edgeLength, float factor = 1.0f);
@@ -227,6 +306,8 @@ namespace ogdf
         __uint32 numberOfIterationsByLevelNr(__uint32 levelNr);
 
         int               m_iMaxNumThreads;
+        bool              m_multipoleSinglePrecision;
+        FMEThreadPool*    m_pThreadPool; //!< the pool shared by all levels and calls
         int               m_iNumLevels;
         int               m_multiLevelNumNodesBound;
 
@@ -244,6 +325,9 @@ namespace ogdf
 
         NodeArray<float>* m_pLastNodeXPos;
         NodeArray<float>* m_pLastNodeYPos;
+
+        FastMultipoleMultilevelEmbedder(const FastMultipoleMultilevelEmbedder &); // = delete
+        FastMultipoleMultilevelEmbedder & operator=(const FastMultipoleMultilevelEmbedder &); // = delete
     };
 
 } // end of namespace ogdf
@@ -123,8 +123,40 @@ namespace ogdf
      *   </tr><tr>
      *     <td><i>pageRatio</i><td>double<td>1.0
      *     <td>The page ratio used for the layout of connected components.
+     *   </tr><tr>
+     *     <td><i>useQuadTree</i><td>bool<td>false
+     *     <td>If true, repulsive forces are approximated with a quadtree.
+     *   </tr><tr>
+     *     <td><i>quadTreeTheta</i><td>double<td>0.6
+     *     <td>The opening criterion of the quadtree approximation.
+     *   </tr><tr>
+     *     <td><i>quadTreeRebuildInterval</i><td>int<td>1
+     *     <td>The number of passes over all nodes after which the quadtree is rebuilt.
+     *   </tr><tr>
+     *     <td><i>batchSize</i><td>int<td>1
+     *     <td>The number of nodes whose impulses are computed simultaneously.
+     *   </tr><tr>
+     *     <td><i>numberOfThreads</i><td>int<td>1
+     *     <td>The maximal number of threads computing the impulses of a batch.
      *   </tr>
      * </table>
+     *
+     * <H3>Large graphs</H3>
+     * The original algorithm computes the repulsive forces acting on a node
+     * from all other nodes, which requires quadratic time per pass over all
+     * nodes. If \a useQuadTree is set, the nodes of each connected component
+     * are stored in a quadtree (LinearQuadTreeNM) that is rebuilt every
+     * \a quadTreeRebuildInterval passes; in between, only the centers of its
+     * cells are moved along with the nodes. Cells whose length is smaller than
+     * \a quadTreeTheta times their distance to the node are replaced by their
+     * center, so a pass only takes O(<I>n</I> log <I>n</I>) time.
+     *
+     * The original algorithm moves one node after the other. If \a batchSize
+     * is larger than 1, the impulses of that many nodes are computed
+     * simultaneously from the same positions and then applied one after the
+     * other (like in a Jacobi iteration), which allows using up to
+     * \a numberOfThreads threads. The result only depends on the batch size
+     * and the random seed, not on the number of threads.
     */
     class OGDF_EXPORT GEMLayout : public LayoutModule
     {
@@ -144,6 +176,11 @@ namespace ogdf
         int m_attractionFormula;        //!< The used formula for attraction.
         double m_minDistCC;             //!< The minimal distance between connected components.
         double m_pageRatio;             //!< The page ratio used for the layout of connected components.
+        bool m_useQuadTree;             //!< Approximate repulsive forces with a quadtree?
+        double m_quadTreeTheta;         //!< The opening criterion of the quadtree.
+        int m_quadTreeRebuildInterval;  //!< The number of passes after which the quadtree is rebuilt.
+        int m_batchSize;                //!< The number of nodes whose impulses are computed simultaneously.
+        int m_numberOfThreads;          //!< The maximal number of threads.
 
         // node data used by the algorithm
 
@@ -344,8 +381,82 @@ namespace ogdf
             m_pageRatio = x;
         }
 
+        //! Returns whether repulsive forces are approximated with a quadtree.
+        bool useQuadTree() const
+        {
+            return m_useQuadTree;
+        }
+
+        //! Sets whether repulsive forces are approximated with a quadtree.
+        void useQuadTree(bool b)
+        {
+            m_useQuadTree = b;
+        }
+
+        //! Returns the opening criterion of the quadtree.
+        double quadTreeTheta() const
+        {
+            return m_quadTreeTheta;
+        }
+
+        //! Sets the opening criterion of the quadtree to \a x; must be >= 0.
+        /**
+         * Smaller values give more accurate forces; 0 computes the exact forces.
+         */
+        void quadTreeTheta(double x)
+        {
+            m_quadTreeTheta = (x < 0) ? 0 : x;
+        }
+
+        //! Returns the number of passes over all nodes after which the quadtree is rebuilt.
+        int quadTreeRebuildInterval() const
+        {
+            return m_quadTreeRebuildInterval;
+        }
+
+        //! Sets the number of passes over all nodes after which the quadtree is rebuilt to \a n; must be >= 1.
+        void quadTreeRebuildInterval(int n)
+        {
+            m_quadTreeRebuildInterval = (n < 1) ? 1 : n;
+        }
+
+        //! Returns the number of nodes whose impulses are computed simultaneously.
+        int batchSize() const
+        {
+            return m_batchSize;
+        }
+
+        //! Sets the number of nodes whose impulses are computed simultaneously to \a n; must be >= 1.
+        /**
+         * A batch size of 1 gives the original algorithm; batch sizes of
+         * 64 or more allow for parallel computation.
+         */
+        void batchSize(int n)
+        {
+            m_batchSize = (n < 1) ? 1 : n;
+        }
+
+        //! Returns the maximal number of threads.
+        int numberOfThreads() const
+        {
+            return m_numberOfThreads;
+        }
+
+        //! Sets the maximal number of threads to \a n; must be >= 1.
+        /**
+         * Threads are only used if the batch size is larger than 1 and only
+         * for connected components with at least 1000 nodes.
+         */
+        void numberOfThreads(int n)
+        {
+            m_numberOfThreads = (n < 1) ? 1 : n;
+        }
+
 
     private:
+        class RepulsionTree; //!< The quadtree approximating repulsive forces.
+        class ImpulseBatch;  //!< Computes the impulses of a batch of nodes in parallel.
+
         //! Returns the length of the vector (\a x,\a y).
         double length(double x, double y = 0) const
         {
@@ -359,7 +470,23 @@ namespace ogdf
         }
 
         //! Computes the new impulse for node \a v.
-        void computeImpulse(GraphCopy & GC, GraphCopyAttributes & AGC, node v);
+        void computeImpulse(GraphCopy & GC, GraphCopyAttributes & AGC, const RepulsionTree* tree, node v);
+
+        //! Computes the impulse (\a impulse[0],\a impulse[1]) for node \a v disturbed by (\a disturbX,\a disturbY).
+        /**
+         * Only reads the layout; hence it may be called for several nodes in parallel.
+         */
+        void computeImpulse(
+            const GraphCopy & GC,
+            const GraphCopyAttributes & AGC,
+            const RepulsionTree* tree,
+            node v,
+            double disturbX,
+            double disturbY,
+            double* impulse) const;
+
+        //! Returns a random disturbance (\a disturbX,\a disturbY).
+        void randomDisturbance(double & disturbX, double & disturbY) const;
 
         //! Updates the node data for node \a v.
         void updateNode(GraphCopy & GC, GraphCopyAttributes & AGC, node v);
@@ -0,0 +1,159 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of class IterationMonitor, which observes the
+ *        iterations of energy-based layout algorithms.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_ITERATION_MONITOR_H
+#define OGDF_ITERATION_MONITOR_H
+
+#include <ogdf/basic/Timeouter.h>
+#include <ogdf/basic/Stopwatch.h>
+
+
+namespace ogdf
+{
+
+    //! Observes the iterations of an energy-based layout algorithm and decides when to stop.
+    /**
+     * A monitor is passed to a layout algorithm with setIterationMonitor()
+     * (supported by SpringEmbedderFRExact, FMMMLayout, FastMultipoleEmbedder
+     * and StressMinimization). The algorithm calls start() at the beginning of
+     * its call and report() after every iteration; report() passes the values
+     * of the iteration to iterationDone(), which can be overridden, e.g., for
+     * profiling, and tells the algorithm to stop iterating if
+     *  - the maximal displacement of a node falls below tolerance(), or
+     *  - the wall-clock time since start() exceeds timeLimit().
+     *
+     * Both criteria are independent of the iteration limits of the algorithms,
+     * which are still respected. Algorithms consisting of several phases
+     * (e.g., the levels of FMMMLayout) start every phase with a new
+     * convergence test, but skip the iterations of all further phases once
+     * the time limit is exceeded.
+     *
+     * The values reported are normalized as follows:
+     *  - \a maxDisplacement is the largest distance a node has moved in the
+     *    iteration, in units of the (average) desired edge length.
+     *  - \a energy is the energy of the layout as far as it is available
+     *    without extra cost: the stress for StressMinimization and the sum of
+     *    the squared (normalized) displacements of all nodes for the
+     *    force-directed algorithms.
+     */
+    class OGDF_EXPORT IterationMonitor : public Timeouter
+    {
+    public:
+        //! The reason for the last request to stop.
+        enum StopReason
+        {
+            srNone,       //!< No stop has been requested.
+            srConverged,  //!< The maximal displacement fell below the tolerance.
+            srTimeLimit   //!< The time limit has been exceeded.
+        };
+
+        //! Creates a monitor without tolerance and time limit.
+        IterationMonitor() : m_tolerance(0), m_numberOfIterations(0), m_stopReason(srNone) { }
+
+        virtual ~IterationMonitor() { }
+
+        //! Returns the tolerance for the maximal displacement (0 = no convergence test).
+        double tolerance() const
+        {
+            return m_tolerance;
+        }
+
+        //! Sets the tolerance for the maximal displacement to \a tol (in units of the desired edge length).
+        void tolerance(double tol)
+        {
+            m_tolerance = max(0.0, tol);
+        }
+
+        //! Starts monitoring a new call of a layout algorithm.
+        void start();
+
+        //! Reports an iteration; returns true if the algorithm shall stop iterating.
+        bool report(double energy, double maxDisplacement);
+
+        //! Returns true if the time limit has been exceeded.
+        bool timeLimitExceeded() const
+        {
+            return isTimeLimit() && elapsedSeconds() >= m_timeLimit;
+        }
+
+        //! Returns the number of iterations reported since start().
+        int numberOfIterations() const
+        {
+            return m_numberOfIterations;
+        }
+
+        //! Returns the wall-clock time since start() in seconds.
+        double elapsedSeconds() const
+        {
+            return m_clock.milliSeconds() / 1000.0;
+        }
+
+        //! Returns the reason for the last request to stop.
+        StopReason stopReason() const
+        {
+            return m_stopReason;
+        }
+
+    protected:
+        //! Is called for every reported iteration (does nothing by default).
+        /**
+         * @param iteration is the number of the iteration since start() (starting with 1).
+         * @param energy is the energy of the layout.
+         * @param maxDisplacement is the maximal displacement of a node.
+         * @param elapsedSeconds is the wall-clock time since start().
+         */
+        virtual void iterationDone(int /* iteration */, double /* energy */, double /* maxDisplacement */, double /* elapsedSeconds */) { }
+
+    private:
+        double m_tolerance;       //!< The tolerance for the maximal displacement.
+        int m_numberOfIterations; //!< The number of reported iterations.
+        StopReason m_stopReason;  //!< The reason for the last request to stop.
+        StopwatchWallClock m_clock; //!< Measures the time since start().
+    };
+
+} // end namespace ogdf
+
+#endif
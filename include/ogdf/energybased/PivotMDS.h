@@ -78,7 +78,8 @@ namespace ogdf
     class OGDF_EXPORT PivotMDS : public LayoutModule
     {
     public:
-        PivotMDS() : m_numberOfPivots(250), m_edgeCosts(100), m_hasEdgeCostsAttribute(false) { }
+        PivotMDS() : m_numberOfPivots(250), m_edgeCosts(100), m_hasEdgeCostsAttribute(false),
+            m_numberOfThreads(1) { }
 
         virtual ~PivotMDS() { }
 
@@ -104,6 +105,24 @@ namespace ogdf
             m_hasEdgeCostsAttribute = useEdgeCostsAttribute;
         }
 
+        //! Sets the number of threads used for the pivot distances and the matrix computations.
+        /**
+         * The breadth first searches from the pivots are only parallelized
+         * for uniform edge costs; the layout does not depend on the number
+         * of threads.
+         */
+        void setNumberOfThreads(int numberOfThreads)
+        {
+            if(numberOfThreads > 0)
+                m_numberOfThreads = numberOfThreads;
+        }
+
+        //! Returns the number of threads.
+        int numberOfThreads() const
+        {
+            return m_numberOfThreads;
+        }
+
     private:
 
         //! The dimension count determines the number of evecs that
@@ -130,26 +149,28 @@ namespace ogdf
         //! edge costs attribute
         bool m_hasEdgeCostsAttribute;
 
-        //! Centers the pivot matrix.
-        void centerPivotmatrix(Array<Array<double>> & pivotMatrix);
+        //! The number of threads.
+        int m_numberOfThreads;
 
         //! Computes the pivot mds layout of the given connected graph of \a GA.
         void pivotMDSLayout(GraphAttributes & GA);
 
-        void copySPSS(Array<double> & copyTo, NodeArray<double> & copyFrom);
-
         //! Computes the layout of a path.
         void doPathLayout(GraphAttributes & GA, const node & v);
 
         //! Computes the eigen value decomposition based on power iteration.
+        /**
+         * @param K is the symmetric p x p matrix in row-major order.
+         * @param p is the number of rows of \a K.
+         * @param eVecs is assigned the eigen vectors.
+         * @param eValues is assigned the eigen values.
+         */
         void eigenValueDecomposition(
-            Array<Array<double>> & K,
+            const Array<double> & K,
+            int p,
             Array<Array<double>> & eVecs,
             Array<double> & eValues);
 
-        //! Computes the pivot distance matrix based on the maxmin strategy
-        void getPivotDistanceMatrix(const GraphAttributes & GA, Array<Array<double>> & pivDistMatrix);
-
         //! Checks whether the given graph is a path or not. Only works if no size 2 cycles exist
         node getRootedPath(const Graph & G);
 
@@ -161,15 +182,6 @@ namespace ogdf
 
         //! Fills the given \a matrix with random doubles d 0 <= d <= 1.
         void randomize(Array<Array<double>> & matrix);
-
-        //! Computes the self product of \a d.
-        void selfProduct(const Array<Array<double>> & d, Array<Array<double>> & result);
-
-        //! Computes the singular value decomposition of matrix \a K.
-        void singularValueDecomposition(
-            Array<Array<double>> & K,
-            Array<Array<double>> & eVecs,
-            Array<double> & eVals);
     };
 
 
@@ -51,16 +51,13 @@
 
 
 #include <ogdf/module/LayoutModule.h>
-#include <ogdf/basic/Array2D.h>
+#include <ogdf/basic/ThreadTeam.h>
 
 
 namespace ogdf
 {
 
 
-    class OGDF_EXPORT GraphCopyAttributes;
-    class OGDF_EXPORT GraphCopy;
-
 
     //! The spring-embedder layout algorithm by Fruchterman and Reingold.
     /**
@@ -97,6 +94,9 @@ namespace ogdf
      *   </tr><tr>
      *     <td><i>userBoundingBox</i><td>rectangle<td>(0.0,100.0,0.0,100.0)
      *     <td>The user bounding box for scaling (used if scaling = scUserBoundingBox).
+     *   </tr><tr>
+     *     <td><i>maxThreads</i><td>int<td>number of processors
+     *     <td>The maximal number of threads used for computing repulsive forces.
      *   </tr>
      * </table>
      */
@@ -215,39 +215,79 @@ namespace ogdf
             m_bbYmax = ymax;
         }
 
+        //! Returns the maximal number of threads used for computing repulsive forces.
+        int maxThreads() const
+        {
+            return m_maxThreads;
+        }
+
+        //! Sets the maximal number of threads used for computing repulsive forces to \a n.
+        /**
+         * Additional threads are only used for large connected components.
+         */
+        void maxThreads(int n)
+        {
+            m_maxThreads = max(n, 1);
+        }
+
     private:
-        bool initialize(GraphCopy & G, GraphCopyAttributes & AG);
 
-        void mainStep(GraphCopy & G, GraphCopyAttributes & AG);
+        bool initialize(const List<node> & nodes, const GraphAttributes & AG);
+
+        void mainStep(ThreadTeam<SpringEmbedderFR> & team);
+
+        void buildCellList();
+        void repulsiveForces(int firstCell, int lastCell);
+        void repulsiveKernel(int t);
+
         void cleanup()
         {
-            delete m_A;
-            m_A = 0;
+            m_x.init();
+            m_y.init();
+            m_xdisp.init();
+            m_ydisp.init();
+            m_source.init();
+            m_target.init();
+            m_edgeFactor.init();
+            m_cellOf.init();
+            m_cellStart.init();
+            m_cellNode.init();
+            m_cellX.init();
+            m_cellY.init();
+            m_firstCell.init();
         }
 
-        NodeArray<ListIterator<node>> m_lit;
+        // current connected component (nodes are numbered 0,...,n-1)
+        Array<double> m_x;        //!< x-coordinates of the nodes
+        Array<double> m_y;        //!< y-coordinates of the nodes
+        Array<double> m_xdisp;    //!< x-displacement of the nodes
+        Array<double> m_ydisp;    //!< y-displacement of the nodes
+        Array<int>    m_source;   //!< source node of each edge
+        Array<int>    m_target;   //!< target node of each edge
+        Array<double> m_edgeFactor; //!< degree factor of each edge
+
+        // grid of cells with side length m_ki; built by counting sort in each step
+        Array<int>    m_cellOf;    //!< cell of each node
+        Array<int>    m_cellStart; //!< first position of each cell in the sorted arrays
+        Array<int>    m_cellNode;  //!< nodes sorted by cell
+        Array<double> m_cellX;     //!< x-coordinates of the nodes sorted by cell
+        Array<double> m_cellY;     //!< y-coordinates of the nodes sorted by cell
+        Array<int>    m_firstCell; //!< first cell of each thread (and the end of the last range)
 
         int m_cF;
-
         double m_width;
         double m_height;
-
         double m_txNull;
         double m_tyNull;
         double m_tx;
         double m_ty;
-
         double m_k;
         double m_k2;
         double m_kk;
         int m_ki;
-
         int m_xA;
         int m_yA;
 
-        Array2D<List<node>>* m_A;
-
-
         double mylog2(int x)
         {
             double l = 0.0;
@@ -279,6 +319,7 @@ namespace ogdf
 
         double m_minDistCC; //!< The minimal distance between connected components.
         double m_pageRatio; //!< The page ratio.
+        int m_maxThreads;   //!< The maximal number of threads.
     };
 
 
@@ -50,7 +50,10 @@
 
 
 #include <ogdf/module/ForceLayoutModule.h>
+#include <ogdf/energybased/WarmStart.h>
+#include <ogdf/energybased/IterationMonitor.h>
 #include <ogdf/basic/SList.h>
+#include <ogdf/basic/ThreadTeam.h>
 
 
 namespace ogdf
@@ -76,6 +79,19 @@ namespace ogdf
         //! Calls the layout algorithm for graph attributes \a GA.
         void call(GraphAttributes & GA);
 
+        //! Calls the layout algorithm incrementally for graph attributes \a GA.
+        /**
+         * The current positions in \a GA are used as initial layout, which is
+         * neither rescaled nor repacked; \a ws must have been initialized for
+         * \a GA. The start temperature of a connected component is a quarter of
+         * the extent of its affected region (at least sqrt(n_A) ideal edge lengths
+         * for n_A affected nodes; components without affected nodes are not
+         * changed), and ws.iterations(iterations()) iterations are performed. A
+         * node outside the affected region moves at most ws.frozenMobility() ideal
+         * edge lengths away from its initial position.
+         */
+        void callIncremental(GraphAttributes & GA, const WarmStart & ws);
+
 
         //! Returns the current setting of iterations.
         int iterations() const
@@ -168,10 +184,57 @@ namespace ogdf
             m_convTolerance = tol;
         }
 
+        //! Returns the maximal number of threads used for computing repulsive forces.
+        int numberOfThreads() const
+        {
+            return m_numberOfThreads;
+        }
+
+        //! Sets the maximal number of threads used for computing repulsive forces to \a n.
+        void numberOfThreads(int n)
+        {
+            OGDF_ASSERT(n > 0)
+            m_numberOfThreads = n;
+        }
+
+        //! Returns whether repulsive forces are computed in single precision.
+        bool singlePrecision() const
+        {
+            return m_singlePrecision;
+        }
+
+        //! Sets whether repulsive forces are computed in single precision.
+        /**
+         * Single precision doubles the number of node pairs processed by one
+         * AVX2/AVX-512 instruction, but the resulting layouts are less exact.
+         */
+        void singlePrecision(bool on)
+        {
+            m_singlePrecision = on;
+        }
+
+        //! Returns the monitor observing the iterations (or 0).
+        IterationMonitor* iterationMonitor() const
+        {
+            return m_pMonitor;
+        }
+
+        //! Sets the monitor observing the iterations to \a pMonitor (0 = none).
+        /**
+         * The monitor is not deleted by the algorithm. The displacements are
+         * reported in units of the ideal edge length; the iterations of all
+         * connected components are reported consecutively.
+         */
+        void setIterationMonitor(IterationMonitor* pMonitor)
+        {
+            m_pMonitor = pMonitor;
+        }
+
     private:
         class ArrayGraph
         {
             int m_numNodes;
+            int m_numPaddedNodes;
             int m_numEdges;
             int m_numCC;
 
@@ -208,11 +271,22 @@ namespace ogdf
                 return m_nodesInCC[i];
             }
 
+            //! Returns the size of the node arrays (the number of nodes rounded up to a multiple of 16).
+            int numberOfPaddedNodes() const
+            {
+                return m_numPaddedNodes;
+            }
+
             int* m_src;
             int* m_tgt;
-            double* m_x;
-            double* m_y;
-            double* m_nodeWeight;
+            double* m_x; //!< x-coordinates (padded with 0)
+            double* m_y; //!< y-coordinates (padded with 0)
+            double* m_nodeWeight; //!< node weights (padded with 0)
+            float* m_xf; //!< x-coordinates in single precision (padded with 0)
+            float* m_yf; //!< y-coordinates in single precision (padded with 0)
+            float* m_nodeWeightf; //!< node weights in single precision (padded with 0)
+            double* m_mobility; //!< scaling factors of the displacements (0 if not incremental)
+            const WarmStart* m_warmStart; //!< the warm start of an incremental call (or 0)
             //this should be part of a multilevel layout interface class later on
             bool m_useNodeWeight; //should given nodeweights be used or all set to 1.0?
         };
@@ -232,10 +306,22 @@ namespace ogdf
             return l / 2;
         }
 
+        //! Returns the number of threads for the repulsive forces on \a n nodes.
+        int repulsionThreads(int n) const
+        {
+            // a thread should process at least about 2^16 node pairs
+            return (int)min((__int64)m_numberOfThreads, 1 + (__int64)n * n / 65536);
+        }
+
         void initialize(ArrayGraph & component);
-        void mainStep(ArrayGraph & component);
+        void initializeIncremental(ArrayGraph & component);
+        void mainStep(ArrayGraph & component, KernelTeam & team);
         void mainStep_sse3(ArrayGraph & component);
 
+        //! Computes the repulsive forces (scaled by \a c_rep) on all nodes of \a C with the threads of \a team.
+        void computeRepulsiveForces(ArrayGraph & C, double minDistSquare, double c_rep,
+                                    double* disp_x, double* disp_y, KernelTeam & team);
+
         // Fruchterman, Reingold
         //double f_att(double d) { return d*d / m_idealEdgeLength; }
         //double f_rep(double d) { return m_idealEdgeLength*m_idealEdgeLength / d; }
@@ -269,6 +355,10 @@ namespace ogdf
         bool m_useNodeWeight;
         bool m_checkConvergence; //<! If set to true, computation is stopped if movement falls below threshold
         double m_convTolerance; //<! Fraction of ideal edge length below which convergence is achieved
+        int m_numberOfThreads;   //!< The maximal number of threads.
+        bool m_singlePrecision;  //!< Compute repulsive forces in single precision?
+        const WarmStart* m_warmStart; //!< The warm start of an incremental call (or 0).
+        IterationMonitor* m_pMonitor; //!< The monitor observing the iterations (or 0).
     };
 
 
@@ -52,6 +52,7 @@
 #include <ogdf/module/LayoutModule.h>
 #include <ogdf/basic/Array2D.h>
 #include <ogdf/basic/tuples.h>
+#include <ogdf/graphalg/ShortestPathAlgorithms.h>
 
 
 namespace ogdf
@@ -111,7 +112,7 @@ namespace ogdf
         //! Constructor: Constructs instance of Kamada Kawai Layout
         SpringEmbedderKK() : m_tolerance(0.001), m_ltolerance(0.0001), m_computeMaxIt(true),
             m_K(5.0), m_desLength(0.0), m_distFactor(2.0), m_useLayout(true),
-            m_gItBaseVal(50), m_gItFactor(16)
+            m_gItBaseVal(50), m_gItFactor(16), m_numberOfThreads(1)
         {
             m_maxLocalIt = m_maxGlobalIt = maxVal;
         }
@@ -202,6 +203,22 @@ namespace ogdf
         {
             m_computeMaxIt = b;
         }
+        //! Sets the number of threads used for the all pairs shortest paths and the
+        //! updates of the partial derivatives to \a n.
+        /**
+         * The derivatives are only updated in parallel on graphs with at least 512 nodes
+         * per thread, since they are updated after every move of a single node.
+         */
+        void setNumberOfThreads(int n)
+        {
+            if(n > 0)
+                m_numberOfThreads = n;
+        }
+        //! Returns the number of threads.
+        int numberOfThreads() const
+        {
+            return m_numberOfThreads;
+        }
         //We could add some noise to the computation
         // Returns the current setting of nodes.
         //bool noise() const {
@@ -265,31 +282,19 @@ namespace ogdf
                           EdgeArray<double> & adaptedLengths);
         //! Adapts positions to avoid degeneracy (all nodes on a single point)
         void shufflePositions(GraphAttributes & GA);
-        //! Computes contribution of node u to the first partial
-        //! derivatives (dE/dx_m, dE/dy_m) (for node m) (eq. 7 and 8 in paper)
-        dpair computeParDer(node m,
-                            node u,
-                            GraphAttributes & GA,
-                            NodeArray<NodeArray<double>> & ss,
-                            NodeArray<NodeArray<double>> & dist);
-        //! Compute partial derivative for v
-        dpair computeParDers(node v,
-                             GraphAttributes & GA,
-                             NodeArray<NodeArray<double>> & ss,
-                             NodeArray<NodeArray<double>> & dist);
         //! Does the necessary initialization work for the call functions
         void initialize(GraphAttributes & GA,
                         NodeArray<dpair> & partialDer,
                         const EdgeArray<double> & eLength,
-                        NodeArray<NodeArray<double>> & oLength,
-                        NodeArray<NodeArray<double>> & sstrength,
+                        DistanceMatrix<double> & oLength,
+                        DistanceMatrix<double> & sstrength,
                         double & maxDist,
                         bool simpleBFS);
         //! Main computation loop, nodes are moved here
         void mainStep(GraphAttributes & GA,
                       NodeArray<dpair> & partialDer,
-                      NodeArray<NodeArray<double>> & oLength,
-                      NodeArray<NodeArray<double>> & sstrength,
+                      const DistanceMatrix<double> & oLength,
+                      const DistanceMatrix<double> & sstrength,
                       const double maxDist);
         //! Does the scaling if no edge lengths are given but node sizes
         //! are respected
@@ -316,6 +321,7 @@ namespace ogdf
         //!< avoid degeneration
         int m_gItBaseVal; //!< minimum number of global iterations
         int m_gItFactor;  //!< factor for global iterations: m_gItBaseVal+m_gItFactor*|V|
+        int m_numberOfThreads; //!< number of threads
 
         static const double startVal;
         static const double minVal;
@@ -323,9 +329,8 @@ namespace ogdf
         //! Smaller values are treated as zero
         static const int maxVal; //! defines infinite upper bound for iteration number
 
-        double allpairsspBFS(const Graph & G, NodeArray<NodeArray<double>> & distance);
-        double allpairssp(const Graph & G, const EdgeArray<double> & eLengths,
-                          NodeArray<NodeArray<double>> & distance,   const double threshold = numeric_limits<double>::max());
+        //! Returns the maximum finite entry of \a distance.
+        static double maxDistance(const DistanceMatrix<double> & distance);
     };//SpringEmbedderKK
 
     //Things that potentially could be added
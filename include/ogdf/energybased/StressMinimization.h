@@ -50,6 +50,8 @@
 
 #include <ogdf/module/LayoutModule.h>
 #include <ogdf/energybased/PivotMDS.h>
+#include <ogdf/energybased/WarmStart.h>
+#include <ogdf/energybased/IterationMonitor.h>
 #include <ogdf/basic/simple_graph_alg.h>
 #include <ogdf/graphalg/ShortestPathAlgorithms.h>
 #include <ogdf/packing/ComponentSplitterLayout.h>
@@ -74,7 +76,9 @@ namespace ogdf
             m_hasEdgeCostsAttribute(false), m_hasInitialLayout(false), m_numberOfIterations(
                 200), m_edgeCosts(100), m_avgEdgeCosts(-1), m_componentLayout(
                     false), m_terminationCriterion(NONE), m_fixXCoords(false), m_fixYCoords(
-                        false), m_fixZCoords(false)
+                        false), m_fixZCoords(false), m_sparseStress(false), m_numberOfSparsePivots(
+                            DEFAULT_NUMBER_OF_SPARSE_PIVOTS), m_sparseNeighborhood(1), m_numberOfThreads(1), m_warmStart(0),
+            m_pMonitor(0)
         {
         }
 
@@ -91,6 +95,15 @@ namespace ogdf
             call(GA);
         }
 
+        //! Calls the layout algorithm incrementally.
+        /**
+         * The current positions in \a GA are used as initial layout; \a ws must
+         * have been initialized for \a GA. The move of a node towards its new
+         * position is scaled by its mobility, and ws.iterations() of the
+         * iterations set by setIterations() are performed at most.
+         */
+        void callIncremental(GraphAttributes & GA, const WarmStart & ws);
+
         //! Tells whether the current layout should be used or the initial layout
         //! needs to be computed.
         inline void hasInitialLayout(bool hasInitialLayout);
@@ -122,6 +135,46 @@ namespace ogdf
         //! Tells whether the edge costs are uniform or defined by some edge costs attribute.
         inline void useEdgeCostsAttribute(bool useEdgeCostsAttribute);
 
+        //! Tells whether the sparse stress model is used instead of the full stress.
+        /**
+         * The sparse stress model keeps the exact terms only for pairs of nodes
+         * within a small number of hops (see setSparseNeighborhood()). The
+         * remaining terms of a node are approximated by terms with a set of
+         * pivots chosen by max-min distance; the term of pivot p is weighted by
+         * the number of nodes closest to p that lie on the near side of p.
+         * Memory and time per iteration are O(n * (#pivots + neighborhood size))
+         * instead of O(n^2); the positions are updated simultaneously (Jacobi
+         * style), which allows several threads (see setNumberOfThreads()).
+         */
+        inline void useSparseStress(bool sparse);
+
+        //! Sets the number of pivots of the sparse stress model. If the new value is smaller or equal
+        //! 0 the default value (100) is used. At most n pivots are used, and on huge graphs the
+        //! number is reduced so that the n * #pivots terms fit into an Array.
+        inline void setNumberOfSparsePivots(int numberOfPivots);
+
+        //! Sets the number of hops up to which the sparse stress model uses exact terms
+        //! (at least 1, i.e. the edges).
+        inline void setSparseNeighborhood(int hops);
+
+        //! Sets the number of threads used for the shortest paths and by the sparse stress model.
+        inline void setNumberOfThreads(int numberOfThreads);
+
+        //! Sets the monitor observing the iterations to \a pMonitor (0 = none).
+        /**
+         * The monitor is not deleted by the algorithm. The reported energy is the
+         * stress accumulated while the positions are updated, the displacements are
+         * given in units of the (average) edge costs. At least one iteration is
+         * performed.
+         */
+        inline void setIterationMonitor(IterationMonitor* pMonitor);
+
+        //! Returns the monitor observing the iterations (or 0).
+        IterationMonitor* iterationMonitor() const
+        {
+            return m_pMonitor;
+        }
+
     private:
 
         //! Convergence constant.
@@ -130,6 +183,9 @@ namespace ogdf
         //! Default number of pivots used for the initial Pivot-MDS layout
         const static int DEFAULT_NUMBER_OF_PIVOTS;
 
+        //! Default number of pivots used by the sparse stress model
+        const static int DEFAULT_NUMBER_OF_SPARSE_PIVOTS;
+
         //! Tells whether the stress minimization is based on uniform edge costs or a
         //! edge costs attribute
         bool m_hasEdgeCostsAttribute;
@@ -162,21 +218,34 @@ namespace ogdf
         //! Indicates whether the z coordinates will be modified or not.
         bool m_fixZCoords;
 
-        //! Calculates the stress for the given layout
+        //! Indicates whether the sparse stress model is used.
+        bool m_sparseStress;
+
+        //! Number of pivots of the sparse stress model.
+        int m_numberOfSparsePivots;
+
+        //! Number of hops with exact terms in the sparse stress model.
+        int m_sparseNeighborhood;
+
+        //! Number of threads used for the shortest paths and by the sparse stress model.
+        int m_numberOfThreads;
+
+        //! The warm start of an incremental call (or 0).
+        const WarmStart* m_warmStart;
+
+        //! The monitor observing the iterations (or 0).
+        IterationMonitor* m_pMonitor;
+
+        //! Runs the sparse stress model.
+        void callSparse(GraphAttributes & GA);
+
+        //! Calculates the stress for the given layout. The weights are w_ij = s_ij^{-2}.
         double calcStress(const GraphAttributes & GA,
-                          NodeArray<NodeArray<double>> & shortestPathMatrix,
-                          NodeArray<NodeArray<double>> & weightMatrix);
+                          const DistanceMatrix<double> & shortestPathMatrix);
 
-        //! Runs the stress for a given Graph, shortest path and weight matrix.
+        //! Runs the stress for a given Graph and shortest path matrix.
         void call(GraphAttributes & GA,
-                  NodeArray<NodeArray<double>> & shortestPathMatrix,
-                  NodeArray<NodeArray<double>> & weightMatrix);
-
-        //! Calculates the weight matrix of the shortest path matrix. This is done by w_ij = s_ij^{-2}
-        void calcWeights(const Graph & G,
-                         const int dimension,
-                         NodeArray<NodeArray<double>> & shortestPathMatrix,
-                         NodeArray<NodeArray<double>> & weightMatrix);
+                  DistanceMatrix<double> & shortestPathMatrix);
 
         //! Calculates the intial layout of the graph if necessary.
         void computeInitialLayout(GraphAttributes & GA);
@@ -195,26 +264,20 @@ namespace ogdf
                       NodeArray<double> & prevXCoords, NodeArray<double> & prevYCoords,
                       const double prevStress, const double curStress);
 
-        //! Convenience method to initialize the matrices.
-        void initMatrices(const Graph & G,
-                          NodeArray<NodeArray<double>> & shortestPathMatrix,
-                          NodeArray<NodeArray<double>> & weightMatrix);
-
         //! Minimizes the stress for each component separately given
-        //! the shortest path matrix and the weight matrix.
+        //! the shortest path matrix.
         void minimizeStress(GraphAttributes & GA,
-                            NodeArray<NodeArray<double>> & shortestPathMatrix,
-                            NodeArray<NodeArray<double>> & weightMatrix);
+                            const DistanceMatrix<double> & shortestPathMatrix);
 
         //! Runs the next iteration of the stress minimization process. Note that serial update
-        //! is used.
-        void nextIteration(GraphAttributes & GA,
-                           NodeArray<NodeArray<double>> & shortestPathMatrix,
-                           NodeArray<NodeArray<double>> & weightMatrix);
+        //! is used. Returns the stress accumulated during the update and the maximum squared
+        //! move of a node in \a maxMoveSq.
+        double nextIteration(GraphAttributes & GA,
+                             const DistanceMatrix<double> & shortestPathMatrix,
+                             double & maxMoveSq);
 
         //! Replaces infinite distances to the given value
-        void replaceInfinityDistances(const int dimension,
-                                      NodeArray<NodeArray<double>> & shortestPathMatrix, double newVal);
+        void replaceInfinityDistances(DistanceMatrix<double> & shortestPathMatrix, double newVal);
 
     }
     ;
@@ -254,10 +317,35 @@ namespace ogdf
         m_terminationCriterion = criterion;
     }
 
+    void StressMinimization::setIterationMonitor(IterationMonitor* pMonitor)
+    {
+        m_pMonitor = pMonitor;
+    }
+
     void StressMinimization::useEdgeCostsAttribute(bool useEdgeCostsAttribute)
     {
         m_hasEdgeCostsAttribute = useEdgeCostsAttribute;
     }
 
+    void StressMinimization::useSparseStress(bool sparse)
+    {
+        m_sparseStress = sparse;
+    }
+
+    void StressMinimization::setNumberOfSparsePivots(int numberOfPivots)
+    {
+        m_numberOfSparsePivots = (numberOfPivots > 0) ? numberOfPivots : DEFAULT_NUMBER_OF_SPARSE_PIVOTS;
+    }
+
+    void StressMinimization::setSparseNeighborhood(int hops)
+    {
+        m_sparseNeighborhood = max(1, hops);
+    }
+
+    void StressMinimization::setNumberOfThreads(int numberOfThreads)
+    {
+        m_numberOfThreads = max(1, numberOfThreads);
+    }
+
 } // end namespace
 #endif // OGDF_STRESS_MINIMIZATION_H
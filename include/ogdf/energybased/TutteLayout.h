@@ -71,26 +71,33 @@
 namespace ogdf
 {
 
+    //! Tutte's barycentric layout algorithm.
+    /**
+     * The nodes of a largest face (or a given set of nodes) are placed on a
+     * circle and all other nodes are placed in the barycenter of their
+     * neighbors. The resulting system of linear equations is solved by a
+     * Jacobi-preconditioned conjugate gradient method on a sparse matrix
+     * (default), or by an LP solver provided by COIN.
+     *
+     * The conjugate gradient method solves the systems for the x- and
+     * y-coordinates together. For large graphs, it can use several threads
+     * (see maxThreads()). If it does not converge within the admissible
+     * number of iterations and COIN is available, the LP solver is used as
+     * fallback; otherwise, the coordinates in the GraphAttributes are left
+     * unchanged.
+     */
     class OGDF_EXPORT TutteLayout : public LayoutModule
     {
-#ifndef USE_COIN
     public:
-
-        void call(GraphAttributes & AG)
-        {
-            THROW_NO_COIN_EXCEPTION;
-        }
-        void call(GraphAttributes & AG, const List<node> & givenNodes)
+        //! The solvers for the system of linear equations.
+        enum SolverType
         {
-            THROW_NO_COIN_EXCEPTION;
-        }
-
-    };
-
-#else // USE_COIN
-    public:
+            stConjugateGradient, //!< Jacobi-preconditioned conjugate gradient on a sparse matrix.
+            stLP                 //!< LP solver provided by COIN (requires COIN).
+        };
 
         TutteLayout();
+
         ~TutteLayout() { }
 
         DRect bbox() const
@@ -103,20 +110,94 @@ namespace ogdf
             m_bbox = bb;
         }
 
+        //! Returns the solver used for the system of linear equations.
+        SolverType solver() const
+        {
+            return m_solver;
+        }
+
+        //! Sets the solver used for the system of linear equations to \a st.
+        void solver(SolverType st)
+        {
+            m_solver = st;
+        }
+
+        //! Returns the relative residual at which the conjugate gradient method stops.
+        double tolerance() const
+        {
+            return m_tolerance;
+        }
+
+        //! Sets the relative residual at which the conjugate gradient method stops to \a tol.
+        void tolerance(double tol)
+        {
+            m_tolerance = tol;
+        }
+
+        //! Returns the maximal number of conjugate gradient iterations (0 = automatic).
+        int maxIterations() const
+        {
+            return m_maxIterations;
+        }
+
+        //! Sets the maximal number of conjugate gradient iterations to \a n (0 = automatic).
+        /**
+         * In automatic mode, 2<I>n</I>+100 iterations are admissible, where
+         * <I>n</I> is the number of nodes with variable position.
+         */
+        void maxIterations(int n)
+        {
+            m_maxIterations = max(n, 0);
+        }
+
+        //! Returns the maximal number of threads used by the conjugate gradient method.
+        int maxThreads() const
+        {
+            return m_maxThreads;
+        }
+
+        //! Sets the maximal number of threads used by the conjugate gradient method to \a n.
+        /**
+         * Additional threads are only used for systems with many variables.
+         */
+        void maxThreads(int n)
+        {
+            m_maxThreads = max(n, 1);
+        }
+
         void call(GraphAttributes & AG);
+
         void call(GraphAttributes & AG, const List<node> & givenNodes);
+
         void call(GraphAttributes & GA, GraphConstraints & GC)
         {
             call(GA);
         }
 
     private:
-
+#ifdef USE_COIN
         static bool solveLP(
             int cols,
             const CoinPackedMatrix & Matrix,
             const Array<double> & rightHandSide,
             Array<double> & x);
+#endif
+
+        //! Solves the Laplacian system for the coordinates of the free nodes.
+        /**
+         * @param rowStart is the start index of the neighbors of each row in \a column (size <I>n</I>+1).
+         * @param column contains the free neighbors of all rows.
+         * @param diag contains the diagonal entries.
+         * @param rhs contains the right hand sides (x and y interleaved, size 2<I>n</I>).
+         * @param coord receives the coordinates (x and y interleaved, size 2<I>n</I>).
+         * @return true if the relative residual is below tolerance().
+         */
+        bool solveCG(
+            const Array<int> & rowStart,
+            const Array<int> & column,
+            const Array<double> & diag,
+            const Array<double> & rhs,
+            Array<double> & coord) const;
 
         void setFixedNodes(const Graph & G, List<node> & nodes,
                            List<DPoint> & pos, double radius = 1.0);
@@ -136,9 +217,12 @@ namespace ogdf
                     List<DPoint> & fixedPositions);
 
         DRect m_bbox;
-    };
 
-#endif // USE_COIN
+        SolverType m_solver;   //!< the solver for the system of linear equations
+        double m_tolerance;    //!< relative residual at which the conjugate gradient method stops
+        int m_maxIterations;   //!< maximal number of conjugate gradient iterations (0 = automatic)
+        int m_maxThreads;      //!< maximal number of threads used by the conjugate gradient method
+    };
 
 } // end namespace ogdf
 
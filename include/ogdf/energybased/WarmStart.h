@@ -0,0 +1,194 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of class WarmStart, which prepares incremental
+ *        runs of force-directed layouts of evolving graphs.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_WARM_START_H
+#define OGDF_WARM_START_H
+
+#include <ogdf/basic/GraphAttributes.h>
+
+
+namespace ogdf
+{
+
+    //! Prepares an incremental run of a force-directed layout after a small change of the graph.
+    /**
+     * The layout of the previous version of the graph is given by the positions
+     * in a GraphAttributes object; nodes that have been added since are marked
+     * as new. init() places every new node at the barycenter of its already
+     * placed neighbors (new nodes without such neighbors are placed to the
+     * right of the drawing) and determines the <i>affected region</i>, i.e.,
+     * all nodes within regionRadius() hops of a new or changed node.
+     *
+     * The incremental calls of FMMMLayout, SpringEmbedderFRExact,
+     * FastMultipoleEmbedder and StressMinimization (callIncremental()) start
+     * from these positions instead of a random or multilevel initial layout,
+     * let the affected region move freely while the displacement of all other
+     * nodes is scaled down by frozenMobility(), and perform only
+     * iterationFraction() of their usual number of iterations.
+     *
+     * <H3>Optional parameters</H3>
+     * <table>
+     *   <tr>
+     *     <th><i>Option</i><th><i>Type</i><th><i>Default</i><th><i>Description</i>
+     *   </tr><tr>
+     *     <td><i>regionRadius</i><td>int<td>2
+     *     <td>The number of hops around new or changed nodes that belong to the affected region.
+     *   </tr><tr>
+     *     <td><i>frozenMobility</i><td>double<td>0.1
+     *     <td>The factor by which the displacement of nodes outside the affected region is scaled.
+     *   </tr><tr>
+     *     <td><i>iterationFraction</i><td>double<td>0.2
+     *     <td>The fraction of the usual number of iterations performed by an incremental call.
+     *   </tr>
+     * </table>
+     */
+    class OGDF_EXPORT WarmStart
+    {
+    public:
+        //! Creates a warm start with default options.
+        WarmStart();
+
+        ~WarmStart() { }
+
+        //! Places the new nodes of \a GA and computes the affected region.
+        /**
+         * @param GA contains the previous positions of all nodes that are not new;
+         *        the positions of the new nodes are assigned.
+         * @param newNode marks the nodes that have been added to the graph.
+         */
+        void init(GraphAttributes & GA, const NodeArray<bool> & newNode);
+
+        //! Places the new nodes of \a GA and computes the affected region.
+        /**
+         * Like init(GA, newNode), but additionally the nodes marked in \a changed
+         * (e.g., the end nodes of inserted or deleted edges) belong to the centers
+         * of the affected region.
+         */
+        void init(GraphAttributes & GA, const NodeArray<bool> & newNode, const NodeArray<bool> & changed);
+
+        //! Returns the graph for which init() has been called last (or 0).
+        const Graph* graphOf() const
+        {
+            return m_affected.graphOf();
+        }
+
+        //! Returns true if \a v lies in the affected region.
+        bool isAffected(node v) const
+        {
+            return m_affected[v];
+        }
+
+        //! Returns the factor by which the displacement of \a v is scaled.
+        double mobility(node v) const
+        {
+            return m_affected[v] ? 1.0 : m_frozenMobility;
+        }
+
+        //! Returns the number of nodes in the affected region.
+        int numberOfAffectedNodes() const
+        {
+            return m_numberOfAffectedNodes;
+        }
+
+        //! Returns the number of iterations of an incremental run replacing \a fullIterations iterations.
+        int iterations(int fullIterations) const;
+
+        //! Returns the current setting of option regionRadius.
+        int regionRadius() const
+        {
+            return m_regionRadius;
+        }
+
+        //! Sets the option regionRadius to \a hops (at least 0).
+        void regionRadius(int hops)
+        {
+            m_regionRadius = max(0, hops);
+        }
+
+        //! Returns the current setting of option frozenMobility.
+        double frozenMobility() const
+        {
+            return m_frozenMobility;
+        }
+
+        //! Sets the option frozenMobility to \a f (0 <= \a f <= 1).
+        void frozenMobility(double f)
+        {
+            OGDF_ASSERT(f >= 0 && f <= 1)
+            m_frozenMobility = f;
+        }
+
+        //! Returns the current setting of option iterationFraction.
+        double iterationFraction() const
+        {
+            return m_iterationFraction;
+        }
+
+        //! Sets the option iterationFraction to \a f (0 < \a f <= 1).
+        void iterationFraction(double f)
+        {
+            OGDF_ASSERT(f > 0 && f <= 1)
+            m_iterationFraction = f;
+        }
+
+    private:
+        //! Assigns positions to the nodes marked in \a newNode.
+        void placeNewNodes(GraphAttributes & GA, const NodeArray<bool> & newNode);
+
+        //! Marks all nodes within regionRadius() hops of a new or changed node.
+        void markAffectedRegion(const Graph & G, const NodeArray<bool> & newNode, const NodeArray<bool>* pChanged);
+
+        int    m_regionRadius;      //!< The radius of the affected region (in hops).
+        double m_frozenMobility;    //!< The mobility of nodes outside the affected region.
+        double m_iterationFraction; //!< The fraction of iterations of an incremental run.
+
+        NodeArray<bool> m_affected; //!< Marks the affected region.
+        int m_numberOfAffectedNodes;
+    };
+
+} // end namespace ogdf
+
+#endif
@@ -48,6 +48,7 @@
 #define OGDF_MODULAR_MULTILEVEL_MIXER_H
 
 #include <ogdf/basic/ModuleOption.h>
+#include <ogdf/basic/Timeouter.h>
 #include <ogdf/module/LayoutModule.h>
 #include <ogdf/internal/energybased/MultilevelGraph.h>
 #include <ogdf/energybased/multilevelmixer/MultilevelBuilder.h>
@@ -85,8 +86,24 @@ namespace ogdf
      *     <td>The layout module applied to the final drawing for additional beautification.
      *   </tr>
      * </table>
+     *
+     * <H3>Time limit</H3>
+     * If a time limit is set (see Timeouter::timeLimit()), the algorithm runs in
+     * anytime mode and tries to return within the given wall-clock time. The
+     * hierarchy is built as usual. Before the layout of a level, the
+     * remaining time is divided among this level and all finer levels, in
+     * proportion to their (estimated) numbers of nodes. The number of calls of
+     * the one-level layout on this level (at most the layout repeats) is then
+     * chosen from the measured time per node of the previous calls; the time
+     * per node of the final layout module is measured separately. A level gets
+     * at least one call if a single call fits into the remaining time, and the
+     * finest level gets as many calls as fit into the time left. Levels without
+     * a call are only placed, i.e., once the time limit is exceeded, the
+     * current layout is interpolated to the finest level by the initial placer
+     * without further layout calls. If a level has been skipped, errorCode()
+     * returns ercTimeLimit.
      */
-    class OGDF_EXPORT ModularMultilevelMixer : public LayoutModule
+    class OGDF_EXPORT ModularMultilevelMixer : public LayoutModule, public Timeouter
     {
     private:
 
@@ -132,7 +149,8 @@ namespace ogdf
         enum erc
         {
             ercNone,       //!< no error
-            ercLevelBound  //!< level bound exceeded by merger step
+            ercLevelBound, //!< level bound exceeded by merger step
+            ercTimeLimit   //!< time limit exceeded, at least one level has only been placed
         };
 
         ModularMultilevelMixer();
@@ -230,6 +248,20 @@ namespace ogdf
         }
 
     private:
+        //! Returns the number of calls of the one-level layout on the current level within the time limit.
+        /**
+         * @param n is the number of nodes of the current level.
+         * @param level is the number of the current level.
+         * @param finestNodes is the number of nodes of the finest level.
+         * @param remaining is the remaining time in seconds.
+         * @param levelSecondsPerNode is the measured time per node of the one-level
+         *        layout (negative if not measured yet).
+         * @param finalSecondsPerNode is the measured time per node of the layout of
+         *        the finest level (negative if not measured yet).
+         */
+        int repeatsWithinTimeLimit(int n, int level, int finestNodes, double remaining,
+                                   double levelSecondsPerNode, double finalSecondsPerNode) const;
+
         erc m_errorCode; //!< The error code of the last call.
     };
 
@@ -49,6 +49,7 @@
 
 #include <ogdf/basic/Graph.h>
 #include <ogdf/internal/energybased/MultilevelGraph.h>
+#include <ogdf/basic/basic.h>
 
 namespace ogdf
 {
@@ -73,10 +74,20 @@ namespace ogdf
         //  all edges that are moved to the other node in this merge.
         int m_adjustEdgeLengths;
         int m_numLevels; //!< stores number of levels for statistics purposes
+        int m_numThreads; //!< number of threads used for selecting the merges
+        int m_randomSeed; //!< seed for selecting the merges (-1 = use randomNumber())
+
+        //! Returns the seed used for selecting the merges of level \a level.
+        __uint32 levelSeed(int level) const
+        {
+            if(m_randomSeed < 0)
+                return (__uint32)randomNumber(0, numeric_limits<int>::max());
+            return (__uint32)m_randomSeed * 31u + (__uint32)level;
+        }
 
     public:
         virtual ~MultilevelBuilder() { }
-        MultilevelBuilder(): m_adjustEdgeLengths(0), m_numLevels(1) { }
+        MultilevelBuilder(): m_adjustEdgeLengths(0), m_numLevels(1), m_numThreads(1), m_randomSeed(-1) { }
 
         virtual void buildAllLevels(MultilevelGraph & MLG)
         {
@@ -94,6 +105,19 @@ namespace ogdf
         {
             m_adjustEdgeLengths = factor;
         }
+        //! Sets the number of threads used for selecting the merges (only used by some builders).
+        void setNumberOfThreads(int numThreads)
+        {
+            m_numThreads = max(1, numThreads);
+        }
+        //! Sets the seed for selecting the merges; the levels do not depend on the number of threads if the seed is fixed.
+        /**
+         * A negative seed (the default) draws a seed for each level with randomNumber().
+         */
+        void setRandomSeed(int seed)
+        {
+            m_randomSeed = seed;
+        }
         int getNumLevels()
         {
             return m_numLevels;
@@ -80,9 +80,9 @@ namespace ogdf
         void addPath(node sourceSun, node targetSun, double distance);
         void findInterSystemPaths(Graph & G, MultilevelGraph & MLG);
         int calcSystemMass(node v);
-        bool collapsSolarSystem(MultilevelGraph & MLG, node sun, int level);
+        bool collapsSolarSystem(MultilevelGraph & MLG, node sun, int level, std::vector<NodeCollapse> & merges);
         bool buildOneLevel(MultilevelGraph & MLG);
-        std::vector<node> selectSuns(MultilevelGraph & MLG);
+        std::vector<node> selectSuns(MultilevelGraph & MLG, __uint32 seed);
 
     public:
         SolarMerger(bool simple = false, bool massAsNodeRadius = false);
@@ -52,6 +52,7 @@
 #include <ogdf/basic/GridLayout.h>
 #include <ogdf/cluster/ClusterGraphAttributes.h>
 #include <ogdf/internal/steinertree/EdgeWeightedGraph.h>
+#include <ogdf/fileformats/OutputBuffer.h>
 #include <sstream>
 
 
@@ -853,6 +854,28 @@ namespace ogdf
          */
         static bool writeGML(const GraphAttributes & A, ostream & os);
 
+        //! Writes selected attributes of graph with attributes \a A in GML format to output buffer \a out.
+        /**
+         * This is the fast writer variant of writeGML(const GraphAttributes &A, ostream &os):
+         * the output is collected in \a out, and numbers are formatted without
+         * the locale-aware iostream machinery. Reusing the same output buffer for
+         * many graphs avoids repeated allocation of the buffer memory.
+         *
+         * @param A          specifies the graph and its attributes to be written.
+         * @param out        is the output buffer to which the graph will be written;
+         *                   it is flushed when writing is finished.
+         * @param attributes is a bit mask of GraphAttributes flags; only attributes
+         *                   contained in \a attributes and enabled in \a A are written.
+         * @return true if successful, false otherwise.
+         */
+        static bool writeGML(const GraphAttributes & A, OutputBuffer & out, long attributes);
+
+        //! Writes selected attributes of graph with attributes \a A in GML format to output stream \a os.
+        /**
+         * Uses the fast writer, see writeGML(const GraphAttributes &A, OutputBuffer &out, long attributes).
+         */
+        static bool writeGML(const GraphAttributes & A, ostream & os, long attributes);
+
 
         //! Reads graph \a G with attributes \a A in OGML format from file \a filename.
         /**
@@ -1600,6 +1623,28 @@ namespace ogdf
          */
         static bool writeGraphML(const GraphAttributes & A, ostream & os);
 
+        //! Writes selected attributes of graph with attributes \a A in GraphML format to output buffer \a out.
+        /**
+         * This is the fast writer variant of writeGraphML(const GraphAttributes &A, ostream &os):
+         * the output is collected in \a out, and numbers are formatted without
+         * the locale-aware iostream machinery. Reusing the same output buffer for
+         * many graphs avoids repeated allocation of the buffer memory.
+         *
+         * @param A          specifies the graph and its attributes to be written.
+         * @param out        is the output buffer to which the graph will be written;
+         *                   it is flushed when writing is finished.
+         * @param attributes is a bit mask of GraphAttributes flags; only attributes
+         *                   contained in \a attributes and enabled in \a A are written.
+         * @return true if successful, false otherwise.
+         */
+        static bool writeGraphML(const GraphAttributes & A, OutputBuffer & out, long attributes);
+
+        //! Writes selected attributes of graph with attributes \a A in GraphML format to output stream \a os.
+        /**
+         * Uses the fast writer, see writeGraphML(const GraphAttributes &A, OutputBuffer &out, long attributes).
+         */
+        static bool writeGraphML(const GraphAttributes & A, ostream & os, long attributes);
+
         //! Writes with attributes \a A in GraphML format to file \a filename.
         /**
          * \sa writeGraphML(const ClusterGraphAttributes &A, ostream &os) for more details.<br>
@@ -2954,6 +2999,9 @@ namespace ogdf
         //! Prints indentation for indentation \a depth to output stream \a os and returns \a os.
         static ostream & indent(ostream & os, int depth);
 
+        //! Prints indentation for indentation \a depth to output buffer \a out and returns \a out.
+        static OutputBuffer & indent(OutputBuffer & out, int depth);
+
         //@}
 
 
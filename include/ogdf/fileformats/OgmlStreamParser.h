@@ -0,0 +1,199 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of class OgmlStreamParser, a single-pass
+ *        reader for the structure and constraints of OGML files.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_OGML_STREAM_PARSER_H
+#define OGDF_OGML_STREAM_PARSER_H
+
+#include <ogdf/fileformats/XmlParser.h>
+#include <ogdf/basic/ArrayBuffer.h>
+#include <ogdf/basic/CompactGraphAttributes.h>
+#include <ogdf/cluster/ClusterGraph.h>
+#include <vector>
+
+
+namespace ogdf
+{
+
+    //
+    // ---------- O g m l S t r e a m P a r s e r ------------------------
+    //
+
+    //! Single-pass reader for the structure of OGML files.
+    /**
+     * In contrast to OgmlParser, this reader does not build an XML parse tree.
+     * It consumes the tokens of an XmlScanner in a single pass and creates
+     * nodes, clusters and edges as soon as the corresponding elements are
+     * closed. Memory consumption is therefore proportional to the size of the
+     * resulting graph and not to the size of the file.
+     *
+     * - Ids of nodes and clusters are kept in a compact table that maps an id
+     *   string to a slot; edges whose endpoints have not been read yet are
+     *   stored as pairs of slots and resolved when the structure element is
+     *   closed.
+     * - Nodes, edges and clusters get consecutive indices in the order in
+     *   which they are created. Unlike OgmlParser, numeric suffixes of ids
+     *   are not used as indices, so the size of the graph's index tables does
+     *   not depend on the values of the ids.
+     *
+     * The reader does not validate the document against the OGML
+     * specification and ignores layout and style information as well as
+     * constraints; use OgmlParser if these are required.
+     */
+    class OGDF_EXPORT OgmlStreamParser
+    {
+    public:
+        //! Constructs a streaming OGML reader.
+        OgmlStreamParser();
+
+        ~OgmlStreamParser();
+
+        //! Reads a graph \a G from the OGML input stream \a is.
+        /**
+         * Hierarchical nodes (nodes containing nodes) are ignored.
+         * @return true if successful, false otherwise.
+         */
+        bool read(istream & is, Graph & G)
+        {
+            return doRead(is, G, 0);
+        }
+
+        //! Reads a cluster graph \a CG from the OGML input stream \a is.
+        /**
+         * @param is is the input stream to be parsed as OGML file.
+         * @param G is the graph to be build; must be the graph associated with \a CG.
+         * @param CG is the cluster graph to be build.
+         * @return true if successful, false otherwise.
+         */
+        bool read(istream & is, Graph & G, ClusterGraph & CG)
+        {
+            return doRead(is, G, &CG);
+        }
+
+    private:
+        //! The kinds of elements the reader distinguishes.
+        enum ElementKind
+        {
+            ekOther, ekOgml, ekGraph, ekStructure, ekNode, ekEdge, ekSource, ekTarget
+        };
+
+        //! An open element.
+        struct Frame
+        {
+            ElementKind   m_kind;
+            string        m_name;    //!< tag name (for matching the closing tag)
+            int           m_slot;    //!< id slot of a node element
+            cluster       m_cluster; //!< cluster of a hierarchical node element
+            bool          m_hierarchical; //!< true if a node element contains nodes
+            int           m_src;     //!< source slot of an edge element (-1 if none)
+            int           m_tgt;     //!< target slot of an edge element (-1 if none)
+            int           m_numEnds; //!< number of sources and targets of an edge element
+
+            Frame() : m_kind(ekOther), m_slot(-1), m_cluster(0), m_hierarchical(false),
+                m_src(-1), m_tgt(-1), m_numEnds(0) { }
+        };
+
+        //! An entry of the id table.
+        struct IdSlot
+        {
+            node    m_v; //!< the node with this id (0 if none)
+            cluster m_c; //!< the cluster with this id (0 if none)
+            bool    m_defined; //!< true if a node element with this id has been read
+
+            IdSlot() : m_v(0), m_c(0), m_defined(false) { }
+        };
+
+        //! An edge whose endpoints were unknown when it was read.
+        struct PendingEdge
+        {
+            int m_src, m_tgt;
+
+            PendingEdge() : m_src(-1), m_tgt(-1) { }
+            PendingEdge(int src, int tgt) : m_src(src), m_tgt(tgt) { }
+        };
+
+        XmlScanner* m_pScanner; //!< scanner of the current input stream
+
+        Graph*            m_pG;  //!< the graph to be build
+        ClusterGraph*     m_pCG; //!< the cluster graph to be build (or 0)
+
+        std::vector<Frame> m_frames; //!< stack of open elements
+
+        Hashing<string, int, StringTableHashFunc> m_slots; //!< maps ids of nodes and clusters to slots
+        ArrayBuffer<IdSlot>      m_idSlots;      //!< the slots
+        ArrayBuffer<PendingEdge> m_pendingEdges; //!< edges with forward references
+
+        std::vector<string> m_attrNames;  //!< attribute names of the current tag
+        std::vector<string> m_attrValues; //!< attribute values of the current tag
+
+        bool m_structureRead; //!< true if a structure element has been read
+
+        bool doRead(istream & is, Graph & G, ClusterGraph* pCG);
+
+        bool parse();
+        bool startElement(const string & name);
+        bool endElement();
+
+        const string* attribute(int attrId) const;
+
+        int slot(const string & id);
+        cluster enclosingCluster(int frameIndex) const;
+
+        void makeHierarchical(Frame & f, int frameIndex);
+        void closeNode(Frame & f, int frameIndex);
+        bool closeEdge(const Frame & f);
+        void newEdge(int src, int tgt);
+        bool resolvePendingEdges();
+
+        bool error(const char* msg) const;
+        void cleanup();
+
+        OgmlStreamParser(const OgmlStreamParser &); // = delete
+        OgmlStreamParser & operator=(const OgmlStreamParser &); // = delete
+    };
+
+}//end namespace ogdf
+
+#endif
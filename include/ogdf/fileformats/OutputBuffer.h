@@ -0,0 +1,202 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of class OutputBuffer, a reusable write buffer
+ *        with locale-independent number formatting.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_OUTPUT_BUFFER_H
+#define OGDF_OUTPUT_BUFFER_H
+
+#include <ogdf/basic/graphics.h>
+#include <cstring>
+
+
+namespace ogdf
+{
+
+    //! Buffered text output with fast, locale-independent number formatting.
+    /**
+     * An output buffer collects text in a memory block and writes it to the
+     * attached output stream only if the block is full or flush() is called.
+     * Integers and floating point numbers are formatted without going through
+     * the locale machinery of iostreams; floating point numbers always contain
+     * a decimal point.
+     *
+     * An output buffer can be attached to different streams one after another
+     * (see attach()), so that its memory block is reused for many writes.
+     */
+    class OGDF_EXPORT OutputBuffer
+    {
+        ostream* m_pOs;     //!< the attached output stream (0 if none)
+        char*    m_buffer;  //!< the memory block
+        int      m_capacity;//!< size of the memory block
+        int      m_pos;     //!< number of characters currently in the block
+        int      m_precision; //!< number of significant digits for floating point numbers
+
+    public:
+        //! Creates an output buffer not attached to any stream.
+        explicit OutputBuffer(int capacity = 1 << 16);
+
+        //! Creates an output buffer attached to \a os.
+        explicit OutputBuffer(ostream & os, int capacity = 1 << 16);
+
+        //! Flushes the buffer and releases its memory.
+        ~OutputBuffer();
+
+        //! Flushes the buffer and attaches it to \a os.
+        void attach(ostream & os);
+
+        //! Flushes the buffer and detaches it from its stream.
+        void detach();
+
+        //! Writes the content of the buffer to the attached stream.
+        void flush();
+
+        //! Returns true if the attached stream is in a good state.
+        bool good() const
+        {
+            return m_pOs != 0 && m_pOs->good();
+        }
+
+        //! Returns the number of significant digits used for floating point numbers.
+        int precision() const
+        {
+            return m_precision;
+        }
+
+        //! Sets the number of significant digits used for floating point numbers to \a p (1 <= \a p <= 15).
+        void precision(int p)
+        {
+            m_precision = (p < 1) ? 1 : ((p > 15) ? 15 : p);
+        }
+
+        //! Appends character \a c.
+        OutputBuffer & put(char c)
+        {
+            if(m_pos == m_capacity) flush();
+            m_buffer[m_pos++] = c;
+            return *this;
+        }
+
+        //! Appends \a n copies of character \a c.
+        OutputBuffer & fill(char c, int n);
+
+        //! Appends the \a n characters starting at \a str.
+        OutputBuffer & write(const char* str, int n);
+
+        //! Appends the zero-terminated string \a str.
+        OutputBuffer & operator<<(const char* str)
+        {
+            return write(str, (int)strlen(str));
+        }
+
+        //! Appends string \a str.
+        OutputBuffer & operator<<(const string & str)
+        {
+            return write(str.data(), (int)str.size());
+        }
+
+        //! Appends character \a c.
+        OutputBuffer & operator<<(char c)
+        {
+            return put(c);
+        }
+
+        //! Appends the decimal representation of \a i.
+        OutputBuffer & operator<<(int i)
+        {
+            return writeInteger(i);
+        }
+
+        //! Appends the decimal representation of \a i.
+        OutputBuffer & operator<<(long i)
+        {
+            return writeInteger(i);
+        }
+
+        //! Appends the decimal representation of \a i.
+        OutputBuffer & operator<<(unsigned int i)
+        {
+            return writeUnsigned(i);
+        }
+
+        //! Appends the decimal representation of \a d (with precision() significant digits).
+        OutputBuffer & operator<<(double d)
+        {
+            return writeDouble(d);
+        }
+
+        //! Appends the decimal representation of \a i.
+        OutputBuffer & writeInteger(__int64 i)
+        {
+            if(i < 0)
+            {
+                put('-');
+                return writeUnsigned(__uint64(0) - __uint64(i));
+            }
+            return writeUnsigned(__uint64(i));
+        }
+
+        //! Appends the decimal representation of \a u.
+        OutputBuffer & writeUnsigned(__uint64 u);
+
+        //! Appends the decimal representation of \a d (with precision() significant digits).
+        OutputBuffer & writeDouble(double d);
+
+    private:
+        OutputBuffer(const OutputBuffer &); // = delete
+        OutputBuffer & operator=(const OutputBuffer &); // = delete
+    };
+
+
+    //! Appends the string representation of color \a c to \a out.
+    inline OutputBuffer & operator<<(OutputBuffer & out, const Color & c)
+    {
+        return out << c.toString();
+    }
+
+
+} // end namespace ogdf
+
+
+#endif
@@ -53,11 +53,112 @@
 #include <ogdf/basic/NodeArray.h>
 #include <ogdf/basic/Array.h>
 #include <ogdf/basic/BinaryHeap2.h>
+#include <vector>
 
 
 namespace ogdf
 {
 
+    //! Distances between all pairs of nodes of a graph, stored in one row-major array.
+    /**
+     * Row and column \a i belong to the \a i-th node of the graph in the order of
+     * forall_nodes when the matrix was initialized. Pairs of nodes that are not
+     * connected have distance infinity().
+     * The value type \a T is double, float, or __uint16 for hop counts.
+     */
+    template<class T>
+    class DistanceMatrix
+    {
+    public:
+        //! Creates an empty matrix.
+        DistanceMatrix() : m_n(0) { }
+
+        //! Creates the matrix for graph \a G; see init().
+        explicit DistanceMatrix(const Graph & G)
+        {
+            init(G);
+        }
+
+        //! Initializes the matrix for graph \a G with distance infinity() for all pairs of distinct nodes.
+        void init(const Graph & G)
+        {
+            m_n = G.numberOfNodes();
+            m_index.init(G);
+            m_node.init(m_n);
+            int i = 0;
+            node v;
+            forall_nodes(v, G)
+            {
+                m_index[v] = i;
+                m_node[i++] = v;
+            }
+            m_data.assign(size_t(m_n) * m_n, infinity());
+            for(i = 0; i < m_n; i++)
+                m_data[size_t(i) * m_n + i] = T(0);
+        }
+
+        //! Returns the value used for pairs of nodes that are not connected.
+        static T infinity()
+        {
+            return numeric_limits<T>::has_infinity ? numeric_limits<T>::infinity() : numeric_limits<T>::max();
+        }
+
+        //! Returns the number of rows (and columns).
+        int numberOfNodes() const
+        {
+            return m_n;
+        }
+
+        //! Returns the row (and column) of node \a v.
+        int index(node v) const
+        {
+            return m_index[v];
+        }
+
+        //! Returns the node of row (and column) \a i.
+        node nodeAt(int i) const
+        {
+            return m_node[i];
+        }
+
+        //! Returns a pointer to the first entry of row \a i.
+        T* row(int i)
+        {
+            return &m_data[size_t(i) * m_n];
+        }
+        const T* row(int i) const
+        {
+            return &m_data[size_t(i) * m_n];
+        }
+
+        //! Returns the distance from the node of row \a i to the node of column \a j.
+        T & operator()(int i, int j)
+        {
+            return m_data[size_t(i) * m_n + j];
+        }
+        const T & operator()(int i, int j) const
+        {
+            return m_data[size_t(i) * m_n + j];
+        }
+
+        //! Returns the distance from \a v to \a w.
+        T & operator()(node v, node w)
+        {
+            return m_data[size_t(m_index[v]) * m_n + m_index[w]];
+        }
+        const T & operator()(node v, node w) const
+        {
+            return m_data[size_t(m_index[v]) * m_n + m_index[w]];
+        }
+
+    private:
+        int m_n;               //!< the number of nodes
+        NodeArray<int> m_index; //!< the row of each node
+        Array<node> m_node;    //!< the node of each row
+        std::vector<T> m_data; //!< the entries in row-major order
+    };
+
+
     //! BFS to compute shortest path all pairs. The costs for
     //! traversing an edge corresponds to /a edgeCosts.
     OGDF_EXPORT
@@ -94,6 +195,49 @@ namespace ogdf
                        NodeArray<double> & shortestPathMatrix,
                        const EdgeArray<double> & edgeCosts);
 
+    //! BFS from all nodes in parallel. The costs for traversing an edge corresponds to \a edgeCosts.
+    /**
+     * The sources are distributed among \a numThreads threads; \a distance
+     * is initialized for \a G.
+     */
+    OGDF_EXPORT
+    void bfs_SPAP(const Graph & G, DistanceMatrix<double> & distance,
+                  double edgeCosts, int numThreads = 1);
+
+    //! BFS from all nodes in parallel, with distances in single precision.
+    OGDF_EXPORT
+    void bfs_SPAP(const Graph & G, DistanceMatrix<float> & distance,
+                  double edgeCosts, int numThreads = 1);
+
+    //! BFS from all nodes in parallel, computing the number of edges of shortest paths.
+    /**
+     * Hop counts larger than 65534 are stored as 65534.
+     */
+    OGDF_EXPORT
+    void bfs_SPAP(const Graph & G, DistanceMatrix<__uint16> & hops, int numThreads = 1);
+
+    //! Dijkstra algorithm from all nodes in parallel. The costs for traversing edge e
+    //! corresponds to \a GA.doubleWeight(e)
+    /**
+     * @return returns the average edge costs
+     */
+    OGDF_EXPORT
+    double dijkstra_SPAP(const GraphAttributes & GA,
+                         DistanceMatrix<double> & shortestPathMatrix, int numThreads = 1);
+
+    //! Dijkstra algorithm from all nodes in parallel. The costs for traversing edge e
+    //! corresponds to \a edgeCosts[e]
+    OGDF_EXPORT
+    void dijkstra_SPAP(const Graph & G,
+                       DistanceMatrix<double> & shortestPathMatrix,
+                       const EdgeArray<double> & edgeCosts, int numThreads = 1);
+
+    //! Dijkstra algorithm from all nodes in parallel, with distances in single precision.
+    OGDF_EXPORT
+    void dijkstra_SPAP(const Graph & G,
+                       DistanceMatrix<float> & shortestPathMatrix,
+                       const EdgeArray<double> & edgeCosts, int numThreads = 1);
+
     //! Floyd-Wharshall algorithm to compute shortest path all pairs given a weighted graph.
     //! Note the shortestPathMatrix has to be initialized and all entries positive. The costs
     //! non-adjacent nodes should be set to std::numeric_limits<double>::infinity().
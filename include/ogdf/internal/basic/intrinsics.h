@@ -74,4 +74,31 @@
 #endif
 
 
+// AVX2 and AVX-512 code is compiled per function (independent of the compiler
+// flags for the whole library), hence such functions must only be called if
+// SIMD::level() is at least simdAVX2 or simdAVX512, respectively (see SIMDKernel
+// in ogdf/basic/SIMD.h).
+//
+// OGDF_AVX2_EXTENSIONS    defined if functions marked with OGDF_TARGET_AVX2 may use AVX2 and FMA intrinsics
+// OGDF_AVX512_EXTENSIONS  defined if functions marked with OGDF_TARGET_AVX512 may use AVX-512F intrinsics
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1911) && (defined(_M_IX86) || defined(_M_X64)) && !defined(_M_CEE_PURE)
+#include <immintrin.h>
+
+#define OGDF_AVX2_EXTENSIONS
+#define OGDF_AVX512_EXTENSIONS
+#define OGDF_TARGET_AVX2
+#define OGDF_TARGET_AVX512
+
+#elif (defined(__x86_64__) || defined(__i386__)) && (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 7))
+#include <immintrin.h>
+
+#define OGDF_AVX2_EXTENSIONS
+#define OGDF_AVX512_EXTENSIONS
+#define OGDF_TARGET_AVX2   __attribute__((target("avx2,fma")))
+#define OGDF_TARGET_AVX512 __attribute__((target("avx512f")))
+
+#endif
+
+
 #endif
@@ -87,6 +87,30 @@ namespace ogdf
         //! Changes m_currentX and m_currentY by setting the position of m_testNode to m_testX and m_testY. Sets m_energy to m_candidateEnergy. Computes the energy of the layout stored in AG.
         void candidateTaken();
 
+        //! Prepares the concurrent computation of candidate energies by \a numThreads threads.
+        /**
+         * Returns false if concurrentCandidateEnergy() is not supported; then
+         * candidates can only be evaluated with computeCandidateEnergy().
+         */
+        virtual bool prepareConcurrentCandidates(int /* numThreads */)
+        {
+            return false;
+        }
+
+        //! Returns the energy for the layout where vertex v moves to newPos without changing any data.
+        /**
+         * Thread \a t (0 <= \a t < numThreads) may call this function while other
+         * threads evaluate other candidates, as long as no candidate is taken.
+         * Requires a successful call of prepareConcurrentCandidates().
+         */
+        virtual double concurrentCandidateEnergy(
+            const node /* v */,
+            const DPoint & /* newPos */,
+            int /* t */) const
+        {
+            OGDF_THROW(AlgorithmFailureException);
+        }
+
 #ifdef OGDF_DEBUG
         //! prints status information for debugging
         void printStatus() const;
@@ -51,12 +51,15 @@
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/geometry.h>
 #include <ogdf/basic/NodeArray.h>
+#include <ogdf/basic/Array.h>
 #include <ogdf/internal/energybased/NodeAttributes.h>
 #include <ogdf/internal/energybased/EdgeAttributes.h>
 
 namespace ogdf
 {
 
+    class KernelTeam;
+
     class OGDF_EXPORT FruchtermanReingold
     {
     public:
@@ -88,11 +91,42 @@ namespace ogdf
             down_left_corner = d_l_c;
         }
 
+        //The threads used for the force calculation (0 for the calling thread
+        //only); the team is kept alive by the caller between the iterations. If
+        //it has more than one thread, the force on each node is summed up by a
+        //single thread (the result does not depend on the number of threads then).
+        void thread_team(KernelTeam* team);
+        int number_of_threads() const
+        {
+            return _number_of_threads;
+        }
+
     private:
         int _grid_quotient;//for coarsening the FrRe-grid
         int max_gridindex; //maximum index of a grid row/column
         double boxlength;  //length of drawing box
         DPoint down_left_corner;//down left corner of drawing box
+        KernelTeam* _thread_team;//threads for the force calculation (or 0)
+        int _number_of_threads;//number of threads for the force calculation
+
+        //data of the parallel force calculation
+        Array<node> nodes;       //the nodes (sorted by grid box for the approximation)
+        Array<DPoint> positions; //positions of the nodes in nodes
+        Array<int> box_start;    //index of the first node of each grid box in nodes
+        NodeArray<DPoint>* F_rep_ptr;
+
+        //Parallel versions of the force calculation; the kernels compute the
+        //forces of the nodes (grid boxes) in the t-th part of all nodes (grid boxes).
+        void calculate_exact_repulsive_forces_in_parallel(
+            const Graph & G,
+            NodeArray<NodeAttributes> & A,
+            NodeArray<DPoint> & F_rep);
+        void exact_repulsive_forces_kernel(int t);
+        void calculate_approx_repulsive_forces_in_parallel(
+            const Graph & G,
+            NodeArray<NodeAttributes> & A,
+            NodeArray<DPoint> & F_rep);
+        void approx_repulsive_forces_kernel(int t);
 
         //Returns the repulsing force_function_value of scalar d.
         double f_rep_scalar(double d);
@@ -0,0 +1,287 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of class LinearQuadTreeNM, an array based
+ *        reduced quadtree for the New Multipole Method (NMM).
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_LINEAR_QUAD_TREE_NM_H
+#define OGDF_LINEAR_QUAD_TREE_NM_H
+
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/ArrayBuffer.h>
+#include <ogdf/basic/geometry.h>
+#include <ogdf/internal/energybased/NodeAttributes.h>
+#include <complex>
+
+
+using std::complex;
+
+namespace ogdf
+{
+
+    class OGDF_EXPORT LinearQuadTreeNM
+    {
+        //Helping data structure that stores the reduced quadtree of the New Multipole
+        //Method (NMM) in arrays instead of linked tree nodes.
+        //The particles are sorted by the Morton numbers of their positions, so that the
+        //particles of every tree node form a contiguous range. The tree nodes are
+        //numbered in breadth first order (the index of a node is larger than the index
+        //of its father, the children of a node have consecutive indices), the expansion
+        //coefficients of all tree nodes are stored in two contiguous arrays, and the
+        //interaction lists I, D1, D2 and M of all tree nodes are stored in one array.
+        //All arrays are only reallocated if the number of particles or the precision
+        //grows, hence the tree can be rebuilt in every iteration without allocations.
+
+    public:
+        LinearQuadTreeNM();   //constructor
+        ~LinearQuadTreeNM() { } //destructor
+
+        //Builds the reduced quadtree for the particles at positions A[v] (v in G) in the
+        //quadratic box with down left corner dlc and length boxlength; every leaf
+        //contains at most particles_in_leaves particles, unless its particles cannot be
+        //separated; the expansions (with precision + 1 coefficients) are set to zero.
+        void build(const Graph & G,
+                   NodeArray<NodeAttributes> & A,
+                   DPoint dlc,
+                   double boxlength,
+                   int particles_in_leaves,
+                   int precision);
+
+        //Frees all memory.
+        void clear();
+
+        //Returns the number of tree nodes/leaves/particles.
+        int number_of_tree_nodes() const
+        {
+            return m_numberOfTreeNodes;
+        }
+        int number_of_leaves() const
+        {
+            return m_leaves.size();
+        }
+        int number_of_particles() const
+        {
+            return m_numberOfParticles;
+        }
+
+        //Returns the i-th leaf (leaves are ordered like their particles).
+        int leaf(int i) const
+        {
+            return m_leaves[i];
+        }
+
+        //Information about tree node i.
+        int get_Sm_level(int i) const
+        {
+            return m_treeNode[i].m_level;
+        }
+        DPoint get_Sm_downleftcorner(int i) const
+        {
+            return m_treeNode[i].m_dlc;
+        }
+        double get_Sm_boxlength(int i) const
+        {
+            return m_treeNode[i].m_boxlength;
+        }
+        complex<double> get_Sm_center(int i) const
+        {
+            return m_treeNode[i].m_center;
+        }
+        void set_Sm_center(int i, complex<double> c)
+        {
+            m_treeNode[i].m_center = c;
+        }
+        int get_father(int i) const
+        {
+            return m_treeNode[i].m_father;
+        }
+        bool is_root(int i) const
+        {
+            return i == 0;
+        }
+        bool is_leaf(int i) const
+        {
+            return m_treeNode[i].m_numberOfChildren == 0;
+        }
+        int first_child(int i) const
+        {
+            return m_treeNode[i].m_firstChild;
+        }
+        int number_of_children(int i) const
+        {
+            return m_treeNode[i].m_numberOfChildren;
+        }
+        int first_particle(int i) const
+        {
+            return m_treeNode[i].m_firstParticle;
+        }
+        int number_of_particles(int i) const
+        {
+            return m_treeNode[i].m_numberOfParticles;
+        }
+
+        //The coefficients of the multipole/local expansion of tree node i.
+        complex<double>* get_multipole_exp(int i)
+        {
+            return m_ME.begin() + i * m_numberOfCoefficients;
+        }
+        complex<double>* get_local_exp(int i)
+        {
+            return m_LE.begin() + i * m_numberOfCoefficients;
+        }
+
+        //The interaction lists of tree node i; the lists are set in the order I, D1,
+        //D2, M by calling set_lists() for the tree nodes in increasing order.
+        const int* I_begin(int i) const
+        {
+            return m_lists.begin() + m_treeNode[i].m_listBegin[0];
+        }
+        const int* I_end(int i) const
+        {
+            return m_lists.begin() + m_treeNode[i].m_listBegin[1];
+        }
+        const int* D1_begin(int i) const
+        {
+            return I_end(i);
+        }
+        const int* D1_end(int i) const
+        {
+            return m_lists.begin() + m_treeNode[i].m_listBegin[2];
+        }
+        const int* D2_begin(int i) const
+        {
+            return D1_end(i);
+        }
+        const int* D2_end(int i) const
+        {
+            return m_lists.begin() + m_treeNode[i].m_listBegin[3];
+        }
+        const int* M_begin(int i) const
+        {
+            return D2_end(i);
+        }
+        const int* M_end(int i) const
+        {
+            return m_lists.begin() + m_treeNode[i].m_listBegin[4];
+        }
+
+        //Stores the interaction lists of tree node i.
+        void set_lists(int i,
+                       const ArrayBuffer<int> & I,
+                       const ArrayBuffer<int> & D1,
+                       const ArrayBuffer<int> & D2,
+                       const ArrayBuffer<int> & M);
+
+        //Information about the k-th particle (in Morton order).
+        node get_particle(int k) const
+        {
+            return m_particle[k];
+        }
+        int get_particle_index(int k) const
+        {
+            return m_particleIndex[k];
+        }
+        DPoint get_position(int k) const
+        {
+            return m_position[k];
+        }
+
+    private:
+        struct TreeNode
+        {
+            int    m_level;             //level of the small cell
+            DPoint m_dlc;               //down left corner of the small cell
+            double m_boxlength;         //length of the small cell
+            complex<double> m_center;   //center of the expansions
+            int    m_father;            //index of the father (-1 for the root)
+            int    m_firstChild;        //index of the first child
+            int    m_numberOfChildren;  //number of children (0 for leaves)
+            int    m_firstParticle;     //index of the first particle in the subtree
+            int    m_numberOfParticles; //number of particles in the subtree
+            int    m_listBegin[5];      //positions of the interaction lists in m_lists
+        };
+
+        //A particle with its Morton number.
+        struct MortonEntry
+        {
+            __uint64 m_code;
+            node     m_node;
+
+            bool operator<(const MortonEntry & e) const
+            {
+                return m_code < e.m_code || (m_code == e.m_code && m_node->index() < e.m_node->index());
+            }
+        };
+
+        //Sets the small cell of tree node i, which lies in the cell on level
+        //min_level containing its particles.
+        void set_small_cell(int i, int min_level);
+
+        //Creates the children of tree node i.
+        void split(int i);
+
+        //Returns the position of the first particle in [first,last) whose Morton
+        //number has a quadrant index larger than q on level (level+1).
+        int find_quadrant_end(int first, int last, int level, int q) const;
+
+        int m_particlesInLeaves; //max. number of particles of a leaf
+        int m_numberOfCoefficients; //precision + 1
+        DPoint m_dlc;            //down left corner of the box
+        double m_boxlength;      //length of the box
+
+        int m_numberOfParticles;
+        Array<MortonEntry> m_morton;   //particles sorted by Morton numbers
+        Array<node>   m_particle;      //the nodes of the graph (in Morton order)
+        Array<int>    m_particleIndex; //the indices of these nodes
+        Array<DPoint> m_position;      //the positions of these nodes
+
+        int m_numberOfTreeNodes;
+        Array<TreeNode> m_treeNode;    //the tree nodes (in breadth first order)
+        ArrayBuffer<int> m_leaves;     //the leaves
+        ArrayBuffer<int> m_lists;      //the interaction lists of all tree nodes
+        Array<complex<double>> m_ME;   //the multipole expansions of all tree nodes
+        Array<complex<double>> m_LE;   //the local expansions of all tree nodes
+    };
+
+}//namespace ogdf
+#endif
@@ -79,6 +79,19 @@ namespace ogdf
     };
 
 
+    //Describes one merge of the bulk operation MultilevelGraph::collapse()
+    struct NodeCollapse
+    {
+        node m_merged;     // the node that is merged into m_parent
+        node m_parent;     // the node representing m_merged on the next level
+        double m_radius;   // the new radius of m_parent
+        NodeMerge* m_NM;   // records the merge (may contain position information); deleted if not used
+
+        NodeCollapse(node merged, node parent, double radius, NodeMerge* NM)
+            : m_merged(merged), m_parent(parent), m_radius(radius), m_NM(NM) { }
+    };
+
+
     class OGDF_EXPORT MultilevelGraph
     {
     private:
@@ -207,6 +220,12 @@ namespace ogdf
         bool changeEdge(NodeMerge* NM, edge theEdge, double newWeight, node newSource, node newTarget);
         bool deleteEdge(NodeMerge* NM, edge theEdge);
         std::vector<edge> moveEdgesToParent(NodeMerge* NM, node theNode, node parent, bool deleteDoubleEndges, int adjustEdgeLengths);
+        // merges all nodes given in merges into their parents (in this order); has the same
+        // effect as changeNode, moveEdgesToParent (deleting double edges) and postMerge for
+        // each merge, but moves edges instead of recreating them and finds the edges of a
+        // parent in constant time. Merges into the same parent should be consecutive.
+        // Merges whose nodes no longer exist are skipped. Returns the number of merged nodes.
+        int collapse(const std::vector<NodeCollapse> & merges, int adjustEdgeLengths);
         NodeMerge* getLastMerge();
         node undoLastMerge();
 
@@ -55,6 +55,7 @@
 #include <ogdf/internal/energybased/NodeAttributes.h>
 #include <ogdf/internal/energybased/EdgeAttributes.h>
 #include <ogdf/internal/energybased/QuadTreeNM.h>
+#include <ogdf/internal/energybased/LinearQuadTreeNM.h>
 #include <ogdf/internal/energybased/ParticleInfo.h>
 #include <ogdf/internal/energybased/FruchtermanReingold.h>
 #include <complex>
@@ -89,6 +90,18 @@ namespace ogdf
         //Import updated information of the drawing area.
         void update_boxlength_and_cornercoordinate(double b_l, DPoint d_l_c);
 
+        //The threads used for the force calculation (0 for the calling thread
+        //only); the team is kept alive by the caller between the iterations. If
+        //it has more than one thread, the local expansions of disjoint subtrees
+        //and the forces of the leaves are computed in parallel, and the force on
+        //each node is summed up by a single thread (the result does not depend on
+        //the number of threads then).
+        void thread_team(KernelTeam* team);
+        int number_of_threads() const
+        {
+            return _number_of_threads;
+        }
+
     private:
         int MIN_NODE_NUMBER; //The minimum number of nodes for which the forces are
         //calculated using NMM (for lower values the exact
@@ -101,6 +114,8 @@ namespace ogdf
         int _find_small_cell;//0 = iterative; 1= Aluru
         int _particles_in_leaves;//max. number of particles for leaves of the quadtree
         int _precision;  //precision for p-term multipole expansion
+        KernelTeam* _thread_team; //threads for the force calculation (or 0)
+        int _number_of_threads; //number of threads for the force calculation
 
         double boxlength;//length of drawing box
         DPoint down_left_corner;//down left corner of drawing box
@@ -410,6 +425,10 @@ namespace ogdf
         //The center of the box of *act_ptr is initialized.
         void set_center(QuadTreeNodeNM* act_ptr);
 
+        //Returns a center for the cell with down left corner Sm_downleftcorner and
+        //length Sm_boxlength (slightly moved in y-direction by a random amount).
+        complex<double> cell_center(DPoint Sm_downleftcorner, double Sm_boxlength);
+
         //Calculate List ME for *act_ptr Precondition: *act_ptr is a leaf.
         void form_multipole_expansion_of_leaf_node(NodeArray<NodeAttributes> & A,
                 QuadTreeNodeNM* act_ptr);
@@ -418,27 +437,135 @@ namespace ogdf
         // *act_ptr has a father_node.
         void add_shifted_expansion_to_father_expansion(QuadTreeNodeNM* act_ptr);
 
+        //The shifted multipole expansion ME_0 (around z_0) is added to the multipole
+        //expansion ME_1 (around z_1).
+        void add_shifted_multipole_exp(const complex<double>* ME_0, complex<double> z_0,
+                                       complex<double>* ME_1, complex<double> z_1);
+
         //According to NMM T is traversed recursively top-down starting from act_node_ptr
         //== T.get_root_ptr() and thereby the lists D1, D2, M and LE are calculated for all
         //treenodes.
         void calculate_local_expansions_and_WSPRLS(NodeArray<NodeAttributes> & A,
                 QuadTreeNodeNM* act_node_ptr);
 
+        //The lists D1, D2, M and LE are calculated for *act_node_ptr (as in
+        //calculate_local_expansions_and_WSPRLS, but without recursive calls).
+        void calculate_local_expansions_and_WSPRLS_of_node(NodeArray<NodeAttributes> & A,
+                QuadTreeNodeNM* act_node_ptr);
+
+        //Parallel version of calculate_local_expansions_and_WSPRLS: The upper levels
+        //of T are processed sequentially until there are enough subtrees; the
+        //subtrees are processed in parallel afterwards.
+        void calculate_local_expansions_and_WSPRLS_in_parallel(NodeArray<NodeAttributes> & A,
+                QuadTreeNodeNM* root_ptr);
+
+        //Kernel of the t-th thread for the subtrees in subtree_roots.
+        void local_expansions_kernel(int t);
+
+        //Parallel version of transform_local_exp_to_forces,
+        //transform_multipole_exp_to_forces and calculate_neighbourcell_forces.
+        void calculate_leaf_forces_in_parallel(NodeArray<NodeAttributes> & A,
+                                               List<QuadTreeNodeNM*> & quad_tree_leaves,
+                                               NodeArray<DPoint> & F_direct,
+                                               NodeArray<DPoint> & F_multipole_exp,
+                                               NodeArray<DPoint> & F_local_exp);
+
+        //Kernel of the t-th thread for the leaves in leaves.
+        void leaf_forces_kernel(int t);
+
+        //The force contribution defined by leaf_ptr->get_local_exp() is calculated for
+        //all nodes of *leaf_ptr and stored in F_local_exp.
+        void transform_local_exp_of_leaf_to_forces(NodeArray<NodeAttributes> & A,
+                QuadTreeNodeNM* leaf_ptr,
+                NodeArray<DPoint> & F_local_exp);
+
+        //The force contribution defined by all nodes in leaf_ptr->get_M() is calculated
+        //for all nodes of *leaf_ptr and added to F_multipole_exp.
+        void transform_multipole_exp_of_leaf_to_forces(NodeArray<NodeAttributes> & A,
+                QuadTreeNodeNM* leaf_ptr,
+                NodeArray<DPoint> & F_multipole_exp);
+
+        //The force contributions from *leaf_ptr and all leaves in leaf_ptr->get_D1()
+        //and leaf_ptr->get_D2() are calculated for all nodes of *leaf_ptr (only these
+        //entries of F_direct are changed).
+        void calculate_neighbourcell_forces_of_leaf(NodeArray<NodeAttributes> & A,
+                QuadTreeNodeNM* leaf_ptr,
+                NodeArray<DPoint> & F_direct);
+
+        // *********functions needed for the linear quadtree ********
+
+        //Use NMM with the linear quadtree for force calculation.
+        void calculate_repulsive_forces_by_linear_NMM(const Graph & G,
+                NodeArray<NodeAttributes> & A,
+                NodeArray<DPoint> & F_rep);
+
+        //The centers and the multipole expansions of all nodes of T are calculated.
+        void form_multipole_expansions(LinearQuadTreeNM & T);
+
+        //The lists I, D1, D2, M and the local expansions of all nodes of T are
+        //calculated (see calculate_local_expansions_and_WSPRLS_of_node).
+        void calculate_local_expansions_and_WSPRLS(LinearQuadTreeNM & T);
+
+        //Kernel of the t-th thread for the leaves of linear_tree.
+        void linear_leaf_forces_kernel(int t);
+
+        //The repulsive forces of all particles of leaf i of linear_tree are calculated
+        //and stored in linear_forces.
+        void calculate_forces_of_leaf(int i);
+
+        LinearQuadTreeNM linear_tree; //the linear quadtree (reused in every iteration)
+        Array<DPoint> linear_forces;  //the forces of the particles of linear_tree
+
+        //data of the parallel force calculation
+        Array<QuadTreeNodeNM*> subtree_roots; //roots of the subtrees processed in parallel
+        Array<QuadTreeNodeNM*> leaves;        //leaves of the reduced quadtree
+        NodeArray<NodeAttributes>* A_ptr;
+        NodeArray<DPoint>* F_direct_ptr;
+        NodeArray<DPoint>* F_multipole_exp_ptr;
+        NodeArray<DPoint>* F_local_exp_ptr;
+
         //If the small cell of ptr_1 and ptr_2 are well separated true is returned (else
         //false).
         bool well_separated(QuadTreeNodeNM* ptr_1, QuadTreeNodeNM* ptr_2);
 
+        //Same as above for the cells given by their down left corners and boxlengths.
+        bool well_separated(DPoint dlc_1, double boxlength_1, DPoint dlc_2, double boxlength_2);
+
         //If ptr_1 and ptr_2 are nonequal and bordering true is returned; else false.
         bool bordering(QuadTreeNodeNM* ptr_1, QuadTreeNodeNM* ptr_2);
 
+        //Same as above for the cells given by their down left corners and boxlengths.
+        bool bordering(DPoint dlc_1, double boxlength_1, DPoint dlc_2, double boxlength_2);
+
         //The shifted local expansion of the father of node_ptr is added to the local
         //expansion of node_ptr;precondition: node_ptr is not the root of T.
         void add_shifted_local_exp_of_parent(QuadTreeNodeNM* node_ptr);
 
+        //The shifted local expansion LE_0 (around z_0) is added to the local expansion
+        //LE_1 (around z_1).
+        void add_shifted_local_exp(const complex<double>* LE_0, complex<double> z_0,
+                                   complex<double>* LE_1, complex<double> z_1);
+
         //The multipole expansion of *ptr_1 is transformed into a local expansion around
         //the center of *ptr_2 and added to *ptr_2 s local expansion list.
         void add_local_expansion(QuadTreeNodeNM* ptr_1, QuadTreeNodeNM* ptr_2);
 
+        //The multipole expansion ME_0 (around z_0) is transformed into a local expansion
+        //around z_1 and added to LE_1.
+        void add_local_expansion(const complex<double>* ME_0, complex<double> z_0,
+                                 complex<double>* LE_1, complex<double> z_1);
+
+        //The multipole expansion (1,0,...) of a particle at z_0 is transformed into a
+        //local expansion around z_1 and added to LE_1.
+        void add_local_expansion_of_particle(complex<double> z_0, complex<double>* LE_1,
+                                             complex<double> z_1);
+
+        //Returns the force defined by the local expansion LE (around z_0) at z_v.
+        DPoint local_exp_force(const complex<double>* LE, complex<double> z_0, complex<double> z_v);
+
+        //Returns the force defined by the multipole expansion ME (around z_0) at z_v.
+        DPoint multipole_exp_force(const complex<double>* ME, complex<double> z_0, complex<double> z_v);
+
         //The multipole expansion for every particle of leaf_ptr->contained_nodes
         //(1,0,...) is transformed into a local expansion around the center of *ptr_2 and
         //added to *ptr_2 s local expansion List;precondition: *leaf_ptr is a leaf.
@@ -483,8 +610,8 @@ namespace ogdf
         //Returns n over k.
         double binko(int n, int k);
 
-        //The way to construct the reduced tree (0) = level by level (1) path by path
-        //(2) subtree by subtree
+        //The way to construct the reduced tree (0) = path by path (1) subtree by subtree
+        //(2) linear quadtree
         int tree_construction_way() const
         {
             return _tree_construction_way;
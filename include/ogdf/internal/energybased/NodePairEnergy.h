@@ -74,6 +74,18 @@ namespace ogdf
         //computes the energy of the initial layout
         void computeEnergy();
 
+        //candidates can be evaluated concurrently
+        bool prepareConcurrentCandidates(int)
+        {
+            return true;
+        }
+
+        //computes the energy of the layout if v moves to newPos; thread-safe
+        double concurrentCandidateEnergy(const node v, const DPoint & newPos, int) const
+        {
+            return candidateEnergy(v, newPos, 0);
+        }
+
     protected:
         //computes the energy stored by a pair of vertices at the given positions
         virtual double computeCoordEnergy(node, node, const DPoint &, const DPoint &) const = 0;
@@ -116,6 +128,10 @@ namespace ogdf
         //computes energy of whole layout if new position of the candidate vertex is chosen
         void compCandEnergy();
 
+        //computes energy of whole layout if v moves to newPos; stores the new pair
+        //energies in candPairEnergy unless it is 0
+        double candidateEnergy(const node v, const DPoint & newPos, NodeArray<double>* candPairEnergy) const;
+
         //If a candidate change is chosen as the new position, this function sets the
         //internal data accordingly
         void internalCandidateTaken();
@@ -0,0 +1,116 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of class ParallelCoarsening, which computes
+ *        independent sets and matchings for multilevel layouts in parallel.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_PARALLEL_COARSENING_H
+#define OGDF_PARALLEL_COARSENING_H
+
+#include <ogdf/basic/Graph.h>
+
+
+namespace ogdf
+{
+
+    //! Parallel computation of independent sets and matchings for coarsening graphs.
+    /**
+     * The objects are processed greedily in the order of increasing keys; ties
+     * are broken by pseudo-random priorities derived from a seed. Both
+     * algorithms work in rounds: an object is taken if it precedes all
+     * undecided objects in its neighborhood. The result is the same as that of
+     * the sequential greedy algorithm, hence it only depends on the seed and
+     * not on the number of threads. Each round takes time linear in the size
+     * of the graph.
+     */
+    class OGDF_EXPORT ParallelCoarsening
+    {
+    public:
+        //! Returns the pseudo-random priority of the object with index \a index for seed \a seed.
+        static __uint32 priority(__uint32 seed, int index)
+        {
+            __uint32 h = seed * 0x9e3779b9u ^ (__uint32)index;
+            h ^= h >> 16;
+            h *= 0x85ebca6bu;
+            h ^= h >> 13;
+            h *= 0xc2b2ae35u;
+            h ^= h >> 16;
+            return h;
+        }
+
+        //! Computes a maximal set of nodes with pairwise distance larger than \a distance.
+        /**
+         * @param G is the input graph.
+         * @param inSet is assigned true for the nodes in the set.
+         * @param distance is 1 (independent set) or 2 (independent set of the square of \a G).
+         * @param seed is the seed of the priorities.
+         * @param numThreads is the number of threads used.
+         * @param key are optional node keys; nodes with smaller keys are preferred.
+         */
+        static void independentSet(
+            const Graph & G,
+            NodeArray<bool> & inSet,
+            int distance,
+            __uint32 seed,
+            int numThreads,
+            const NodeArray<double>* key = 0);
+
+        //! Computes a maximal matching of \a G.
+        /**
+         * @param G is the input graph.
+         * @param mate is assigned the matching edge at each node (0 if the node is not matched).
+         * @param seed is the seed of the priorities.
+         * @param numThreads is the number of threads used.
+         * @param key are optional edge keys; edges with smaller keys are preferred.
+         */
+        static void matching(
+            const Graph & G,
+            NodeArray<edge> & mate,
+            __uint32 seed,
+            int numThreads,
+            const EdgeArray<double>* key = 0);
+    };
+
+} // end namespace ogdf
+
+#endif
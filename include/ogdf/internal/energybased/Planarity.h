@@ -52,13 +52,26 @@
 
 
 #include <ogdf/internal/energybased/EnergyFunction.h>
-#include <ogdf/basic/Array2D.h>
+#include <ogdf/basic/ArrayBuffer.h>
 
 
 namespace ogdf
 {
 
 
+    //! Energy function counting the crossings of the edges.
+    /**
+     * The straight-line segments of the edges are stored in a uniform grid
+     * whose cells are mapped to buckets by hashing, so only edges sharing a
+     * bucket are tested for crossings. For every edge, the number of edges
+     * crossing it is stored; moving a node only requires to test the
+     * incident edges at their new positions, and if the move is taken, to
+     * update the crossing numbers and to move the incident edges in the
+     * grid. The side length of the cells follows the average edge length;
+     * the grid is rebuilt when the average edge length has changed too
+     * much. Candidates can be evaluated concurrently, since every thread
+     * uses its own query data.
+     */
     class Planarity: public EnergyFunction
     {
     public:
@@ -70,44 +83,93 @@ namespace ogdf
         //! Computes energy of initial layout and stores it in \a m_energy.
         void computeEnergy();
 
+        //! Allocates the query data for \a numThreads threads.
+        bool prepareConcurrentCandidates(int numThreads);
+
+        //! Computes the energy if \a v moves to \a newPos using the query data of thread \a t.
+        double concurrentCandidateEnergy(const node v, const DPoint & newPos, int t) const;
+
+        //! Returns the number of edges crossing \a e in the current layout (0 for self loops).
+        int crossings(edge e) const
+        {
+            return (m_edgeNums[e] < 0) ? 0 : m_crossings[m_edgeNums[e]];
+        }
+
     private:
-        struct ChangedCrossing
+        //! The data of a query for the edges crossing a segment.
+        struct Query
         {
-            int edgeNum1;
-            int edgeNum2;
-            bool cross;
+            Array<int>       m_visited; //!< stamp of the last query visiting each edge
+            int              m_stamp;   //!< stamp of the current query
+            ArrayBuffer<int> m_buckets; //!< buckets of the current query
+
+            Query() : m_stamp(0) { }
+
+            //! Prepares the query data for \a e_num edges.
+            void init(int e_num)
+            {
+                m_visited.init(0, e_num - 1, 0);
+                m_stamp = 0;
+            }
         };
 
-        //! Returns 1 if edges cross else 0.
-        bool intersect(const edge, const edge) const;
-
         //! Computes energy of candidate.
         void compCandEnergy();
 
         //! Changes internal data if candidate is taken.
         void internalCandidateTaken();
 
-        //! Releases memory allocated for \a m_candidateCrossings.
-        void clearCandidateCrossings();
-
         //! Tests if two lines given by four points intersect.
         bool lowLevelIntersect(const DPoint &, const DPoint &, const DPoint &,
                                const DPoint &) const;
 
-#ifdef OGDF_DEBUG
-        virtual void printInternalData() const;
-#endif
+        //! Returns the energy if \a v moves to \a newPos using the query data \a q.
+        double candidateEnergy(const node v, const DPoint & newPos, Query & q) const;
 
-        EdgeArray<int>* m_edgeNums; //!< numbers of edges
-        Array2D<bool>* m_crossingMatrix; //!< stores for each pair of edges if they cross
+        //! Returns the number of edges crossing edge \a e if it is drawn from \a s to \a t.
+        /**
+         * If \a crossing is not 0, the numbers of these edges are appended to it.
+         */
+        int countCrossings(int e, const DPoint & s, const DPoint & t, Query & q,
+                           ArrayBuffer<int>* crossing) const;
 
+        //! Returns the number of edges crossing edge \a e if it is drawn from \a s to \a t.
         /**
-         * stores for all edges incident to the test node
-         * an array with the crossings that change if the candidate position is chosen
+         * Adds \a delta to the crossing numbers of these edges.
          */
-        List<ChangedCrossing> m_crossingChanges;
+        int countCrossings(int e, const DPoint & s, const DPoint & t, int delta);
+
+        //! Chooses the cell size and inserts all edges into the grid.
+        void buildGrid();
+
+        //! Appends the buckets of all cells the segment from \a s to \a t may cross to \a buckets.
+        void collectBuckets(const DPoint & s, const DPoint & t, ArrayBuffer<int> & buckets) const;
+
+        //! Inserts edge \a e into the buckets of its segment.
+        void insertSegment(int e);
+
+        //! Removes edge \a e from the buckets of its segment.
+        void removeSegment(int e);
+
+#ifdef OGDF_DEBUG
+        virtual void printInternalData() const;
+#endif
 
-        List<edge> m_nonSelfLoops; //!< list of edges that are not slef loops
+        EdgeArray<int> m_edgeNums;   //!< numbers of edges (-1 for self loops)
+        Array<edge>    m_edges;      //!< edges that are not self loops, by number
+        Array<DPoint>  m_source;     //!< source point of the segment of each edge in the grid
+        Array<DPoint>  m_target;     //!< target point of the segment of each edge in the grid
+        Array<int>     m_crossings;  //!< number of edges crossing each edge
+
+        double m_cellSize;    //!< side length of the grid cells
+        int    m_bucketMask;  //!< number of buckets - 1 (a power of two - 1)
+        Array<ArrayBuffer<int>> m_buckets; //!< numbers of the edges crossing the cells of each bucket
+        double m_lengthSum;   //!< sum of the lengths of all segments
+        int    m_movesSinceBuild; //!< number of taken candidates since the grid was built
+
+        Query            m_query;    //!< query data of sequential queries
+        ArrayBuffer<int> m_crossing; //!< edges found by the current sequential query
+        mutable Array<Query> m_threadQueries; //!< query data of concurrent candidate evaluations
     }; // class Planarity
 
 
@@ -72,6 +72,14 @@ namespace ogdf
 
 
         //! The main call to the algorithm. AG should have nodeGraphics and EdgeGraphics attributes enabled.
+        /**
+         * The node-edge forces and the zones of the nodes are computed with a
+         * uniform grid over the node positions and edge segments, which is rebuilt
+         * in every iteration. The forces and zones are computed from the edges
+         * within the range of the node-edge force (4 * reqlength()). Farther edges
+         * could only limit the zones to more than a third of this range, so only
+         * the nodes moving farther search them, within a doubling radius.
+         */
         void call(GraphAttributes & AG);
 
 
@@ -105,6 +113,18 @@ namespace ogdf
             return req_length;
         }
 
+        //! Sets the number of threads computing the forces and moves of the nodes
+        void setNumberOfThreads(int number)
+        {
+            m_numberOfThreads = max(1, number);
+        }
+
+        //! Returns the number of threads
+        int numberOfThreads()
+        {
+            return m_numberOfThreads;
+        }
+
         /** Set the initPositions of nodes. Must for graphs without node attributes
         * c accepts character arguments:
         * 'm' for Grid-like Layout of nodes
@@ -124,30 +144,6 @@ namespace ogdf
 
     protected:
 
-        //! Calculates the repulsive force on node v due to node j and adds it to total force on v
-        void f_Node_Repulsive(node* v, node* j, GraphAttributes & AG);
-
-        //! Calculates the attractive force on node v due to node j and adds it to total force on v
-        void f_Node_Attractive(node* v, node* j, GraphAttributes & AG);
-
-        //! Computes the projection of node v on the edge (a,b)
-        void compute_I(node* v, edge* e, GraphAttributes & AG);
-
-        //! Returns true if node i lies on the edge (a,b)
-        bool i_On_Edge(edge* e, GraphAttributes & AG);
-
-        //! Calculates the repulsive force on node v due to the edge on which node i lies and adds it to total force on v
-        void f_Edge(node* v, edge* e, GraphAttributes & AG);
-
-        //! Calculates the radii of the zones of node v if node i lies on edge (a,b)
-        void r_Calc_On_Edge(node* v, edge* e, GraphAttributes & AG);
-
-        //! Calculates the radii of the zones of node v if node i does not lie on edge (a,b)
-        void r_Calc_Outside_Edge(node* v, edge* e, GraphAttributes & AG);
-
-        //! Moves the node v according to the forces Fx and Fy on it. Also ensures that movement is within the respective zones
-        void move(node* v, GraphAttributes & AG);
-
         //! Objects of this class are members of the containment heirarchy made in preprocessing stage of ImPrEd
         class CCElement
         {
@@ -170,22 +166,6 @@ namespace ogdf
 
 
     private:
-        //! The sections associated with each node
-        class BertaultSections
-        {
-        public:
-            double R[9];                    //! Ri is radius of ith section
-
-            //! Radii are initialised to numeric_limits<double>::max() at the start
-            void initialize()
-            {
-                int i;
-                for(i = 0; i < 9; i++)
-                    R[i] = numeric_limits<double>::max();
-            }
-        };
-
-
         //! preprocessing for ImPrEd
         void preprocess(GraphAttributes & AG);
 
@@ -204,20 +184,12 @@ namespace ogdf
         //! Computes the surrounding edges from the data calculated so far
         void compute(CCElement* element, PlanRep & PG, GraphAttributes & AG1, GraphCopy & G1);
 
-        //! a structure which stores the projection of a node on an edge
-        struct proj
-        {
-            double x;
-            double y;
-        } i;
-        NodeArray<BertaultSections> sect;               //! Sections associated with all nodes
-        NodeArray<double> F_x;                  //! Force in x direction
-        NodeArray<double> F_y;                      //! Force in y direction
         double req_length;                  //! req_length is the required edge length
         double limit;                       //! limit is the max distance (between node and its projection) at which the edge force on node is considered
         int iter_no;                        //! number of iterations to be performed
         bool impred;                        //! sets the algorithm to ImPrEd when true
         Array2D<bool> surr;                 //! stores the indices of the surrounding edges for each node
+        int m_numberOfThreads;              //! number of threads computing the forces and moves
 
         OGDF_NEW_DELETE
     }; //class BertaultLayout
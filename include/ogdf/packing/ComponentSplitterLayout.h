@@ -71,6 +71,17 @@ namespace ogdf
         int m_numberOfComponents;
         double m_targetRatio;
         int m_border;
+        bool m_reuseIsomorphic;
+
+        // for each connected component the component whose layout is reused
+        // (the component itself if it is laid out), up to date only in call method
+        Array<int> m_shapeOf;
+        // for each node the corresponding node in the component whose layout is reused
+        NodeArray<node> m_twin;
+
+        //! Groups isomorphic components (with equal node sizes) and fills
+        //! m_shapeOf and m_twin.
+        void findIsomorphicComponents(const GraphAttributes & GA);
 
         //! Combines drawings of connected components to
         //! a single drawing by rotating components and packing
@@ -91,6 +102,31 @@ namespace ogdf
         {
             m_packer.set(packer);
         }
+
+        //! Returns whether the layout of a component is reused for isomorphic components.
+        bool reuseIsomorphicComponents() const
+        {
+            return m_reuseIsomorphic;
+        }
+
+        //! Sets whether the layout of a component is reused for isomorphic components.
+        /**
+         * If enabled (disabled by default), the secondary layout is called only once for
+         * each set of isomorphic components with equal node sizes (and edge
+         * weights, if present); the other components of the set get a copy of
+         * that drawing before the packer is called. Isomorphism respects edge
+         * directions. Trees are compared by canonical codes; other components
+         * by a bounded backtracking search, so that some isomorphic pairs may
+         * be laid out twice.
+         *
+         * Only node coordinates (x, y and z) are copied; node sizes are equal
+         * within a set anyway, and edge bends are not transferred back from
+         * the secondary layout in either case.
+         */
+        void setReuseIsomorphicComponents(bool on)
+        {
+            m_reuseIsomorphic = on;
+        }
     };
 
 } // namespace ogdf
@@ -0,0 +1,284 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Implementation of classes StringTable and CompactGraphAttributes.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#include <ogdf/basic/CompactGraphAttributes.h>
+
+
+namespace ogdf
+{
+
+    //---------------------------------------------------------
+    // StringTable
+    //---------------------------------------------------------
+
+    StringTable::StringTable()
+    {
+        m_strings.push(&m_ids.fastInsert(string(), 0)->key());
+    }
+
+
+    StringTable::StringTable(const StringTable & table)
+    {
+        m_strings.push(&m_ids.fastInsert(string(), 0)->key());
+        for(int id = 1; id < table.size(); ++id)
+            intern(table[id]);
+    }
+
+
+    StringTable & StringTable::operator=(const StringTable & table)
+    {
+        if(&table != this)
+        {
+            clear();
+            for(int id = 1; id < table.size(); ++id)
+                intern(table[id]);
+        }
+        return *this;
+    }
+
+
+    int StringTable::intern(const string & str)
+    {
+        HashElement<string, int>* it = m_ids.lookup(str);
+        if(it != 0)
+            return it->info();
+
+        int id = m_strings.size();
+        m_strings.push(&m_ids.fastInsert(str, id)->key());
+        return id;
+    }
+
+
+    int StringTable::lookup(const string & str) const
+    {
+        HashElement<string, int>* it = m_ids.lookup(str);
+        return (it != 0) ? it->info() : -1;
+    }
+
+
+    void StringTable::clear()
+    {
+        m_strings.clear();
+        m_ids.clear();
+
+        m_strings.push(&m_ids.fastInsert(string(), 0)->key());
+    }
+
+
+    //---------------------------------------------------------
+    // CompactGraphAttributes
+    //---------------------------------------------------------
+
+    CompactGraphAttributes::CompactGraphAttributes() : m_pGraph(0), m_attributes(0) { }
+
+
+    CompactGraphAttributes::CompactGraphAttributes(const Graph & G, long initAttr) :
+        m_pGraph(&G), m_attributes(0)
+    {
+        initAttributes(initAttr);
+    }
+
+
+    void CompactGraphAttributes::init(const Graph & G, long initAttr)
+    {
+        destroyAttributes(m_attributes);
+        m_strings.clear();
+
+        m_pGraph = &G;
+        initAttributes(initAttr);
+    }
+
+
+    void CompactGraphAttributes::initAttributes(long attr)
+    {
+        attr &= supportedAttributes;
+        m_attributes |= attr;
+
+        if(attr & GraphAttributes::nodeGraphics)
+        {
+            m_xy    .init(*m_pGraph, FPoint(0.0f, 0.0f));
+            m_width .init(*m_pGraph, float(LayoutStandards::defaultNodeWidth()));
+            m_height.init(*m_pGraph, float(LayoutStandards::defaultNodeHeight()));
+        }
+        if(attr & GraphAttributes::nodeLabel)
+        {
+            m_nodeLabel.init(*m_pGraph, 0);
+        }
+        if(attr & GraphAttributes::nodeTemplate)
+        {
+            m_nodeTemplate.init(*m_pGraph, 0);
+        }
+        if(attr & GraphAttributes::edgeLabel)
+        {
+            m_edgeLabel.init(*m_pGraph, 0);
+        }
+    }
+
+
+    void CompactGraphAttributes::destroyAttributes(long attr)
+    {
+        m_attributes &= ~attr;
+
+        if(attr & GraphAttributes::nodeGraphics)
+        {
+            m_xy    .init();
+            m_width .init();
+            m_height.init();
+        }
+        if(attr & GraphAttributes::nodeLabel)
+        {
+            m_nodeLabel.init();
+        }
+        if(attr & GraphAttributes::nodeTemplate)
+        {
+            m_nodeTemplate.init();
+        }
+        if(attr & GraphAttributes::edgeLabel)
+        {
+            m_edgeLabel.init();
+        }
+    }
+
+
+    const float* CompactGraphAttributes::coordinateData() const
+    {
+        OGDF_ASSERT(m_xy.valid());
+        return &m_xy[0].m_x;
+    }
+
+
+    const DRect CompactGraphAttributes::boundingBox() const
+    {
+        node v = m_pGraph->firstNode();
+        if(v == 0)
+            return DRect(0.0, 0.0, 0.0, 0.0);
+
+        float minx = m_xy[v].m_x - m_width[v] / 2, maxx = m_xy[v].m_x + m_width[v] / 2;
+        float miny = m_xy[v].m_y - m_height[v] / 2, maxy = m_xy[v].m_y + m_height[v] / 2;
+
+        for(v = v->succ(); v != 0; v = v->succ())
+        {
+            float x1 = m_xy[v].m_x - m_width[v] / 2;
+            float x2 = m_xy[v].m_x + m_width[v] / 2;
+            float y1 = m_xy[v].m_y - m_height[v] / 2;
+            float y2 = m_xy[v].m_y + m_height[v] / 2;
+
+            if(x1 < minx) minx = x1;
+            if(x2 > maxx) maxx = x2;
+            if(y1 < miny) miny = y1;
+            if(y2 > maxy) maxy = y2;
+        }
+
+        return DRect(minx, miny, maxx, maxy);
+    }
+
+
+    void CompactGraphAttributes::transferFrom(const GraphAttributes & GA)
+    {
+        OGDF_ASSERT(&GA.constGraph() == m_pGraph);
+
+        const long attr = m_attributes & GA.attributes();
+        node v;
+        edge e;
+
+        if(attr & GraphAttributes::nodeGraphics)
+        {
+            forall_nodes(v, *m_pGraph)
+            {
+                m_xy[v]     = FPoint(float(GA.x(v)), float(GA.y(v)));
+                m_width[v]  = float(GA.width(v));
+                m_height[v] = float(GA.height(v));
+            }
+        }
+        if(attr & GraphAttributes::nodeLabel)
+        {
+            forall_nodes(v, *m_pGraph)
+                m_nodeLabel[v] = m_strings.intern(GA.label(v));
+        }
+        if(attr & GraphAttributes::nodeTemplate)
+        {
+            forall_nodes(v, *m_pGraph)
+                m_nodeTemplate[v] = m_strings.intern(GA.templateNode(v));
+        }
+        if(attr & GraphAttributes::edgeLabel)
+        {
+            forall_edges(e, *m_pGraph)
+                m_edgeLabel[e] = m_strings.intern(GA.label(e));
+        }
+    }
+
+
+    void CompactGraphAttributes::transferTo(GraphAttributes & GA) const
+    {
+        OGDF_ASSERT(&GA.constGraph() == m_pGraph);
+
+        const long attr = m_attributes & GA.attributes();
+        node v;
+        edge e;
+
+        if(attr & GraphAttributes::nodeGraphics)
+        {
+            forall_nodes(v, *m_pGraph)
+            {
+                GA.x(v)      = m_xy[v].m_x;
+                GA.y(v)      = m_xy[v].m_y;
+                GA.width(v)  = m_width[v];
+                GA.height(v) = m_height[v];
+            }
+        }
+        if(attr & GraphAttributes::nodeLabel)
+        {
+            forall_nodes(v, *m_pGraph)
+                GA.label(v) = m_strings[m_nodeLabel[v]];
+        }
+        if(attr & GraphAttributes::nodeTemplate)
+        {
+            forall_nodes(v, *m_pGraph)
+                GA.templateNode(v) = m_strings[m_nodeTemplate[v]];
+        }
+        if(attr & GraphAttributes::edgeLabel)
+        {
+            forall_edges(e, *m_pGraph)
+                GA.label(e) = m_strings[m_edgeLabel[e]];
+        }
+    }
+
+} // end namespace ogdf
@@ -0,0 +1,166 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Implementation of structural hash functions for graphs
+ *        and graph attributes.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#include <ogdf/basic/GraphFingerprint.h>
+#include <cstring>
+
+
+namespace ogdf
+{
+
+    // Accumulates 64-bit words into a hash value (FNV-1a on words,
+    // followed by a final avalanche step).
+    class FingerprintHasher
+    {
+        __uint64 m_h;
+
+    public:
+        FingerprintHasher() : m_h(14695981039346656037ULL) { }
+
+        void add(__uint64 x)
+        {
+            m_h ^= x;
+            m_h *= 1099511628211ULL;
+        }
+
+        void add(double d)
+        {
+            if(d == 0.0) d = 0.0; // identify -0.0 and 0.0
+            __uint64 x;
+            memcpy(&x, &d, sizeof(x));
+            add(x);
+        }
+
+        __uint64 value() const
+        {
+            __uint64 h = m_h;
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+            return h;
+        }
+    };
+
+
+    // hashes the structure of G; pos receives the position of each node
+    static void hashStructure(const Graph & G, FingerprintHasher & h, NodeArray<int> & pos)
+    {
+        pos.init(G);
+
+        int i = 0;
+        node v;
+        forall_nodes(v, G)
+            pos[v] = i++;
+
+        h.add(__uint64(G.numberOfNodes()));
+        h.add(__uint64(G.numberOfEdges()));
+
+        edge e;
+        forall_edges(e, G)
+            h.add((__uint64(pos[e->source()]) << 32) | __uint64(pos[e->target()]));
+    }
+
+
+    __uint64 graphFingerprint(const Graph & G)
+    {
+        FingerprintHasher h;
+        NodeArray<int> pos;
+        hashStructure(G, h, pos);
+
+        return h.value();
+    }
+
+
+    __uint64 graphFingerprint(const GraphAttributes & GA, long attributes)
+    {
+        const Graph & G = GA.constGraph();
+
+        FingerprintHasher h;
+        NodeArray<int> pos;
+        hashStructure(G, h, pos);
+
+        const long attr = attributes & GA.attributes() & fingerprintAttributes;
+        h.add(__uint64(attr));
+
+        node v;
+        edge e;
+
+        if(attr & GraphAttributes::nodeGraphics)
+        {
+            forall_nodes(v, G)
+            {
+                h.add(GA.width(v));
+                h.add(GA.height(v));
+            }
+        }
+        if(attr & GraphAttributes::nodeWeight)
+        {
+            forall_nodes(v, G)
+                h.add(__uint64(GA.weight(v)));
+        }
+        if(attr & GraphAttributes::nodeType)
+        {
+            forall_nodes(v, G)
+                h.add(__uint64(GA.type(v)));
+        }
+        if(attr & GraphAttributes::edgeIntWeight)
+        {
+            forall_edges(e, G)
+                h.add(__uint64(GA.intWeight(e)));
+        }
+        if(attr & GraphAttributes::edgeDoubleWeight)
+        {
+            forall_edges(e, G)
+                h.add(GA.doubleWeight(e));
+        }
+        if(attr & GraphAttributes::edgeType)
+        {
+            forall_edges(e, G)
+                h.add(__uint64(GA.type(e)));
+        }
+
+        return h.value();
+    }
+
+} // end namespace ogdf
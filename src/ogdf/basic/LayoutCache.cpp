@@ -0,0 +1,447 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Implementation of class LayoutCache.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#include <ogdf/basic/LayoutCache.h>
+#include <cstring>
+
+
+namespace ogdf
+{
+
+    //! A stored layout; nodes and edges are identified by their list positions.
+    struct LayoutCache::Entry
+    {
+        string   m_moduleKey;
+        __uint64 m_fingerprint;
+        int      m_n, m_m;
+
+        Array<double> m_x, m_y;    //!< coordinates of the nodes
+        Array<int>    m_bendStart; //!< bends of edge i are m_bends[m_bendStart[i]..m_bendStart[i+1]-1]
+        Array<DPoint> m_bends;     //!< bend points (if m_bendStart is not empty)
+
+        ListIterator<Entry*> m_it; //!< position in LayoutCache::m_order
+
+        bool hasBends() const
+        {
+            return m_bendStart.size() > 0;
+        }
+
+        OGDF_NEW_DELETE
+    };
+
+
+    static const char s_magic[8] = { 'O', 'G', 'D', 'F', 'L', 'Y', 'C', '1' };
+
+
+    LayoutCache::LayoutCache() :
+        m_maxEntries(1024), m_attributes(fingerprintAttributes), m_hits(0), m_misses(0)
+    { }
+
+
+    LayoutCache::~LayoutCache()
+    {
+        clear();
+    }
+
+
+    void LayoutCache::setLayoutModule(LayoutModule* pLayout, const string & moduleKey)
+    {
+        OGDF_ASSERT(pLayout == 0 || !moduleKey.empty());
+        m_layout.set(pLayout);
+        m_moduleKey = moduleKey;
+    }
+
+
+    void LayoutCache::setModuleKey(const string & moduleKey)
+    {
+        OGDF_ASSERT(!moduleKey.empty());
+        m_moduleKey = moduleKey;
+    }
+
+
+    void LayoutCache::maxEntries(int n)
+    {
+        OGDF_ASSERT(n >= 1);
+        m_maxEntries = max(n, 1);
+
+        while(m_order.size() > m_maxEntries)
+        {
+            Entry* pEntry = m_order.popFrontRet();
+            m_entries.del(keyHash(pEntry->m_moduleKey, pEntry->m_fingerprint));
+            delete pEntry;
+        }
+    }
+
+
+    void LayoutCache::clear()
+    {
+        ListConstIterator<Entry*> it;
+        for(it = m_order.begin(); it.valid(); ++it)
+            delete *it;
+
+        m_order.clear();
+        m_entries.clear();
+        m_hits = m_misses = 0;
+    }
+
+
+    __uint64 LayoutCache::keyHash(const string & moduleKey, __uint64 fingerprint)
+    {
+        __uint64 h = 14695981039346656037ULL;
+        for(string::size_type i = 0; i < moduleKey.size(); ++i)
+        {
+            h ^= (unsigned char)moduleKey[i];
+            h *= 1099511628211ULL;
+        }
+        return h ^ fingerprint;
+    }
+
+
+    LayoutCache::Entry* LayoutCache::lookup(
+        const string & moduleKey,
+        __uint64 fingerprint,
+        const Graph & G) const
+    {
+        HashElement<__uint64, Entry*>* it = m_entries.lookup(keyHash(moduleKey, fingerprint));
+        if(it == 0)
+            return 0;
+
+        // the key hash may collide; compare the complete key
+        Entry* pEntry = it->info();
+        if(pEntry->m_fingerprint != fingerprint || pEntry->m_moduleKey != moduleKey
+                || pEntry->m_n != G.numberOfNodes() || pEntry->m_m != G.numberOfEdges())
+            return 0;
+
+        return pEntry;
+    }
+
+
+    void LayoutCache::insert(Entry* pEntry)
+    {
+        const __uint64 key = keyHash(pEntry->m_moduleKey, pEntry->m_fingerprint);
+
+        // replace an entry with the same key hash
+        HashElement<__uint64, Entry*>* it = m_entries.lookup(key);
+        if(it != 0)
+        {
+            m_order.del(it->info()->m_it);
+            delete it->info();
+            m_entries.del(key);
+        }
+        else if(m_order.size() >= m_maxEntries)
+        {
+            Entry* pOldest = m_order.popFrontRet();
+            m_entries.del(keyHash(pOldest->m_moduleKey, pOldest->m_fingerprint));
+            delete pOldest;
+        }
+
+        pEntry->m_it = m_order.pushBack(pEntry);
+        m_entries.fastInsert(key, pEntry);
+    }
+
+
+    void LayoutCache::call(GraphAttributes & GA)
+    {
+        if(!m_layout.valid())
+            return;
+
+        const Graph & G = GA.constGraph();
+        const bool withBends = (GA.attributes() & GraphAttributes::edgeGraphics) != 0;
+        const __uint64 fingerprint = graphFingerprint(GA, m_attributes);
+
+        node v;
+        edge e;
+        int i;
+
+        Entry* pEntry = lookup(m_moduleKey, fingerprint, G);
+        if(pEntry != 0 && (pEntry->hasBends() || !withBends))
+        {
+            ++m_hits;
+
+            i = 0;
+            forall_nodes(v, G)
+            {
+                GA.x(v) = pEntry->m_x[i];
+                GA.y(v) = pEntry->m_y[i];
+                ++i;
+            }
+
+            if(withBends)
+            {
+                i = 0;
+                forall_edges(e, G)
+                {
+                    DPolyline & dpl = GA.bends(e);
+                    dpl.clear();
+                    for(int k = pEntry->m_bendStart[i]; k < pEntry->m_bendStart[i + 1]; ++k)
+                        dpl.pushBack(pEntry->m_bends[k]);
+                    ++i;
+                }
+            }
+            return;
+        }
+
+        ++m_misses;
+        m_layout.get().call(GA);
+
+        // store the result
+        pEntry = new Entry;
+        pEntry->m_moduleKey   = m_moduleKey;
+        pEntry->m_fingerprint = fingerprint;
+        pEntry->m_n = G.numberOfNodes();
+        pEntry->m_m = G.numberOfEdges();
+
+        pEntry->m_x.init(pEntry->m_n);
+        pEntry->m_y.init(pEntry->m_n);
+        i = 0;
+        forall_nodes(v, G)
+        {
+            pEntry->m_x[i] = GA.x(v);
+            pEntry->m_y[i] = GA.y(v);
+            ++i;
+        }
+
+        if(withBends)
+        {
+            int numBends = 0;
+            forall_edges(e, G)
+                numBends += GA.bends(e).size();
+
+            pEntry->m_bendStart.init(pEntry->m_m + 1);
+            pEntry->m_bends.init(numBends);
+
+            i = 0;
+            int k = 0;
+            forall_edges(e, G)
+            {
+                pEntry->m_bendStart[i++] = k;
+                ListConstIterator<DPoint> it;
+                for(it = GA.bends(e).begin(); it.valid(); ++it, ++k)
+                {
+                    pEntry->m_bends[k].m_x = (*it).m_x;
+                    pEntry->m_bends[k].m_y = (*it).m_y;
+                }
+            }
+            pEntry->m_bendStart[i] = k;
+        }
+
+        insert(pEntry);
+    }
+
+
+    //---------------------------------------------------------
+    // binary snapshots
+    //---------------------------------------------------------
+    // All values are written in the native byte order of the machine.
+
+    template<class T>
+    static inline void writeValue(ostream & os, const T & x)
+    {
+        os.write(reinterpret_cast<const char*>(&x), sizeof(T));
+    }
+
+    template<class T>
+    static inline bool readValue(istream & is, T & x)
+    {
+        is.read(reinterpret_cast<char*>(&x), sizeof(T));
+        return is.good();
+    }
+
+    template<class T>
+    static inline void writeArray(ostream & os, const Array<T> & a)
+    {
+        if(a.size() > 0)
+            os.write(reinterpret_cast<const char*>(&a[0]), a.size() * sizeof(T));
+    }
+
+    // The counts in a stream are not trusted: arrays are read in blocks and only
+    // grow by the values actually read, so a corrupted count cannot allocate
+    // much more memory than the stream holds.
+    static const int s_blockSize = 1 << 16;
+
+    // grows a (of current size k < n) for reading the values k,...
+    template<class T>
+    static inline void growForRead(Array<T> & a, int k, int n)
+    {
+        if(k == 0)
+            a.init(min(n, s_blockSize));
+        else if(k == a.size())
+            a.grow(min(n - k, k));
+    }
+
+    template<class T>
+    static inline bool readArray(istream & is, Array<T> & a, int n)
+    {
+        a.init();
+        for(int k = 0; k < n; )
+        {
+            growForRead(a, k, n);
+            const int num = a.size() - k;
+            is.read(reinterpret_cast<char*>(&a[k]), std::streamsize(num) * sizeof(T));
+            if(!is.good())
+                return false;
+            k += num;
+        }
+        return is.good();
+    }
+
+    static bool readString(istream & is, string & s, int len)
+    {
+        s.clear();
+        char buffer[4096];
+        while(len > 0)
+        {
+            const int num = min(len, int(sizeof(buffer)));
+            is.read(buffer, num);
+            if(!is.good())
+                return false;
+            s.append(buffer, num);
+            len -= num;
+        }
+        return true;
+    }
+
+
+    // the bends of an edge are a range of the bend array; the ranges have to be
+    // consecutive and cover the whole array
+    static bool validBendStart(const Array<int> & bendStart, int numBends)
+    {
+        if(bendStart[0] != 0 || bendStart[bendStart.high()] != numBends)
+            return false;
+
+        for(int i = 0; i < bendStart.high(); ++i)
+        {
+            if(bendStart[i] > bendStart[i + 1])
+                return false;
+        }
+        return true;
+    }
+
+
+    bool LayoutCache::save(ostream & os) const
+    {
+        os.write(s_magic, sizeof(s_magic));
+        writeValue(os, __int32(m_order.size()));
+
+        ListConstIterator<Entry*> it;
+        for(it = m_order.begin(); it.valid(); ++it)
+        {
+            const Entry & entry = **it;
+
+            writeValue(os, __int32(entry.m_moduleKey.size()));
+            os.write(entry.m_moduleKey.data(), entry.m_moduleKey.size());
+            writeValue(os, entry.m_fingerprint);
+            writeValue(os, __int32(entry.m_n));
+            writeValue(os, __int32(entry.m_m));
+            writeArray(os, entry.m_x);
+            writeArray(os, entry.m_y);
+
+            writeValue(os, __int32(entry.m_bends.size()));
+            writeValue(os, __int32(entry.hasBends() ? 1 : 0));
+            if(entry.hasBends())
+            {
+                writeArray(os, entry.m_bendStart);
+                for(int k = 0; k < entry.m_bends.size(); ++k)
+                {
+                    writeValue(os, entry.m_bends[k].m_x);
+                    writeValue(os, entry.m_bends[k].m_y);
+                }
+            }
+        }
+
+        return os.good();
+    }
+
+
+    bool LayoutCache::load(istream & is)
+    {
+        char magic[sizeof(s_magic)];
+        is.read(magic, sizeof(magic));
+        if(!is.good() || memcmp(magic, s_magic, sizeof(s_magic)) != 0)
+            return false;
+
+        __int32 count;
+        if(!readValue(is, count) || count < 0)
+            return false;
+
+        for(; count > 0; --count)
+        {
+            __int32 len, n, m, numBends, hasBends;
+            if(!readValue(is, len) || len < 0)
+                return false;
+
+            // m + 1 bend ranges are stored
+            Entry* pEntry = new Entry;
+            bool ok = readString(is, pEntry->m_moduleKey, len)
+                      && readValue(is, pEntry->m_fingerprint)
+                      && readValue(is, n) && readValue(is, m) && n >= 0 && m >= 0
+                      && m < numeric_limits<__int32>::max()
+                      && readArray(is, pEntry->m_x, n)
+                      && readArray(is, pEntry->m_y, n)
+                      && readValue(is, numBends) && readValue(is, hasBends) && numBends >= 0;
+
+            if(ok && hasBends)
+            {
+                ok = readArray(is, pEntry->m_bendStart, m + 1) && validBendStart(pEntry->m_bendStart, numBends);
+                for(int k = 0; ok && k < numBends; ++k)
+                {
+                    growForRead(pEntry->m_bends, k, numBends);
+                    ok = readValue(is, pEntry->m_bends[k].m_x) && readValue(is, pEntry->m_bends[k].m_y);
+                }
+            }
+            else if(ok)
+                ok = (hasBends == 0 && numBends == 0);
+
+            if(!ok)
+            {
+                delete pEntry;
+                return false;
+            }
+
+            pEntry->m_n = n;
+            pEntry->m_m = m;
+            insert(pEntry);
+        }
+
+        return true;
+    }
+
+} // end namespace ogdf
@@ -0,0 +1,116 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Implementation of class SIMD.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+
+#include <ogdf/basic/SIMD.h>
+#include <ogdf/internal/basic/intrinsics.h>
+
+
+namespace ogdf
+{
+
+    SIMDLevel SIMD::s_level;
+    SIMDLevel SIMD::s_supportedLevel;
+
+
+    static const char* const simdLevelNames[simdNumberOfLevels] =
+    {
+        "scalar", "sse2", "sse3", "avx2", "avx512"
+    };
+
+
+    void SIMD::init()
+    {
+        s_supportedLevel = simdScalar;
+
+#ifdef OGDF_SSE2_EXTENSIONS
+        if(System::cpuSupports(cpufSSE2))
+            s_supportedLevel = simdSSE2;
+#endif
+#ifdef OGDF_SSE3_EXTENSIONS
+        if(System::cpuSupports(cpufSSE3))
+            s_supportedLevel = simdSSE3;
+#endif
+#ifdef OGDF_AVX2_EXTENSIONS
+        if(System::cpuSupports(cpufAVX2) && System::cpuSupports(cpufFMA))
+            s_supportedLevel = simdAVX2;
+#endif
+#ifdef OGDF_AVX512_EXTENSIONS
+        if(s_supportedLevel == simdAVX2 && System::cpuSupports(cpufAVX512F))
+            s_supportedLevel = simdAVX512;
+#endif
+
+        s_level = s_supportedLevel;
+
+        SIMDLevel level;
+        const char* str = getenv("OGDF_SIMD");
+        if(str != 0 && fromName(str, level))
+            maxLevel(level);
+    }
+
+
+    SIMDLevel SIMD::maxLevel(SIMDLevel maxLevel)
+    {
+        s_level = min(maxLevel, s_supportedLevel);
+        return s_level;
+    }
+
+
+    const char* SIMD::name(SIMDLevel level)
+    {
+        return simdLevelNames[level];
+    }
+
+
+    bool SIMD::fromName(const char* str, SIMDLevel & level)
+    {
+        for(int l = simdScalar; l < simdNumberOfLevels; ++l)
+        {
+            if(equalIgnoreCase(str, simdLevelNames[l]))
+            {
+                level = SIMDLevel(l);
+                return true;
+            }
+        }
+        return false;
+    }
+
+} // end namespace ogdf
@@ -95,9 +95,30 @@ static void __cpuid(int CPUInfo[4], int infoType)
     CPUInfo[2] = c;
     CPUInfo[3] = d;
 }
+
+static void __cpuidex(int CPUInfo[4], int infoType, int subInfoType)
+{
+    CPUInfo[2] = subInfoType;
+    __cpuid(CPUInfo, infoType);
+}
 #endif
 
 
+// returns the extended control register XCR0; may only be called if cpuid reports OSXSAVE
+static __uint64 xgetbv0()
+{
+#if defined(_MSC_VER) && (_MSC_FULL_VER >= 160040219)
+    return _xgetbv(0);
+#elif (defined(OGDF_SYSTEM_UNIX) || defined(__MINGW32__)) && (defined(__i386__) || defined(__x86_64__))
+    uint32_t a, d;
+    __asm__ __volatile__(".byte 0x0f, 0x01, 0xd0" : "=a"(a), "=d"(d) : "c"(0));
+    return ((__uint64)d << 32) | a;
+#else
+    return 0;
+#endif
+}
+
+
 namespace ogdf
 {
 
@@ -144,6 +165,25 @@ namespace ogdf
             if(featureInfoECX & (1 <<  6)) s_cpuFeatures |= cpufmSMX;
             if(featureInfoECX & (1 <<  7)) s_cpuFeatures |= cpufmEST;
             if(featureInfoECX & (1 <<  3)) s_cpuFeatures |= cpufmMONITOR;
+
+            // AVX requires that the OS saves the XMM/YMM registers (XCR0 bits 1 and 2),
+            // AVX-512 additionally the opmask and ZMM registers (XCR0 bits 5 to 7)
+            __uint64 xcr0 = (featureInfoECX & (1 << 27)) ? xgetbv0() : 0;
+            bool osAVX    = (xcr0 & 0x06) == 0x06;
+            bool osAVX512 = (xcr0 & 0xe6) == 0xe6;
+
+            if(osAVX && (featureInfoECX & (1 << 28))) s_cpuFeatures |= cpufmAVX;
+            if(osAVX && (featureInfoECX & (1 << 12))) s_cpuFeatures |= cpufmFMA;
+
+            if(nIds >= 7)
+            {
+                CPUInfo[2] = 0;
+                __cpuidex(CPUInfo, 7, 0);
+
+                int extFeatureInfoEBX = CPUInfo[1];
+                if(osAVX    && (extFeatureInfoEBX & (1 <<  5))) s_cpuFeatures |= cpufmAVX2;
+                if(osAVX512 && (extFeatureInfoEBX & (1 << 16))) s_cpuFeatures |= cpufmAVX512F;
+            }
         }
 
         __cpuid(CPUInfo, 0x80000000);
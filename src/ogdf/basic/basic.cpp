@@ -43,6 +43,7 @@
 
 
 #include <ogdf/basic/Thread.h>
+#include <ogdf/basic/SIMD.h>
 #include <ogdf/basic/List.h>
 #include <time.h>
 
@@ -90,6 +91,7 @@ BOOL APIENTRY DllMain(HANDLE hModule, DWORD  ul_reason_for_call, LPVOID lpReserv
     case DLL_PROCESS_ATTACH:
         ogdf::PoolMemoryAllocator::init();
         ogdf::System::init();
+        ogdf::SIMD::init();
         break;
 
     case DLL_THREAD_ATTACH:
@@ -109,6 +111,7 @@ void __attribute__((constructor)) my_load(void)
 {
     ogdf::PoolMemoryAllocator::init();
     ogdf::System::init();
+    ogdf::SIMD::init();
 }
 
 void __attribute__((destructor)) my_unload(void)
@@ -132,6 +135,7 @@ namespace ogdf
         {
             ogdf::PoolMemoryAllocator::init();
             ogdf::System::init();
+            ogdf::SIMD::init();
 #ifdef OGDF_USE_THREAD_POOL
             ogdf::Thread::initPool();
 #endif
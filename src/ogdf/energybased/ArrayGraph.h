@@ -44,6 +44,7 @@
 #define OGDF_ARRAY_GRAPH_H
 
 #include <ogdf/basic/GraphAttributes.h>
+#include <ogdf/basic/CompactGraphAttributes.h>
 
 namespace ogdf
 {
@@ -101,6 +102,17 @@ namespace ogdf
          */
         void readFrom(const GraphAttributes & GA, const EdgeArray<float> & edgeLength, const NodeArray<float> & nodeSize);
 
+        //! updates an array graph from CompactGraphAttributes with the given edge lenghts and node sizes and creates the edges;
+        /**
+         * The nodes and edges are ordered in the same way like in the Graph instance.
+         * @param CGA the CompactGraphAttributes to read from
+         * @param edgeLength the desired edge length
+         */
+        void readFrom(const CompactGraphAttributes & CGA, const EdgeArray<float> & edgeLength, const NodeArray<float> & nodeSize)
+        {
+            readFrom(CGA.constGraph(), CGA.coordinates(), edgeLength, nodeSize);
+        }
+
         //! updates an array graph with the given positions, edge lenghts and node sizes and creates the edges
         /**
          * The nodes and edges are ordered in the same way like in the Graph instance.
@@ -148,6 +160,55 @@ namespace ogdf
          */
         void writeTo(GraphAttributes & GA);
 
+        //! writes the data back to CompactGraphAttributes
+        void writeTo(CompactGraphAttributes & CGA)
+        {
+            writeTo(CGA.constGraph(), CGA.coordinates());
+        }
+
+        //! updates an array graph with the given interleaved positions, edge lenghts and node sizes and creates the edges
+        template<typename C_T, typename E_T, typename S_T>
+        void readFrom(const Graph & G, const NodeArray<GenericPoint<C_T> > & pos, const EdgeArray<E_T> & edgeLength, const NodeArray<S_T> & nodeSize)
+        {
+            NodeArray<__uint32> nodeIndex(G);
+            node v;
+            m_numNodes = 0;
+            m_numEdges = 0;
+            m_desiredAvgEdgeLength = 0;
+            m_avgNodeSize = 0;
+            forall_nodes(v, G)
+            {
+                m_nodeXPos[m_numNodes] = (float)pos[v].m_x;
+                m_nodeYPos[m_numNodes] = (float)pos[v].m_y;
+                m_nodeSize[m_numNodes] = (float)nodeSize[v];
+                m_avgNodeSize += nodeSize[v];
+                nodeIndex[v] = m_numNodes;
+                m_numNodes++;
+            }
+            m_avgNodeSize = m_avgNodeSize / (double)m_numNodes;
+
+            edge e;
+            forall_edges(e, G)
+            {
+                pushBackEdge(nodeIndex[e->source()], nodeIndex[e->target()], (float)edgeLength[e]);
+            }
+            m_desiredAvgEdgeLength = m_desiredAvgEdgeLength / (double)m_numEdges;
+        }
+
+        //! writes the data back to a node array of interleaved positions
+        template<typename C_T>
+        void writeTo(const Graph & G, NodeArray<GenericPoint<C_T> > & pos)
+        {
+            node v;
+            __uint32 i = 0;
+            forall_nodes(v, G)
+            {
+                pos[v].m_x = (C_T)m_nodeXPos[i];
+                pos[v].m_y = (C_T)m_nodeYPos[i];
+                i++;
+            }
+        }
+
         //! writes the data back to node arrays with the given coordinate type
         /**
          * The function does not require to be the same Graph, only the order of nodes and edges
@@ -49,6 +49,7 @@
 
 #include <ogdf/energybased/DavidsonHarel.h>
 #include <ogdf/basic/Math.h>
+#include <ogdf/basic/ThreadTeam.h>
 #include <time.h>
 
 //TODO: in addition to the layout size, node sizes should be used in
@@ -67,13 +68,119 @@ namespace ogdf
     const double DavidsonHarel::m_coolingFactor = 0.80;  //0.75;ori
     const double DavidsonHarel::m_shrinkFactor = 0.8;
 
+
+    //---------------------------------------------------------
+    // DavidsonHarel::CandidateBatch
+    //---------------------------------------------------------
+
+    //! A batch of candidates whose energies are computed for the same layout.
+    class DavidsonHarel::CandidateBatch
+    {
+    public:
+        CandidateBatch(const List<EnergyFunction*> & functions,
+                       const List<double> & weights,
+                       int batchSize,
+                       int numThreads) :
+            m_numFunctions(functions.size()),
+            m_function(m_numFunctions), m_weight(m_numFunctions), m_concurrent(m_numFunctions),
+            m_size(0),
+            m_node(batchSize), m_pos(batchSize), m_funcEnergy(batchSize * m_numFunctions),
+            m_team(this, numThreads)
+        {
+            ListConstIterator<EnergyFunction*> it = functions.begin();
+            ListConstIterator<double> it2 = weights.begin();
+            for(int f = 0; f < m_numFunctions; ++f, ++it, ++it2)
+            {
+                m_function[f] = *it;
+                m_weight[f] = *it2;
+                m_concurrent[f] = (*it)->prepareConcurrentCandidates(numThreads);
+            }
+        }
+
+        //! Appends the move of \a v to \a newPos to the batch.
+        void push(node v, const DPoint & newPos)
+        {
+            m_node[m_size] = v;
+            m_pos[m_size] = newPos;
+            ++m_size;
+        }
+
+        //! Removes all candidates from the batch.
+        void clear()
+        {
+            m_size = 0;
+        }
+
+        int size() const
+        {
+            return m_size;
+        }
+
+        node candidateNode(int j) const
+        {
+            return m_node[j];
+        }
+
+        const DPoint & candidatePos(int j) const
+        {
+            return m_pos[j];
+        }
+
+        //! Computes the energies of all energy functions for all candidates.
+        void computeEnergies()
+        {
+            m_team.run(&CandidateBatch::energyTask);
+
+            for(int f = 0; f < m_numFunctions; ++f)
+                if(!m_concurrent[f])
+                    for(int j = 0; j < m_size; ++j)
+                        m_funcEnergy[j * m_numFunctions + f] =
+                            m_function[f]->computeCandidateEnergy(m_node[j], m_pos[j]);
+        }
+
+        //! Returns the weighted energy of candidate \a j (summed like in the sequential case).
+        double energy(int j) const
+        {
+            double newEnergy = 0.0;
+            for(int f = 0; f < m_numFunctions; ++f)
+                newEnergy += m_funcEnergy[j * m_numFunctions + f] * m_weight[f];
+            return newEnergy;
+        }
+
+    private:
+        int m_numFunctions;
+        Array<EnergyFunction*> m_function;
+        Array<double> m_weight;
+        Array<bool>   m_concurrent; //!< true if a function supports concurrent evaluation
+
+        int m_size;
+        Array<node>   m_node;
+        Array<DPoint> m_pos;
+        Array<double> m_funcEnergy; //!< the energies of the functions for each candidate
+
+        ThreadTeam<CandidateBatch> m_team;
+
+        void energyTask(int t)
+        {
+            const int numThreads = m_team.numThreads();
+            const int end = threadRangeBegin(m_size, t + 1, numThreads);
+            for(int j = threadRangeBegin(m_size, t, numThreads); j < end; ++j)
+                for(int f = 0; f < m_numFunctions; ++f)
+                    if(m_concurrent[f])
+                        m_funcEnergy[j * m_numFunctions + f] =
+                            m_function[f]->concurrentCandidateEnergy(m_node[j], m_pos[j], t);
+        }
+    };
+
     //initializes internal data and the random number generator
     DavidsonHarel::DavidsonHarel():
         m_temperature(m_defaultTemp),
         m_shrinkingFactor(m_shrinkFactor),
         m_diskRadius(m_defaultRadius),
         m_energy(0.0),
-        m_numberOfIterations(0)
+        m_numberOfIterations(0),
+        m_batchSize(1),
+        m_numberOfThreads(1)
     {
         srand((unsigned)time(NULL));
     }
@@ -102,6 +209,18 @@ namespace ogdf
         m_numberOfIterations = steps;
     }
 
+    void DavidsonHarel::setBatchSize(int size)
+    {
+        if(size < 1) OGDF_THROW_PARAM(AlgorithmFailureException, afcIllegalParameter);
+        m_batchSize = size;
+    }
+
+    void DavidsonHarel::setNumberOfThreads(int n)
+    {
+        if(n < 1) OGDF_THROW_PARAM(AlgorithmFailureException, afcIllegalParameter);
+        m_numberOfThreads = n;
+    }
+
     //whenever an energy function is added, the initial energy of the new function
     //is computed and added to the initial energy of the layout
     void DavidsonHarel::addEnergyFunction(EnergyFunction* F, double weight)
@@ -249,6 +368,60 @@ namespace ogdf
             m_energy += (*it)->energy() * (*it2);
     }
 
+    //all energy functions are informed that the new layout is accepted
+    void DavidsonHarel::takeCandidate(
+        GraphAttributes & AG,
+        node v,
+        const DPoint & newPos,
+        double newEnergy)
+    {
+        ListIterator<EnergyFunction*> it;
+        for(it = m_energyFunctions.begin(); it.valid(); it = it.succ())
+            (*it)->candidateTaken();
+        AG.x(v) = newPos.m_x;
+        AG.y(v) = newPos.m_y;
+        m_energy = newEnergy;
+    }
+
+    //the candidates are drawn and tested in the same order as in the sequential
+    //iterations, but the energies of a batch are computed for the same layout;
+    //once a candidate is accepted, the rest of the batch is outdated and discarded
+    void DavidsonHarel::batchedIterations(GraphAttributes & AG, CandidateBatch & batch)
+    {
+        int ic = 0;
+        while(ic < m_numberOfIterations)
+        {
+            batch.clear();
+            while(batch.size() < m_batchSize && ic + batch.size() < m_numberOfIterations)
+            {
+                DPoint newPos;
+                node v = computeCandidateLayout(AG, newPos);
+                batch.push(v, newPos);
+            }
+            batch.computeEnergies();
+
+            for(int j = 0; j < batch.size(); ++j)
+            {
+                ++ic;
+                double newEnergy = batch.energy(j);
+                OGDF_ASSERT(newEnergy >= 0.0);
+                if(testEnergyValue(newEnergy))
+                {
+                    //the energy functions need the data of this candidate
+                    node v = batch.candidateNode(j);
+                    const DPoint & newPos = batch.candidatePos(j);
+                    ListIterator<EnergyFunction*> it;
+                    ListIterator<double> it2 = m_weightsOfEnergyFunctions.begin();
+                    newEnergy = 0.0;
+                    for(it = m_energyFunctions.begin(); it.valid(); it = it.succ(), it2 = it2.succ())
+                        newEnergy += (*it)->computeCandidateEnergy(v, newPos) * (*it2);
+                    takeCandidate(AG, v, newPos, newEnergy);
+                    break;
+                }
+            }
+        }
+    }
+
     //the vertices with degree zero are placed below all other vertices on a horizontal
     // line centered with repect to the rest of the drawing
     void DavidsonHarel::placeIsolatedNodes(GraphAttributes & AG) const
@@ -336,40 +509,44 @@ namespace ogdf
             computeInitialEnergy();
             if(m_numberOfIterations == 0)
                 m_numberOfIterations = m_nonIsolatedNodes.size() * m_iterationMultiplier;
+            CandidateBatch* batch = 0;
+            if(m_batchSize > 1)
+                batch = new CandidateBatch(m_energyFunctions, m_weightsOfEnergyFunctions,
+                                           m_batchSize, min(m_numberOfThreads, m_batchSize));
             //this is the main optimization loop
             while(m_temperature > 0)
             {
-                //iteration loop for each temperature
-                for(int ic = 1; ic <= m_numberOfIterations; ic ++)
+                if(batch != 0)
+                    batchedIterations(AG, *batch);
+                else
                 {
-                    DPoint newPos;
-                    //choose random vertex and new position for vertex
-                    node v = computeCandidateLayout(AG, newPos);
-                    //compute candidate energy and decide if new layout is chosen
-                    ListIterator<EnergyFunction*> it;
-                    ListIterator<double> it2 = m_weightsOfEnergyFunctions.begin();
-                    double newEnergy = 0.0;
-                    for(it = m_energyFunctions.begin(); it.valid(); it = it.succ())
-                    {
-                        newEnergy += (*it)->computeCandidateEnergy(v, newPos) * (*it2);
-                        it2 = it2.succ();
-                    }
-                    OGDF_ASSERT(newEnergy >= 0.0);
-                    //this tests if the new layout is accepted. If this is the case,
-                    //all energy functions are informed that the new layout is accepted
-                    if(testEnergyValue(newEnergy))
+                    //iteration loop for each temperature
+                    for(int ic = 1; ic <= m_numberOfIterations; ic ++)
                     {
+                        DPoint newPos;
+                        //choose random vertex and new position for vertex
+                        node v = computeCandidateLayout(AG, newPos);
+                        //compute candidate energy and decide if new layout is chosen
+                        ListIterator<EnergyFunction*> it;
+                        ListIterator<double> it2 = m_weightsOfEnergyFunctions.begin();
+                        double newEnergy = 0.0;
                         for(it = m_energyFunctions.begin(); it.valid(); it = it.succ())
-                            (*it)->candidateTaken();
-                        AG.x(v) = newPos.m_x;
-                        AG.y(v) = newPos.m_y;
-                        m_energy = newEnergy;
+                        {
+                            newEnergy += (*it)->computeCandidateEnergy(v, newPos) * (*it2);
+                            it2 = it2.succ();
+                        }
+                        OGDF_ASSERT(newEnergy >= 0.0);
+                        //this tests if the new layout is accepted. If this is the case,
+                        //all energy functions are informed that the new layout is accepted
+                        if(testEnergyValue(newEnergy))
+                            takeCandidate(AG, v, newPos, newEnergy);
                     }
                 }
                 //lower the temperature and decrease the disk radius
                 m_temperature = (int)floor(m_temperature * m_coolingFactor);
                 m_diskRadius *= m_shrinkingFactor;
             }
+            delete batch;
         }
         //if there are zero degree vertices, they are placed using placeIsolatedNodes
         if(m_nonIsolatedNodes.size() != G.numberOfNodes())
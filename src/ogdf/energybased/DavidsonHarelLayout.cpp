@@ -89,6 +89,8 @@ namespace ogdf
         m_multiplier = 2.0;
         m_prefEdgeLength = 0.0;
         m_crossings = false;
+        m_batchSize = 1;
+        m_numberOfThreads = 1;
     }
 
 
@@ -177,6 +179,20 @@ namespace ogdf
     }
 
 
+    void DavidsonHarelLayout::setBatchSize(int size)
+    {
+        if(size < 1) OGDF_THROW_PARAM(AlgorithmFailureException, afcIllegalParameter);
+        else m_batchSize = size;
+    }
+
+
+    void DavidsonHarelLayout::setNumberOfThreads(int n)
+    {
+        if(n < 1) OGDF_THROW_PARAM(AlgorithmFailureException, afcIllegalParameter);
+        else m_numberOfThreads = n;
+    }
+
+
     //this sets the parameters of the class DavidsonHarel, adds the energy functions and
     //starts the optimization process
     void DavidsonHarelLayout::call(GraphAttributes & AG)
@@ -240,6 +256,8 @@ namespace ogdf
                 dh.setNumberOfIterations(m_numberOfIterations);
         }
         dh.setStartTemperature(m_startTemperature);
+        dh.setBatchSize(m_batchSize);
+        dh.setNumberOfThreads(m_numberOfThreads);
         dh.call(AG);
     }
 
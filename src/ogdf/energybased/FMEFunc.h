@@ -102,6 +102,11 @@ namespace ogdf
         double stopCritConstSq;             //!< stopping criteria
 
         __uint32 multipolePrecision;
+        bool multipoleSinglePrecision;      //!< apply the M2L translation in single precision
+
+        bool useNodeMoveRadius;             //!< scale the displacement of each node by its move radius
+
+        IterationMonitor* pMonitor;         //!< observes the iterations of the main step (or 0)
     };
 
 
@@ -143,6 +148,7 @@ namespace ogdf
         float* forceY;                          //!< local force array for all nodes, points
         double maxForceSq;                      //!< local maximum force
         double avgForce;                        //!< local maximum force
+        double sumForceSq;                      //!< local sum of the squared displacements
         float min_x;                            //!< global point, node min x coordinate for bounding box calculations
         float max_x;                            //!< global point, node max x coordinate for bounding box calculations
         float min_y;                            //!< global point, node min y coordinate for bounding box calculations
@@ -978,11 +984,17 @@ namespace ogdf
         {
             float d_x = forceArrayX[i] * timeStep;
             float d_y = forceArrayY[i] * timeStep;
+            if(FLAGS & USE_NODE_MOVE_RAD)
+            {
+                d_x *= nodeMoveRadius[i];
+                d_y *= nodeMoveRadius[i];
+            }
             double dsq = (d_x * d_x + d_y * d_y);
             double d = sqrt(dsq);
 
             localContext->maxForceSq = max<double>(localContext->maxForceSq, (double)dsq);
             localContext->avgForce += d;
+            localContext->sumForceSq += dsq;
             if(d < FLT_MAX)
             {
                 x[i] += (float)((d_x));
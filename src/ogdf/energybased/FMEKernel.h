@@ -48,6 +48,7 @@
 #define OGDF_FME_KERNEL_H
 
 #include <ogdf/basic/basic.h>
+#include <ogdf/energybased/IterationMonitor.h>
 #include "FastUtils.h"
 #include "ArrayGraph.h"
 #include "FMEThread.h"
@@ -116,6 +117,23 @@ namespace ogdf
     }
 
 
+    //! like move_nodes above, but the displacement of node i is scaled by r[i]
+    inline double move_nodes(float* x, float* y, const __uint32 begin, const __uint32 end, const float* fx, const float* fy, const float t, const float* r)
+    {
+        double dsq_max = 0.0;
+        for(__uint32 i = begin; i <= end; i++)
+        {
+            float d_x = fx[i] * r[i];
+            float d_y = fy[i] * r[i];
+            double dsq = d_x * d_x + d_y * d_y;
+            x[i] += d_x * t;
+            y[i] += d_y * t;
+            dsq_max = max(dsq_max, dsq);
+        }
+        return dsq_max;
+    }
+
+
     inline void eval_edges(const ArrayGraph & graph, const __uint32 begin, const __uint32 end, float* fx, float* fy)
     {
         const float* x = graph.nodeXPos();
@@ -236,27 +254,47 @@ namespace ogdf
             eval_direct_fast(graph.nodeXPos(), graph.nodeYPos(), graph.nodeSize(), fx, fy,  graph.numNodes());
         }
 
-        inline double moveNodes(ArrayGraph & graph, float* fx, float* fy, float timeStep)
+        //! moves the nodes; if \a moveRadius is not 0, the displacements are scaled by the move radii of the nodes
+        inline double moveNodes(ArrayGraph & graph, float* fx, float* fy, float timeStep, bool moveRadius = false)
         {
+            if(moveRadius)
+                return move_nodes(graph.nodeXPos(), graph.nodeYPos(), 0, graph.numNodes() - 1, fx, fy, timeStep, graph.nodeMoveRadius());
             return move_nodes(graph.nodeXPos(), graph.nodeYPos(), 0, graph.numNodes() - 1, fx, fy, timeStep);
         }
 
-        inline double simpleIteration(ArrayGraph & graph, float* fx, float* fy, float timeStep)
+        inline double simpleIteration(ArrayGraph & graph, float* fx, float* fy, float timeStep, bool moveRadius = false)
         {
             repForces(graph, fx, fy);
             edgeForces(graph, fx, fy);
-            return moveNodes(graph, fx, fy, timeStep);
+            return moveNodes(graph, fx, fy, timeStep, moveRadius);
         }
 
 
-        inline double simpleEdgeIteration(ArrayGraph & graph, float* fx, float* fy, float timeStep)
+        inline double simpleEdgeIteration(ArrayGraph & graph, float* fx, float* fy, float timeStep, bool moveRadius = false)
         {
             edgeForces(graph, fx, fy);
-            return moveNodes(graph, fx, fy, timeStep);
+            return moveNodes(graph, fx, fy, timeStep, moveRadius);
         }
 
 
-        inline void simpleForceDirected(ArrayGraph & graph, float timeStep, __uint32 minIt, __uint32 maxIt, __uint32 preProcIt, double threshold)
+        //! reports the displacements \a timeStep * (\a fx, \a fy) of the last iteration to \a pMonitor; returns true if it stops the iterations
+        inline bool reportIteration(ArrayGraph & graph, const float* fx, const float* fy, float timeStep, bool moveRadius, IterationMonitor* pMonitor)
+        {
+            double energy = 0.0;
+            double dsq_max = 0.0;
+            for(__uint32 j = 0; j < graph.numNodes(); j++)
+            {
+                float t = moveRadius ? timeStep * graph.nodeMoveRadius()[j] : timeStep;
+                double dsq = (fx[j] * fx[j] + fy[j] * fy[j]) * t * t;
+                energy += dsq;
+                dsq_max = max(dsq_max, dsq);
+            }
+            const double l = graph.avgDesiredEdgeLength();
+            return pMonitor->report(energy / (l * l), sqrt(dsq_max) / l);
+        }
+
+        inline void simpleForceDirected(ArrayGraph & graph, float timeStep, __uint32 minIt, __uint32 maxIt, __uint32 preProcIt, double threshold, bool moveRadius = false,
+                                        IterationMonitor* pMonitor = 0)
         {
             bool earlyExit = false;
             float* fx = (float*)MALLOC_16(sizeof(float) * graph.numNodes());
@@ -269,7 +307,7 @@ namespace ogdf
                     fx[j] = 0.0f;
                     fy[j] = 0.0f;
                 }
-                simpleEdgeIteration(graph, fx, fy, timeStep);
+                simpleEdgeIteration(graph, fx, fy, timeStep, moveRadius);
             }
             for(__uint32 i = 0; (i < maxIt) && (!earlyExit); i++)
             {
@@ -278,9 +316,11 @@ namespace ogdf
                     fx[j] = 0.0f;
                     fy[j] = 0.0f;
                 }
-                double dsq = simpleIteration(graph, fx, fy, timeStep);
+                double dsq = simpleIteration(graph, fx, fy, timeStep, moveRadius);
                 if(dsq < threshold && i > (minIt))
                     earlyExit = true;
+                if(pMonitor != 0 && reportIteration(graph, fx, fy, timeStep, moveRadius, pMonitor))
+                    earlyExit = true;
             }
 
             FREE_16(fx);
@@ -295,9 +335,10 @@ namespace ogdf
     {
     public:
         //FMESingleKernel(FMEThread* pThread) : FMEKernel(pThread) {};
-        void operator()(ArrayGraph & graph, float timeStep, __uint32 minIt, __uint32 maxIt, double threshold)
+        void operator()(ArrayGraph & graph, float timeStep, __uint32 minIt, __uint32 maxIt, double threshold, bool moveRadius = false,
+                        IterationMonitor* pMonitor = 0)
         {
-            simpleForceDirected(graph, timeStep, minIt, maxIt, 20, threshold);
+            simpleForceDirected(graph, timeStep, minIt, maxIt, 20, threshold, moveRadius, pMonitor);
         }
     };
 
@@ -535,16 +535,26 @@ namespace ogdf
             // wait until all edges are done
             sync();
             // now collect the forces in parallel and put the sum into the global array and move the nodes accordingly
-            for_loop(nodePointPartition,
-                     func_comp(
-                         collect_force_function < COLLECT_EDGE_FACTOR_PREP | COLLECT_ZERO_THREAD_ARRAY > (localContext),
-                         node_move_function < TIME_STEP_PREP | ZERO_GLOBAL_ARRAY > (localContext)
-                     )
-                    );
+            if(options->useNodeMoveRadius)
+                for_loop(nodePointPartition,
+                         func_comp(
+                             collect_force_function < COLLECT_EDGE_FACTOR_PREP | COLLECT_ZERO_THREAD_ARRAY > (localContext),
+                             node_move_function < TIME_STEP_PREP | ZERO_GLOBAL_ARRAY | USE_NODE_MOVE_RAD > (localContext)
+                         )
+                        );
+            else
+                for_loop(nodePointPartition,
+                         func_comp(
+                             collect_force_function < COLLECT_EDGE_FACTOR_PREP | COLLECT_ZERO_THREAD_ARRAY > (localContext),
+                             node_move_function < TIME_STEP_PREP | ZERO_GLOBAL_ARRAY > (localContext)
+                         )
+                        );
         }
         if(isMainThread())
         {
             globalContext->coolDown = 1.0f;
+            if(options->pMonitor != 0 && options->pMonitor->timeLimitExceeded())
+                globalContext->earlyExit = true;
         }
         sync();
 
@@ -556,6 +566,7 @@ namespace ogdf
 
             localContext->maxForceSq = 0.0;
             localContext->avgForce = 0.0;
+            localContext->sumForceSq = 0.0;
 
             // construct the quadtree
             quadtreeConstruction(nodePointPartition);
@@ -577,12 +588,20 @@ namespace ogdf
             sync();
 
             // collect the edge forces and move nodes without waiting
-            for_loop(nodePointPartition,
-                     func_comp(
-                         collect_force_function < COLLECT_EDGE_FACTOR | COLLECT_ZERO_THREAD_ARRAY > (localContext),
-                         node_move_function < TIME_STEP_NORMAL | ZERO_GLOBAL_ARRAY > (localContext)
-                     )
-                    );
+            if(options->useNodeMoveRadius)
+                for_loop(nodePointPartition,
+                         func_comp(
+                             collect_force_function < COLLECT_EDGE_FACTOR | COLLECT_ZERO_THREAD_ARRAY > (localContext),
+                             node_move_function < TIME_STEP_NORMAL | ZERO_GLOBAL_ARRAY | USE_NODE_MOVE_RAD > (localContext)
+                         )
+                        );
+            else
+                for_loop(nodePointPartition,
+                         func_comp(
+                             collect_force_function < COLLECT_EDGE_FACTOR | COLLECT_ZERO_THREAD_ARRAY > (localContext),
+                             node_move_function < TIME_STEP_NORMAL | ZERO_GLOBAL_ARRAY > (localContext)
+                         )
+                        );
             // wait so we can decide if we need another iteration
             sync();
             // check the max force square for all threads
@@ -597,6 +616,17 @@ namespace ogdf
                 {
                     globalContext->earlyExit = true;
                 }
+
+                // report the iteration (in units of the average desired edge length)
+                if(options->pMonitor != 0)
+                {
+                    double sumForceSq = 0.0;
+                    for(__uint32 j = 0; j < numThreads(); j++)
+                        sumForceSq += globalContext->pLocalContext[j]->sumForceSq;
+                    const double l = globalContext->pGraph->avgDesiredEdgeLength();
+                    if(options->pMonitor->report(sumForceSq / (l * l), sqrt(maxForceSq) / l))
+                        globalContext->earlyExit = true;
+                }
             }
             // this is required to wait for the earlyExit result
             sync();
@@ -613,7 +643,8 @@ namespace ogdf
         globalContext->pGraph = pGraph;
         globalContext->pQuadtree = new LinearQuadtree(pGraph->numNodes(), pGraph->nodeXPos(), pGraph->nodeYPos(), pGraph->nodeSize());
         globalContext->pWSPD = globalContext->pQuadtree->wspd();
-        globalContext->pExpansion = new LinearQuadtreeExpansion(globalContext->pOptions->multipolePrecision, (*globalContext->pQuadtree));
+        globalContext->pExpansion = new LinearQuadtreeExpansion(globalContext->pOptions->multipolePrecision, (*globalContext->pQuadtree),
+                globalContext->pOptions->multipoleSinglePrecision);
         __uint32 numPoints = globalContext->pQuadtree->numberOfPoints();
         typedef FMELocalContext* FMELocalContextPtr;
 
@@ -174,33 +174,45 @@ namespace ogdf
             }
         }
 
-        //! lazy parallel sorting for num_threads = power of two
+        //! lazy parallel sorting for an arbitrary number of threads
         template<typename T, typename C>
         inline void sort_parallel(T* ptr, __uint32 n, C comparer)
         {
             if((n < numThreads() * 1000) || (numThreads() == 1))
                 sort_single(ptr, n, comparer);
             else
-                sort_parallel(ptr, n, comparer, 0, numThreads());
+            {
+                __uint32 depth = 0;
+                while((1u << depth) < numThreads())
+                    depth++;
+                sort_parallel(ptr, n, comparer, 0, numThreads(), depth);
+            }
         }
 
-        //! lazy parallel sorting for num_threads = power of two
+        //! lazy parallel sorting for an arbitrary number of threads
+        /**
+         * The threads threadNrBegin,...,threadNrBegin+numThreads-1 sort ptr[0..n-1].
+         * The range and the threads are split proportionally; every thread calls
+         * sync() exactly \a depth times, so subtrees of different height stay in step.
+         */
         template<typename T, typename C>
-        inline void sort_parallel(T* ptr, __uint32 n, C comparer, __uint32 threadNrBegin, __uint32 numThreads)
+        inline void sort_parallel(T* ptr, __uint32 n, C comparer, __uint32 threadNrBegin, __uint32 numThreads, __uint32 depth)
         {
-            if(n <= 1) return;
             if(numThreads == 1)
             {
-                std::sort(ptr, ptr + n, comparer);
+                if(n > 1)
+                    std::sort(ptr, ptr + n, comparer);
+                for(__uint32 i = 0; i < depth; i++)
+                    sync();
             }
             else
             {
-                __uint32 half = n >> 1;
                 __uint32 halfThreads = numThreads >> 1;
+                __uint32 half = (__uint32)(((__uint64)n * halfThreads) / numThreads);
                 if(this->threadNr() < threadNrBegin + halfThreads)
-                    sort_parallel(ptr, half, comparer, threadNrBegin, halfThreads);
+                    sort_parallel(ptr, half, comparer, threadNrBegin, halfThreads, depth - 1);
                 else
-                    sort_parallel(ptr + half, n - half, comparer, threadNrBegin + halfThreads, halfThreads);
+                    sort_parallel(ptr + half, n - half, comparer, threadNrBegin + halfThreads, numThreads - halfThreads, depth - 1);
 
                 // wait until all threads are ready.
                 sync();
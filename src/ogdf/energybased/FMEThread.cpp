@@ -99,7 +99,7 @@ namespace ogdf
 #endif
 
 
-    FMEThread::FMEThread(FMEThreadPool* pThreadPool, __uint32 threadNr) : m_threadNr(threadNr), m_pThreadPool(pThreadPool)
+    FMEThread::FMEThread(FMEThreadPool* pThreadPool, __uint32 threadNr) : m_threadNr(threadNr), m_pThreadPool(pThreadPool), m_pTask(0)
     {
         m_numThreads = m_pThreadPool->numThreads();
     }
@@ -112,8 +112,26 @@ namespace ogdf
     }
 
 
+    void FMEThread::doWork()
+    {
+#if defined(OGDF_SYSTEM_UNIX) && defined(OGDF_FME_THREAD_AFFINITY)
+        unixSetAffinity();
+#endif
+        for(;;)
+        {
+            // wait for the next task
+            m_pThreadPool->m_pPoolBarrier->threadSync();
+            if(m_pThreadPool->m_shutdown)
+                break;
+            runTask();
+            // signal that the task is finished
+            m_pThreadPool->m_pPoolBarrier->threadSync();
+        }
+    }
+
 
-    FMEThreadPool::FMEThreadPool(__uint32 numThreads) : m_numThreads(numThreads)
+
+    FMEThreadPool::FMEThreadPool(__uint32 numThreads) : m_numThreads(max<__uint32>(1, numThreads))
     {
         allocate();
     }
@@ -126,17 +144,41 @@ namespace ogdf
     //! runs one iteration. This call blocks the main thread
     void FMEThreadPool::runThreads()
     {
-        for(__uint32 i = 1; i < numThreads(); i++)
+        // the worker threads are not woken up if there is nothing to do for them
+        if(m_numActiveThreads == 1)
         {
-            thread(i)->start();
+#if defined(OGDF_SYSTEM_UNIX) && defined(OGDF_FME_THREAD_AFFINITY)
+            thread(0)->unixSetAffinity();
+#endif
+            thread(0)->runTask();
+            return;
         }
 
-        thread(0)->doWork();
+        // start the worker threads
+        m_pPoolBarrier->threadSync();
 
-        for(__uint32 i = 1; i < numThreads(); i++)
+#if defined(OGDF_SYSTEM_UNIX) && defined(OGDF_FME_THREAD_AFFINITY)
+        thread(0)->unixSetAffinity();
+#endif
+        thread(0)->runTask();
+
+        // wait until all threads are finished
+        m_pPoolBarrier->threadSync();
+    }
+
+
+    void FMEThreadPool::setNumActiveThreads(__uint32 numActiveThreads)
+    {
+        numActiveThreads = max<__uint32>(1, min(numActiveThreads, m_numThreads));
+        if(numActiveThreads != m_numActiveThreads)
         {
-            thread(i)->join();
+            // the worker threads are waiting at the pool barrier, hence nobody uses the sync barrier
+            delete m_pSyncBarrier;
+            m_pSyncBarrier = new Barrier(numActiveThreads);
+            m_numActiveThreads = numActiveThreads;
         }
+        for(__uint32 i = 0; i < m_numThreads; i++)
+            m_pThreads[i]->m_numThreads = m_numActiveThreads;
     }
 
 
@@ -144,25 +186,44 @@ namespace ogdf
     {
         typedef FMEThread* FMEThreadPtr;
 
+        m_shutdown = false;
+        m_numActiveThreads = m_numThreads;
         m_pSyncBarrier = new Barrier(m_numThreads);
+        m_pPoolBarrier = new Barrier(m_numThreads);
         m_pThreads = new FMEThreadPtr[m_numThreads];
         for(__uint32 i = 0; i < m_numThreads; i++)
         {
             m_pThreads[i] = new FMEThread(this, i);
 #ifdef OGDF_SYSTEM_WINDOWS
             //m_pThreads[i]->priority(Thread::tpCritical);
-            m_pThreads[i]->cpuAffinity(1 << i);
+            if(i < 64)
+                m_pThreads[i]->cpuAffinity(__uint64(1) << i);
 #endif
         }
+        // the main thread is the calling thread, all others wait for tasks
+        for(__uint32 i = 1; i < m_numThreads; i++)
+        {
+            m_pThreads[i]->start();
+        }
     }
 
     void FMEThreadPool::deallocate()
     {
+        if(m_numThreads > 1)
+        {
+            m_shutdown = true;
+            m_pPoolBarrier->threadSync();
+        }
+        for(__uint32 i = 1; i < numThreads(); i++)
+        {
+            m_pThreads[i]->join();
+        }
         for(__uint32 i = 0; i < numThreads(); i++)
         {
             delete m_pThreads[i];
         }
         delete[] m_pThreads;
+        delete m_pPoolBarrier;
         delete m_pSyncBarrier;
     }
 
@@ -117,9 +117,15 @@ namespace ogdf
 
     /*!
      * The fast multipole embedder work thread class
+     *
+     * All threads except the main thread (thread 0) are started once when the pool
+     * is created and wait for tasks until the pool is destroyed. The main thread
+     * is the calling thread.
     */
     class FMEThread : public Thread
     {
+        friend class FMEThreadPool;
+
     public:
         //! construtor
         FMEThread(FMEThreadPool* pThreadPool, __uint32 threadNr);
@@ -130,7 +136,7 @@ namespace ogdf
             return m_threadNr;
         }
 
-        //! returns the total number of threads in the pool
+        //! returns the number of threads running the current task
         inline __uint32 numThreads() const
         {
             return m_numThreads;
@@ -152,30 +158,26 @@ namespace ogdf
         void sync();
 #if defined(OGDF_SYSTEM_UNIX) && defined(OGDF_FME_THREAD_AFFINITY)
         void unixSetAffinity();
-
-        //! the main work function
-        void doWork()
-        {
-            unixSetAffinity();
-            m_pTask->doWork();
-            delete m_pTask;
-            m_pTask = 0;
-        };
-#else
-        //! the main work function
-        void doWork()
+#endif
+        //! runs and deletes the actual task (if any)
+        void runTask()
         {
+            if(!m_pTask) return;
             m_pTask->doWork();
             delete m_pTask;
             m_pTask = 0;
         }
-#endif
+
         //! sets the actual task
         void setTask(FMETask* pTask)
         {
             m_pTask = pTask;
         }
 
+    protected:
+        //! the main work function of the worker threads: runs tasks until the pool is destroyed
+        void doWork();
+
     private:
         __uint32 m_threadNr;
 
@@ -189,7 +191,10 @@ namespace ogdf
 
     class FMEThreadPool
     {
+        friend class FMEThread;
+
     public:
+        //! creates a pool with \a numThreads threads (including the calling thread)
         FMEThreadPool(__uint32 numThreads);
 
         ~FMEThreadPool();
@@ -215,10 +220,19 @@ namespace ogdf
         //! runs one iteration. This call blocks the main thread
         void runThreads();
 
+        //! runs a kernel on all threads of the pool
         template<typename KernelType, typename ArgType1>
         void runKernel(ArgType1 arg1)
         {
-            for(__uint32 i = 0; i < numThreads(); i++)
+            runKernel<KernelType, ArgType1>(arg1, numThreads());
+        }
+
+        //! runs a kernel on the first \a numActiveThreads threads of the pool
+        template<typename KernelType, typename ArgType1>
+        void runKernel(ArgType1 arg1, __uint32 numActiveThreads)
+        {
+            setNumActiveThreads(numActiveThreads);
+            for(__uint32 i = 0; i < m_numActiveThreads; i++)
             {
                 KernelType kernel(thread(i));
                 FuncInvoker<KernelType, ArgType1> invoker(kernel, arg1);
@@ -232,11 +246,23 @@ namespace ogdf
 
         void deallocate();
 
+        //! sets the number of threads running the next task and resizes the sync barrier
+        void setNumActiveThreads(__uint32 numActiveThreads);
+
         __uint32 m_numThreads;
 
+        __uint32 m_numActiveThreads;
+
         FMEThread** m_pThreads;
 
+        //! barrier of the active threads, used by the kernels
         Barrier* m_pSyncBarrier;
+
+        //! barrier of all threads, used to start and finish a task
+        Barrier* m_pPoolBarrier;
+
+        //! tells the worker threads to terminate
+        bool m_shutdown;
     };
 
 }
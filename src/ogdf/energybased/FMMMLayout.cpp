@@ -44,6 +44,7 @@
 #include <ogdf/energybased/FMMMLayout.h>
 #include <ogdf/basic/Math.h>
 #include "numexcept.h"
+#include <ogdf/basic/ThreadTeam.h>
 #include "MAARPacking.h"
 #include "Multilevel.h"
 #include "Edge.h"
@@ -61,6 +62,12 @@ namespace ogdf
     FMMMLayout::FMMMLayout()
     {
         initialize_all_options();
+        A_ptr = 0;
+        E_ptr = 0;
+        F_attr_ptr = 0;
+        m_pTeam = 0;
+        m_warmStart = 0;
+        m_pMonitor = 0;
     }
 
 
@@ -112,10 +119,20 @@ namespace ogdf
 
             double t_total;
             usedTime(t_total);
+            if(m_pMonitor != 0)
+                m_pMonitor->start();
             max_integer_position = pow(2.0, maxIntPosExponent());
             init_ind_ideal_edgelength(G, A, E);
             make_simple_loopfree(G, A, E, G_reduced, A_reduced, E_reduced);
-            call_DIVIDE_ET_IMPERA_step(G_reduced, A_reduced, E_reduced);
+
+            //the threads of the force calculation are kept alive for the whole call
+            KernelTeam team(numberOfThreads());
+            m_pTeam = &team;
+            if(m_warmStart != 0)
+                call_INCREMENTAL_step(G_reduced, A_reduced, E_reduced);
+            else
+                call_DIVIDE_ET_IMPERA_step(G_reduced, A_reduced, E_reduced);
+            m_pTeam = 0;
             if(allowedPositions() != apAll)
                 make_positions_integer(G_reduced, A_reduced);
             time_total = usedTime(t_total);
@@ -151,6 +168,57 @@ namespace ogdf
     }
 
 
+    void FMMMLayout::callIncremental(GraphAttributes & GA, const WarmStart & ws)
+    {
+        const Graph & G = GA.constGraph();
+        EdgeArray<double> edgelength(G, 1.0);
+        callIncremental(GA, edgelength, ws);
+    }
+
+
+    void FMMMLayout::callIncremental(
+        GraphAttributes & GA,
+        const EdgeArray<double> & edgeLength,
+        const WarmStart & ws)
+    {
+        OGDF_ASSERT(ws.graphOf() == &GA.constGraph())
+
+        m_warmStart = &ws;
+        call(GA, edgeLength);
+        m_warmStart = 0;
+    }
+
+
+    void FMMMLayout::call_INCREMENTAL_step(
+        Graph & G,
+        NodeArray<NodeAttributes> & A,
+        EdgeArray<EdgeAttributes> & E)
+    {
+        m_mobility.init(G);
+        m_startPosition.init(G);
+        DPoint center(0, 0);
+        node v;
+        forall_nodes(v, G)
+        {
+            m_mobility[v] = m_warmStart->mobility(A[v].get_original_node());
+            m_startPosition[v] = A[v].get_position();
+            center = center + A[v].get_position();
+        }
+
+        update_boxlength_and_cornercoordinate(G, A);
+        call_FORCE_CALCULATION_step(G, A, E, 0, 0);
+        m_mobility.init();
+        m_startPosition.init();
+
+        //the resizing of the drawing moves its center; restore it
+        forall_nodes(v, G)
+            center = center - A[v].get_position();
+        DPoint shift(center.m_x / G.numberOfNodes(), center.m_y / G.numberOfNodes());
+        forall_nodes(v, G)
+            A[v].set_position(A[v].get_position() + shift);
+    }
+
+
     void FMMMLayout::call_DIVIDE_ET_IMPERA_step(
         Graph & G,
         NodeArray<NodeAttributes> & A,
@@ -234,14 +302,17 @@ namespace ogdf
             set_average_ideal_edgelength(G, E); //needed for easy scaling of the forces
             make_initialisations_for_rep_calc_classes(G);
 
-            while(((stopCriterion() == scFixedIterations) && (iter <= max_mult_iter)) ||
+            bool stopped = (m_pMonitor != 0) && m_pMonitor->timeLimitExceeded();
+            while(!stopped && (((stopCriterion() == scFixedIterations) && (iter <= max_mult_iter)) ||
                     ((stopCriterion() == scThreshold) && (actforcevectorlength >= threshold()) &&
                      (iter <= ITERBOUND)) ||
                     ((stopCriterion() == scFixedIterationsOrThreshold) && (iter <= max_mult_iter) &&
-                     (actforcevectorlength >= threshold())))
+                     (actforcevectorlength >= threshold()))))
             {
                 //while
                 calculate_forces(G, A, E, F, F_attr, F_rep, last_node_movement, iter, 0);
+                if(m_pMonitor != 0)
+                    stopped = report_iteration(G, F);
                 if(stopCriterion() != scFixedIterations)
                     actforcevectorlength = get_average_forcevector_length(G, F);
                 iter++;
@@ -264,19 +335,31 @@ namespace ogdf
         NodeArray<DPoint> & F_rep,
         NodeArray<DPoint> & last_node_movement)
     {
-        for(int i = 1; i <= 10; i++)
+        bool stopped = (m_pMonitor != 0) && m_pMonitor->timeLimitExceeded();
+        for(int i = 1; i <= 10 && !stopped; i++)
+        {
             calculate_forces(G, A, E, F, F_attr, F_rep, last_node_movement, i, 1);
+            if(m_pMonitor != 0)
+                stopped = report_iteration(G, F);
+        }
 
-        if((resizeDrawing() == true))
+        // an incremental call must not rescale the frozen part of the drawing
+        const bool resize = resizeDrawing() && m_warmStart == 0;
+        if(resize)
         {
             adapt_drawing_to_ideal_average_edgelength(G, A, E);
             update_boxlength_and_cornercoordinate(G, A);
         }
 
-        for(int i = 1; i <= fineTuningIterations(); i++)
+        stopped = (m_pMonitor != 0) && m_pMonitor->timeLimitExceeded();
+        for(int i = 1; i <= fineTuningIterations() && !stopped; i++)
+        {
             calculate_forces(G, A, E, F, F_attr, F_rep, last_node_movement, i, 2);
+            if(m_pMonitor != 0)
+                stopped = report_iteration(G, F);
+        }
 
-        if((resizeDrawing() == true))
+        if(resize)
             adapt_drawing_to_ideal_average_edgelength(G, A, E);
     }
 
@@ -298,6 +381,7 @@ namespace ogdf
         edgeLengthMeasurement(elmBoundingCircle);
         allowedPositions(apInteger);
         maxIntPosExponent(40);
+        numberOfThreads(1);
 
         //setting options for the divide et impera step
         pageRatio(1.0);
@@ -1089,7 +1173,7 @@ namespace ogdf
     inline int FMMMLayout::get_max_mult_iter(int act_level, int max_level, int node_nr)
     {
         int iter;
-        if(maxIterChange() == micConstant) //nothing to do
+        if(maxIterChange() == micConstant || m_warmStart != 0) //nothing to do (an incremental call has only the finest level)
             iter =  fixedIterations();
         else if(maxIterChange() == micLinearlyDecreasing)  //linearly decreasing values
         {
@@ -1113,14 +1197,30 @@ namespace ogdf
 
         //helps to get good drawings for small graphs and graphs with few multilevels
         if((node_nr <= 500) && (iter < 100))
-            return 100;
-        else
-            return iter;
+            iter = 100;
+
+        //an incremental call only refines the current layout
+        return (m_warmStart != 0) ? m_warmStart->iterations(iter) : iter;
     }
 
 
     //-------------------------- functions for force calculation ---------------------------
 
+    bool FMMMLayout::report_iteration(Graph & G, NodeArray<DPoint> & F)
+    {
+        double energy = 0, max_move = 0;
+        node v;
+        forall_nodes(v, G)
+        {
+            double move = F[v].m_x * F[v].m_x + F[v].m_y * F[v].m_y;
+            energy += move;
+            max_move = max(max_move, move);
+        }
+        const double l_square = average_ideal_edgelength * average_ideal_edgelength;
+        return m_pMonitor->report(energy / l_square, sqrt(max_move / l_square));
+    }
+
+
     inline void FMMMLayout::calculate_forces(
         Graph & G,
         NodeArray<NodeAttributes> & A,
@@ -1252,13 +1352,22 @@ namespace ogdf
     inline void FMMMLayout::make_initialisations_for_rep_calc_classes(Graph & G)
     {
         if(repulsiveForcesCalculation() == rfcExact)
+        {
             FR.make_initialisations(boxlength, down_left_corner, frGridQuotient());
+            FR.thread_team(m_pTeam);
+        }
         else if(repulsiveForcesCalculation() == rfcGridApproximation)
+        {
             FR.make_initialisations(boxlength, down_left_corner, frGridQuotient());
+            FR.thread_team(m_pTeam);
+        }
         else //(repulsiveForcesCalculation() == rfcNMM
+        {
             NM.make_initialisations(G, boxlength, down_left_corner,
                                     nmParticlesInLeaves(), nmPrecision(),
                                     nmTreeConstruction(), nmSmallCell());
+            NM.thread_team(m_pTeam);
+        }
     }
 
 
@@ -1275,6 +1384,12 @@ namespace ogdf
         DPoint vector_v_minus_u, f_u;
         DPoint nullpoint(0, 0);
 
+        if(numberOfThreads() > 1)
+        {
+            calculate_attractive_forces_in_parallel(G, A, E, F_attr);
+            return;
+        }
+
         //initialisation
         init_F(G, F_attr);
 
@@ -1301,6 +1416,80 @@ namespace ogdf
     }
 
 
+    void FMMMLayout::calculate_attractive_forces_in_parallel(
+        Graph & G,
+        NodeArray<NodeAttributes> & A,
+        EdgeArray<EdgeAttributes> & E,
+        NodeArray<DPoint> & F_attr)
+    {
+        nodes.init(G.numberOfNodes());
+        int i = 0;
+        node v;
+        forall_nodes(v, G)
+            nodes[i++] = v;
+
+        A_ptr = &A;
+        E_ptr = &E;
+        F_attr_ptr = &F_attr;
+
+        attr_number_of_threads = min(numberOfThreads(), max(1, G.numberOfEdges() / 1024));
+        m_pTeam->run(this, &FMMMLayout::attractive_forces_kernel);
+
+        A_ptr = 0;
+        E_ptr = 0;
+        F_attr_ptr = 0;
+    }
+
+
+    void FMMMLayout::attractive_forces_kernel(int t)
+    {
+        //each thread sums up the forces of the edges incident to its own nodes;
+        //the force of an edge is always computed from source to target, hence
+        //the forces on both end nodes are exactly opposite
+        if(t >= attr_number_of_threads)
+            return;
+        int first = threadRangeBegin(nodes.size(), t, attr_number_of_threads);
+        int last = threadRangeBegin(nodes.size(), t + 1, attr_number_of_threads);
+
+        for(int i = first; i < last; i++)
+        {
+            node v = nodes[i];
+            DPoint f(0, 0);
+            adjEntry adj;
+            forall_adj(adj, v)
+            {
+                edge e = adj->theEdge();
+                if(e->isSelfLoop())
+                    continue;
+                if(e->source() == v)
+                    f = f + f_attr_on_source(*A_ptr, *E_ptr, e);
+                else
+                    f = f - f_attr_on_source(*A_ptr, *E_ptr, e);
+            }
+            (*F_attr_ptr)[v] = f;
+        }
+    }
+
+
+    inline DPoint FMMMLayout::f_attr_on_source(
+        NodeArray<NodeAttributes> & A,
+        EdgeArray<EdgeAttributes> & E,
+        edge e)
+    {
+        numexcept N;
+        DPoint f_u(0, 0);
+        DPoint vector_v_minus_u = A[e->target()].get_position() - A[e->source()].get_position();
+        double norm_v_minus_u = vector_v_minus_u.norm();
+        if(vector_v_minus_u != DPoint(0, 0) && !N.f_near_machine_precision(norm_v_minus_u, f_u))
+        {
+            double scalar = f_attr_scalar(norm_v_minus_u, E[e].get_length()) / norm_v_minus_u;
+            f_u.m_x = scalar * vector_v_minus_u.m_x;
+            f_u.m_y = scalar * vector_v_minus_u.m_y;
+        }
+        return f_u;
+    }
+
+
     double FMMMLayout::f_attr_scalar(double d, double ind_ideal_edge_length)
     {
         double s;
@@ -1422,8 +1611,29 @@ namespace ogdf
     {
         node v;
 
-        forall_nodes(v, G)
-        A[v].set_position(A[v].get_position() + F[v]);
+        if(m_warmStart != 0)
+        {
+            // the cumulative displacement of nodes outside the affected region is clamped
+            const double maxDist = m_warmStart->frozenMobility() * average_ideal_edgelength;
+            forall_nodes(v, G)
+            {
+                DPoint pos = A[v].get_position() + DPoint(m_mobility[v] * F[v].m_x, m_mobility[v] * F[v].m_y);
+                if(m_mobility[v] < 1.0)
+                {
+                    DPoint d = pos - m_startPosition[v];
+                    double dist = d.norm();
+                    if(dist > maxDist)
+                        pos = m_startPosition[v] + DPoint(d.m_x * maxDist / dist, d.m_y * maxDist / dist);
+                }
+                F[v] = pos - A[v].get_position();
+                A[v].set_position(pos);
+            }
+        }
+        else
+        {
+            forall_nodes(v, G)
+            A[v].set_position(A[v].get_position() + F[v]);
+        }
     }
 
 
@@ -0,0 +1,94 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Declaration of function fmmmRepulsiveForce used by the
+ *        parallel force calculation of FMMMLayout.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef OGDF_FMMM_THREAD_H
+#define OGDF_FMMM_THREAD_H
+
+#include <ogdf/basic/ThreadTeam.h>
+#include "numexcept.h"
+
+
+namespace ogdf
+{
+
+    //! Returns the repulsive force of node \a u on node \a v for the parallel force calculation.
+    /**
+     * The nodes are given by their positions and indices. Coinciding nodes are
+     * separated by an offset that only depends on the indices; hence the result
+     * is reproducible and the force of \a v on \a u is the negated force of
+     * \a u on \a v.
+     */
+    inline DPoint fmmmRepulsiveForce(
+        numexcept & N,
+        const DPoint & pos_u, int u,
+        const DPoint & pos_v, int v)
+    {
+        DPoint vector_v_minus_u = pos_v - pos_u;
+        if(vector_v_minus_u.m_x == 0 && vector_v_minus_u.m_y == 0)
+        {
+            DPoint delta = N.choose_distinct_point_in_radius_epsilon(DPoint(0, 0), min(u, v), max(u, v));
+            vector_v_minus_u = (u < v) ? delta : DPoint(-delta.m_x, -delta.m_y);
+        }
+
+        double norm_v_minus_u = vector_v_minus_u.norm();
+        DPoint f_rep_u_on_v;
+        if(N.f_rep_near_machine_precision(norm_v_minus_u, f_rep_u_on_v, min(u, v), max(u, v)))
+        {
+            if(u > v)
+                f_rep_u_on_v = DPoint(-f_rep_u_on_v.m_x, -f_rep_u_on_v.m_y);
+        }
+        else
+        {
+            double scalar = 1 / (norm_v_minus_u * norm_v_minus_u);
+            f_rep_u_on_v.m_x = scalar * vector_v_minus_u.m_x;
+            f_rep_u_on_v.m_y = scalar * vector_v_minus_u.m_y;
+        }
+        return f_rep_u_on_v;
+    }
+
+} // end namespace ogdf
+
+#endif
@@ -57,17 +57,32 @@ namespace ogdf
     FastMultipoleEmbedder::FastMultipoleEmbedder()
     {
         m_precisionParameter = 5;
+        m_multipoleSinglePrecision = false;
         m_defaultEdgeLength = 1.0;
         m_defaultNodeSize = 1.0;
         m_numIterations = 100;
         m_randomize = true;
         m_numberOfThreads = 0;
         m_maxNumberOfThreads = 1; //the only save value
+        m_threadPool = 0;
+        m_pExternalThreadPool = 0;
+        m_warmStart = 0;
+        m_pMonitor = 0;
     }
 
     FastMultipoleEmbedder::~FastMultipoleEmbedder(void)
     {
-        // nothing
+        delete m_threadPool;
+    }
+
+    FMEThreadPool* FastMultipoleEmbedder::createThreadPool(__uint32 numThreads)
+    {
+        return new FMEThreadPool(numThreads);
+    }
+
+    void FastMultipoleEmbedder::destroyThreadPool(FMEThreadPool* pThreadPool)
+    {
+        delete pThreadPool;
     }
 
     void FastMultipoleEmbedder::initOptions()
@@ -82,6 +97,9 @@ namespace ogdf
         m_pOptions->stopCritAvgForce = 0.1f;        //
         m_pOptions->minNumIterations = 4;           // 4
         m_pOptions->multipolePrecision = m_precisionParameter;
+        m_pOptions->multipoleSinglePrecision = m_multipoleSinglePrecision;
+        m_pOptions->useNodeMoveRadius = false;
+        m_pOptions->pMonitor = m_pMonitor;
     }
 
     /*
@@ -120,11 +138,61 @@ namespace ogdf
         call(GA, edgeLength, nodeSize);
     }
 
+    void FastMultipoleEmbedder::call(CompactGraphAttributes & CGA)
+    {
+        OGDF_ASSERT(CGA.attributes() & GraphAttributes::nodeGraphics)
+
+        const Graph & G = CGA.constGraph();
+        EdgeArray<float> edgeLength(G);
+        NodeArray<float> nodeSize(G);
+        node v;
+        edge e;
+        forall_nodes(v, G)
+        {
+            nodeSize[v] = sqrt(CGA.width(v) * CGA.width(v) + CGA.height(v) * CGA.height(v)) * 0.5f;
+        }
+
+        forall_edges(e, G)
+        {
+            edgeLength[e] = nodeSize[e->source()] + nodeSize[e->target()];
+        }
+
+        allocate(G.numberOfNodes(), G.numberOfEdges());
+        m_pGraph->readFrom(CGA, edgeLength, nodeSize);
+        run(m_numIterations);
+        m_pGraph->writeTo(CGA);
+        deallocate();
+    }
+
+    void FastMultipoleEmbedder::callIncremental(GraphAttributes & GA, const WarmStart & ws)
+    {
+        OGDF_ASSERT(ws.graphOf() == &GA.constGraph())
+
+        const bool randomize = m_randomize;
+        m_randomize = false;
+        m_warmStart = &ws;
+        call(GA);
+        m_warmStart = 0;
+        m_randomize = randomize;
+    }
+
     void FastMultipoleEmbedder::call(GraphAttributes & GA, const EdgeArray<float> & edgeLength, const NodeArray<float> & nodeSize)
     {
         allocate(GA.constGraph().numberOfNodes(), GA.constGraph().numberOfEdges());
         m_pGraph->readFrom(GA, edgeLength, nodeSize);
-        run(m_numIterations);
+        if(m_warmStart != 0)
+        {
+            // the nodes are numbered like in ArrayGraph::readFrom()
+            __uint32 i = 0;
+            node v;
+            forall_nodes(v, GA.constGraph())
+                m_pGraph->nodeMoveRadius()[i++] = (float)m_warmStart->mobility(v);
+            m_pOptions->useNodeMoveRadius = true;
+            m_pOptions->preProcMaxNumIterations = m_warmStart->iterations(m_pOptions->preProcMaxNumIterations);
+            run(m_warmStart->iterations(m_numIterations));
+        }
+        else
+            run(m_numIterations);
         m_pGraph->writeTo(GA);
         deallocate();
 
@@ -137,6 +205,8 @@ namespace ogdf
 
     void FastMultipoleEmbedder::run(__uint32 numIterations)
     {
+        if(m_pMonitor != 0)
+            m_pMonitor->start();
         if(m_pGraph->numNodes() == 0) return;
         if(m_pGraph->numNodes() == 1)
         {
@@ -172,8 +242,8 @@ namespace ogdf
 
     void FastMultipoleEmbedder::runMultipole()
     {
-        FMEGlobalContext* pGlobalContext = FMEMultipoleKernel::allocateContext(m_pGraph, m_pOptions, m_threadPool->numThreads());
-        m_threadPool->runKernel<FMEMultipoleKernel>(pGlobalContext);
+        FMEGlobalContext* pGlobalContext = FMEMultipoleKernel::allocateContext(m_pGraph, m_pOptions, m_numberOfThreads);
+        threadPool()->runKernel<FMEMultipoleKernel>(pGlobalContext, m_numberOfThreads);
         FMEMultipoleKernel::deallocateContext(pGlobalContext);
     }
 
@@ -181,7 +251,8 @@ namespace ogdf
     void FastMultipoleEmbedder::runSingle()
     {
         FMESingleKernel kernel;
-        kernel(*m_pGraph, m_pOptions->timeStep, m_pOptions->minNumIterations, m_pOptions->maxNumIterations, m_pOptions->stopCritForce);
+        kernel(*m_pGraph, m_pOptions->timeStep, m_pOptions->minNumIterations, m_pOptions->maxNumIterations, m_pOptions->stopCritForce,
+               m_pOptions->useNodeMoveRadius, m_pOptions->pMonitor);
     }
 
 
@@ -190,29 +261,40 @@ namespace ogdf
         m_pOptions = new FMEGlobalOptions();
         m_pGraph = new ArrayGraph(numNodes, numEdges);
         initOptions();
-        if(!m_maxNumberOfThreads)
-        {
-            __uint32 availableThreads = System::numberOfProcessors();
-            __uint32 minNodesPerThread = 100;
-            m_numberOfThreads = numNodes / minNodesPerThread;
-            m_numberOfThreads = max<__uint32>(1, m_numberOfThreads);
-            m_numberOfThreads = prevPowerOfTwo(min<__uint32>(m_numberOfThreads, availableThreads));
-        }
-        else
+
+        // the threads are kept alive between calls; use as many as the graph size justifies
+        __uint32 minNodesPerThread = 100;
+        m_numberOfThreads = numNodes / minNodesPerThread;
+        m_numberOfThreads = max<__uint32>(1, m_numberOfThreads);
+        m_numberOfThreads = min<__uint32>(m_numberOfThreads, threadPool()->numThreads());
+#ifdef OGDF_MEMORY_POOL_NTS
+        // the memory pool is not thread-safe; this also holds for external pools
+        m_numberOfThreads = 1;
+#endif
+    }
+
+
+    FMEThreadPool* FastMultipoleEmbedder::threadPool()
+    {
+        if(m_pExternalThreadPool)
+            return m_pExternalThreadPool;
+
+        __uint32 availableThreads = System::numberOfProcessors();
+        if(m_maxNumberOfThreads)
+            availableThreads = min<__uint32>(m_maxNumberOfThreads, availableThreads);
+        availableThreads = max<__uint32>(1, availableThreads);
+
+        if(!m_threadPool || m_threadPool->numThreads() != availableThreads)
         {
-            __uint32 availableThreads = min<__uint32>(m_maxNumberOfThreads, System::numberOfProcessors());
-            __uint32 minNodesPerThread = 100;
-            m_numberOfThreads = numNodes / minNodesPerThread;
-            m_numberOfThreads = max<__uint32>(1, m_numberOfThreads);
-            m_numberOfThreads = prevPowerOfTwo(min<__uint32>(m_numberOfThreads, availableThreads));
+            delete m_threadPool;
+            m_threadPool = new FMEThreadPool(availableThreads);
         }
-        m_threadPool = new FMEThreadPool(m_numberOfThreads);
+        return m_threadPool;
     }
 
 
     void FastMultipoleEmbedder::deallocate()
     {
-        delete m_threadPool;
         delete m_pGraph;
         delete m_pOptions;
     }
@@ -234,8 +316,27 @@ namespace ogdf
         GraphIO::writeGML(GA, filename);
     }
 
+    FastMultipoleMultilevelEmbedder::~FastMultipoleMultilevelEmbedder()
+    {
+        FastMultipoleEmbedder::destroyThreadPool(m_pThreadPool);
+    }
+
     void FastMultipoleMultilevelEmbedder::call(GraphAttributes & GA)
     {
+        // one pool for all levels and calls
+        __uint32 numThreads = System::numberOfProcessors();
+        if(m_iMaxNumThreads > 0)
+            numThreads = min<__uint32>(m_iMaxNumThreads, numThreads);
+        numThreads = max<__uint32>(1, numThreads);
+#ifdef OGDF_MEMORY_POOL_NTS
+        numThreads = 1;
+#endif
+        if(!m_pThreadPool || m_pThreadPool->numThreads() != numThreads)
+        {
+            FastMultipoleEmbedder::destroyThreadPool(m_pThreadPool);
+            m_pThreadPool = FastMultipoleEmbedder::createThreadPool(numThreads);
+        }
+
         EdgeArray<float> edgeLengthAuto(GA.constGraph());
         computeAutoEdgeLength(GA, edgeLengthAuto);
         m_multiLevelNumNodesBound = 10; //10
@@ -243,7 +344,8 @@ namespace ogdf
         if(t.numberOfNodes() <= 25)
         {
             FastMultipoleEmbedder fme;
-            fme.setNumberOfThreads(this->m_iMaxNumThreads);
+            fme.setThreadPool(m_pThreadPool);
+            fme.setMultipoleSinglePrecision(m_multipoleSinglePrecision);
             fme.setRandomize(true);
             fme.setNumIterations(500);
             fme.call(GA);
@@ -334,6 +436,7 @@ namespace ogdf
         m_iCurrentLevelNr = 0;
 
         GalaxyMultilevelBuilder builder;
+        builder.setNumberOfThreads(m_pThreadPool->numThreads());
         while(m_pCurrentLevel->m_pGraph->numberOfNodes() > m_multiLevelNumNodesBound)
         {
             GalaxyMultilevel* newLevel = builder.build(m_pCurrentLevel);
@@ -432,7 +535,8 @@ namespace ogdf
     void FastMultipoleMultilevelEmbedder::layoutCurrentLevel()
     {
         FastMultipoleEmbedder fme;
-        fme.setNumberOfThreads(this->m_iMaxNumThreads);
+        fme.setThreadPool(m_pThreadPool);
+        fme.setMultipoleSinglePrecision(m_multipoleSinglePrecision);
         fme.setRandomize(m_iCurrentLevelNr == (m_iNumLevels - 1));
         fme.setNumIterations(numberOfIterationsByLevelNr(m_iCurrentLevelNr));
         fme.call((*m_pCurrentGraph), (*m_pCurrentNodeXPos), (*m_pCurrentNodeYPos), (*m_pCurrentEdgeLength), (*m_pCurrentNodeSize));
@@ -44,6 +44,7 @@
 #include <ogdf/internal/energybased/FruchtermanReingold.h>
 
 #include "numexcept.h"
+#include "FMMMThread.h"
 #include <ogdf/basic/Array2D.h>
 
 
@@ -53,6 +54,15 @@ namespace ogdf
     FruchtermanReingold::FruchtermanReingold()
     {
         grid_quotient(2);
+        thread_team(0);
+        F_rep_ptr = 0;
+    }
+
+
+    void FruchtermanReingold::thread_team(KernelTeam* team)
+    {
+        _thread_team = team;
+        _number_of_threads = (team != 0) ? team->numThreads() : 1;
     }
 
 
@@ -61,6 +71,12 @@ namespace ogdf
         NodeArray<NodeAttributes> & A,
         NodeArray<DPoint> & F_rep)
     {
+        if(number_of_threads() > 1)
+        {
+            calculate_exact_repulsive_forces_in_parallel(G, A, F_rep);
+            return;
+        }
+
         //naive algorithm by Fruchterman & Reingold
         numexcept N;
         node v, u;
@@ -114,6 +130,12 @@ namespace ogdf
         NodeArray<NodeAttributes> & A,
         NodeArray<DPoint> & F_rep)
     {
+        if(number_of_threads() > 1)
+        {
+            calculate_approx_repulsive_forces_in_parallel(G, A, F_rep);
+            return;
+        }
+
         //GRID algorithm by Fruchterman & Reingold
         numexcept N;
         List<IPoint> neighbour_boxes;
@@ -253,6 +275,135 @@ namespace ogdf
     }
 
 
+    void FruchtermanReingold::calculate_exact_repulsive_forces_in_parallel(
+        const Graph & G,
+        NodeArray<NodeAttributes> & A,
+        NodeArray<DPoint> & F_rep)
+    {
+        int node_number = G.numberOfNodes();
+        nodes.init(node_number);
+        positions.init(node_number);
+
+        int i = 0;
+        node v;
+        forall_nodes(v, G)
+        {
+            nodes[i] = v;
+            positions[i] = A[v].get_position();
+            ++i;
+        }
+
+        F_rep_ptr = &F_rep;
+        _thread_team->run(this, &FruchtermanReingold::exact_repulsive_forces_kernel);
+        F_rep_ptr = 0;
+    }
+
+
+    void FruchtermanReingold::exact_repulsive_forces_kernel(int t)
+    {
+        numexcept N;
+        const int node_number = nodes.size();
+        const int num_threads = min(number_of_threads(), max(node_number / 256, 1));
+        if(t >= num_threads)
+            return;
+        const int last = threadRangeBegin(node_number, t + 1, num_threads);
+
+        for(int i = threadRangeBegin(node_number, t, num_threads); i < last; i++)
+        {
+            const int index_v = nodes[i]->index();
+            DPoint f(0, 0);
+            for(int j = 0; j < node_number; j++)
+            {
+                if(j == i) continue;
+                f = f + fmmmRepulsiveForce(N, positions[j], nodes[j]->index(), positions[i], index_v);
+            }
+            (*F_rep_ptr)[nodes[i]] = f;
+        }
+    }
+
+
+    void FruchtermanReingold::calculate_approx_repulsive_forces_in_parallel(
+        const Graph & G,
+        NodeArray<NodeAttributes> & A,
+        NodeArray<DPoint> & F_rep)
+    {
+        max_gridindex = static_cast<int>(sqrt(double(G.numberOfNodes())) / grid_quotient()) - 1;
+        max_gridindex = ((max_gridindex > 0) ? max_gridindex : 0);
+
+        //sort the nodes by grid box (counting sort); box (i,j) has number
+        //i*(max_gridindex+1)+j
+        const int row_length = max_gridindex + 1;
+        const int box_number = row_length * row_length;
+        const double gridboxlength = boxlength / row_length;
+        NodeArray<int> box(G);
+
+        box_start.init(0, box_number, 0);
+        node v;
+        forall_nodes(v, G)
+        {
+            int x_index = static_cast<int>((A[v].get_x() - down_left_corner.m_x) / gridboxlength);
+            int y_index = static_cast<int>((A[v].get_y() - down_left_corner.m_y) / gridboxlength);
+            x_index = max(0, min(x_index, max_gridindex));
+            y_index = max(0, min(y_index, max_gridindex));
+            box[v] = x_index * row_length + y_index;
+            ++box_start[box[v] + 1];
+        }
+        for(int b = 0; b < box_number; b++)
+            box_start[b + 1] += box_start[b];
+
+        nodes.init(G.numberOfNodes());
+        positions.init(G.numberOfNodes());
+        Array<int> next(0, box_number - 1);
+        for(int b = 0; b < box_number; b++)
+            next[b] = box_start[b];
+        forall_nodes(v, G)
+        {
+            int pos = next[box[v]]++;
+            nodes[pos] = v;
+            positions[pos] = A[v].get_position();
+        }
+
+        F_rep_ptr = &F_rep;
+        _thread_team->run(this, &FruchtermanReingold::approx_repulsive_forces_kernel);
+        F_rep_ptr = 0;
+    }
+
+
+    void FruchtermanReingold::approx_repulsive_forces_kernel(int t)
+    {
+        numexcept N;
+        const int row_length = max_gridindex + 1;
+        const int num_threads = min(number_of_threads(), row_length);
+        if(t >= num_threads)
+            return;
+        const int last_i = threadRangeBegin(row_length, t + 1, num_threads);
+
+        for(int i = threadRangeBegin(row_length, t, num_threads); i < last_i; i++)
+            for(int j = 0; j <= max_gridindex; j++)
+            {
+                const int b = i * row_length + j;
+                for(int p = box_start[b]; p < box_start[b + 1]; p++)
+                {
+                    const int index_v = nodes[p]->index();
+                    DPoint f(0, 0);
+
+                    //the neighbour boxes (k,j-1),...,(k,j+1) are stored consecutively
+                    for(int k = max(i - 1, 0); k <= min(i + 1, max_gridindex); k++)
+                    {
+                        const int first = box_start[k * row_length + max(j - 1, 0)];
+                        const int last = box_start[k * row_length + min(j + 1, max_gridindex) + 1];
+                        for(int q = first; q < last; q++)
+                        {
+                            if(q == p) continue;
+                            f = f + fmmmRepulsiveForce(N, positions[q], nodes[q]->index(), positions[p], index_v);
+                        }
+                    }
+                    (*F_rep_ptr)[nodes[p]] = f;
+                }
+            }
+    }
+
+
     void FruchtermanReingold::make_initialisations(double bl, DPoint d_l_c, int grid_quot)
     {
         grid_quotient(grid_quot);
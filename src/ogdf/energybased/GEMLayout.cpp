@@ -48,11 +48,295 @@
 #include <ogdf/basic/simple_graph_alg.h>
 #include <ogdf/basic/GraphCopyAttributes.h>
 #include <ogdf/packing/TileToRowsCCPacker.h>
+#include <ogdf/internal/energybased/LinearQuadTreeNM.h>
+#include <ogdf/basic/ThreadTeam.h>
 
 
 namespace ogdf
 {
 
+    //! Maximal number of nodes in a leaf of the quadtree.
+    static const int PARTICLES_IN_LEAVES = 8;
+
+    //! Minimal number of nodes of a connected component for using threads.
+    static const int MIN_NODES_FOR_THREADS = 1000;
+
+
+    //---------------------------------------------------------
+    // GEMLayout::RepulsionTree
+    //
+    // Barnes-Hut approximation of the repulsive forces. The
+    // structure of the quadtree is only changed by build(); when
+    // a node moves, update() moves the centers of the cells
+    // containing it, so the sums are always exact while the
+    // cells themselves may become too small until the next
+    // rebuild.
+    //---------------------------------------------------------
+
+    class GEMLayout::RepulsionTree
+    {
+    public:
+        RepulsionTree(const GraphCopy & GC, double theta) :
+            m_GC(GC), m_theta2(theta * theta), m_position(GC), m_slot(GC) { }
+
+        //! Builds the quadtree for the current layout \a AGC.
+        void build(const GraphCopyAttributes & AGC);
+
+        //! Moves node \a v to (\a x,\a y).
+        void update(node v, double x, double y);
+
+        //! Adds the repulsive forces acting on node \a v at (\a x,\a y) to (\a impulseX,\a impulseY).
+        void addRepulsion(node v, double x, double y, double desiredSqu,
+                          double & impulseX, double & impulseY) const;
+
+    private:
+        const GraphCopy & m_GC;
+        double m_theta2; //!< the square of the opening criterion
+
+        LinearQuadTreeNM  m_tree;
+        NodeArray<NodeAttributes> m_position; //!< positions of the nodes when building the tree
+        NodeArray<int>    m_slot;     //!< position of each node in Morton order
+        Array<DPoint>     m_particle; //!< current positions of the nodes in Morton order
+        Array<int>        m_leafOf;   //!< leaf containing the k-th node in Morton order
+        Array<double>     m_sumX;     //!< sum of the x-coordinates of the nodes in a cell
+        Array<double>     m_sumY;     //!< sum of the y-coordinates of the nodes in a cell
+    };
+
+
+    void GEMLayout::RepulsionTree::build(const GraphCopyAttributes & AGC)
+    {
+        const int n = m_GC.numberOfNodes();
+
+        // the quadratic box containing all nodes
+        node v = m_GC.firstNode();
+        double minX = AGC.x(v), maxX = AGC.x(v), minY = AGC.y(v), maxY = AGC.y(v);
+        forall_nodes(v, m_GC)
+        {
+            const double x = AGC.x(v), y = AGC.y(v);
+            m_position[v].set_position(DPoint(x, y));
+            if(x < minX) minX = x;
+            if(x > maxX) maxX = x;
+            if(y < minY) minY = y;
+            if(y > maxY) maxY = y;
+        }
+        double boxlength = max(maxX - minX, maxY - minY) * 1.001;
+        if(boxlength <= 0)
+            boxlength = 1;
+
+        m_tree.build(m_GC, m_position, DPoint(minX, minY), boxlength, PARTICLES_IN_LEAVES, 0);
+
+        if(m_particle.size() < n)
+        {
+            m_particle.init(n);
+            m_leafOf.init(n);
+        }
+        for(int k = 0; k < n; ++k)
+        {
+            m_particle[k] = m_tree.get_position(k);
+            m_slot[m_tree.get_particle(k)] = k;
+        }
+
+        // sum up the positions bottom-up; fathers have smaller indices than their children
+        const int numTreeNodes = m_tree.number_of_tree_nodes();
+        if(m_sumX.size() < numTreeNodes)
+        {
+            m_sumX.init(2 * n);
+            m_sumY.init(2 * n);
+        }
+        for(int l = 0; l < m_tree.number_of_leaves(); ++l)
+        {
+            const int i = m_tree.leaf(l);
+            const int first = m_tree.first_particle(i);
+            const int last = first + m_tree.number_of_particles(i);
+            double sumX = 0, sumY = 0;
+            for(int k = first; k < last; ++k)
+            {
+                sumX += m_particle[k].m_x;
+                sumY += m_particle[k].m_y;
+                m_leafOf[k] = i;
+            }
+            m_sumX[i] = sumX;
+            m_sumY[i] = sumY;
+        }
+        for(int i = numTreeNodes - 1; i >= 0; --i)
+        {
+            if(!m_tree.is_leaf(i))
+            {
+                double sumX = 0, sumY = 0;
+                const int firstChild = m_tree.first_child(i);
+                for(int c = firstChild; c < firstChild + m_tree.number_of_children(i); ++c)
+                {
+                    sumX += m_sumX[c];
+                    sumY += m_sumY[c];
+                }
+                m_sumX[i] = sumX;
+                m_sumY[i] = sumY;
+            }
+        }
+    }
+
+
+    void GEMLayout::RepulsionTree::update(node v, double x, double y)
+    {
+        const int k = m_slot[v];
+        const double dx = x - m_particle[k].m_x;
+        const double dy = y - m_particle[k].m_y;
+        m_particle[k] = DPoint(x, y);
+
+        for(int i = m_leafOf[k]; i >= 0; i = m_tree.get_father(i))
+        {
+            m_sumX[i] += dx;
+            m_sumY[i] += dy;
+        }
+    }
+
+
+    void GEMLayout::RepulsionTree::addRepulsion(
+        node v,
+        double x,
+        double y,
+        double desiredSqu,
+        double & impulseX,
+        double & impulseY) const
+    {
+        const int kv = m_slot[v];
+
+        // the depth of the tree is bounded by the number of levels of the grid
+        // of LinearQuadTreeNM (30), and at most 3 siblings wait on each level
+        int stack[128];
+        int top = 0;
+        stack[top++] = 0;
+
+        while(top > 0)
+        {
+            const int i = stack[--top];
+            const int first = m_tree.first_particle(i);
+            const int num = m_tree.number_of_particles(i);
+
+            // replace cells not containing v by their centers if they are far enough
+            if(kv < first || kv >= first + num)
+            {
+                const double deltaX = x - m_sumX[i] / num;
+                const double deltaY = y - m_sumY[i] / num;
+                const double deltaSqu = deltaX * deltaX + deltaY * deltaY;
+                const double boxlength = m_tree.get_Sm_boxlength(i);
+                if(boxlength * boxlength < m_theta2 * deltaSqu)
+                {
+                    impulseX += num * deltaX * desiredSqu / deltaSqu;
+                    impulseY += num * deltaY * desiredSqu / deltaSqu;
+                    continue;
+                }
+            }
+
+            if(m_tree.is_leaf(i))
+            {
+                for(int k = first; k < first + num; ++k)
+                {
+                    if(k == kv)
+                        continue;
+                    const double deltaX = x - m_particle[k].m_x;
+                    const double deltaY = y - m_particle[k].m_y;
+                    const double delta = sqrt(deltaX * deltaX + deltaY * deltaY);
+                    if(DIsGreater(delta, 0))
+                    {
+                        const double deltaSqu = delta * delta;
+                        impulseX += deltaX * desiredSqu / deltaSqu;
+                        impulseY += deltaY * desiredSqu / deltaSqu;
+                    }
+                }
+            }
+            else
+            {
+                const int firstChild = m_tree.first_child(i);
+                for(int c = firstChild + m_tree.number_of_children(i) - 1; c >= firstChild; --c)
+                    stack[top++] = c;
+            }
+        }
+    }
+
+
+    //---------------------------------------------------------
+    // GEMLayout::ImpulseBatch
+    //---------------------------------------------------------
+
+    class GEMLayout::ImpulseBatch
+    {
+    public:
+        ImpulseBatch(const GEMLayout & gem,
+                     const GraphCopy & GC,
+                     const GraphCopyAttributes & AGC,
+                     const RepulsionTree* tree,
+                     int batchSize,
+                     int numThreads) :
+            m_gem(gem), m_GC(GC), m_AGC(AGC), m_tree(tree), m_size(0),
+            m_node(batchSize), m_disturbX(batchSize), m_disturbY(batchSize),
+            m_impulse(2 * batchSize),
+            m_team(this, numThreads) { }
+
+        //! Appends node \a v to the batch and draws its disturbance.
+        void push(node v)
+        {
+            m_node[m_size] = v;
+            m_gem.randomDisturbance(m_disturbX[m_size], m_disturbY[m_size]);
+            ++m_size;
+        }
+
+        //! Removes all nodes from the batch.
+        void clear()
+        {
+            m_size = 0;
+        }
+
+        int size() const
+        {
+            return m_size;
+        }
+
+        node operator[](int j) const
+        {
+            return m_node[j];
+        }
+
+        double impulseX(int j) const
+        {
+            return m_impulse[2 * j];
+        }
+
+        double impulseY(int j) const
+        {
+            return m_impulse[2 * j + 1];
+        }
+
+        //! Computes the impulses of all nodes of the batch.
+        void computeImpulses()
+        {
+            m_team.run(&ImpulseBatch::impulseTask);
+        }
+
+    private:
+        const GEMLayout & m_gem;
+        const GraphCopy & m_GC;
+        const GraphCopyAttributes & m_AGC;
+        const RepulsionTree* m_tree;
+
+        int m_size;
+        Array<node>   m_node;
+        Array<double> m_disturbX, m_disturbY;
+        Array<double> m_impulse; //!< the impulses (x- and y-coordinates interleaved)
+
+        ThreadTeam<ImpulseBatch> m_team;
+
+        void impulseTask(int t)
+        {
+            const int numThreads = m_team.numThreads();
+            const int end = threadRangeBegin(m_size, t + 1, numThreads);
+            for(int j = threadRangeBegin(m_size, t, numThreads); j < end; ++j)
+                m_gem.computeImpulse(m_GC, m_AGC, m_tree, m_node[j],
+                                     m_disturbX[j], m_disturbY[j], &m_impulse[2 * j]);
+        }
+    };
+
+
     GEMLayout::GEMLayout() :
         m_numberOfRounds(30000),
         m_minimalTemperature(0.005),
@@ -66,7 +350,12 @@ namespace ogdf
         m_oscillationSensitivity(0.3),
         m_attractionFormula(1),
         m_minDistCC(LayoutStandards::defaultCCSeparation()),
-        m_pageRatio(1.0)
+        m_pageRatio(1.0),
+        m_useQuadTree(false),
+        m_quadTreeTheta(0.6),
+        m_quadTreeRebuildInterval(1),
+        m_batchSize(1),
+        m_numberOfThreads(1)
     { }
 
     GEMLayout::GEMLayout(const GEMLayout & fl) :
@@ -82,7 +371,12 @@ namespace ogdf
         m_oscillationSensitivity(fl.m_oscillationSensitivity),
         m_attractionFormula(fl.m_attractionFormula),
         m_minDistCC(fl.m_minDistCC),
-        m_pageRatio(fl.m_pageRatio)
+        m_pageRatio(fl.m_pageRatio),
+        m_useQuadTree(fl.m_useQuadTree),
+        m_quadTreeTheta(fl.m_quadTreeTheta),
+        m_quadTreeRebuildInterval(fl.m_quadTreeRebuildInterval),
+        m_batchSize(fl.m_batchSize),
+        m_numberOfThreads(fl.m_numberOfThreads)
     { }
 
 
@@ -102,6 +396,11 @@ namespace ogdf
         m_rotationSensitivity = fl.m_rotationSensitivity;
         m_oscillationSensitivity = fl.m_oscillationSensitivity;
         m_attractionFormula = fl.m_attractionFormula;
+        m_useQuadTree = fl.m_useQuadTree;
+        m_quadTreeTheta = fl.m_quadTreeTheta;
+        m_quadTreeRebuildInterval = fl.m_quadTreeRebuildInterval;
+        m_batchSize = fl.m_batchSize;
+        m_numberOfThreads = fl.m_numberOfThreads;
         return *this;
     }
 
@@ -167,28 +466,80 @@ namespace ogdf
             m_cos = cos(m_oscillationAngle / 2.0);
             m_sin = sin(Math::pi / 2 + m_rotationAngle / 2.0);
 
+            RepulsionTree* tree = m_useQuadTree ? new RepulsionTree(GC, m_quadTreeTheta) : 0;
+            int pass = 0;
+
             // main loop
             int counter = m_numberOfRounds;
-            while(DIsGreater(m_globalTemperature, m_minimalTemperature) && counter--)
+            if(m_batchSize == 1)
             {
-
-                // choose nodes by random permutations
-                if(permutation.empty())
+                while(DIsGreater(m_globalTemperature, m_minimalTemperature) && counter--)
                 {
-                    forall_nodes(v, GC)
-                    permutation.pushBack(v);
-                    permutation.permute();
-                }
-                v = permutation.popFrontRet();
 
-                // compute the impulse of node v
-                computeImpulse(GC, AGC, v);
+                    // choose nodes by random permutations
+                    if(permutation.empty())
+                    {
+                        forall_nodes(v, GC)
+                        permutation.pushBack(v);
+                        permutation.permute();
+
+                        if(tree != 0 && pass++ % m_quadTreeRebuildInterval == 0)
+                            tree->build(AGC);
+                    }
+                    v = permutation.popFrontRet();
+
+                    // compute the impulse of node v
+                    computeImpulse(GC, AGC, tree, v);
 
-                // update node v
-                updateNode(GC, AGC, v);
+                    // update node v
+                    updateNode(GC, AGC, v);
+                    if(tree != 0)
+                        tree->update(v, AGC.x(v), AGC.y(v));
 
+                }
+            }
+            else
+            {
+                // the batches never extend over two permutations, hence
+                // every node occurs at most once in a batch
+                int numThreads = (GC.numberOfNodes() >= MIN_NODES_FOR_THREADS) ? min(m_numberOfThreads, m_batchSize) : 1;
+                ImpulseBatch batch(*this, GC, AGC, tree, m_batchSize, numThreads);
+
+                while(DIsGreater(m_globalTemperature, m_minimalTemperature) && counter > 0)
+                {
+                    if(permutation.empty())
+                    {
+                        forall_nodes(v, GC)
+                        permutation.pushBack(v);
+                        permutation.permute();
+
+                        if(tree != 0 && pass++ % m_quadTreeRebuildInterval == 0)
+                            tree->build(AGC);
+                    }
+
+                    batch.clear();
+                    while(batch.size() < m_batchSize && batch.size() < counter && !permutation.empty())
+                        batch.push(permutation.popFrontRet());
+                    counter -= batch.size();
+
+                    // compute the impulses from the same layout
+                    batch.computeImpulses();
+
+                    // update the nodes one after the other
+                    for(int j = 0; j < batch.size(); ++j)
+                    {
+                        v = batch[j];
+                        m_newImpulseX = batch.impulseX(j);
+                        m_newImpulseY = batch.impulseY(j);
+                        updateNode(GC, AGC, v);
+                        if(tree != 0)
+                            tree->update(v, AGC.x(v), AGC.y(v));
+                    }
+                }
             }
 
+            delete tree;
+
             node vFirst = GC.firstNode();
             double minX = AGC.x(vFirst), maxX = AGC.x(vFirst),
                    minY = AGC.y(vFirst), maxY = AGC.y(vFirst);
@@ -252,7 +603,23 @@ namespace ogdf
         m_localTemperature.init();
     }
 
-    void GEMLayout::computeImpulse(GraphCopy & G, GraphCopyAttributes & AG, node v)
+    void GEMLayout::computeImpulse(GraphCopy & G, GraphCopyAttributes & AG, const RepulsionTree* tree, node v)
+    {
+        double disturbX, disturbY, impulse[2];
+        randomDisturbance(disturbX, disturbY);
+        computeImpulse(G, AG, tree, v, disturbX, disturbY, impulse);
+        m_newImpulseX = impulse[0];
+        m_newImpulseY = impulse[1];
+    }
+
+    void GEMLayout::computeImpulse(
+        const GraphCopy & G,
+        const GraphCopyAttributes & AG,
+        const RepulsionTree* tree,
+        node v,
+        double disturbX,
+        double disturbY,
+        double* impulse) const
     {
         //const Graph &G = AG.constGraph();
         int n = G.numberOfNodes();
@@ -267,28 +634,30 @@ namespace ogdf
         desiredSqu = desiredLength * desiredLength;
 
         // compute attraction to center of gravity
-        m_newImpulseX = (m_barycenterX / n - AG.x(v)) * m_gravitationalConstant;
-        m_newImpulseY = (m_barycenterY / n - AG.y(v)) * m_gravitationalConstant;
+        impulse[0] = (m_barycenterX / n - AG.x(v)) * m_gravitationalConstant;
+        impulse[1] = (m_barycenterY / n - AG.y(v)) * m_gravitationalConstant;
 
         // disturb randomly
-        int maxIntDisturbance = (int)(m_maximalDisturbance * 10000);
-        m_newImpulseX +=
-            (double)(randomNumber(-maxIntDisturbance, maxIntDisturbance) / 10000);
-        m_newImpulseY +=
-            (double)(randomNumber(-maxIntDisturbance, maxIntDisturbance) / 10000);
+        impulse[0] += disturbX;
+        impulse[1] += disturbY;
 
         // compute repulsive forces
-        forall_nodes(u, G)
-        if(u != v)
+        if(tree != 0)
+            tree->addRepulsion(v, AG.x(v), AG.y(v), desiredSqu, impulse[0], impulse[1]);
+        else
         {
-            deltaX = AG.x(v) - AG.x(u);
-            deltaY = AG.y(v) - AG.y(u);
-            delta = length(deltaX, deltaY);
-            if(DIsGreater(delta, 0))
+            forall_nodes(u, G)
+            if(u != v)
             {
-                deltaSqu = delta * delta;
-                m_newImpulseX += deltaX * desiredSqu / deltaSqu;
-                m_newImpulseY += deltaY * desiredSqu / deltaSqu;
+                deltaX = AG.x(v) - AG.x(u);
+                deltaY = AG.y(v) - AG.y(u);
+                delta = length(deltaX, deltaY);
+                if(DIsGreater(delta, 0))
+                {
+                    deltaSqu = delta * delta;
+                    impulse[0] += deltaX * desiredSqu / deltaSqu;
+                    impulse[1] += deltaY * desiredSqu / deltaSqu;
+                }
             }
         }
 
@@ -301,19 +670,26 @@ namespace ogdf
             delta = length(deltaX, deltaY);
             if(m_attractionFormula == 1)
             {
-                m_newImpulseX -= deltaX * delta / (desiredLength * weight(v));
-                m_newImpulseY -= deltaY * delta / (desiredLength * weight(v));
+                impulse[0] -= deltaX * delta / (desiredLength * weight(v));
+                impulse[1] -= deltaY * delta / (desiredLength * weight(v));
             }
             else
             {
                 deltaSqu = delta * delta;
-                m_newImpulseX -= deltaX * deltaSqu / (desiredSqu * weight(v));
-                m_newImpulseY -= deltaY * deltaSqu / (desiredSqu * weight(v));
+                impulse[0] -= deltaX * deltaSqu / (desiredSqu * weight(v));
+                impulse[1] -= deltaY * deltaSqu / (desiredSqu * weight(v));
             }
         }
 
     }
 
+    void GEMLayout::randomDisturbance(double & disturbX, double & disturbY) const
+    {
+        int maxIntDisturbance = (int)(m_maximalDisturbance * 10000);
+        disturbX = (double)(randomNumber(-maxIntDisturbance, maxIntDisturbance) / 10000);
+        disturbY = (double)(randomNumber(-maxIntDisturbance, maxIntDisturbance) / 10000);
+    }
+
     void GEMLayout::updateNode(GraphCopy & G, GraphCopyAttributes & AG, node v)
     {
         //const Graph &G = AG.constGraph();
@@ -42,7 +42,9 @@
 
 #include "GalaxyMultilevel.h"
 #include "FastUtils.h"
+#include <ogdf/basic/ThreadTeam.h>
 #include <ogdf/basic/Array.h>
+#include <ogdf/internal/energybased/ParallelCoarsening.h>
 
 namespace ogdf
 {
@@ -54,7 +56,6 @@ namespace ogdf
         forall_nodes(v, *m_pGraph)
         {
             m_nodeState[v].sysMass = (*m_pNodeInfo)[v].mass;
-            m_nodeState[v].label = 0;
             m_nodeState[v].lastVisitor = v;
         }
 
@@ -72,56 +73,90 @@ namespace ogdf
     }
 
 
-    void swap(ogdf::GalaxyMultilevelBuilder::NodeOrderInfo & a, ogdf::GalaxyMultilevelBuilder::NodeOrderInfo & b)
+    void GalaxyMultilevelBuilder::selectSuns()
     {
-        ogdf::GalaxyMultilevelBuilder::NodeOrderInfo t = a;
-        a = b;
-        b = t;
-    }
-
-
-    void GalaxyMultilevelBuilder::sortNodesBySystemMass()
-    {
-        int i = 0;
+        // the suns are the nodes that are chosen greedily in the order of increasing
+        // system mass such that no two suns have distance 2 or less
+        NodeArray<double> sysMass(*m_pGraph);
         node v = 0;
-        m_pRandomSet = new RandomNodeSet(*m_pGraph);
-        for(i = 0; i < m_pGraph->numberOfNodes(); i++)
+        forall_nodes(v, *m_pGraph)
         {
-            v = m_pRandomSet->chooseNode();
-            m_pRandomSet->removeNode(v);
-            m_nodeMassOrder[i].theNode = v;
+            sysMass[v] = m_nodeState[v].sysMass;
         }
+        m_seed = (__uint32)randomNumber(0, numeric_limits<int>::max());
+        ParallelCoarsening::independentSet(*m_pGraph, m_isSun, m_dist, m_seed, m_numThreads, &sysMass);
+    }
 
-        delete m_pRandomSet;
-        std::sort(m_nodeMassOrder, m_nodeMassOrder + (m_pGraph->numberOfNodes()), NodeMassComparer(m_nodeState));
+
+    // the order in which ParallelCoarsening has selected the suns
+    bool GalaxyMultilevelBuilder::precedes(node u, node v) const
+    {
+        if(m_nodeState[u].sysMass != m_nodeState[v].sysMass)
+            return m_nodeState[u].sysMass < m_nodeState[v].sysMass;
+        __uint32 pu = ParallelCoarsening::priority(m_seed, u->index());
+        __uint32 pv = ParallelCoarsening::priority(m_seed, v->index());
+        if(pu != pv)
+            return pu < pv;
+        return u->index() < v->index();
     }
 
 
-    void GalaxyMultilevelBuilder::labelSystem(node u, node v, int d, float df)
+    void GalaxyMultilevelBuilder::labelSystem(int threadNr)
     {
-        if(d > 0)
+        const int begin = threadRangeBegin(m_nodes.size(), threadNr, m_numThreads);
+        const int end = threadRangeBegin(m_nodes.size(), threadNr + 1, m_numThreads);
+
+        // every node belongs to the nearest sun (in hops), ties are broken by the
+        // order of the suns; the distance to the sun is the shortest length of
+        // the paths with the least number of hops
+        for(int i = begin; i < end; i++)
         {
+            node v = m_nodes[i];
+            LevelNodeState & state = m_nodeState[v];
+            state.lastVisitor = v;
+            state.edgeLengthFromSun = 0.0;
+            if(m_isSun[v])
+                continue;
+
+            node sun = 0;
+            float dist = 0.0;
             adjEntry adj;
             forall_adj(adj, v)
             {
                 node w = adj->twinNode();
-                // this node may have been labeled before but its closer to the current sun
-                if(m_nodeState[w].label < d)
+                float currDistFromSun = (*m_pEdgeInfo)[adj->theEdge()].length;
+                if(m_isSun[w] && (sun == 0 || (w == sun && currDistFromSun < dist)))
                 {
-                    float currDistFromSun = (*m_pEdgeInfo)[adj->theEdge()].length + df /*+ (*m_pNodeInfo)[w].radius*/;
-                    // check if we relabeling by a new sun
-                    if(m_nodeState[w].lastVisitor != u)
+                    sun = w;
+                    dist = currDistFromSun;
+                }
+            }
+
+            if(sun == 0)
+            {
+                forall_adj(adj, v)
+                {
+                    node w = adj->twinNode();
+                    float df = (*m_pEdgeInfo)[adj->theEdge()].length;
+                    adjEntry adj2;
+                    forall_adj(adj2, w)
                     {
-                        // maybe this node has never been labeled
-                        m_nodeState[w].lastVisitor = u;
-                        m_nodeState[w].edgeLengthFromSun = currDistFromSun;
+                        node x = adj2->twinNode();
+                        if(!m_isSun[x] || x == v)
+                            continue;
+                        float currDistFromSun = df + (*m_pEdgeInfo)[adj2->theEdge()].length;
+                        if(sun == 0 || precedes(x, sun) || (x == sun && currDistFromSun < dist))
+                        {
+                            sun = x;
+                            dist = currDistFromSun;
+                        }
                     }
-                    // finally relabel it
-                    m_nodeState[w].edgeLengthFromSun = min(m_nodeState[w].edgeLengthFromSun, currDistFromSun);
-                    m_nodeState[w].label = d;
-                    labelSystem(u, w, d - 1, currDistFromSun /*+(*m_pNodeInfo)[w].radius*/);
                 }
             }
+
+            OGDF_ASSERT(sun != 0);
+            state.lastVisitor = sun;
+            state.edgeLengthFromSun = dist;
         }
     }
 
@@ -129,25 +164,21 @@ namespace ogdf
     void GalaxyMultilevelBuilder::labelSystem()
     {
         m_sunNodeList.clear();
+        m_nodes.init(m_pGraph->numberOfNodes());
+        int i = 0;
         node v = 0;
         forall_nodes(v, *m_pGraph)
         {
-            m_nodeState[v].sysMass = 0;
-            m_nodeState[v].label = 0;
-            m_nodeState[v].lastVisitor = v;
-        }
-
-        for(int i = 0; i < m_pGraph->numberOfNodes(); i++)
-        {
-            v = m_nodeMassOrder[i].theNode;
-            if(m_nodeState[v].label == 0)
-            {
+            m_nodes[i++] = v;
+            if(m_isSun[v])
                 m_sunNodeList.pushBack(v);
-                m_nodeState[v].label = (m_dist + 1);
-                m_nodeState[v].edgeLengthFromSun = 0.0;//(*m_pNodeInfo)[v].radius;
-                labelSystem(v, v, m_dist, m_nodeState[v].edgeLengthFromSun);
-            }
         }
+
+        int numThreads = m_numThreads;
+        m_numThreads = max(1, min(m_numThreads, m_pGraph->numberOfNodes() / 1000));
+        runKernelThreads(this, &GalaxyMultilevelBuilder::labelSystem, m_numThreads);
+        m_numThreads = numThreads;
+        m_nodes.init();
     }
 
 
@@ -157,16 +188,15 @@ namespace ogdf
         m_pGraph = pMultiLevel->m_pGraph;
         m_pNodeInfo = pMultiLevel->m_pNodeInfo;
         m_pEdgeInfo = pMultiLevel->m_pEdgeInfo;
-        m_nodeMassOrder = (NodeOrderInfo*)MALLOC_16(sizeof(NodeOrderInfo) * m_pGraph->numberOfNodes());
         m_nodeState.init(*m_pGraph);
 
         this->computeSystemMass();
-        this->sortNodesBySystemMass();
+        this->selectSuns();
         this->labelSystem();
         GalaxyMultilevel* pMultiLevelResult = new GalaxyMultilevel(pMultiLevel);
         this->createResult(pMultiLevelResult);;
 
-        FREE_16(m_nodeMassOrder);
+        m_isSun.init();
 
         return pMultiLevelResult;
     }
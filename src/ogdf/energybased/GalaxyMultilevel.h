@@ -118,23 +118,26 @@ namespace ogdf
         {
             node lastVisitor;
             double sysMass;
-            int label;
             float edgeLengthFromSun;
         };
 
-        struct NodeOrderInfo
+        GalaxyMultilevelBuilder() : m_numThreads(1) { }
+
+        //! Sets the number of threads used for selecting the suns and labeling the systems.
+        void setNumberOfThreads(int numThreads)
         {
-            node theNode;
-        };
+            m_numThreads = max(1, numThreads);
+        }
 
         GalaxyMultilevel* build(GalaxyMultilevel* pMultiLevel);
 
     private:
         void computeSystemMass();
-        void sortNodesBySystemMass();
-        void createResult(GalaxyMultilevel* pMultiLevelResult);
-        void labelSystem(node u, node v, int d, float df);
+        void selectSuns();
+        bool precedes(node u, node v) const;
+        void labelSystem(int threadNr);
         void labelSystem();
+        void createResult(GalaxyMultilevel* pMultiLevelResult);
         Graph* m_pGraph;
         Graph* m_pGraphResult;
         List<node> m_sunNodeList;
@@ -144,25 +147,11 @@ namespace ogdf
         NodeArray<GalaxyMultilevel::LevelNodeInfo>* m_pNodeInfoResult;
         EdgeArray<GalaxyMultilevel::LevelEdgeInfo>* m_pEdgeInfoResult;
         NodeArray<LevelNodeState> m_nodeState;
-        NodeOrderInfo* m_nodeMassOrder;
-        RandomNodeSet* m_pRandomSet;
+        NodeArray<bool> m_isSun;
+        Array<node> m_nodes;
+        __uint32 m_seed;
         int m_dist;
-    };
-
-
-    class NodeMassComparer
-    {
-    public:
-        NodeMassComparer(const NodeArray<GalaxyMultilevelBuilder::LevelNodeState> & nodeState) : m_nodeState(nodeState) { }
-
-        // used for std::sort
-        inline bool operator()(const GalaxyMultilevelBuilder::NodeOrderInfo & a, const GalaxyMultilevelBuilder::NodeOrderInfo & b) const
-        {
-            return m_nodeState[a.theNode].sysMass < m_nodeState[b.theNode].sysMass;
-        }
-
-    private:
-        const NodeArray<GalaxyMultilevelBuilder::LevelNodeState> & m_nodeState;
+        int m_numThreads;
     };
 
 } // end of namespace ogdf
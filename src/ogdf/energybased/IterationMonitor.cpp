@@ -0,0 +1,75 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Implementation of class IterationMonitor.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#include <ogdf/energybased/IterationMonitor.h>
+
+
+namespace ogdf
+{
+
+    void IterationMonitor::start()
+    {
+        m_numberOfIterations = 0;
+        m_stopReason = srNone;
+        m_clock.start(true);
+    }
+
+
+    bool IterationMonitor::report(double energy, double maxDisplacement)
+    {
+        ++m_numberOfIterations;
+        const double elapsed = elapsedSeconds();
+        iterationDone(m_numberOfIterations, energy, maxDisplacement, elapsed);
+
+        if(maxDisplacement < m_tolerance)
+        {
+            m_stopReason = srConverged;
+            return true;
+        }
+        if(isTimeLimit() && elapsed >= m_timeLimit)
+        {
+            m_stopReason = srTimeLimit;
+            return true;
+        }
+        return false;
+    }
+
+} // end namespace ogdf
@@ -0,0 +1,284 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Implementation of class LinearQuadTreeNM.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#include <ogdf/internal/energybased/LinearQuadTreeNM.h>
+#include "FastUtils.h"
+#include <algorithm>
+#include <cmath>
+
+
+namespace ogdf
+{
+
+    //the number of levels below the root; positions are mapped to a grid of
+    //2^MAX_LEVEL x 2^MAX_LEVEL cells
+    static const int MAX_LEVEL = 30;
+
+
+    LinearQuadTreeNM::LinearQuadTreeNM()
+    {
+        m_particlesInLeaves = 1;
+        m_numberOfCoefficients = 1;
+        m_boxlength = 0;
+        m_numberOfParticles = 0;
+        m_numberOfTreeNodes = 0;
+    }
+
+
+    void LinearQuadTreeNM::clear()
+    {
+        m_numberOfParticles = 0;
+        m_numberOfTreeNodes = 0;
+        m_morton.init();
+        m_particle.init();
+        m_particleIndex.init();
+        m_position.init();
+        m_treeNode.init();
+        m_leaves.init();
+        m_lists.init();
+        m_ME.init();
+        m_LE.init();
+    }
+
+
+    void LinearQuadTreeNM::build(
+        const Graph & G,
+        NodeArray<NodeAttributes> & A,
+        DPoint dlc,
+        double boxlength,
+        int particles_in_leaves,
+        int precision)
+    {
+        const int n = G.numberOfNodes();
+        m_particlesInLeaves = particles_in_leaves;
+        m_numberOfCoefficients = precision + 1;
+        m_dlc = dlc;
+        m_boxlength = boxlength;
+        m_numberOfParticles = n;
+        m_numberOfTreeNodes = 0;
+        m_leaves.clear();
+        m_lists.clear();
+
+        if(n == 0)
+            return;
+
+        //a reduced quadtree with n leaves has at most 2n-1 nodes
+        if(m_morton.size() < n)
+        {
+            m_morton.init(n);
+            m_particle.init(n);
+            m_particleIndex.init(n);
+            m_position.init(n);
+            m_treeNode.init(2 * n);
+        }
+        if(m_ME.size() < 2 * n * m_numberOfCoefficients)
+        {
+            m_ME.init(2 * n * m_numberOfCoefficients);
+            m_LE.init(2 * n * m_numberOfCoefficients);
+        }
+
+        //sort the particles by the Morton numbers of their grid cells
+        const __uint32 max_coord = (__uint32(1) << MAX_LEVEL) - 1;
+        const double scale = (boxlength > 0) ? ldexp(1.0, MAX_LEVEL) / boxlength : 0;
+
+        int k = 0;
+        node v;
+        forall_nodes(v, G)
+        {
+            double x = (A[v].get_x() - dlc.m_x) * scale;
+            double y = (A[v].get_y() - dlc.m_y) * scale;
+            __uint32 ix = (x <= 0) ? 0 : ((x >= max_coord) ? max_coord : __uint32(x));
+            __uint32 iy = (y <= 0) ? 0 : ((y >= max_coord) ? max_coord : __uint32(y));
+            m_morton[k].m_code = mortonNumber<__uint64, __uint32>(ix, iy);
+            m_morton[k++].m_node = v;
+        }
+        std::sort(m_morton.begin(), m_morton.begin() + n);
+
+        for(k = 0; k < n; k++)
+        {
+            v = m_morton[k].m_node;
+            m_particle[k] = v;
+            m_particleIndex[k] = v->index();
+            m_position[k] = A[v].get_position();
+        }
+
+        //build the tree in breadth first order
+        TreeNode & root = m_treeNode[0];
+        root.m_father = -1;
+        root.m_firstParticle = 0;
+        root.m_numberOfParticles = n;
+        m_numberOfTreeNodes = 1;
+        set_small_cell(0, 0);
+
+        for(int i = 0; i < m_numberOfTreeNodes; i++)
+        {
+            const TreeNode & t = m_treeNode[i];
+            const int last = t.m_firstParticle + t.m_numberOfParticles - 1;
+            if(t.m_numberOfParticles > m_particlesInLeaves &&
+                    m_morton[t.m_firstParticle].m_code != m_morton[last].m_code)
+                split(i);
+            else
+            {
+                m_treeNode[i].m_firstChild = -1;
+                m_treeNode[i].m_numberOfChildren = 0;
+            }
+        }
+
+        //collect the leaves in the order of their particles
+        ArrayBuffer<int> stack(4 * MAX_LEVEL + 4);
+        stack.push(0);
+        while(!stack.empty())
+        {
+            int i = stack.popRet();
+            if(is_leaf(i))
+                m_leaves.push(i);
+            else
+                for(int c = first_child(i) + number_of_children(i) - 1; c >= first_child(i); c--)
+                    stack.push(c);
+        }
+
+        //reset the expansions
+        const int number_of_coefficients = m_numberOfTreeNodes * m_numberOfCoefficients;
+        complex<double> null_complex(0, 0);
+        for(k = 0; k < number_of_coefficients; k++)
+            m_ME[k] = m_LE[k] = null_complex;
+    }
+
+
+    void LinearQuadTreeNM::set_small_cell(int i, int min_level)
+    {
+        TreeNode & t = m_treeNode[i];
+        __uint64 code_first = m_morton[t.m_firstParticle].m_code;
+        __uint64 code_last = m_morton[t.m_firstParticle + t.m_numberOfParticles - 1].m_code;
+
+        //the small cell is the cell on the deepest level containing the particles with
+        //the smallest and the largest Morton number; if all particles lie in the same
+        //grid cell, the cell on min_level is used
+        int level = min_level;
+        __uint64 diff = code_first ^ code_last;
+        if(diff != 0)
+        {
+            int msb = 0;
+            while((diff >> msb) > 1)
+                msb++;
+            level = MAX_LEVEL - 1 - msb / 2;
+        }
+
+        __uint32 ix, iy;
+        mortonNumberInv<__uint64, __uint32>(code_first, ix, iy);
+        ix >>= MAX_LEVEL - level;
+        iy >>= MAX_LEVEL - level;
+
+        t.m_level = level;
+        t.m_boxlength = ldexp(m_boxlength, -level);
+        t.m_dlc.m_x = m_dlc.m_x + ix * t.m_boxlength;
+        t.m_dlc.m_y = m_dlc.m_y + iy * t.m_boxlength;
+    }
+
+
+    void LinearQuadTreeNM::split(int i)
+    {
+        TreeNode & t = m_treeNode[i];
+        const int last = t.m_firstParticle + t.m_numberOfParticles;
+        int first = t.m_firstParticle;
+
+        t.m_firstChild = m_numberOfTreeNodes;
+        t.m_numberOfChildren = 0;
+
+        for(int q = 0; q < 4 && first < last; q++)
+        {
+            int end = find_quadrant_end(first, last, t.m_level, q);
+            if(end > first)
+            {
+                TreeNode & c = m_treeNode[m_numberOfTreeNodes];
+                c.m_father = i;
+                c.m_firstParticle = first;
+                c.m_numberOfParticles = end - first;
+                set_small_cell(m_numberOfTreeNodes, t.m_level + 1);
+                m_numberOfTreeNodes++;
+                t.m_numberOfChildren++;
+            }
+            first = end;
+        }
+    }
+
+
+    int LinearQuadTreeNM::find_quadrant_end(int first, int last, int level, int q) const
+    {
+        const int shift = 2 * (MAX_LEVEL - 1 - level);
+        while(first < last)
+        {
+            int middle = first + (last - first) / 2;
+            if(int((m_morton[middle].m_code >> shift) & 3) <= q)
+                first = middle + 1;
+            else
+                last = middle;
+        }
+        return first;
+    }
+
+
+    void LinearQuadTreeNM::set_lists(
+        int i,
+        const ArrayBuffer<int> & I,
+        const ArrayBuffer<int> & D1,
+        const ArrayBuffer<int> & D2,
+        const ArrayBuffer<int> & M)
+    {
+        int* list_begin = m_treeNode[i].m_listBegin;
+        int k;
+
+        list_begin[0] = m_lists.size();
+        for(k = 0; k < I.size(); k++)
+            m_lists.push(I[k]);
+        list_begin[1] = m_lists.size();
+        for(k = 0; k < D1.size(); k++)
+            m_lists.push(D1[k]);
+        list_begin[2] = m_lists.size();
+        for(k = 0; k < D2.size(); k++)
+            m_lists.push(D2[k]);
+        list_begin[3] = m_lists.size();
+        for(k = 0; k < M.size(); k++)
+            m_lists.push(M[k]);
+        list_begin[4] = m_lists.size();
+    }
+
+}//namespace ogdf
@@ -43,6 +43,8 @@
 #include "LinearQuadtreeExpansion.h"
 #include "ComplexDouble.h"
 #include "WSPD.h"
+#include <ogdf/basic/SIMD.h>
+#include <ogdf/internal/basic/intrinsics.h>
 #include <complex>
 
 using namespace ogdf::sse;
@@ -50,10 +52,118 @@ using namespace ogdf::sse;
 namespace ogdf
 {
 
-    LinearQuadtreeExpansion::LinearQuadtreeExpansion(__uint32 precision, const LinearQuadtree & tree) : m_tree(tree), m_numCoeff(precision), binCoef(2 * m_numCoeff)
+    //! Array for temporary values of an expansion operator.
+    /**
+     * For the usual precisions the array is on the stack, hence the operators
+     * can be called by several threads without allocating memory.
+     */
+    template<class T, int N>
+    class ExpansionScratch
+    {
+    public:
+        ExpansionScratch(__uint32 size) : m_ptr((size <= N) ? m_local : new T[size]) { }
+
+        ~ExpansionScratch()
+        {
+            if(m_ptr != m_local)
+                delete[] m_ptr;
+        }
+
+        operator T* ()
+        {
+            return m_ptr;
+        }
+
+    private:
+        T  m_local[N];
+        T* m_ptr;
+    };
+
+
+    // The M2L kernels multiply the translation matrix (numRows rows of length stride)
+    // with the vector c of interleaved complex numbers; sum receives numRows complex
+    // numbers.
+
+    template<class T>
+    static void m2lKernel(const T* matrix, const T* c, __uint32 stride, __uint32 numRows, T* sum)
+    {
+        for(__uint32 l = 0; l < numRows; l++)
+        {
+            const T* row = matrix + l * stride;
+            T re = 0, im = 0;
+            for(__uint32 j = 0; j < stride; j += 2)
+            {
+                re += row[j] * c[j];
+                im += row[j + 1] * c[j + 1];
+            }
+            sum[2 * l]     = re;
+            sum[2 * l + 1] = im;
+        }
+    }
+
+
+#ifdef OGDF_AVX2_EXTENSIONS
+    OGDF_TARGET_AVX2 static void m2lKernel_avx2(
+        const double* matrix, const double* c, __uint32 stride, __uint32 numRows, double* sum)
+    {
+        for(__uint32 l = 0; l < numRows; l++)
+        {
+            const double* row = matrix + l * stride;
+            __m256d mm_sum = _mm256_setzero_pd();
+            for(__uint32 j = 0; j < stride; j += 4)
+                mm_sum = _mm256_fmadd_pd(_mm256_loadu_pd(row + j), _mm256_loadu_pd(c + j), mm_sum);
+
+            // | re0+re1 | im0+im1 |
+            _mm_storeu_pd(sum + 2 * l, _mm_add_pd(_mm256_castpd256_pd128(mm_sum), _mm256_extractf128_pd(mm_sum, 1)));
+        }
+    }
+
+
+    OGDF_TARGET_AVX2 static void m2lKernel_avx2(
+        const float* matrix, const float* c, __uint32 stride, __uint32 numRows, float* sum)
+    {
+        for(__uint32 l = 0; l < numRows; l++)
+        {
+            const float* row = matrix + l * stride;
+            __m256 mm_sum = _mm256_setzero_ps();
+            for(__uint32 j = 0; j < stride; j += 8)
+                mm_sum = _mm256_fmadd_ps(_mm256_loadu_ps(row + j), _mm256_loadu_ps(c + j), mm_sum);
+
+            // | re0+re2 | im0+im2 | re1+re3 | im1+im3 |
+            __m128 s = _mm_add_ps(_mm256_castps256_ps128(mm_sum), _mm256_extractf128_ps(mm_sum, 1));
+            // | re | im | ...
+            s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+            sum[2 * l]     = _mm_cvtss_f32(s);
+            sum[2 * l + 1] = _mm_cvtss_f32(_mm_shuffle_ps(s, s, 1));
+        }
+    }
+#endif
+
+
+    //! The M2L kernels in double and single precision.
+    template<class T>
+    struct M2LKernel
+    {
+        typedef void (*Function)(const T*, const T*, __uint32, __uint32, T*);
+
+        static SIMDKernel<Function> s_kernel;
+    };
+
+    template<class T>
+    SIMDKernel<typename M2LKernel<T>::Function> M2LKernel<T>::s_kernel =
+        SIMDKernel<typename M2LKernel<T>::Function>(m2lKernel<T>)
+#ifdef OGDF_AVX2_EXTENSIONS
+        .add(simdAVX2, m2lKernel_avx2)
+#endif
+        ;
+
+
+    LinearQuadtreeExpansion::LinearQuadtreeExpansion(__uint32 precision, const LinearQuadtree & tree, bool singlePrecision)
+        : m_tree(tree), m_numCoeff(precision), m_singlePrecision(singlePrecision)
     {
         m_numExp = m_tree.maxNumberOfNodes();
         allocate();
+        initTables();
     }
 
 
@@ -67,6 +177,13 @@ namespace ogdf
     {
         m_multiExp = (double*)MALLOC_16(m_numCoeff * sizeof(double) * 2 * m_numExp);
         m_localExp = (double*)MALLOC_16(m_numCoeff * sizeof(double) * 2 * m_numExp);
+
+        m_binCoefStride = 2 * m_numCoeff;
+        m_binCoef = (double*)MALLOC_16(m_binCoefStride * m_binCoefStride * sizeof(double));
+
+        m_m2lStride = (2 * (m_numCoeff - 1) + 7) & ~7;
+        m_m2lMatrix = (double*)MALLOC_16(max(m_numCoeff - 1, 1u) * m_m2lStride * sizeof(double));
+        m_m2lMatrixFloat = (float*)MALLOC_16(max(m_numCoeff - 1, 1u) * m_m2lStride * sizeof(float));
     }
 
 
@@ -74,6 +191,36 @@ namespace ogdf
     {
         FREE_16(m_multiExp);
         FREE_16(m_localExp);
+        FREE_16(m_binCoef);
+        FREE_16(m_m2lMatrix);
+        FREE_16(m_m2lMatrixFloat);
+    }
+
+
+    void LinearQuadtreeExpansion::initTables()
+    {
+        // Pascal's triangle
+        for(__uint32 n = 0; n < m_binCoefStride; n++)
+        {
+            double* row = m_binCoef + n * m_binCoefStride;
+            row[0] = row[n] = 1;
+            for(__uint32 k = 1; k < n; k++)
+                row[k] = binCoef(n - 1, k - 1) + binCoef(n - 1, k);
+            for(__uint32 k = n + 1; k < m_binCoefStride; k++)
+                row[k] = 0;
+        }
+
+        for(__uint32 l = 1; l < m_numCoeff; l++)
+        {
+            double* row = m_m2lMatrix + (l - 1) * m_m2lStride;
+            float* rowFloat = m_m2lMatrixFloat + (l - 1) * m_m2lStride;
+            for(__uint32 j = 0; j < m_m2lStride; j++)
+            {
+                __uint32 k = j / 2 + 1;
+                row[j] = (k < m_numCoeff) ? binCoef(l + k - 1, k - 1) : 0.0;
+                rowFloat[j] = (float)row[j];
+            }
+        }
     }
 
 
@@ -141,6 +288,15 @@ namespace ogdf
 
         ComplexDouble delta(ComplexDouble(center_x_source, center_y_source) - ComplexDouble(center_x_receiver, center_y_receiver));
 
+        // delta^k for k = 0,...,numCoeff-1
+        ExpansionScratch<double, 64> delta_pow(m_numCoeff << 1);
+        ComplexDouble delta_k(1.0, 0.0);
+        for(__uint32 k = 0; k < m_numCoeff; k++)
+        {
+            delta_k.store_unaligned(delta_pow + (k << 1));
+            delta_k *= delta;
+        }
+
         ComplexDouble a(source_coeff);
         ComplexDouble b(receiv_coeff);
         b += a;
@@ -148,14 +304,15 @@ namespace ogdf
         for(__uint32 l = 1; l < m_numCoeff; l++)
         {
             b.load(receiv_coeff + (l << 1));
-            ComplexDouble delta_k(1.0, 0.0);
+            const double* binCoef_l = m_binCoef + (l - 1) * m_binCoefStride;
             for(__uint32 k = 0; k < l; k++)
             {
                 a.load(source_coeff + ((l - k) << 1));
-                b += a * delta_k * binCoef.value(l - 1, k);
-                delta_k *= delta;
+                delta_k.load_unaligned(delta_pow + (k << 1));
+                b += a * delta_k * binCoef_l[k];
             }
             a.load(source_coeff);
+            delta_k.load_unaligned(delta_pow + (l << 1));
             b -= a * delta_k * (1 / (double)l);
             b.store(receiv_coeff + (l << 1));
         }
@@ -176,15 +333,25 @@ namespace ogdf
         ComplexDouble center_source(center_x_source, center_y_source);
         ComplexDouble delta(center_source - center_receiver);
 
+        // delta^k for k = 0,...,numCoeff-1
+        ExpansionScratch<double, 64> delta_pow(m_numCoeff << 1);
+        ComplexDouble delta_k(1.0, 0.0);
+        for(__uint32 k = 0; k < m_numCoeff; k++)
+        {
+            delta_k.store_unaligned(delta_pow + (k << 1));
+            delta_k *= delta;
+        }
+
+        ComplexDouble a;
+        ComplexDouble b;
         for(__uint32 l = 0; l < m_numCoeff; l++)
         {
-            ComplexDouble b(receiv_coeff + (l << 1));
-            ComplexDouble delta_k(1.0, 0.0);
+            b.load(receiv_coeff + (l << 1));
             for(__uint32 k = l; k < m_numCoeff; k++)
             {
-                ComplexDouble a(source_coeff + (k << 1));
-                b += a * delta_k * binCoef.value(k, l);
-                delta_k *= delta;
+                a.load(source_coeff + (k << 1));
+                delta_k.load_unaligned(delta_pow + ((k - l) << 1));
+                b += a * delta_k * binCoef(k, l);
             }
             b.store(receiv_coeff + (l << 1));
         }
@@ -204,57 +371,77 @@ namespace ogdf
         ComplexDouble center_receiver(center_x_receiver, center_y_receiver);
         ComplexDouble center_source(center_x_source, center_y_source);
         ComplexDouble delta0(center_source - center_receiver);
-
         ComplexDouble delta1 = -delta0;
-        ComplexDouble delta1_l(delta1);
+
+        // Instead of dividing by delta0^k in every term, the coefficients are
+        // multiplied by the powers of 1/delta0 once:
+        //   c_k = a_k / delta0^k                     (k = 1,...,numCoeff-1)
+        //   b_l += (sum_k binCoef(l+k-1, k-1) * c_k - a0 / l) / delta1^l
+        //   b_0 += a0 * log(delta1) + sum_k c_k * (-1)^k
+        // The sums over k are the product of the M2L matrix with c.
+        const __uint32 numRows = m_numCoeff - 1;
+        ExpansionScratch<double, 64> inv_delta0_pow(m_numCoeff << 1);
+        ExpansionScratch<double, 64> c(m_m2lStride);
+        ExpansionScratch<double, 64> sum(numRows << 1);
+
         ComplexDouble a;
         ComplexDouble a0(source_coeff);
         ComplexDouble b;
-        ComplexDouble sum;
+        ComplexDouble b0(receiv_coeff);
+
+        ComplexDouble inv_delta0 = ComplexDouble(1.0, 0.0) / delta0;
+        ComplexDouble inv_delta0_k(inv_delta0);
+        for(__uint32 k = 1; k < m_numCoeff; k++)
+        {
+            inv_delta0_k.store_unaligned(inv_delta0_pow + (k << 1));
+            a.load(source_coeff + (k << 1));
+            a *= inv_delta0_k;
+            a.store_unaligned(c + ((k - 1) << 1));
+            if(k & 1)
+                b0 -= a;
+            else
+                b0 += a;
+            inv_delta0_k *= inv_delta0;
+        }
+        for(__uint32 j = numRows << 1; j < m_m2lStride; j++)
+            c[j] = 0;
+
+        if(m_singlePrecision)
+        {
+            ExpansionScratch<float, 64> cFloat(m_m2lStride);
+            ExpansionScratch<float, 64> sumFloat(numRows << 1);
+            for(__uint32 j = 0; j < m_m2lStride; j++)
+                cFloat[j] = (float)c[j];
+
+            M2LKernel<float>::s_kernel.get()(m_m2lMatrixFloat, cFloat, m_m2lStride, numRows, sumFloat);
+
+            for(__uint32 j = 0; j < (numRows << 1); j++)
+                sum[j] = sumFloat[j];
+        }
+        else
+            M2LKernel<double>::s_kernel.get()(m_m2lMatrix, c, m_m2lStride, numRows, sum);
+
+        ComplexDouble sum_l;
         for(__uint32 l = 1; l < m_numCoeff; l++)
         {
             b.load(receiv_coeff + (l << 1));
-            sum = a0 * (-1 / (double)l);
-            ComplexDouble delta0_k(delta0);
-            for(__uint32 k = 1; k < m_numCoeff; k++)
-            {
-                a.load(source_coeff + (k << 1));
-                sum += (a * binCoef.value(l + k - 1, k - 1)) / delta0_k;
-                delta0_k *= delta0;
-            }
-
-            b += sum / delta1_l;
+            sum_l.load_unaligned(sum + ((l - 1) << 1));
+            sum_l -= a0 * (1 / (double)l);
+            // 1/delta1^l = (-1)^l / delta0^l
+            inv_delta0_k.load_unaligned(inv_delta0_pow + (l << 1));
+            if(l & 1)
+                b -= sum_l * inv_delta0_k;
+            else
+                b += sum_l * inv_delta0_k;
             b.store(receiv_coeff + (l << 1));
-            delta1_l *= delta1;
         }
 
         // b0
-        b.load(receiv_coeff);
-        //std::complex<double> sdelta(m_center[(receiver<<1)] - m_center[(source<<1)],  m_center[(receiver<<1)+1] - m_center[(source<<1) +1]);//, m_x[receiver] - m_x[source], m_y[receiver] - m_y[source]);
-        /*std::complex<double> sdelta(center_x_receiver - center_x_source,
-                                    center_y_receiver - center_y_source);//, m_x[receiver] - m_x[source], m_y[receiver] - m_y[source]);
-
-        if ((sdelta.real() <=0) && (sdelta.imag() == 0)) //no cont. compl. log fct exists !!!
-            sdelta = log(sdelta + 0.00000001);
-        else
-            sdelta = log(sdelta);
-
-        */
-        double r = delta1.length();//= sqrt(sdelta.real()*sdelta.real()+sdelta.imag()*sdelta.imag());
+        double r = delta1.length();
         double phi = atan((center_x_receiver - center_x_source) / (center_y_receiver - center_y_source));
         // sum = a0*log(z1 - z0)
-        b += a0 * ComplexDouble(log(r), phi);
-        // (z1 - z0)^1
-        //b += a0*ComplexDouble(sdelta.real(), sdelta.imag());
-        delta1_l = delta1;
-        for(__uint32 k = 1; k < m_numCoeff; k++)
-        {
-            a.load(source_coeff + (k << 1));
-            b += a / delta1_l;
-            //(z1 - z0)^k
-            delta1_l *= delta1;
-        }
-        b.store(receiv_coeff);
+        b0 += a0 * ComplexDouble(log(r), phi);
+        b0.store(receiv_coeff);
     }
 
 } // end of namespace ogdf
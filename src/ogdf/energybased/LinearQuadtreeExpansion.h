@@ -52,7 +52,11 @@ namespace ogdf
     {
     public:
         //! constructor
-        LinearQuadtreeExpansion(__uint32 precision, const LinearQuadtree & tree);
+        /**
+         * If \a singlePrecision is set, the translation matrix of M2L is applied
+         * in single precision; the coefficients are always stored in double precision.
+         */
+        LinearQuadtreeExpansion(__uint32 precision, const LinearQuadtree & tree, bool singlePrecision = false);
 
         //! destructor
         ~LinearQuadtreeExpansion(void);
@@ -101,6 +105,12 @@ namespace ogdf
         {
             return m_tree;
         }
+
+        //! returns the binomial coefficient n over k for n < 2 * numCoeff()
+        inline double binCoef(__uint32 n, __uint32 k) const
+        {
+            return m_binCoef[n * m_binCoefStride + k];
+        }
     private:
 
         //! allocates the space for the coeffs
@@ -109,6 +119,9 @@ namespace ogdf
         //! releases the memory for the coeffs
         void deallocate();
 
+        //! computes the binomial coefficients and the M2L translation matrix
+        void initTables();
+
         //! the Quadtree reference
         const LinearQuadtree & m_tree;
     public:
@@ -125,7 +138,25 @@ namespace ogdf
         //! the number of coeff per expansions
         __uint32 m_numCoeff;
 
-        BinCoeff<double> binCoef;
+    private:
+        //! the binomial coefficients (row n starts at n * m_binCoefStride)
+        double* m_binCoef;
+
+        //! the length of a row of m_binCoef
+        __uint32 m_binCoefStride;
+
+        //! the M2L translation matrix; entries 2k and 2k+1 of row l-1 are
+        //! binCoef(l+k-1, k-1) for l, k = 1,...,numCoeff-1 (rows are padded with 0)
+        double* m_m2lMatrix;
+
+        //! m_m2lMatrix in single precision
+        float* m_m2lMatrixFloat;
+
+        //! the length of a row of the M2L translation matrix (a multiple of 8)
+        __uint32 m_m2lStride;
+
+        //! apply the M2L translation matrix in single precision?
+        bool m_singlePrecision;
     };
 
 
@@ -760,6 +760,126 @@ namespace ogdf
     }
 
 
+    int MultilevelGraph::collapse(const std::vector<NodeCollapse> & merges, int adjustEdgeLengths)
+    {
+        // parentEdge[x] is the first edge between the current parent and x
+        NodeArray<edge> parentEdge(*m_G, 0);
+        std::vector<node> parentNeighbors;
+        node currentParent = 0;
+        // edgeStamp[e] is the number of the last merge that recorded edge e
+        EdgeArray<int> edgeStamp(*m_G, -1);
+        std::vector<edge> adjEdges;
+        int numMerged = 0;
+
+        for(int i = 0; i < (int)merges.size(); i++)
+        {
+            node theNode = merges[i].m_merged;
+            node parent = merges[i].m_parent;
+            NodeMerge* NM = merges[i].m_NM;
+
+            if(getNode(theNode->index()) != theNode || getNode(parent->index()) != parent || theNode == parent)
+            {
+                delete NM;
+                continue;
+            }
+
+            changeNode(NM, parent, merges[i].m_radius, theNode);
+
+            if(parent != currentParent)
+            {
+                for(std::vector<node>::iterator it = parentNeighbors.begin(); it != parentNeighbors.end(); ++it)
+                    parentEdge[*it] = 0;
+                parentNeighbors.clear();
+
+                currentParent = parent;
+                adjEntry adj;
+                forall_adj(adj, parent)
+                {
+                    node x = adj->twinNode();
+                    if(x != parent && parentEdge[x] == 0)
+                    {
+                        parentEdge[x] = adj->theEdge();
+                        parentNeighbors.push_back(x);
+                    }
+                }
+            }
+
+            adjEdges.clear();
+            double nodeToParentLen = 0.0;
+            bool parentFound = false;
+            edge e;
+            forall_adj_edges(e, theNode)
+            {
+                adjEdges.push_back(e);
+                if(!parentFound && e->opposite(theNode) == parent)
+                {
+                    nodeToParentLen = m_weight[e->index()];
+                    parentFound = true;
+                }
+            }
+
+            for(std::vector<edge>::iterator it = adjEdges.begin(); it != adjEdges.end(); ++it)
+            {
+                e = *it;
+                int index = e->index();
+                node x = e->opposite(theNode);
+                edge twinEdge = (x == parent || x == theNode) ? 0 : parentEdge[x];
+
+                if(twinEdge != 0)
+                {
+                    // parent has this edge already; update its length and delete e
+                    int twinIndex = twinEdge->index();
+                    if(edgeStamp[twinEdge] != i)
+                    {
+                        edgeStamp[twinEdge] = i;
+                        NM->m_changedEdges.push_back(twinIndex);
+                        NM->m_doubleWeight[twinIndex] = m_weight[twinIndex];
+                        NM->m_source[twinIndex] = twinEdge->source()->index();
+                        NM->m_target[twinIndex] = twinEdge->target()->index();
+                    }
+                    double extraLength = 0.0;
+                    if(adjustEdgeLengths != 0)
+                    {
+                        extraLength = m_weight[twinIndex] + adjustEdgeLengths * nodeToParentLen;
+                    }
+                    m_weight[twinIndex] = (m_weight[twinIndex] + m_weight[index] + extraLength) * 0.5f;
+                }
+
+                if(twinEdge != 0 || x == parent || x == theNode)
+                {
+                    deleteEdge(NM, e);
+                }
+                else
+                {
+                    // move the edge to parent
+                    if(edgeStamp[e] != i)
+                    {
+                        edgeStamp[e] = i;
+                        NM->m_changedEdges.push_back(index);
+                        NM->m_doubleWeight[index] = m_weight[index];
+                        NM->m_source[index] = e->source()->index();
+                        NM->m_target[index] = e->target()->index();
+                    }
+                    if(e->source() == theNode)
+                        m_G->moveSource(e, parent);
+                    else
+                        m_G->moveTarget(e, parent);
+                    parentEdge[x] = e;
+                    parentNeighbors.push_back(x);
+                }
+            }
+
+            parentEdge[theNode] = 0;
+            if(postMerge(NM, theNode))
+                numMerged++;
+            else
+                delete NM;
+        }
+
+        return numMerged;
+    }
+
+
     NodeMerge* MultilevelGraph::getLastMerge()
     {
         return m_changes.back();
@@ -45,6 +45,7 @@
 #include <ogdf/energybased/FMMMLayout.h>
 #include <ogdf/basic/Math.h>
 #include "numexcept.h"
+#include "FMMMThread.h"
 #include <time.h>
 
 
@@ -71,6 +72,10 @@ namespace ogdf
         particles_in_leaves(25);
         tree_construction_way(FMMMLayout::rtcSubtreeBySubtree);
         find_sm_cell(FMMMLayout::scfIteratively);
+        thread_team(0);
+
+        A_ptr = 0;
+        F_direct_ptr = F_multipole_exp_ptr = F_local_exp_ptr = 0;
     }
 
 
@@ -79,7 +84,9 @@ namespace ogdf
         NodeArray <NodeAttributes> & A,
         NodeArray<DPoint> & F_rep)
     {
-        if(using_NMM) //use NewMultipoleMethod
+        if(using_NMM && tree_construction_way() == FMMMLayout::rtcLinear)
+            calculate_repulsive_forces_by_linear_NMM(G, A, F_rep);
+        else if(using_NMM) //use NewMultipoleMethod
             calculate_repulsive_forces_by_NMM(G, A, F_rep);
         else //used the exact naive way
             calculate_repulsive_forces_by_exact_method(G, A, F_rep);
@@ -111,10 +118,18 @@ namespace ogdf
             build_up_red_quad_tree_subtree_by_subtree(G, A, T);
 
         form_multipole_expansions(A, T, quad_tree_leaves);
-        calculate_local_expansions_and_WSPRLS(A, T.get_root_ptr());
-        transform_local_exp_to_forces(A, quad_tree_leaves, F_local_exp);
-        transform_multipole_exp_to_forces(A, quad_tree_leaves, F_multipole_exp);
-        calculate_neighbourcell_forces(A, quad_tree_leaves, F_direct);
+        if(number_of_threads() > 1)
+        {
+            calculate_local_expansions_and_WSPRLS_in_parallel(A, T.get_root_ptr());
+            calculate_leaf_forces_in_parallel(A, quad_tree_leaves, F_direct, F_multipole_exp, F_local_exp);
+        }
+        else
+        {
+            calculate_local_expansions_and_WSPRLS(A, T.get_root_ptr());
+            transform_local_exp_to_forces(A, quad_tree_leaves, F_local_exp);
+            transform_multipole_exp_to_forces(A, quad_tree_leaves, F_multipole_exp);
+            calculate_neighbourcell_forces(A, quad_tree_leaves, F_direct);
+        }
         add_rep_forces(G, F_direct, F_multipole_exp, F_local_exp, F_rep);
 
         delete_red_quad_tree_and_count_treenodes(T);
@@ -166,6 +181,8 @@ namespace ogdf
         {
             free_binko();
             free_power_of_2_array();
+            linear_tree.clear();
+            linear_forces.init();
         }
     }
 
@@ -182,6 +199,14 @@ namespace ogdf
     }
 
 
+    void NMM::thread_team(KernelTeam* team)
+    {
+        _thread_team = team;
+        _number_of_threads = (team != 0) ? team->numThreads() : 1;
+        ExactMethod.thread_team(team);
+    }
+
+
     inline void NMM::init_power_of_2_array()
     {
         int p = 1;
@@ -2133,12 +2158,15 @@ namespace ogdf
 
     void NMM::set_center(QuadTreeNodeNM* act_ptr)
     {
+        act_ptr->set_Sm_center(cell_center(act_ptr->get_Sm_downleftcorner(),
+                                           act_ptr->get_Sm_boxlength()));
+    }
 
+
+    complex<double> NMM::cell_center(DPoint Sm_downleftcorner, double Sm_boxlength)
+    {
         const int BILLION = 1000000000;
-        DPoint Sm_downleftcorner = act_ptr->get_Sm_downleftcorner();
-        double Sm_boxlength = act_ptr->get_Sm_boxlength();
         double boxcenter_x_coord, boxcenter_y_coord;
-        DPoint Sm_dlc;
         double rand_y;
 
         boxcenter_x_coord = Sm_downleftcorner.m_x + Sm_boxlength * 0.5;
@@ -2149,8 +2177,7 @@ namespace ogdf
         rand_y = double(randomNumber(1, BILLION) + 1) / (BILLION + 2); //rand number in (0,1)
         boxcenter_y_coord = boxcenter_y_coord + 0.001 * Sm_boxlength * rand_y;
 
-        complex<double> boxcenter(boxcenter_x_coord, boxcenter_y_coord);
-        act_ptr->set_Sm_center(boxcenter);
+        return complex<double>(boxcenter_x_coord, boxcenter_y_coord);
     }
 
 
@@ -2194,13 +2221,21 @@ namespace ogdf
     void NMM::add_shifted_expansion_to_father_expansion(QuadTreeNodeNM* act_ptr)
     {
         QuadTreeNodeNM* father_ptr = act_ptr->get_father_ptr();
+        add_shifted_multipole_exp(act_ptr->get_multipole_exp(), act_ptr->get_Sm_center(),
+                                  father_ptr->get_multipole_exp(), father_ptr->get_Sm_center());
+    }
+
+
+    void NMM::add_shifted_multipole_exp(
+        const complex<double>* ME_0,
+        complex<double> z_0,
+        complex<double>* ME_1,
+        complex<double> z_1)
+    {
         complex<double> sum;
-        complex<double> z_0, z_1;
         Array<complex<double>> z_0_minus_z_1_over(precision() + 1);
 
-        z_1 = father_ptr->get_Sm_center();
-        z_0 = act_ptr->get_Sm_center();
-        father_ptr->get_multipole_exp()[0] += act_ptr->get_multipole_exp()[0];
+        ME_1[0] += ME_0[0];
 
         //init z_0_minus_z_1_over
         z_0_minus_z_1_over[0] = 1;
@@ -2209,11 +2244,11 @@ namespace ogdf
 
         for(int k = 1; k <= precision(); k++)
         {
-            sum = (act_ptr->get_multipole_exp()[0] * (double(-1)) * z_0_minus_z_1_over[k]) /
+            sum = (ME_0[0] * (double(-1)) * z_0_minus_z_1_over[k]) /
                   double(k) ;
             for(int s = 1; s <= k; s++)
-                sum +=  act_ptr->get_multipole_exp()[s] * z_0_minus_z_1_over[k - s] * binko(k - 1, s - 1);
-            father_ptr->get_multipole_exp()[k] += sum;
+                sum +=  ME_0[s] * z_0_minus_z_1_over[k - s] * binko(k - 1, s - 1);
+            ME_1[k] += sum;
         }
     }
 
@@ -2221,6 +2256,27 @@ namespace ogdf
     void NMM::calculate_local_expansions_and_WSPRLS(
         NodeArray<NodeAttributes> & A,
         QuadTreeNodeNM* act_node_ptr)
+    {
+        calculate_local_expansions_and_WSPRLS_of_node(A, act_node_ptr);
+
+        //Step 4: recursive calls if act_node is not a leaf
+        if(!act_node_ptr->is_leaf())
+        {
+            if(act_node_ptr->child_lt_exists())
+                calculate_local_expansions_and_WSPRLS(A, act_node_ptr->get_child_lt_ptr());
+            if(act_node_ptr->child_rt_exists())
+                calculate_local_expansions_and_WSPRLS(A, act_node_ptr->get_child_rt_ptr());
+            if(act_node_ptr->child_lb_exists())
+                calculate_local_expansions_and_WSPRLS(A, act_node_ptr->get_child_lb_ptr());
+            if(act_node_ptr->child_rb_exists())
+                calculate_local_expansions_and_WSPRLS(A, act_node_ptr->get_child_rb_ptr());
+        }
+    }
+
+
+    void NMM::calculate_local_expansions_and_WSPRLS_of_node(
+        NodeArray<NodeAttributes> & A,
+        QuadTreeNodeNM* act_node_ptr)
     {
         List<QuadTreeNodeNM*> I, L, L2, E, D1, D2, M;
         QuadTreeNodeNM* selected_node_ptr;
@@ -2310,24 +2366,12 @@ namespace ogdf
         for(ptr_it = L2.begin(); ptr_it.valid(); ++ptr_it)
             add_local_expansion_of_leaf(A, *ptr_it, act_node_ptr);
 
-        //Step 4: recursive calls if act_node is not a leaf
-        if(!act_node_ptr->is_leaf())
-        {
-            if(act_node_ptr->child_lt_exists())
-                calculate_local_expansions_and_WSPRLS(A, act_node_ptr->get_child_lt_ptr());
-            if(act_node_ptr->child_rt_exists())
-                calculate_local_expansions_and_WSPRLS(A, act_node_ptr->get_child_rt_ptr());
-            if(act_node_ptr->child_lb_exists())
-                calculate_local_expansions_and_WSPRLS(A, act_node_ptr->get_child_lb_ptr());
-            if(act_node_ptr->child_rb_exists())
-                calculate_local_expansions_and_WSPRLS(A, act_node_ptr->get_child_rb_ptr());
-        }
-
         //Step 5: WSPRLS(Well Separateness Preserving Refinement of leaf surroundings)
         //if act_node is a leaf than calculate the list D1,D2 and M from I and D1
-        else // *act_node_ptr is a leaf
+        //(Step 4, the recursive calls, is done by the caller)
+        if(act_node_ptr->is_leaf())
         {
-            //else
+            //if
             act_node_ptr->get_D1(D1);
             act_node_ptr->get_D2(D2);
 
@@ -2363,43 +2407,48 @@ namespace ogdf
             act_node_ptr->set_D1(D1);
             act_node_ptr->set_D2(D2);
             act_node_ptr->set_M(M);
-        }//else
+        }//if
     }
 
 
     bool NMM::well_separated(QuadTreeNodeNM* node_1_ptr, QuadTreeNodeNM* node_2_ptr)
+    {
+        return well_separated(node_1_ptr->get_Sm_downleftcorner(), node_1_ptr->get_Sm_boxlength(),
+                              node_2_ptr->get_Sm_downleftcorner(), node_2_ptr->get_Sm_boxlength());
+    }
+
+
+    bool NMM::well_separated(DPoint dlc_1, double boxlength_1, DPoint dlc_2, double boxlength_2)
     {
         numexcept N;
-        double boxlength_1 = node_1_ptr->get_Sm_boxlength();
-        double boxlength_2 = node_2_ptr->get_Sm_boxlength();
         double x1_min, x1_max, y1_min, y1_max, x2_min, x2_max, y2_min, y2_max;
         bool x_overlap, y_overlap;
 
         if(boxlength_1 <= boxlength_2)
         {
-            x1_min = node_1_ptr->get_Sm_downleftcorner().m_x;
-            x1_max = node_1_ptr->get_Sm_downleftcorner().m_x + boxlength_1;
-            y1_min = node_1_ptr->get_Sm_downleftcorner().m_y;
-            y1_max = node_1_ptr->get_Sm_downleftcorner().m_y + boxlength_1;
+            x1_min = dlc_1.m_x;
+            x1_max = dlc_1.m_x + boxlength_1;
+            y1_min = dlc_1.m_y;
+            y1_max = dlc_1.m_y + boxlength_1;
 
             //blow the box up
-            x2_min = node_2_ptr->get_Sm_downleftcorner().m_x - boxlength_2;
-            x2_max = node_2_ptr->get_Sm_downleftcorner().m_x + 2 * boxlength_2;
-            y2_min = node_2_ptr->get_Sm_downleftcorner().m_y - boxlength_2;
-            y2_max = node_2_ptr->get_Sm_downleftcorner().m_y + 2 * boxlength_2;
+            x2_min = dlc_2.m_x - boxlength_2;
+            x2_max = dlc_2.m_x + 2 * boxlength_2;
+            y2_min = dlc_2.m_y - boxlength_2;
+            y2_max = dlc_2.m_y + 2 * boxlength_2;
         }
         else //boxlength_1 > boxlength_2
         {
             //blow the box up
-            x1_min = node_1_ptr->get_Sm_downleftcorner().m_x - boxlength_1;
-            x1_max = node_1_ptr->get_Sm_downleftcorner().m_x + 2 * boxlength_1;
-            y1_min = node_1_ptr->get_Sm_downleftcorner().m_y - boxlength_1;
-            y1_max = node_1_ptr->get_Sm_downleftcorner().m_y + 2 * boxlength_1;
-
-            x2_min = node_2_ptr->get_Sm_downleftcorner().m_x;
-            x2_max = node_2_ptr->get_Sm_downleftcorner().m_x + boxlength_2;
-            y2_min = node_2_ptr->get_Sm_downleftcorner().m_y;
-            y2_max = node_2_ptr->get_Sm_downleftcorner().m_y + boxlength_2;
+            x1_min = dlc_1.m_x - boxlength_1;
+            x1_max = dlc_1.m_x + 2 * boxlength_1;
+            y1_min = dlc_1.m_y - boxlength_1;
+            y1_max = dlc_1.m_y + 2 * boxlength_1;
+
+            x2_min = dlc_2.m_x;
+            x2_max = dlc_2.m_x + boxlength_2;
+            y2_min = dlc_2.m_y;
+            y2_max = dlc_2.m_y + boxlength_2;
         }
 
         //test if boxes overlap
@@ -2422,18 +2471,23 @@ namespace ogdf
 
 
     bool NMM::bordering(QuadTreeNodeNM* node_1_ptr, QuadTreeNodeNM* node_2_ptr)
+    {
+        return bordering(node_1_ptr->get_Sm_downleftcorner(), node_1_ptr->get_Sm_boxlength(),
+                         node_2_ptr->get_Sm_downleftcorner(), node_2_ptr->get_Sm_boxlength());
+    }
+
+
+    bool NMM::bordering(DPoint dlc_1, double boxlength_1, DPoint dlc_2, double boxlength_2)
     {
         numexcept N;
-        double boxlength_1 = node_1_ptr->get_Sm_boxlength();
-        double boxlength_2 = node_2_ptr->get_Sm_boxlength();
-        double x1_min = node_1_ptr->get_Sm_downleftcorner().m_x;
-        double x1_max = node_1_ptr->get_Sm_downleftcorner().m_x + boxlength_1;
-        double y1_min = node_1_ptr->get_Sm_downleftcorner().m_y;
-        double y1_max = node_1_ptr->get_Sm_downleftcorner().m_y + boxlength_1;
-        double x2_min = node_2_ptr->get_Sm_downleftcorner().m_x;
-        double x2_max = node_2_ptr->get_Sm_downleftcorner().m_x + boxlength_2;
-        double y2_min = node_2_ptr->get_Sm_downleftcorner().m_y;
-        double y2_max = node_2_ptr->get_Sm_downleftcorner().m_y + boxlength_2;
+        double x1_min = dlc_1.m_x;
+        double x1_max = dlc_1.m_x + boxlength_1;
+        double y1_min = dlc_1.m_y;
+        double y1_max = dlc_1.m_y + boxlength_1;
+        double x2_min = dlc_2.m_x;
+        double x2_max = dlc_2.m_x + boxlength_2;
+        double y2_min = dlc_2.m_y;
+        double y2_max = dlc_2.m_y + boxlength_2;
 
         if(((x2_min <= x1_min || N.nearly_equal(x2_min, x1_min)) &&
                 (x1_max <= x2_max || N.nearly_equal(x1_max, x2_max)) &&
@@ -2513,9 +2567,17 @@ namespace ogdf
     void NMM::add_shifted_local_exp_of_parent(QuadTreeNodeNM* node_ptr)
     {
         QuadTreeNodeNM* father_ptr = node_ptr->get_father_ptr();
+        add_shifted_local_exp(father_ptr->get_local_exp(), father_ptr->get_Sm_center(),
+                              node_ptr->get_local_exp(), node_ptr->get_Sm_center());
+    }
+
 
-        complex<double> z_0 = father_ptr->get_Sm_center();
-        complex<double> z_1 = node_ptr->get_Sm_center();
+    void NMM::add_shifted_local_exp(
+        const complex<double>* LE_0,
+        complex<double> z_0,
+        complex<double>* LE_1,
+        complex<double> z_1)
+    {
         Array<complex<double>> z_1_minus_z_0_over(precision() + 1);
 
         //init z_1_minus_z_0_over
@@ -2528,16 +2590,25 @@ namespace ogdf
         {
             complex<double> sum(0, 0);
             for(int k = l; k <= precision(); k++)
-                sum += binko(k, l) * father_ptr->get_local_exp()[k] * z_1_minus_z_0_over[k - l];
-            node_ptr->get_local_exp()[l] += sum;
+                sum += binko(k, l) * LE_0[k] * z_1_minus_z_0_over[k - l];
+            LE_1[l] += sum;
         }
     }
 
 
     void NMM::add_local_expansion(QuadTreeNodeNM* ptr_0, QuadTreeNodeNM* ptr_1)
     {
-        complex<double> z_0 = ptr_0->get_Sm_center();
-        complex<double> z_1 = ptr_1->get_Sm_center();
+        add_local_expansion(ptr_0->get_multipole_exp(), ptr_0->get_Sm_center(),
+                            ptr_1->get_local_exp(), ptr_1->get_Sm_center());
+    }
+
+
+    void NMM::add_local_expansion(
+        const complex<double>* ME_0,
+        complex<double> z_0,
+        complex<double>* LE_1,
+        complex<double> z_1)
+    {
         complex<double> sum, z_error;
         complex<double> factor;
         complex<double> z_1_minus_z_0_over_k;
@@ -2549,26 +2620,26 @@ namespace ogdf
         if((std::real(z_1 - z_0) <= 0) && (std::imag(z_1 - z_0) == 0)) //no cont. compl. log fct exists !!!
         {
             z_error = log(z_1 - z_0 + 0.0000001);
-            sum = ptr_0->get_multipole_exp()[0] * z_error;
+            sum = ME_0[0] * z_error;
         }
         else
-            sum = ptr_0->get_multipole_exp()[0] * log(z_1 - z_0);
+            sum = ME_0[0] * log(z_1 - z_0);
 
 
         z_1_minus_z_0_over_k = z_1 - z_0;
         for(int k = 1; k <= precision(); k++)
         {
-            sum += ptr_0->get_multipole_exp()[k] / z_1_minus_z_0_over_k;
+            sum += ME_0[k] / z_1_minus_z_0_over_k;
             z_1_minus_z_0_over_k *= z_1 - z_0;
         }
-        ptr_1->get_local_exp()[0] += sum;
+        LE_1[0] += sum;
 
         z_1_minus_z_0_over_s = z_1 - z_0;
         for(int s = 1; s <= precision(); s++)
         {
             pow_minus_1_s_plus_1 = (((s + 1) % 2 == 0) ? 1 : -1);
             pow_minus_1_s = ((pow_minus_1_s_plus_1 == double(1)) ? -1 : 1);
-            sum = pow_minus_1_s_plus_1 * ptr_0->get_multipole_exp()[0] / (z_1_minus_z_0_over_s *
+            sum = pow_minus_1_s_plus_1 * ME_0[0] / (z_1_minus_z_0_over_s *
                     double(s));
             factor = pow_minus_1_s / z_1_minus_z_0_over_s;
             z_1_minus_z_0_over_s *= z_1 - z_0;
@@ -2577,10 +2648,10 @@ namespace ogdf
             z_1_minus_z_0_over_k = z_1 - z_0;
             for(int k = 1; k <= precision(); k++)
             {
-                sum_2 += binko(s + k - 1, k - 1) * ptr_0->get_multipole_exp()[k] / z_1_minus_z_0_over_k;
+                sum_2 += binko(s + k - 1, k - 1) * ME_0[k] / z_1_minus_z_0_over_k;
                 z_1_minus_z_0_over_k *= z_1 - z_0;
             }
-            ptr_1->get_local_exp()[s] += sum + factor * sum_2;
+            LE_1[s] += sum + factor * sum_2;
         }
     }
 
@@ -2591,11 +2662,7 @@ namespace ogdf
         QuadTreeNodeNM* ptr_1)
     {
         List<node> contained_nodes;
-        double multipole_0_of_v = 1;//only the first coefficient is not zero
         complex<double> z_1 = ptr_1->get_Sm_center();
-        complex<double> z_error;
-        complex<double> z_1_minus_z_0_over_s;
-        complex<double> pow_minus_1_s_plus_1;
 
         ptr_0->get_contained_nodes(contained_nodes);
 
@@ -2604,27 +2671,40 @@ namespace ogdf
             //forall
             //set position of v as center ( (1,0,....,0) are the multipole coefficients at v)
             complex<double> z_0(A[*v_it].get_x(), A[*v_it].get_y());
+            add_local_expansion_of_particle(z_0, ptr_1->get_local_exp(), z_1);
+        }//forall
+    }
 
-            //now transform multipole_0_of_v to the locale expansion around z_1
 
-            //Error-Handling for complex logarithm
-            if((std::real(z_1 - z_0) <= 0) && (std::imag(z_1 - z_0) == 0)) //no cont. compl. log fct exists!
-            {
-                z_error = log(z_1 - z_0 + 0.0000001);
-                ptr_1->get_local_exp()[0] += multipole_0_of_v * z_error;
-            }
-            else
-                ptr_1->get_local_exp()[0] +=  multipole_0_of_v * log(z_1 - z_0);
+    void NMM::add_local_expansion_of_particle(
+        complex<double> z_0,
+        complex<double>* LE_1,
+        complex<double> z_1)
+    {
+        double multipole_0_of_v = 1;//only the first coefficient is not zero
+        complex<double> z_error;
+        complex<double> z_1_minus_z_0_over_s;
+        complex<double> pow_minus_1_s_plus_1;
 
-            z_1_minus_z_0_over_s = z_1 - z_0;
-            for(int s = 1; s <= precision(); s++)
-            {
-                pow_minus_1_s_plus_1 = (((s + 1) % 2 == 0) ? 1 : -1);
-                ptr_1->get_local_exp()[s] += pow_minus_1_s_plus_1 * multipole_0_of_v /
-                                             (z_1_minus_z_0_over_s * double(s));
-                z_1_minus_z_0_over_s *= z_1 - z_0;
-            }
-        }//forall
+        //transform multipole_0_of_v to the locale expansion around z_1
+
+        //Error-Handling for complex logarithm
+        if((std::real(z_1 - z_0) <= 0) && (std::imag(z_1 - z_0) == 0)) //no cont. compl. log fct exists!
+        {
+            z_error = log(z_1 - z_0 + 0.0000001);
+            LE_1[0] += multipole_0_of_v * z_error;
+        }
+        else
+            LE_1[0] +=  multipole_0_of_v * log(z_1 - z_0);
+
+        z_1_minus_z_0_over_s = z_1 - z_0;
+        for(int s = 1; s <= precision(); s++)
+        {
+            pow_minus_1_s_plus_1 = (((s + 1) % 2 == 0) ? 1 : -1);
+            LE_1[s] += pow_minus_1_s_plus_1 * multipole_0_of_v /
+                       (z_1_minus_z_0_over_s * double(s));
+            z_1_minus_z_0_over_s *= z_1 - z_0;
+        }
     }
 
 
@@ -2632,39 +2712,53 @@ namespace ogdf
         NodeArray <NodeAttributes> & A,
         List<QuadTreeNodeNM*> & quad_tree_leaves,
         NodeArray<DPoint> & F_local_exp)
+    {
+        forall_listiterators(QuadTreeNodeNM*, leaf_ptr_ptr, quad_tree_leaves)
+        transform_local_exp_of_leaf_to_forces(A, *leaf_ptr_ptr, F_local_exp);
+    }
+
+
+    void NMM::transform_local_exp_of_leaf_to_forces(
+        NodeArray <NodeAttributes> & A,
+        QuadTreeNodeNM* leaf_ptr,
+        NodeArray<DPoint> & F_local_exp)
     {
         List<node> contained_nodes;
-        complex<double> sum;
-        complex<double> complex_null(0, 0);
         complex<double> z_0;
-        complex<double> z_v_minus_z_0_over_k_minus_1;
-        DPoint force_vector;
 
         //calculate derivative of the potential polynom (= local expansion at leaf nodes)
         //and evaluate it for each node in contained_nodes()
-        //and transform the complex number back to the real-world, to obtain the force
 
-        forall_listiterators(QuadTreeNodeNM*, leaf_ptr_ptr, quad_tree_leaves)
+        leaf_ptr->get_contained_nodes(contained_nodes);
+        z_0 = leaf_ptr->get_Sm_center();
+
+        forall_listiterators(node, v_ptr, contained_nodes)
         {
-            (*leaf_ptr_ptr)->get_contained_nodes(contained_nodes);
-            z_0 = (*leaf_ptr_ptr)->get_Sm_center();
+            complex<double> z_v(A[*v_ptr].get_x(), A[*v_ptr].get_y());
+            F_local_exp[*v_ptr] = local_exp_force(leaf_ptr->get_local_exp(), z_0, z_v);
+        }
+    }
 
-            forall_listiterators(node, v_ptr, contained_nodes)
-            {
-                complex<double> z_v(A[*v_ptr].get_x(), A[*v_ptr].get_y());
-                sum = complex_null;
-                z_v_minus_z_0_over_k_minus_1 = 1;
-                for(int k = 1; k <= precision(); k++)
-                {
-                    sum += double(k) * (*leaf_ptr_ptr)->get_local_exp()[k] *
-                           z_v_minus_z_0_over_k_minus_1;
-                    z_v_minus_z_0_over_k_minus_1 *= z_v - z_0;
-                }
-                force_vector.m_x = sum.real();
-                force_vector.m_y = (-1) * sum.imag();
-                F_local_exp[*v_ptr] = force_vector;
-            }
+
+    DPoint NMM::local_exp_force(
+        const complex<double>* LE,
+        complex<double> z_0,
+        complex<double> z_v)
+    {
+        complex<double> sum(0, 0);
+        complex<double> z_v_minus_z_0_over_k_minus_1 = 1;
+        DPoint force_vector;
+
+        //evaluate the derivative of the local expansion at z_v and transform the
+        //complex number back to the real-world, to obtain the force
+        for(int k = 1; k <= precision(); k++)
+        {
+            sum += double(k) * LE[k] * z_v_minus_z_0_over_k_minus_1;
+            z_v_minus_z_0_over_k_minus_1 *= z_v - z_0;
         }
+        force_vector.m_x = sum.real();
+        force_vector.m_y = (-1) * sum.imag();
+        return force_vector;
     }
 
 
@@ -2672,47 +2766,63 @@ namespace ogdf
         NodeArray<NodeAttributes> & A,
         List<QuadTreeNodeNM*> & quad_tree_leaves,
         NodeArray<DPoint> & F_multipole_exp)
+    {
+        forall_listiterators(QuadTreeNodeNM*, act_leaf_ptr_ptr, quad_tree_leaves)
+        transform_multipole_exp_of_leaf_to_forces(A, *act_leaf_ptr_ptr, F_multipole_exp);
+    }
+
+
+    void NMM::transform_multipole_exp_of_leaf_to_forces(
+        NodeArray<NodeAttributes> & A,
+        QuadTreeNodeNM* act_leaf_ptr,
+        NodeArray<DPoint> & F_multipole_exp)
     {
         List<QuadTreeNodeNM*> M;
         List<node> act_contained_nodes;
-        ListIterator<node> v_ptr;
-        complex<double> sum;
         complex<double> z_0;
-        complex<double> z_v_minus_z_0_over_minus_k_minus_1;
-        DPoint force_vector;
 
-        //for each leaf u in the M-List of an actual leaf v do:
+        //for each leaf u in the M-List of the actual leaf v do:
         //calculate derivative of the multipole expansion function at u
         //and evaluate it for each node in v.get_contained_nodes()
         //and transform the complex number back to the real-world, to obtain the force
 
-        forall_listiterators(QuadTreeNodeNM*, act_leaf_ptr_ptr, quad_tree_leaves)
+        act_leaf_ptr->get_contained_nodes(act_contained_nodes);
+        act_leaf_ptr->get_M(M);
+        forall_listiterators(QuadTreeNodeNM*, M_node_ptr_ptr, M)
         {
-            (*act_leaf_ptr_ptr)->get_contained_nodes(act_contained_nodes);
-            (*act_leaf_ptr_ptr)->get_M(M);
-            forall_listiterators(QuadTreeNodeNM*, M_node_ptr_ptr, M)
+            z_0 = (*M_node_ptr_ptr)->get_Sm_center();
+            forall_listiterators(node, v_ptr, act_contained_nodes)
             {
-                z_0 = (*M_node_ptr_ptr)->get_Sm_center();
-                forall_listiterators(node, v_ptr, act_contained_nodes)
-                {
-                    complex<double> z_v(A[*v_ptr].get_x(), A[*v_ptr].get_y());
-                    z_v_minus_z_0_over_minus_k_minus_1 = 1.0 / (z_v - z_0);
-                    sum = (*M_node_ptr_ptr)->get_multipole_exp()[0] *
-                          z_v_minus_z_0_over_minus_k_minus_1;
+                complex<double> z_v(A[*v_ptr].get_x(), A[*v_ptr].get_y());
+                F_multipole_exp[*v_ptr] =  F_multipole_exp[*v_ptr] +
+                                           multipole_exp_force((*M_node_ptr_ptr)->get_multipole_exp(), z_0, z_v);
+            }
+        }
+    }
 
-                    for(int k = 1; k <= precision(); k++)
-                    {
-                        z_v_minus_z_0_over_minus_k_minus_1 /= z_v - z_0;
-                        sum -= double(k) * (*M_node_ptr_ptr)->get_multipole_exp()[k] *
-                               z_v_minus_z_0_over_minus_k_minus_1;
-                    }
-                    force_vector.m_x = sum.real();
-                    force_vector.m_y = (-1) * sum.imag();
-                    F_multipole_exp[*v_ptr] =  F_multipole_exp[*v_ptr] + force_vector;
 
-                }
-            }
+    DPoint NMM::multipole_exp_force(
+        const complex<double>* ME,
+        complex<double> z_0,
+        complex<double> z_v)
+    {
+        complex<double> sum;
+        complex<double> z_v_minus_z_0_over_minus_k_minus_1;
+        DPoint force_vector;
+
+        //evaluate the derivative of the multipole expansion at z_v and transform the
+        //complex number back to the real-world, to obtain the force
+        z_v_minus_z_0_over_minus_k_minus_1 = 1.0 / (z_v - z_0);
+        sum = ME[0] * z_v_minus_z_0_over_minus_k_minus_1;
+
+        for(int k = 1; k <= precision(); k++)
+        {
+            z_v_minus_z_0_over_minus_k_minus_1 /= z_v - z_0;
+            sum -= double(k) * ME[k] * z_v_minus_z_0_over_minus_k_minus_1;
         }
+        force_vector.m_x = sum.real();
+        force_vector.m_y = (-1) * sum.imag();
+        return force_vector;
     }
 
 
@@ -2883,6 +2993,404 @@ namespace ogdf
     }
 
 
+    void NMM::calculate_neighbourcell_forces_of_leaf(
+        NodeArray<NodeAttributes> & A,
+        QuadTreeNodeNM* act_leaf_ptr,
+        NodeArray<DPoint> & F_direct)
+    {
+        numexcept N;
+        List<node> act_contained_nodes, neighbour_contained_nodes;
+        List<QuadTreeNodeNM*> neighboured_leaves;
+
+        act_leaf_ptr->get_contained_nodes(act_contained_nodes);
+
+        if(act_contained_nodes.size() <= particles_in_leaves())
+        {
+            //if (usual case)
+
+            //the forces of all nodes in the leaf itself and in the leaves of D1 and D2
+            //are summed up for each node of the leaf; in contrast to
+            //calculate_neighbourcell_forces the forces of pairs of nodes in
+            //bordering leaves are calculated once for each of the two nodes
+            act_leaf_ptr->get_D1(neighboured_leaves);
+            List<QuadTreeNodeNM*> non_neighboured_leaves;
+            act_leaf_ptr->get_D2(non_neighboured_leaves);
+            neighboured_leaves.conc(non_neighboured_leaves);
+            neighboured_leaves.pushFront(act_leaf_ptr);
+
+            forall_listiterators(node, v_ptr, act_contained_nodes)
+            {
+                const DPoint pos_v = A[*v_ptr].get_position();
+                const int index_v = (*v_ptr)->index();
+                DPoint f(0, 0);
+
+                forall_listiterators(QuadTreeNodeNM*, leaf_ptr, neighboured_leaves)
+                {
+                    if(*leaf_ptr == act_leaf_ptr)
+                    {
+                        forall_listiterators(node, u_ptr, act_contained_nodes)
+                        if(*u_ptr != *v_ptr)
+                            f = f + fmmmRepulsiveForce(N, A[*u_ptr].get_position(), (*u_ptr)->index(), pos_v, index_v);
+                    }
+                    else
+                    {
+                        (*leaf_ptr)->get_contained_nodes(neighbour_contained_nodes);
+                        forall_listiterators(node, u_ptr, neighbour_contained_nodes)
+                        f = f + fmmmRepulsiveForce(N, A[*u_ptr].get_position(), (*u_ptr)->index(), pos_v, index_v);
+                    }
+                }
+                F_direct[*v_ptr] = F_direct[*v_ptr] + f;
+            }
+        }
+        else //special case (more then particles_in_leaves() particles in this leaf)
+        {
+            //else
+            forall_listiterators(node, v_ptr, act_contained_nodes)
+            {
+                const DPoint pos_v = A[*v_ptr].get_position();
+                const int index_v = (*v_ptr)->index();
+                F_direct[*v_ptr] = F_direct[*v_ptr] + fmmmRepulsiveForce(N, pos_v, index_v, pos_v, index_v);
+            }
+        }
+    }
+
+
+    void NMM::calculate_local_expansions_and_WSPRLS_in_parallel(
+        NodeArray<NodeAttributes> & A,
+        QuadTreeNodeNM* root_ptr)
+    {
+        //process the upper levels sequentially (level by level) until there are
+        //enough subtrees for a reasonable load balance
+        const int min_subtree_number = 8 * number_of_threads();
+        List<QuadTreeNodeNM*> level, next_level;
+        level.pushBack(root_ptr);
+
+        while(!level.empty() && level.size() < min_subtree_number)
+        {
+            forall_listiterators(QuadTreeNodeNM*, ptr, level)
+            {
+                calculate_local_expansions_and_WSPRLS_of_node(A, *ptr);
+                if(!(*ptr)->is_leaf())
+                {
+                    if((*ptr)->child_lt_exists())
+                        next_level.pushBack((*ptr)->get_child_lt_ptr());
+                    if((*ptr)->child_rt_exists())
+                        next_level.pushBack((*ptr)->get_child_rt_ptr());
+                    if((*ptr)->child_lb_exists())
+                        next_level.pushBack((*ptr)->get_child_lb_ptr());
+                    if((*ptr)->child_rb_exists())
+                        next_level.pushBack((*ptr)->get_child_rb_ptr());
+                }
+            }
+            level.clear();
+            level.conc(next_level);
+        }
+
+        if(level.empty())
+            return;
+
+        subtree_roots.init(level.size());
+        int i = 0;
+        forall_listiterators(QuadTreeNodeNM*, ptr, level)
+        subtree_roots[i++] = *ptr;
+
+        A_ptr = &A;
+        _thread_team->run(this, &NMM::local_expansions_kernel);
+        A_ptr = 0;
+    }
+
+
+    void NMM::local_expansions_kernel(int t)
+    {
+        //the subtrees are independent of each other
+        for(int i = t; i < subtree_roots.size(); i += number_of_threads())
+            calculate_local_expansions_and_WSPRLS(*A_ptr, subtree_roots[i]);
+    }
+
+
+    void NMM::calculate_leaf_forces_in_parallel(
+        NodeArray<NodeAttributes> & A,
+        List<QuadTreeNodeNM*> & quad_tree_leaves,
+        NodeArray<DPoint> & F_direct,
+        NodeArray<DPoint> & F_multipole_exp,
+        NodeArray<DPoint> & F_local_exp)
+    {
+        leaves.init(quad_tree_leaves.size());
+        int i = 0;
+        forall_listiterators(QuadTreeNodeNM*, ptr, quad_tree_leaves)
+        leaves[i++] = *ptr;
+
+        A_ptr = &A;
+        F_direct_ptr = &F_direct;
+        F_multipole_exp_ptr = &F_multipole_exp;
+        F_local_exp_ptr = &F_local_exp;
+
+        _thread_team->run(this, &NMM::leaf_forces_kernel);
+
+        A_ptr = 0;
+        F_direct_ptr = F_multipole_exp_ptr = F_local_exp_ptr = 0;
+    }
+
+
+    void NMM::leaf_forces_kernel(int t)
+    {
+        //blocks of consecutive leaves are assigned to the threads alternately;
+        //each thread changes only the forces of nodes in its own leaves
+        const int block_size = 16;
+        const int stride = block_size * number_of_threads();
+
+        for(int first = t * block_size; first < leaves.size(); first += stride)
+        {
+            const int last = min(first + block_size, leaves.size());
+            for(int i = first; i < last; i++)
+            {
+                transform_local_exp_of_leaf_to_forces(*A_ptr, leaves[i], *F_local_exp_ptr);
+                transform_multipole_exp_of_leaf_to_forces(*A_ptr, leaves[i], *F_multipole_exp_ptr);
+                calculate_neighbourcell_forces_of_leaf(*A_ptr, leaves[i], *F_direct_ptr);
+            }
+        }
+    }
+
+
+    // ****************** functions for the linear quadtree *******************
+
+    void NMM::calculate_repulsive_forces_by_linear_NMM(
+        const Graph & G,
+        NodeArray<NodeAttributes> & A,
+        NodeArray<DPoint> & F_rep)
+    {
+        LinearQuadTreeNM & T = linear_tree;
+
+        T.build(G, A, down_left_corner, boxlength, particles_in_leaves(), precision());
+        if(T.number_of_particles() == 0)
+            return;
+
+        form_multipole_expansions(T);
+        calculate_local_expansions_and_WSPRLS(T);
+
+        if(linear_forces.size() < T.number_of_particles())
+            linear_forces.init(T.number_of_particles());
+        if(number_of_threads() > 1)
+            _thread_team->run(this, &NMM::linear_leaf_forces_kernel);
+        else
+            linear_leaf_forces_kernel(0);
+
+        for(int k = 0; k < T.number_of_particles(); k++)
+            F_rep[T.get_particle(k)] = linear_forces[k];
+    }
+
+
+    void NMM::form_multipole_expansions(LinearQuadTreeNM & T)
+    {
+        int i;
+        for(i = 0; i < T.number_of_tree_nodes(); i++)
+            T.set_Sm_center(i, cell_center(T.get_Sm_downleftcorner(i), T.get_Sm_boxlength(i)));
+
+        //children have larger indices than their father, hence the expansions of
+        //all children of a node are complete when the node is reached
+        for(i = T.number_of_tree_nodes() - 1; i >= 0; i--)
+        {
+            complex<double>* ME = T.get_multipole_exp(i);
+            complex<double> z_0 = T.get_Sm_center(i);
+
+            if(T.is_leaf(i))
+            {
+                const int last = T.first_particle(i) + T.number_of_particles(i);
+                for(int k = T.first_particle(i); k < last; k++)
+                {
+                    complex<double> z_v_minus_z_0_over_k = complex<double>(T.get_position(k).m_x,
+                                                           T.get_position(k).m_y) - z_0;
+                    complex<double> z_v_minus_z_0 = z_v_minus_z_0_over_k;
+                    ME[0] += 1;
+                    for(int l = 1; l <= precision(); l++)
+                    {
+                        ME[l] += ((double(-1)) * z_v_minus_z_0_over_k) / double(l);
+                        z_v_minus_z_0_over_k *= z_v_minus_z_0;
+                    }
+                }
+            }
+
+            if(!T.is_root(i))
+            {
+                int father = T.get_father(i);
+                add_shifted_multipole_exp(ME, z_0, T.get_multipole_exp(father), T.get_Sm_center(father));
+            }
+        }
+    }
+
+
+    void NMM::calculate_local_expansions_and_WSPRLS(LinearQuadTreeNM & T)
+    {
+        ArrayBuffer<int> E, I, L, L2, D1, D2, M;
+        const int* ptr;
+
+        //the tree nodes are processed top-down (like in the recursive version for
+        //the pointer based tree); see calculate_local_expansions_and_WSPRLS_of_node
+        for(int i = 0; i < T.number_of_tree_nodes(); i++)
+        {
+            E.clear();
+            I.clear();
+            L.clear();
+            L2.clear();
+            D1.clear();
+            D2.clear();
+            M.clear();
+
+            const DPoint dlc = T.get_Sm_downleftcorner(i);
+            const double bl = T.get_Sm_boxlength(i);
+            const bool is_leaf = T.is_leaf(i);
+
+            //Step 1: calculate I, L, L2, D1 and D2
+            if(T.is_root(i))
+            {
+                for(int c = T.first_child(i); c < T.first_child(i) + T.number_of_children(i); c++)
+                    E.push(c);
+            }
+            else
+            {
+                int father = T.get_father(i);
+                for(ptr = T.D1_begin(father); ptr != T.D1_end(father); ++ptr)
+                    E.push(*ptr);
+                for(ptr = T.I_begin(father); ptr != T.I_end(father); ++ptr)
+                    E.push(*ptr);
+            }
+
+            while(!E.empty())
+            {
+                int s = E.popRet();
+                if(well_separated(dlc, bl, T.get_Sm_downleftcorner(s), T.get_Sm_boxlength(s)))
+                    L.push(s);
+                else if(T.get_Sm_level(i) < T.get_Sm_level(s))
+                    I.push(s);
+                else if(!T.is_leaf(s))
+                {
+                    for(int c = T.first_child(s); c < T.first_child(s) + T.number_of_children(s); c++)
+                        E.push(c);
+                }
+                else if(bordering(dlc, bl, T.get_Sm_downleftcorner(s), T.get_Sm_boxlength(s)))
+                    D1.push(s);
+                else if(s != i && is_leaf)
+                    D2.push(s);
+                else if(s != i && !is_leaf)
+                    L2.push(s);
+            }
+
+            //Step 2: add the local expansion of the father and the local expansions of L
+            complex<double>* LE = T.get_local_exp(i);
+            complex<double> z_1 = T.get_Sm_center(i);
+
+            if(!T.is_root(i))
+            {
+                int father = T.get_father(i);
+                add_shifted_local_exp(T.get_local_exp(father), T.get_Sm_center(father), LE, z_1);
+            }
+
+            int k;
+            for(k = 0; k < L.size(); k++)
+                add_local_expansion(T.get_multipole_exp(L[k]), T.get_Sm_center(L[k]), LE, z_1);
+
+            //Step 3: add the local expansions of the particles in L2
+            for(k = 0; k < L2.size(); k++)
+            {
+                const int last = T.first_particle(L2[k]) + T.number_of_particles(L2[k]);
+                for(int l = T.first_particle(L2[k]); l < last; l++)
+                    add_local_expansion_of_particle(complex<double>(T.get_position(l).m_x,
+                                                    T.get_position(l).m_y), LE, z_1);
+            }
+
+            //Step 5: WSPRLS for leaves
+            if(is_leaf)
+            {
+                while(!I.empty())
+                {
+                    int s = I.popRet();
+                    bool border = bordering(dlc, bl, T.get_Sm_downleftcorner(s), T.get_Sm_boxlength(s));
+                    if(T.is_leaf(s))
+                    {
+                        if(border)
+                            D1.push(s);
+                        else
+                            D2.push(s);
+                    }
+                    else if(border)
+                    {
+                        for(int c = T.first_child(s); c < T.first_child(s) + T.number_of_children(s); c++)
+                            I.push(c);
+                    }
+                    else
+                        M.push(s);
+                }
+            }
+
+            T.set_lists(i, I, D1, D2, M);
+        }
+    }
+
+
+    void NMM::linear_leaf_forces_kernel(int t)
+    {
+        //blocks of consecutive leaves are assigned to the threads alternately;
+        //each thread changes only the forces of the particles in its own leaves
+        const LinearQuadTreeNM & T = linear_tree;
+        const int block_size = 16;
+        const int stride = block_size * number_of_threads();
+
+        for(int first = t * block_size; first < T.number_of_leaves(); first += stride)
+        {
+            const int last = min(first + block_size, T.number_of_leaves());
+            for(int i = first; i < last; i++)
+                calculate_forces_of_leaf(T.leaf(i));
+        }
+    }
+
+
+    void NMM::calculate_forces_of_leaf(int i)
+    {
+        LinearQuadTreeNM & T = linear_tree;
+        numexcept N;
+        const int first = T.first_particle(i);
+        const int last = first + T.number_of_particles(i);
+        const complex<double> z_0 = T.get_Sm_center(i);
+        const int* ptr;
+
+        for(int k = first; k < last; k++)
+        {
+            const DPoint pos_v = T.get_position(k);
+            const int index_v = T.get_particle_index(k);
+            const complex<double> z_v(pos_v.m_x, pos_v.m_y);
+
+            //direct forces of the particles in this leaf and in the leaves of D1 and D2
+            DPoint f_direct(0, 0);
+            if(T.number_of_particles(i) <= particles_in_leaves())
+            {
+                int l;
+                for(l = first; l < last; l++)
+                    if(l != k)
+                        f_direct = f_direct + fmmmRepulsiveForce(N, T.get_position(l), T.get_particle_index(l), pos_v, index_v);
+
+                for(ptr = T.D1_begin(i); ptr != T.D2_end(i); ++ptr)
+                {
+                    const int last_l = T.first_particle(*ptr) + T.number_of_particles(*ptr);
+                    for(l = T.first_particle(*ptr); l < last_l; l++)
+                        f_direct = f_direct + fmmmRepulsiveForce(N, T.get_position(l), T.get_particle_index(l), pos_v, index_v);
+                }
+            }
+            else //special case (more then particles_in_leaves() particles in this leaf)
+                f_direct = fmmmRepulsiveForce(N, pos_v, index_v, pos_v, index_v);
+
+            //forces of the multipole expansions of M and of the local expansion
+            DPoint f_multipole_exp(0, 0);
+            for(ptr = T.M_begin(i); ptr != T.M_end(i); ++ptr)
+                f_multipole_exp = f_multipole_exp +
+                                  multipole_exp_force(T.get_multipole_exp(*ptr), T.get_Sm_center(*ptr), z_v);
+
+            DPoint f_local_exp = local_exp_force(T.get_local_exp(i), z_0, z_v);
+
+            linear_forces[k] = f_direct + f_local_exp + f_multipole_exp;
+        }
+    }
+
+
     inline void NMM::add_rep_forces(
         const Graph & G,
         NodeArray<DPoint> & F_direct,
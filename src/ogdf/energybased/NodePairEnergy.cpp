@@ -131,27 +131,37 @@ namespace ogdf
 
     void NodePairEnergy::compCandEnergy()
     {
-        node v = testNode();
+        m_candidateEnergy = candidateEnergy(testNode(), testPos(), &m_candPairEnergy);
+    }
+
+
+    double NodePairEnergy::candidateEnergy(
+        const node v,
+        const DPoint & newPos,
+        NodeArray<double>* candPairEnergy) const
+    {
         int numv = (*m_nodeNums)[v];
-        m_candidateEnergy = energy();
-        ListIterator<node> it;
+        double candEnergy = energy();
+        ListConstIterator<node> it;
         for(it = m_nonIsolated.begin(); it.valid(); ++ it)
         {
             if(*it != v)
             {
                 int j = (*m_nodeNums)[*it];
-                m_candidateEnergy -= (*m_pairEnergy)(min(j, numv), max(j, numv));
-                m_candPairEnergy[*it] = computeCoordEnergy(v, *it, testPos(), currentPos(*it));
-                m_candidateEnergy += m_candPairEnergy[*it];
-                if(m_candidateEnergy < 0.0)
+                candEnergy -= (*m_pairEnergy)(min(j, numv), max(j, numv));
+                double pairEnergy = computeCoordEnergy(v, *it, newPos, currentPos(*it));
+                if(candPairEnergy != 0) (*candPairEnergy)[*it] = pairEnergy;
+                candEnergy += pairEnergy;
+                if(candEnergy < 0.0)
                 {
-                    OGDF_ASSERT(m_candidateEnergy > -0.00001);
-                    m_candidateEnergy = 0.0;
+                    OGDF_ASSERT(candEnergy > -0.00001);
+                    candEnergy = 0.0;
                 }
             }
-            else m_candPairEnergy[*it] = 0.0;
+            else if(candPairEnergy != 0) (*candPairEnergy)[*it] = 0.0;
         }
-        OGDF_ASSERT(m_candidateEnergy >= -0.0001);
+        OGDF_ASSERT(candEnergy >= -0.0001);
+        return candEnergy;
     }
 
 
@@ -0,0 +1,338 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Implementation of class ParallelCoarsening.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#include <ogdf/internal/energybased/ParallelCoarsening.h>
+#include <ogdf/basic/Barrier.h>
+#include <ogdf/basic/ThreadTeam.h>
+
+
+namespace ogdf
+{
+
+    //! Common part of the parallel greedy algorithms.
+    class CoarseningWorker
+    {
+    public:
+        CoarseningWorker(const Graph & G, __uint32 seed, int numThreads)
+            : m_seed(seed), m_numThreads(max(1, numThreads)), m_barrier(max(1, numThreads)),
+              m_undecided(0, 2 * max(1, numThreads) - 1, 0)
+        {
+            m_nodes.init(G.numberOfNodes());
+            int i = 0;
+            node v;
+            forall_nodes(v, G)
+                m_nodes[i++] = v;
+        }
+
+    protected:
+        void sync()
+        {
+            if(m_numThreads > 1)
+                m_barrier.threadSync();
+        }
+
+        //! Stores the number of undecided objects of thread \a t in \a round and returns the total number.
+        int countUndecided(int t, int round, int count)
+        {
+            int* undecided = &m_undecided[(round & 1) * m_numThreads];
+            undecided[t] = count;
+            sync();
+            int total = 0;
+            for(int i = 0; i < m_numThreads; ++i)
+                total += undecided[i];
+            return total;
+        }
+
+        int begin(int t) const
+        {
+            return threadRangeBegin(m_nodes.size(), t, m_numThreads);
+        }
+        int end(int t) const
+        {
+            return threadRangeBegin(m_nodes.size(), t + 1, m_numThreads);
+        }
+
+        Array<node> m_nodes;
+        __uint32    m_seed;
+        int         m_numThreads;
+
+    private:
+        Barrier    m_barrier;
+        Array<int> m_undecided; //!< undecided objects per thread (for two consecutive rounds)
+    };
+
+
+    class IndependentSetWorker : public CoarseningWorker
+    {
+    public:
+        IndependentSetWorker(const Graph & G, NodeArray<bool> & inSet, int distance, __uint32 seed, int numThreads, const NodeArray<double>* key)
+            : CoarseningWorker(G, seed, numThreads), m_inSet(inSet), m_distance(distance), m_key(key),
+              m_state(G, 0), m_winner(G, false), m_nearWinner(G, false), m_min(G, 0), m_min2(G, 0), m_priority(G)
+        {
+            node v;
+            forall_nodes(v, G)
+                m_priority[v] = ParallelCoarsening::priority(m_seed, v->index());
+        }
+
+        void kernel(int t)
+        {
+            const int b = begin(t), e = end(t);
+            for(int round = 0; ; ++round)
+            {
+                // An undecided node wins if it precedes all undecided nodes in its
+                // neighborhood. The minima of the neighborhoods are propagated in one
+                // pass per distance, so that a round takes O(n + m) time.
+                for(int i = b; i < e; ++i)
+                {
+                    node v = m_nodes[i];
+                    node m = (m_state[v] == 0) ? v : 0;
+                    adjEntry adj;
+                    forall_adj(adj, v)
+                    {
+                        node u = adj->twinNode();
+                        if(m_state[u] == 0)
+                            m = minimum(m, u);
+                    }
+                    m_min[v] = m;
+                }
+                sync();
+
+                if(m_distance > 1)
+                {
+                    for(int i = b; i < e; ++i)
+                    {
+                        node v = m_nodes[i];
+                        node m = m_min[v];
+                        adjEntry adj;
+                        forall_adj(adj, v)
+                            m = minimum(m, m_min[adj->twinNode()]);
+                        m_min2[v] = m;
+                    }
+                    sync();
+                }
+
+                const NodeArray<node> & minNearby = (m_distance > 1) ? m_min2 : m_min;
+                for(int i = b; i < e; ++i)
+                {
+                    node v = m_nodes[i];
+                    if(m_state[v] == 0)
+                        m_winner[v] = (minNearby[v] == v);
+                }
+                sync();
+
+                // winners of earlier rounds are decided, so their neighbors are not
+                // undecided anymore; the winners are propagated like the minima
+                for(int i = b; i < e; ++i)
+                {
+                    node v = m_nodes[i];
+                    bool near = m_winner[v];
+                    adjEntry adj;
+                    forall_adj(adj, v)
+                        near = near || m_winner[adj->twinNode()];
+                    m_nearWinner[v] = near;
+                }
+                sync();
+
+                int count = 0;
+                for(int i = b; i < e; ++i)
+                {
+                    node v = m_nodes[i];
+                    if(m_state[v] != 0)
+                        continue;
+
+                    bool near = m_nearWinner[v];
+                    if(m_distance > 1)
+                    {
+                        adjEntry adj;
+                        forall_adj(adj, v)
+                            near = near || m_nearWinner[adj->twinNode()];
+                    }
+
+                    if(m_winner[v])
+                    {
+                        m_state[v] = 1;
+                        m_inSet[v] = true;
+                    }
+                    else if(near)
+                        m_state[v] = 2;
+                    else
+                        ++count;
+                }
+                if(countUndecided(t, round, count) == 0)
+                    break;
+            }
+        }
+
+    private:
+        bool precedes(node u, node v) const
+        {
+            if(m_key != 0 && (*m_key)[u] != (*m_key)[v])
+                return (*m_key)[u] < (*m_key)[v];
+            if(m_priority[u] != m_priority[v])
+                return m_priority[u] < m_priority[v];
+            return u->index() < v->index();
+        }
+
+        //! Returns the preceding node of \a u and \a v (0 is succeeded by all nodes).
+        node minimum(node u, node v) const
+        {
+            if(u == 0)
+                return v;
+            if(v == 0)
+                return u;
+            return precedes(v, u) ? v : u;
+        }
+
+        NodeArray<bool> & m_inSet;
+        int m_distance;
+        const NodeArray<double>* m_key;
+        NodeArray<int> m_state; //!< 0 = undecided, 1 = in the set, 2 = not in the set
+        NodeArray<bool> m_winner;
+        NodeArray<bool> m_nearWinner; //!< whether a winner is at distance at most 1
+        NodeArray<node> m_min;  //!< first undecided node at distance at most 1
+        NodeArray<node> m_min2; //!< first undecided node at distance at most 2
+        NodeArray<__uint32> m_priority;
+    };
+
+
+    class MatchingWorker : public CoarseningWorker
+    {
+    public:
+        MatchingWorker(const Graph & G, NodeArray<edge> & mate, __uint32 seed, int numThreads, const EdgeArray<double>* key)
+            : CoarseningWorker(G, seed, numThreads), m_mate(mate), m_key(key), m_best(G, 0), m_priority(G)
+        {
+            edge e;
+            forall_edges(e, G)
+                m_priority[e] = ParallelCoarsening::priority(m_seed, e->index());
+        }
+
+        void kernel(int t)
+        {
+            const int b = begin(t), e = end(t);
+            for(int round = 0; ; ++round)
+            {
+                // every unmatched node chooses its best edge to an unmatched node
+                for(int i = b; i < e; ++i)
+                {
+                    node v = m_nodes[i];
+                    if(m_mate[v] == 0)
+                        m_best[v] = bestEdge(v);
+                }
+                sync();
+
+                // edges chosen by both end nodes are matched
+                int count = 0;
+                for(int i = b; i < e; ++i)
+                {
+                    node v = m_nodes[i];
+                    edge best = m_best[v];
+                    if(m_mate[v] != 0 || best == 0)
+                        continue;
+                    if(m_best[best->opposite(v)] == best)
+                        m_mate[v] = best;
+                    else
+                        ++count;
+                }
+                if(countUndecided(t, round, count) == 0)
+                    break;
+            }
+        }
+
+    private:
+        bool precedes(edge e, edge f) const
+        {
+            if(m_key != 0 && (*m_key)[e] != (*m_key)[f])
+                return (*m_key)[e] < (*m_key)[f];
+            if(m_priority[e] != m_priority[f])
+                return m_priority[e] < m_priority[f];
+            return e->index() < f->index();
+        }
+
+        edge bestEdge(node v) const
+        {
+            edge best = 0;
+            adjEntry adj;
+            forall_adj(adj, v)
+            {
+                node u = adj->twinNode();
+                edge e = adj->theEdge();
+                if(u != v && m_mate[u] == 0 && (best == 0 || precedes(e, best)))
+                    best = e;
+            }
+            return best;
+        }
+
+        NodeArray<edge> & m_mate;
+        const EdgeArray<double>* m_key;
+        NodeArray<edge> m_best;
+        EdgeArray<__uint32> m_priority;
+    };
+
+
+    void ParallelCoarsening::independentSet(
+        const Graph & G,
+        NodeArray<bool> & inSet,
+        int distance,
+        __uint32 seed,
+        int numThreads,
+        const NodeArray<double>* key)
+    {
+        inSet.init(G, false);
+        numThreads = max(1, min(numThreads, G.numberOfNodes() / 1000));
+        IndependentSetWorker worker(G, inSet, distance, seed, numThreads, key);
+        runKernelThreads(&worker, &IndependentSetWorker::kernel, numThreads);
+    }
+
+
+    void ParallelCoarsening::matching(
+        const Graph & G,
+        NodeArray<edge> & mate,
+        __uint32 seed,
+        int numThreads,
+        const EdgeArray<double>* key)
+    {
+        mate.init(G, 0);
+        numThreads = max(1, min(numThreads, G.numberOfNodes() / 1000));
+        MatchingWorker worker(G, mate, seed, numThreads, key);
+        runKernelThreads(&worker, &MatchingWorker::kernel, numThreads);
+    }
+
+} // end namespace ogdf
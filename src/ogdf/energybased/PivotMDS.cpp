@@ -41,6 +41,10 @@
  ***************************************************************/
 
 #include <ogdf/energybased/PivotMDS.h>
+#include <ogdf/basic/SIMD.h>
+#include <ogdf/internal/basic/intrinsics.h>
+#include <ogdf/basic/ThreadTeam.h>
+#include <vector>
 
 
 namespace ogdf
@@ -50,67 +54,527 @@ namespace ogdf
     const double PivotMDS::FACTOR = -0.5;
 
 
-    void PivotMDS::call(GraphAttributes & GA)
+    //---------------------------------------------------------
+    // kernels for the self product
+    //---------------------------------------------------------
+
+    // Returns the scalar product of a[0..n-1] and b[0..n-1].
+    static double dotProduct(const double* a, const double* b, int n)
     {
-        if(DIMENSION_COUNT > 2)
+        double sum = 0;
+        for(int i = 0; i < n; ++i)
+            sum += a[i] * b[i];
+        return sum;
+    }
+
+
+#ifdef OGDF_AVX2_EXTENSIONS
+    OGDF_TARGET_AVX2 static double dotProduct_avx2(const double* a, const double* b, int n)
+    {
+        __m256d mm_sum0 = _mm256_setzero_pd();
+        __m256d mm_sum1 = _mm256_setzero_pd();
+
+        int i = 0;
+        for(; i + 8 <= n; i += 8)
         {
-            OGDF_ASSERT(GA.attributes() & GraphAttributes::threeD);
+            mm_sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), mm_sum0);
+            mm_sum1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), mm_sum1);
         }
-        if(!isConnected(GA.constGraph()))
+
+        __m256d mm_sum = _mm256_add_pd(mm_sum0, mm_sum1);
+        __m128d s = _mm_add_pd(_mm256_castpd256_pd128(mm_sum), _mm256_extractf128_pd(mm_sum, 1));
+        double sum = _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+        return sum + dotProduct(a + i, b + i, n - i);
+    }
+#endif
+
+
+    typedef double (*DotProductFunction)(const double*, const double*, int);
+
+    static SIMDKernel<DotProductFunction> s_dotProductKernel = SIMDKernel<DotProductFunction>(dotProduct)
+#ifdef OGDF_AVX2_EXTENSIONS
+        .add(simdAVX2, dotProduct_avx2)
+#endif
+        ;
+
+
+    //---------------------------------------------------------
+    // PivotMatrix
+    //---------------------------------------------------------
+
+    //! The pivot distance matrix of PivotMDS and the computations on it.
+    /**
+     * The matrix is stored column-major in one block: column i contains the
+     * distances of pivot i to all nodes (in the order of forall_nodes).
+     * The loops over all nodes are distributed among a team of threads. Every
+     * entry is computed in the same order for every number of threads, hence
+     * the result does not depend on the number of threads.
+     */
+    class PivotMatrix
+    {
+    public:
+        PivotMatrix(const Graph & G, int numberOfPivots, int numThreads);
+
+        //! Returns the number of nodes.
+        int numberOfNodes() const
         {
-            OGDF_THROW_PARAM(PreconditionViolatedException, pvcConnected);
-            return;
+            return m_n;
         }
-        if(m_hasEdgeCostsAttribute
-                && !(GA.attributes() & GraphAttributes::edgeDoubleWeight))
+
+        //! Returns the node of row \a i.
+        node nodeAt(int i) const
         {
-            OGDF_THROW(PreconditionViolatedException);
-            return;
+            return m_node[i];
         }
-        pivotMDSLayout(GA);
+
+        //! Computes the distances of the pivots, which are chosen by the max-min strategy.
+        /**
+         * The first pivot is the first node; every further pivot is the first node
+         * with maximum distance to the previous pivots.
+         * @param edgeCosts are the costs of the edges, or 0 for uniform costs.
+         * @param uniformCosts are the uniform costs of the edges.
+         */
+        void computeDistances(const EdgeArray<double>* edgeCosts, double uniformCosts);
+
+        //! Replaces the entries by \a factor times the double centered squared entries.
+        void center(double factor);
+
+        //! Computes the product C^T C of the matrix C with itself (a row-major k x k matrix).
+        void selfProduct(Array<double> & K);
+
+        //! Computes C x for every vector x in \a x (of length k); \a result must have the same size as \a x.
+        void project(const Array<Array<double>> & x, Array<Array<double>> & result);
+
+    private:
+        //! Number of nodes processed at once by the loops over all pivots.
+        static const int BLOCK_SIZE = 1024;
+        //! Number of pivots per tile of the self product.
+        static const int TILE_SIZE = 8;
+        //! Parameters of the direction-optimizing BFS.
+        static const int ALPHA = 14, BETA = 24;
+
+        const Graph* m_pGraph;
+        int m_n; //!< the number of nodes
+        int m_k; //!< the number of pivots
+        std::vector<double> m_C; //!< the matrix (column-major)
+        Array<node> m_node;      //!< the node of each row
+        Array<int>  m_adjBegin;  //!< adjacency lists of the rows in m_adj
+        Array<int>  m_adj;
+
+        ThreadTeam<PivotMatrix> m_team;
+
+        // state of the current phase
+        std::vector<int> m_level;      //!< BFS level of each node (-1 if not reached)
+        std::vector<double> m_minDist; //!< distance of each node to the closest pivot
+        double* m_column;              //!< the column of the current pivot
+        int m_currentLevel;            //!< the current BFS level
+        double m_currentDist;          //!< the distance of the next BFS level
+        Array<std::vector<int>> m_next; //!< the nodes of the next BFS level found by each thread
+        Array<int> m_best;             //!< the node with maximum distance found by each thread
+        Array<double> m_colSum;        //!< the sum of squares of each column
+        double m_normalization;        //!< the mean of all squared entries
+        double m_factor;               //!< the factor of center()
+        Array<double>* m_pK;           //!< the result of selfProduct()
+        const Array<Array<double>>* m_pX; //!< the vectors of project()
+        Array<Array<double>>* m_pResult;  //!< the result of project()
+
+        double* column(int i)
+        {
+            return &m_C[size_t(i) * m_n];
+        }
+
+        //! Returns the range of rows of thread \a t.
+        void threadRange(int t, int & begin, int & end) const
+        {
+            begin = threadRangeBegin(m_n, t, m_team.numThreads());
+            end   = threadRangeBegin(m_n, t + 1, m_team.numThreads());
+        }
+
+        //! Computes the distances of node \a s by breadth first search into m_column.
+        void bfs(int s, double edgeCosts);
+
+        void resetTask(int t);
+        void bottomUpTask(int t);
+        void minDistanceTask(int t);
+        void columnSumTask(int t);
+        void centerTask(int t);
+        void selfProductTask(int t);
+        void projectTask(int t);
+    };
+
+
+    PivotMatrix::PivotMatrix(const Graph & G, int numberOfPivots, int numThreads)
+        : m_pGraph(&G), m_n(G.numberOfNodes()), m_k(numberOfPivots),
+          m_C(size_t(numberOfPivots) * G.numberOfNodes()),
+          m_team(this, max(1, min(numThreads, G.numberOfNodes() / BLOCK_SIZE)))
+    {
+        const int numThreadsUsed = m_team.numThreads();
+        m_next.init(numThreadsUsed);
+        m_best.init(numThreadsUsed);
+
+        NodeArray<int> index(G);
+        m_node.init(m_n);
+        int i = 0;
+        node v;
+        forall_nodes(v, G)
+        {
+            index[v] = i;
+            m_node[i++] = v;
+        }
+
+        m_adjBegin.init(m_n + 1);
+        m_adj.init(2 * G.numberOfEdges());
+        int k = 0;
+        for(i = 0; i < m_n; i++)
+        {
+            m_adjBegin[i] = k;
+            edge e;
+            forall_adj_edges(e, m_node[i])
+                m_adj[k++] = index[e->opposite(m_node[i])];
+        }
+        m_adjBegin[m_n] = k;
+    }
+
+
+    void PivotMatrix::computeDistances(const EdgeArray<double>* edgeCosts, double uniformCosts)
+    {
+        const Graph & G = *m_pGraph;
+        m_minDist.assign(m_n, std::numeric_limits<double>::infinity());
+        NodeArray<double> shortestPathSingleSource;
+        if(edgeCosts != 0)
+            shortestPathSingleSource.init(G);
+        else
+            m_level.resize(m_n);
+
+        // the current pivot node
+        int pivot = 0;
+        for(int i = 0; i < m_k; i++)
+        {
+            // get the shortest path from the currently processed pivot node to
+            // all other nodes in the graph
+            m_column = column(i);
+            if(edgeCosts != 0)
+            {
+                shortestPathSingleSource.fill(std::numeric_limits<double>::infinity());
+                dijkstra_SPSS(m_node[pivot], G, shortestPathSingleSource, *edgeCosts);
+                for(int j = 0; j < m_n; j++)
+                    m_column[j] = shortestPathSingleSource[m_node[j]];
+            }
+            else
+            {
+                bfs(pivot, uniformCosts);
+            }
+
+            // update the minimum distances and choose the next pivot ... to ensure
+            // the correctness set minDistance of the pivot node to zero
+            m_minDist[pivot] = 0;
+            m_team.run(&PivotMatrix::minDistanceTask);
+            for(int t = 0; t < m_team.numThreads(); t++)
+            {
+                if(m_best[t] >= 0 && m_minDist[m_best[t]] > m_minDist[pivot])
+                    pivot = m_best[t];
+            }
+        }
+    }
+
+
+    void PivotMatrix::minDistanceTask(int t)
+    {
+        int begin, end;
+        threadRange(t, begin, end);
+        int best = -1;
+        double maxDist = 0;
+        for(int v = begin; v < end; v++)
+        {
+            m_minDist[v] = min(m_minDist[v], m_column[v]);
+            if(m_minDist[v] > maxDist)
+            {
+                best = v;
+                maxDist = m_minDist[v];
+            }
+        }
+        m_best[t] = best;
     }
 
 
-    void PivotMDS::centerPivotmatrix(Array<Array<double>> & pivotMatrix)
+    void PivotMatrix::bfs(int s, double edgeCosts)
     {
-        int numberOfPivots = pivotMatrix.size();
-        // this is ensured since the graph size is at least 2!
-        int nodeCount = pivotMatrix[0].size();
+        // Levels with many edges are processed bottom-up: every unreached node
+        // (in parallel) looks for a neighbor in the current level, which saves
+        // most edge inspections on graphs with small diameter. Other levels are
+        // processed top-down by the calling thread. The distances of a level are
+        // summed up like in a sequential BFS.
+        m_team.run(&PivotMatrix::resetTask);
+
+        std::vector<int> frontier(1, s), next;
+        m_level[s] = 0;
+        m_column[s] = 0;
+
+        __int64 frontierEdges = m_adjBegin[s + 1] - m_adjBegin[s];
+        __int64 unexploredEdges = m_adjBegin[m_n] - frontierEdges;
+        bool bottomUp = false;
+
+        m_currentLevel = 0;
+        double dist = 0;
+        while(!frontier.empty())
+        {
+            m_currentDist = dist + edgeCosts;
+
+            if(!bottomUp)
+                bottomUp = frontierEdges > unexploredEdges / ALPHA;
+            else
+                bottomUp = (__int64)frontier.size() * BETA >= m_n;
 
-        double normalizationFactor = 0;
-        double rowColNormalizer;
-        Array<double> colNormalization(numberOfPivots);
+            next.clear();
+            if(bottomUp)
+            {
+                m_team.run(&PivotMatrix::bottomUpTask);
+                for(int t = 0; t < m_team.numThreads(); t++)
+                    next.insert(next.end(), m_next[t].begin(), m_next[t].end());
+            }
+            else
+            {
+                for(size_t i = 0; i < frontier.size(); i++)
+                {
+                    const int v = frontier[i];
+                    for(int k = m_adjBegin[v]; k < m_adjBegin[v + 1]; k++)
+                    {
+                        const int w = m_adj[k];
+                        if(m_level[w] < 0)
+                        {
+                            m_level[w] = m_currentLevel + 1;
+                            m_column[w] = m_currentDist;
+                            next.push_back(w);
+                        }
+                    }
+                }
+            }
 
-        for(int i = 0; i < numberOfPivots; i++)
+            frontierEdges = 0;
+            for(size_t i = 0; i < next.size(); i++)
+                frontierEdges += m_adjBegin[next[i] + 1] - m_adjBegin[next[i]];
+            unexploredEdges -= frontierEdges;
+
+            frontier.swap(next);
+            dist = m_currentDist;
+            m_currentLevel++;
+        }
+    }
+
+
+    void PivotMatrix::resetTask(int t)
+    {
+        int begin, end;
+        threadRange(t, begin, end);
+        for(int v = begin; v < end; v++)
         {
-            rowColNormalizer = 0;
-            for(int j = 0; j < nodeCount; j++)
+            m_level[v] = -1;
+            m_column[v] = std::numeric_limits<double>::infinity();
+        }
+    }
+
+
+    void PivotMatrix::bottomUpTask(int t)
+    {
+        int begin, end;
+        threadRange(t, begin, end);
+        std::vector<int> & next = m_next[t];
+        next.clear();
+        for(int v = begin; v < end; v++)
+        {
+            if(m_level[v] >= 0)
+                continue;
+            for(int k = m_adjBegin[v]; k < m_adjBegin[v + 1]; k++)
             {
-                rowColNormalizer += pivotMatrix[i][j] * pivotMatrix[i][j];
+                if(m_level[m_adj[k]] == m_currentLevel)
+                {
+                    m_level[v] = m_currentLevel + 1;
+                    m_column[v] = m_currentDist;
+                    next.push_back(v);
+                    break;
+                }
             }
-            normalizationFactor += rowColNormalizer;
-            colNormalization[i] = rowColNormalizer / nodeCount;
         }
-        normalizationFactor = normalizationFactor / (nodeCount * numberOfPivots);
-        for(int i = 0; i < nodeCount; i++)
+    }
+
+
+    void PivotMatrix::center(double factor)
+    {
+        m_colSum.init(m_k);
+        m_team.run(&PivotMatrix::columnSumTask);
+
+        m_normalization = 0;
+        for(int j = 0; j < m_k; j++)
+            m_normalization += m_colSum[j];
+        m_normalization = m_normalization / ((double)m_n * m_k);
+
+        m_factor = factor;
+        m_team.run(&PivotMatrix::centerTask);
+    }
+
+
+    void PivotMatrix::columnSumTask(int t)
+    {
+        const int begin = threadRangeBegin(m_k, t, m_team.numThreads());
+        const int end   = threadRangeBegin(m_k, t + 1, m_team.numThreads());
+        for(int j = begin; j < end; j++)
         {
-            rowColNormalizer = 0;
-            for(int j = 0; j < numberOfPivots; j++)
+            const double* c = column(j);
+            double sum = 0;
+            for(int i = 0; i < m_n; i++)
+                sum += c[i] * c[i];
+            m_colSum[j] = sum;
+        }
+    }
+
+
+    void PivotMatrix::centerTask(int t)
+    {
+        int begin, end;
+        threadRange(t, begin, end);
+        double rowMean[BLOCK_SIZE];
+
+        for(int b = begin; b < end; b += BLOCK_SIZE)
+        {
+            const int size = min(BLOCK_SIZE, end - b);
+
+            for(int i = 0; i < size; i++)
+                rowMean[i] = 0;
+            for(int j = 0; j < m_k; j++)
             {
-                double square = pivotMatrix[j][i] * pivotMatrix[j][i];
-                pivotMatrix[j][i] = square + normalizationFactor
-                                    - colNormalization[j];
-                rowColNormalizer += square;
+                const double* c = column(j) + b;
+                for(int i = 0; i < size; i++)
+                    rowMean[i] += c[i] * c[i];
             }
-            rowColNormalizer /= numberOfPivots;
-            for(int j = 0; j < numberOfPivots; j++)
+            for(int i = 0; i < size; i++)
+                rowMean[i] /= m_k;
+
+            for(int j = 0; j < m_k; j++)
             {
-                pivotMatrix[j][i] = FACTOR * (pivotMatrix[j][i] - rowColNormalizer);
+                double* c = column(j) + b;
+                const double colMean = m_colSum[j] / m_n;
+                for(int i = 0; i < size; i++)
+                    c[i] = m_factor * ((c[i] * c[i] + m_normalization - colMean) - rowMean[i]);
             }
         }
     }
 
 
+    void PivotMatrix::selfProduct(Array<double> & K)
+    {
+        K.init(m_k * m_k);
+        m_pK = &K;
+        m_team.run(&PivotMatrix::selfProductTask);
+    }
+
+
+    void PivotMatrix::selfProductTask(int t)
+    {
+        // the entries are computed in tiles of TILE_SIZE x TILE_SIZE pivots; for
+        // each tile, the columns are traversed in blocks of BLOCK_SIZE nodes, which
+        // stay in the cache while they are multiplied with the other columns of the tile
+        const DotProductFunction dot = s_dotProductKernel.get();
+        const int numTiles = (m_k + TILE_SIZE - 1) / TILE_SIZE;
+        Array<double> & K = *m_pK;
+
+        int tile = 0;
+        for(int ti = 0; ti < numTiles; ti++)
+        {
+            for(int tj = 0; tj <= ti; tj++, tile++)
+            {
+                if(tile % m_team.numThreads() != t)
+                    continue;
+
+                const int iBegin = ti * TILE_SIZE, iEnd = min(m_k, iBegin + TILE_SIZE);
+                const int jBegin = tj * TILE_SIZE, jEnd = min(m_k, jBegin + TILE_SIZE);
+
+                double sum[TILE_SIZE][TILE_SIZE];
+                for(int i = 0; i < TILE_SIZE; i++)
+                    for(int j = 0; j < TILE_SIZE; j++)
+                        sum[i][j] = 0;
+
+                for(int b = 0; b < m_n; b += BLOCK_SIZE)
+                {
+                    const int size = min(BLOCK_SIZE, m_n - b);
+                    for(int i = iBegin; i < iEnd; i++)
+                        for(int j = jBegin; j < jEnd && j <= i; j++)
+                            sum[i - iBegin][j - jBegin] += dot(column(i) + b, column(j) + b, size);
+                }
+
+                for(int i = iBegin; i < iEnd; i++)
+                {
+                    for(int j = jBegin; j < jEnd && j <= i; j++)
+                    {
+                        K[i * m_k + j] = sum[i - iBegin][j - jBegin];
+                        K[j * m_k + i] = sum[i - iBegin][j - jBegin];
+                    }
+                }
+            }
+        }
+    }
+
+
+    void PivotMatrix::project(const Array<Array<double>> & x, Array<Array<double>> & result)
+    {
+        m_pX = &x;
+        m_pResult = &result;
+        m_team.run(&PivotMatrix::projectTask);
+    }
+
+
+    void PivotMatrix::projectTask(int t)
+    {
+        int begin, end;
+        threadRange(t, begin, end);
+        const Array<Array<double>> & x = *m_pX;
+        Array<Array<double>> & result = *m_pResult;
+
+        for(int d = 0; d < x.size(); d++)
+        {
+            double* r = &result[d][0];
+            for(int b = begin; b < end; b += BLOCK_SIZE)
+            {
+                const int size = min(BLOCK_SIZE, end - b);
+                for(int i = b; i < b + size; i++)
+                    r[i] = 0;
+                for(int k = 0; k < m_k; k++)
+                {
+                    const double* c = column(k);
+                    const double xk = x[d][k];
+                    for(int i = b; i < b + size; i++)
+                        r[i] += c[i] * xk;
+                }
+            }
+        }
+    }
+
+
+    //---------------------------------------------------------
+    // PivotMDS
+    //---------------------------------------------------------
+
+
+    void PivotMDS::call(GraphAttributes & GA)
+    {
+        if(DIMENSION_COUNT > 2)
+        {
+            OGDF_ASSERT(GA.attributes() & GraphAttributes::threeD);
+        }
+        if(!isConnected(GA.constGraph()))
+        {
+            OGDF_THROW_PARAM(PreconditionViolatedException, pvcConnected);
+            return;
+        }
+        if(m_hasEdgeCostsAttribute
+                && !(GA.attributes() & GraphAttributes::edgeDoubleWeight))
+        {
+            OGDF_THROW(PreconditionViolatedException);
+            return;
+        }
+        pivotMDSLayout(GA);
+    }
+
+
     void PivotMDS::pivotMDSLayout(GraphAttributes & GA)
     {
         const Graph & G = GA.constGraph();
@@ -135,41 +599,75 @@ namespace ogdf
         }
         else
         {
-            Array<Array<double>> pivDistMatrix;
-            // compute the pivot matrix
-            getPivotDistanceMatrix(GA, pivDistMatrix);
+            // lower the number of pivots if necessary
+            const int l = min(G.numberOfNodes(), m_numberOfPivots);
+            const int n = G.numberOfNodes();
+            PivotMatrix pivDistMatrix(G, l, m_numberOfThreads);
+
+            // compute the pivot matrix based on the maxmin strategy
+            if(m_hasEdgeCostsAttribute)
+            {
+                // already checked whether this attribute exists or not (see call method)
+                EdgeArray<double> edgeCosts(G);
+                edge e;
+                forall_edges(e, G)
+                {
+                    edgeCosts[e] = GA.doubleWeight(e);
+                }
+                pivDistMatrix.computeDistances(&edgeCosts, m_edgeCosts);
+            }
+            else
+            {
+                pivDistMatrix.computeDistances(0, m_edgeCosts);
+            }
             // center the pivot matrix
-            centerPivotmatrix(pivDistMatrix);
-            // init the coordinate matrix
-            Array<Array<double>> coord(DIMENSION_COUNT);
-            for(int i = 0; i < coord.size(); i++)
+            pivDistMatrix.center(FACTOR);
+
+            // singular value decomposition: calc C^TC and its eigen vectors
+            Array<double> K;
+            pivDistMatrix.selfProduct(K);
+
+            Array<Array<double>> tmp(DIMENSION_COUNT);
+            for(int i = 0; i < DIMENSION_COUNT; i++)
             {
-                coord[i].init(G.numberOfNodes());
+                tmp[i].init(l);
             }
             // init the eigen values array
             Array<double> eVals(DIMENSION_COUNT);
-            singularValueDecomposition(pivDistMatrix, coord, eVals);
+            eigenValueDecomposition(K, l, tmp, eVals);
+
+            // init the coordinate matrix and compute C^Tx
+            Array<Array<double>> coord(DIMENSION_COUNT);
+            for(int i = 0; i < coord.size(); i++)
+            {
+                coord[i].init(n);
+            }
+            pivDistMatrix.project(tmp, coord);
+            for(int i = 0; i < DIMENSION_COUNT; i++)
+            {
+                eVals[i] = sqrt(eVals[i]);
+                normalize(coord[i]);
+            }
+
             // compute the correct aspect ratio
             for(int i = 0; i < coord.size(); i++)
             {
                 eVals[i] = sqrt(eVals[i]);
-                for(int j = 0; j < G.numberOfNodes(); j++)
+                for(int j = 0; j < n; j++)
                 {
                     coord[i][j] *= eVals[i];
                 }
             }
             // set the new positions to the graph
-            int i = 0;
-            node v;
-            forall_nodes(v, G)
+            for(int i = 0; i < n; i++)
             {
+                node v = pivDistMatrix.nodeAt(i);
                 GA.x(v) = coord[0][i];
                 GA.y(v) = coord[1][i];
                 if(DIMENSION_COUNT > 2)
                 {
-                    GA.z(v) = coord[2][i];//cout << coord[2][i] << "\n";
+                    GA.z(v) = coord[2][i];
                 }
-                ++i;
             }
         }
     }
@@ -214,12 +712,12 @@ namespace ogdf
 
 
     void PivotMDS::eigenValueDecomposition(
-        Array<Array<double>> & K,
+        const Array<double> & K,
+        int p,
         Array<Array<double>> & eVecs,
         Array<double> & eValues)
     {
         randomize(eVecs);
-        const int p = K.size();
         double r = 0;
         for(int i = 0; i < DIMENSION_COUNT; i++)
         {
@@ -245,14 +743,17 @@ namespace ogdf
                     eVecs[i][j] = 0;
                 }
             }
-            // multiply matrices
-            for(int i = 0; i < DIMENSION_COUNT; i++)
+            // multiply matrices; every row of K is read once for all vectors
+            for(int j = 0; j < p; j++)
             {
-                for(int j = 0; j < p; j++)
+                const double* row = &K[j * p];
+                for(int i = 0; i < DIMENSION_COUNT; i++)
                 {
+                    const double t = tmpOld[i][j];
+                    double* eVec = &eVecs[i][0];
                     for(int k = 0; k < p; k++)
                     {
-                        eVecs[i][k] += K[j][k] * tmpOld[i][j];
+                        eVec[k] += row[k] * t;
                     }
                 }
             }
@@ -289,77 +790,6 @@ namespace ogdf
     }
 
 
-    void PivotMDS::getPivotDistanceMatrix(
-        const GraphAttributes & GA,
-        Array<Array<double>> & pivDistMatrix)
-    {
-        const Graph & G = GA.constGraph();
-        // lower the number of pivots if necessary
-        int numberOfPivots = min(G.numberOfNodes(), m_numberOfPivots);
-        // number of pivots times n matrix used to store the graph distances
-        pivDistMatrix.init(numberOfPivots);
-        for(int i = 0; i < numberOfPivots; i++)
-        {
-            pivDistMatrix[i].init(G.numberOfNodes());
-        }
-        // edges costs array
-        EdgeArray<double> edgeCosts;
-        bool hasEdgeCosts = false;
-        // already checked whether this attribute exists or not (see call method)
-        if(m_hasEdgeCostsAttribute)
-        {
-            edgeCosts.init(G);
-            edge e;
-            forall_edges(e, G)
-            {
-                edgeCosts[e] = GA.doubleWeight(e);
-            }
-            hasEdgeCosts = true;
-        }
-        // used for min-max strategy
-        NodeArray<double> minDistances(G, std::numeric_limits<double>::infinity());
-        NodeArray<double> shortestPathSingleSource(G);
-        // the current pivot node
-        node pivNode = G.firstNode();
-        for(int i = 0; i < numberOfPivots; i++)
-        {
-            // get the shortest path from the currently processed pivot node to
-            // all other nodes in the graph
-            shortestPathSingleSource.fill(std::numeric_limits<double>::infinity());
-            if(hasEdgeCosts)
-            {
-                dijkstra_SPSS(pivNode, G, shortestPathSingleSource, edgeCosts);
-            }
-            else
-            {
-                bfs_SPSS(pivNode, G, shortestPathSingleSource, m_edgeCosts);
-            }
-            copySPSS(pivDistMatrix[i], shortestPathSingleSource);
-            // update the pivot and the minDistances array ... to ensure the
-            // correctness set minDistance of the pivot node to zero
-            minDistances[pivNode] = 0;
-            node v;
-            forall_nodes(v, G)
-            {
-                minDistances[v] = min(minDistances[v], shortestPathSingleSource[v]);
-                if(minDistances[v] > minDistances[pivNode])
-                {
-                    pivNode = v;
-                }
-            }
-        }
-    }
-
-
-    void PivotMDS::copySPSS(Array<double> & copyTo, NodeArray<double> & copyFrom)
-    {
-        for(int i = 0; i < copyTo.size(); i++)
-        {
-            copyTo[i] = copyFrom[i];
-        }
-    }
-
-
     node PivotMDS::getRootedPath(const Graph & G)
     {
         node head = 0;
@@ -442,66 +872,4 @@ namespace ogdf
         }
     }
 
-
-    void PivotMDS::selfProduct(const Array<Array<double>> & d, Array<Array<double>> & result)
-    {
-        double sum;
-        for(int i = 0; i < d.size(); i++)
-        {
-            for(int j = 0; j <= i; j++)
-            {
-                sum = 0;
-                for(int k = 0; k < d[0].size(); k++)
-                {
-                    sum += d[i][k] * d[j][k];
-                }
-                result[i][j] = sum;
-                result[j][i] = sum;
-            }
-        }
-    }
-
-
-    void PivotMDS::singularValueDecomposition(
-        Array<Array<double>> & pivDistMatrix,
-        Array<Array<double>> & eVecs,
-        Array<double> & eVals)
-    {
-        const int l = pivDistMatrix.size();
-        const int n = pivDistMatrix[0].size();
-        Array<Array<double>> K(l);
-        for(int i = 0; i < l; i++)
-        {
-            K[i].init(l);
-        }
-        // calc C^TC
-        selfProduct(pivDistMatrix, K);
-
-        Array<Array<double>> tmp(DIMENSION_COUNT);
-        for(int i = 0; i < DIMENSION_COUNT; i++)
-        {
-            tmp[i].init(l);
-        }
-
-        eigenValueDecomposition(K, tmp, eVals);
-
-        // C^Tx
-        for(int i = 0; i < DIMENSION_COUNT; i++)
-        {
-            eVals[i] = sqrt(eVals[i]);
-            for(int j = 0; j < n; j++)    // node j
-            {
-                eVecs[i][j] = 0;
-                for(int k = 0; k < l; k++)    // pivot k
-                {
-                    eVecs[i][j] += pivDistMatrix[k][j] * tmp[i][k];
-                }
-            }
-        }
-        for(int i = 0; i < DIMENSION_COUNT; i++)
-        {
-            normalize(eVecs[i]);
-        }
-    }
-
 } /* namespace ogdf */
@@ -45,69 +45,54 @@
 namespace ogdf
 {
 
-    Planarity::~Planarity()
-    {
-        delete m_edgeNums;
-        delete m_crossingMatrix;
-    }
+    //! Cell coordinates are clamped to [-MAX_CELL, MAX_CELL].
+    static const double MAX_CELL = 1 << 30;
+
+
+    Planarity::~Planarity() { }
 
 
-    // intializes number of edges and allocates memory for  crossingMatrix
+    // numbers the edges that are not self loops
     Planarity::Planarity(GraphAttributes & AG):
-        EnergyFunction("Planarity", AG)
+        EnergyFunction("Planarity", AG),
+        m_edgeNums(m_G, -1),
+        m_cellSize(1.0),
+        m_bucketMask(0),
+        m_lengthSum(0.0),
+        m_movesSinceBuild(0)
     {
-        m_edgeNums = OGDF_NEW EdgeArray<int>(m_G, 0);
-        m_G.allEdges(m_nonSelfLoops);
-        ListIterator<edge> it, itSucc;
-        for(it = m_nonSelfLoops.begin(); it.valid(); it = itSucc)
+        int e_num = 0;
+        edge e;
+        forall_edges(e, m_G)
+            if(!e->isSelfLoop()) e_num++;
+
+        m_edges.init(e_num);
+        m_source.init(e_num);
+        m_target.init(e_num);
+        m_crossings.init(0, e_num - 1, 0);
+        m_query.init(e_num);
+
+        e_num = 0;
+        forall_edges(e, m_G) if(!e->isSelfLoop())
         {
-            itSucc = it.succ();
-            if((*it)->isSelfLoop()) m_nonSelfLoops.del(it);
+            m_edgeNums[e] = e_num;
+            m_edges[e_num++] = e;
         }
-        int e_num = 1;
-        for(it = m_nonSelfLoops.begin(); it.valid(); ++it)(*m_edgeNums)[*it] = e_num ++;
-        e_num --;
-        m_crossingMatrix = new Array2D<bool> (1, e_num, 1, e_num);
     }
 
 
-    // computes energy of layout, stores it and sets the crossingMatrix
+    // computes energy of layout, stores it and sets the crossing numbers
     void Planarity::computeEnergy()
     {
-        int e_num = m_nonSelfLoops.size();
-        int energySum = 0;
-        Array<edge> numEdge(1, e_num);
-        edge e;
-        ListIterator<edge> it;
+        buildGrid();
 
-        for(it = m_nonSelfLoops.begin(); it.valid(); ++it)
-            numEdge[(*m_edgeNums)[*it]] = *it;
-        for(int i = 1; i < e_num; i++)
+        int energySum = 0;
+        for(int e = 0; e < m_edges.size(); e++)
         {
-            e = numEdge[i];
-            for(int j = i + 1; j <= e_num ; j++)
-            {
-                bool cross = intersect(e, numEdge[j]);
-                (*m_crossingMatrix)(i, j) = cross;
-                if(cross) energySum += 1;
-            }
+            m_crossings[e] = countCrossings(e, m_source[e], m_target[e], 0);
+            energySum += m_crossings[e];
         }
-        m_energy = energySum;
-    }
-
-
-    // tests if two edges cross
-    bool Planarity::intersect(const edge e1, const edge e2) const
-    {
-        node v1s = e1->source();
-        node v1t = e1->target();
-        node v2s = e2->source();
-        node v2t = e2->target();
-
-        bool cross = false;
-        if(v1s != v2s && v1s != v2t && v1t != v2s && v1t != v2t)
-            cross = lowLevelIntersect(currentPos(v1s), currentPos(v1t), currentPos(v2s), currentPos(v2t));
-        return cross;
+        m_energy = energySum / 2; // every crossing was counted for both edges
     }
 
 
@@ -118,6 +103,15 @@ namespace ogdf
         const DPoint & e2s,
         const DPoint & e2t) const
     {
+        // DLine::intersection() only reports crossings within both bounding
+        // boxes (up to OGDF_GEOM_EPS), so disjoint boxes are rejected first
+        const double tolerance = 4 * OGDF_GEOM_EPS;
+        if(min(e1s.m_x, e1t.m_x) > max(e2s.m_x, e2t.m_x) + tolerance
+                || min(e2s.m_x, e2t.m_x) > max(e1s.m_x, e1t.m_x) + tolerance
+                || min(e1s.m_y, e1t.m_y) > max(e2s.m_y, e2t.m_y) + tolerance
+                || min(e2s.m_y, e2t.m_y) > max(e1s.m_y, e1t.m_y) + tolerance)
+            return false;
+
         DPoint s1(e1s), t1(e1t), s2(e2s), t2(e2t);
         DLine l1(s1, t1), l2(s2, t2);
         DPoint dummy;
@@ -125,86 +119,248 @@ namespace ogdf
     }
 
 
-    // computes the energy if the node returned by testNode() is moved
-    // to position testPos().
-    void Planarity::compCandEnergy()
+    // counts the edges in the buckets of the segment that cross it; only the
+    // query data is changed, so threads with different query data may run
+    // this function concurrently
+    int Planarity::countCrossings(
+        int e,
+        const DPoint & s,
+        const DPoint & t,
+        Query & q,
+        ArrayBuffer<int>* crossing) const
     {
-        node v = testNode();
-        m_candidateEnergy = energy();
-        edge e;
-        m_crossingChanges.clear();
+        // every edge is tested only once although it may occur in several buckets
+        if(++q.m_stamp == numeric_limits<int>::max())
+        {
+            q.m_visited.fill(0);
+            q.m_stamp = 1;
+        }
+        q.m_visited[e] = q.m_stamp;
 
-        forall_adj_edges(e, v) if(!e->isSelfLoop())
+        q.m_buckets.clear();
+        collectBuckets(s, t, q.m_buckets);
+
+        node v1s = m_edges[e]->source();
+        node v1t = m_edges[e]->target();
+        int count = 0;
+        for(int i = 0; i < q.m_buckets.size(); i++)
         {
-            // first we compute the two endpoints of e if v is on its new position
-            node s = e->source();
-            node t = e->target();
-            DPoint p1 = testPos();
-            DPoint p2 = (s == v) ? currentPos(t) : currentPos(s);
-            int e_num = (*m_edgeNums)[e];
-            edge f;
-            // now we compute the crossings of all other edges with e
-            ListIterator<edge> it;
-            for(it = m_nonSelfLoops.begin(); it.valid(); ++it) if(*it != e)
+            const ArrayBuffer<int> & bucket = m_buckets[q.m_buckets[i]];
+            for(int j = 0; j < bucket.size(); j++)
+            {
+                int f = bucket[j];
+                if(q.m_visited[f] == q.m_stamp) continue;
+                q.m_visited[f] = q.m_stamp;
+
+                // edges with a common endpoint do not cross
+                node v2s = m_edges[f]->source();
+                node v2t = m_edges[f]->target();
+                if(v1s != v2s && v1s != v2t && v1t != v2s && v1t != v2t
+                        && lowLevelIntersect(s, t, m_source[f], m_target[f]))
                 {
-                    f = *it;
-                    node s2 = f->source();
-                    node t2 = f->target();
-                    if(s2 != s && s2 != t && t2 != s && t2 != t)
-                    {
-                        bool cross = lowLevelIntersect(p1, p2, currentPos(s2), currentPos(t2));
-                        int f_num = (*m_edgeNums)[f];
-                        bool priorIntersect = (*m_crossingMatrix)(min(e_num, f_num), max(e_num, f_num));
-                        if(priorIntersect != cross)
-                        {
-                            if(priorIntersect) m_candidateEnergy --; // this intersection was saved
-                            else m_candidateEnergy ++; // produced a new intersection
-                            ChangedCrossing cc;
-                            cc.edgeNum1 = min(e_num, f_num);
-                            cc.edgeNum2 = max(e_num, f_num);
-                            cc.cross = cross;
-                            m_crossingChanges.pushBack(cc);
-                        }
-                    }
+                    count++;
+                    if(crossing != 0) crossing->push(f);
                 }
+            }
         }
+        return count;
     }
 
 
-    // this functions sets the crossingMatrix according to candidateCrossings
-    void Planarity::internalCandidateTaken()
+    int Planarity::countCrossings(int e, const DPoint & s, const DPoint & t, int delta)
     {
-        ListIterator<ChangedCrossing> it;
-        for(it = m_crossingChanges.begin(); it.valid(); ++ it)
-        {
-            ChangedCrossing cc = *(it);
-            (*m_crossingMatrix)(cc.edgeNum1, cc.edgeNum2) = cc.cross;
-        }
+        if(delta == 0)
+            return countCrossings(e, s, t, m_query, 0);
+
+        m_crossing.clear();
+        int count = countCrossings(e, s, t, m_query, &m_crossing);
+        for(int i = 0; i < m_crossing.size(); i++)
+            m_crossings[m_crossing[i]] += delta;
+        return count;
     }
 
 
-#ifdef OGDF_DEBUG
-    void Planarity::printInternalData() const
+    // the cells are roughly as large as the average edge, hence every
+    // segment is stored in a constant number of cells on average
+    void Planarity::buildGrid()
     {
-        cout << "\nCrossing Matrix:";
-        int e_num = m_nonSelfLoops.size();
-        for(int i = 1; i < e_num; i++)
+        const int e_num = m_edges.size();
+
+        m_lengthSum = 0.0;
+        for(int e = 0; e < e_num; e++)
         {
-            cout << "\n Edge " << i << " crosses: ";
-            for(int j = i + 1; j <= e_num; j++)
-                if((*m_crossingMatrix)(i, j)) cout << j << " ";
+            m_source[e] = currentPos(m_edges[e]->source());
+            m_target[e] = currentPos(m_edges[e]->target());
+            m_lengthSum += m_source[e].distance(m_target[e]);
         }
-        cout << "\nChanged crossings:";
-        if(testNode() == NULL) cout << " None.";
+        m_cellSize = (e_num > 0) ? m_lengthSum / e_num : 0.0;
+        if(!DIsGreater(m_cellSize, 0.0)) m_cellSize = 1.0;
+        m_movesSinceBuild = 0;
+
+        int numBuckets = 16;
+        while(numBuckets < 2 * e_num) numBuckets *= 2;
+        if(m_buckets.size() != numBuckets)
+            m_buckets.init(numBuckets);
         else
+            for(int b = 0; b < numBuckets; b++) m_buckets[b].clear();
+        m_bucketMask = numBuckets - 1;
+
+        for(int e = 0; e < e_num; e++)
+            insertSegment(e);
+    }
+
+
+    // Every row of cells is intersected with the segment, and all cells in the
+    // x-range of the resulting piece are reported. Both ranges are enlarged by a
+    // small tolerance, so two crossing segments always share the cell of the
+    // crossing, even if it lies on the border between cells.
+    void Planarity::collectBuckets(const DPoint & s, const DPoint & t, ArrayBuffer<int> & buckets) const
+    {
+        const double eps = 1e-9 * m_cellSize;
+        const double minY = min(s.m_y, t.m_y), maxY = max(s.m_y, t.m_y);
+        const double dx = t.m_x - s.m_x, dy = t.m_y - s.m_y;
+
+        int firstRow = int(max(-MAX_CELL, floor((minY - eps) / m_cellSize)));
+        int lastRow  = int(min( MAX_CELL, floor((maxY + eps) / m_cellSize)));
+        for(int row = firstRow; row <= lastRow; row++)
         {
-            ListConstIterator<ChangedCrossing> it;
-            for(it = m_crossingChanges.begin(); it.valid(); ++it)
+            // the piece of the segment within this row
+            double y1 = max(minY, row * m_cellSize);
+            double y2 = min(maxY, (row + 1) * m_cellSize);
+            if(y1 > y2)
+                y1 = y2 = (row == firstRow) ? minY : maxY;
+
+            double x1, x2;
+            if(dy == 0)
+            {
+                x1 = min(s.m_x, t.m_x);
+                x2 = max(s.m_x, t.m_x);
+            }
+            else
             {
-                ChangedCrossing cc = *(it);
-                cout << " (" << cc.edgeNum1 << "," << cc.edgeNum2 << ")" << cc.cross;
+                x1 = s.m_x + (y1 - s.m_y) / dy * dx;
+                x2 = s.m_x + (y2 - s.m_y) / dy * dx;
+                if(x1 > x2) swap(x1, x2);
             }
+
+            int firstCol = int(max(-MAX_CELL, floor((x1 - eps) / m_cellSize)));
+            int lastCol  = int(min( MAX_CELL, floor((x2 + eps) / m_cellSize)));
+            for(int col = firstCol; col <= lastCol; col++)
+            {
+                __uint32 h = __uint32(col) * 0x9E3779B1u ^ __uint32(row) * 0x85EBCA77u;
+                buckets.push(int((h ^ (h >> 15)) & m_bucketMask));
+            }
+        }
+    }
+
+
+    void Planarity::insertSegment(int e)
+    {
+        ArrayBuffer<int> & buckets = m_query.m_buckets;
+        buckets.clear();
+        collectBuckets(m_source[e], m_target[e], buckets);
+        for(int i = 0; i < buckets.size(); i++)
+            m_buckets[buckets[i]].push(e);
+    }
+
+
+    // removes one occurrence of e for every cell, i.e., exactly the entries
+    // added by insertSegment()
+    void Planarity::removeSegment(int e)
+    {
+        ArrayBuffer<int> & buckets = m_query.m_buckets;
+        buckets.clear();
+        collectBuckets(m_source[e], m_target[e], buckets);
+        for(int i = 0; i < buckets.size(); i++)
+        {
+            ArrayBuffer<int> & bucket = m_buckets[buckets[i]];
+            int j = 0;
+            while(bucket[j] != e) j++;
+            bucket[j] = bucket.top();
+            bucket.pop();
+        }
+    }
+
+
+    // computes the energy if the node returned by testNode() is moved
+    // to position testPos(); only the incident edges change their crossings
+    void Planarity::compCandEnergy()
+    {
+        m_candidateEnergy = candidateEnergy(testNode(), testPos(), m_query);
+    }
+
+
+    double Planarity::candidateEnergy(const node v, const DPoint & newPos, Query & q) const
+    {
+        double candEnergy = energy();
+        edge e;
+
+        forall_adj_edges(e, v) if(!e->isSelfLoop())
+        {
+            int e_num = m_edgeNums[e];
+            DPoint s = (e->source() == v) ? newPos : currentPos(e->source());
+            DPoint t = (e->target() == v) ? newPos : currentPos(e->target());
+            candEnergy += countCrossings(e_num, s, t, q, 0) - m_crossings[e_num];
         }
+        return candEnergy;
+    }
+
+
+    bool Planarity::prepareConcurrentCandidates(int numThreads)
+    {
+        m_threadQueries.init(numThreads);
+        for(int t = 0; t < numThreads; t++)
+            m_threadQueries[t].init(m_edges.size());
+        return true;
+    }
+
+
+    double Planarity::concurrentCandidateEnergy(const node v, const DPoint & newPos, int t) const
+    {
+        return candidateEnergy(v, newPos, m_threadQueries[t]);
+    }
+
+
+    // this function updates the crossing numbers and moves the incident edges
+    // of the test node in the grid; the layout already contains the new position
+    void Planarity::internalCandidateTaken()
+    {
+        node v = testNode();
+        edge e;
+
+        forall_adj_edges(e, v) if(!e->isSelfLoop())
+        {
+            int e_num = m_edgeNums[e];
+            removeSegment(e_num);
+            countCrossings(e_num, m_source[e_num], m_target[e_num], -1);
+            m_lengthSum -= m_source[e_num].distance(m_target[e_num]);
+
+            m_source[e_num] = currentPos(e->source());
+            m_target[e_num] = currentPos(e->target());
+            m_crossings[e_num] = countCrossings(e_num, m_source[e_num], m_target[e_num], 1);
+            m_lengthSum += m_source[e_num].distance(m_target[e_num]);
+            insertSegment(e_num);
+        }
+
+        // rebuild the grid if the cells do not fit the edges anymore; waiting for
+        // as many moves as there are edges makes the rebuilding costs amortized constant
+        const int e_num = m_edges.size();
+        if(++m_movesSinceBuild >= e_num && e_num > 0)
+        {
+            double avgLength = m_lengthSum / e_num;
+            if(avgLength < m_cellSize / 2 || avgLength > m_cellSize * 2)
+                buildGrid();
+        }
+    }
+
+
+#ifdef OGDF_DEBUG
+    void Planarity::printInternalData() const
+    {
+        cout << "\nCrossing numbers:";
+        for(int e = 0; e < m_edges.size(); e++)
+            cout << "\n Edge " << e << " has " << m_crossings[e] << " crossings";
+        cout << "\nCell size: " << m_cellSize;
     }
 #endif
 
@@ -42,7 +42,6 @@
 
 #include <ogdf/energybased/SpringEmbedderFR.h>
 #include <ogdf/packing/TileToRowsCCPacker.h>
-#include <ogdf/basic/GraphCopyAttributes.h>
 #include <ogdf/basic/simple_graph_alg.h>
 #include <math.h>
 
@@ -50,10 +49,8 @@
 namespace ogdf
 {
 
-
     SpringEmbedderFR::SpringEmbedderFR()
     {
-        m_A = 0;
         // default parameters
         m_iterations   = 400;
         m_fineness     = 0.51;
@@ -71,6 +68,12 @@ namespace ogdf
 
         m_minDistCC = LayoutStandards::defaultCCSeparation();
         m_pageRatio = 1.0;
+
+#ifdef OGDF_MEMORY_POOL_NTS
+        m_maxThreads = 1;
+#else
+        m_maxThreads = System::numberOfProcessors();
+#endif
     }
 
 
@@ -83,9 +86,6 @@ namespace ogdf
         // all edges straight-line
         AG.clearAllBends();
 
-        GraphCopy GC;
-        GC.createEmpty(G);
-
         // compute connected component of G
         NodeArray<int> component(G);
         int numCC = connectedComponents(G, component);
@@ -97,43 +97,76 @@ namespace ogdf
         forall_nodes(v, G)
         nodesInCC[component[v]].pushBack(v);
 
-        EdgeArray<edge> auxCopy(G);
-        Array<DPoint> boundingBox(numCC);
-
+        // number the nodes within their CC
+        NodeArray<int> index(G);
+        Array<int> numEdgesInCC(0, numCC - 1, 0);
         int i;
         for(i = 0; i < numCC; ++i)
         {
-            GC.initByNodes(nodesInCC[i], auxCopy);
+            int k = 0;
+            forall_listiterators(node, it, nodesInCC[i])
+                index[*it] = k++;
+        }
 
-            GraphCopyAttributes AGC(GC, AG);
-            node vCopy;
-            forall_nodes(vCopy, GC)
-            {
-                node vOrig = GC.original(vCopy);
-                AGC.x(vCopy) = AG.x(vOrig);
-                AGC.y(vCopy) = AG.y(vOrig);
-            }
+        edge e;
+        forall_edges(e, G)
+            ++numEdgesInCC[component[e->source()]];
+
+        Array<DPoint> boundingBox(numCC);
+
+        for(i = 0; i < numCC; ++i)
+        {
+            const List<node> & nodes = nodesInCC[i];
 
             // original
-            if(initialize(GC, AGC) == true)
+            if(initialize(nodes, AG) == true)
             {
+                m_source.init(numEdgesInCC[i]);
+                m_target.init(numEdgesInCC[i]);
+                m_edgeFactor.init(numEdgesInCC[i]);
+
+                int k = 0;
+                forall_listiterators(node, it, nodes)
+                {
+                    adjEntry adj;
+                    forall_adj(adj, *it)
+                    {
+                        e = adj->theEdge();
+                        if(adj != e->adjSource()) continue;
+
+                        m_source[k] = index[e->source()];
+                        m_target[k] = index[e->target()];
+                        m_edgeFactor[k] = 6.0 / (e->source()->degree() + e->target()->degree());
+                        ++k;
+                    }
+                }
+
+                // the threads are kept alive for all iterations; additional
+                // threads only pay off for large components
+                const int minNodesPerThread = 2048;
+                ThreadTeam<SpringEmbedderFR> team(this,
+                                                  max(1, min(m_maxThreads, nodes.size() / minNodesPerThread)));
+                m_firstCell.init(0, team.numThreads());
+
                 for(int i = 1; i <= m_iterations; i++)
-                    mainStep(GC, AGC);
+                    mainStep(team);
 
+                forall_listiterators(node, it, nodes)
+                {
+                    AG.x(*it) = m_x[index[*it]];
+                    AG.y(*it) = m_y[index[*it]];
+                }
             }
             cleanup();
             // end original
 
-            node vFirst = GC.firstNode();
-            double minX = AGC.x(vFirst), maxX = AGC.x(vFirst),
-                   minY = AGC.y(vFirst), maxY = AGC.y(vFirst);
+            v = nodes.front();
+            double minX = AG.x(v), maxX = AG.x(v),
+                   minY = AG.y(v), maxY = AG.y(v);
 
-            forall_nodes(vCopy, GC)
+            forall_listiterators(node, it, nodes)
             {
-                node v = GC.original(vCopy);
-                AG.x(v) = AGC.x(vCopy);
-                AG.y(v) = AGC.y(vCopy);
-
+                v = *it;
                 if(AG.x(v) - AG.width(v) / 2 < minX) minX = AG.x(v) - AG.width(v) / 2;
                 if(AG.x(v) + AG.width(v) / 2 > maxX) maxX = AG.x(v) + AG.width(v) / 2;
                 if(AG.y(v) - AG.height(v) / 2 < minY) minY = AG.y(v) - AG.height(v) / 2;
@@ -143,11 +176,10 @@ namespace ogdf
             minX -= m_minDistCC;
             minY -= m_minDistCC;
 
-            forall_nodes(vCopy, GC)
+            forall_listiterators(node, it, nodes)
             {
-                node v = GC.original(vCopy);
-                AG.x(v) -= minX;
-                AG.y(v) -= minY;
+                AG.x(*it) -= minX;
+                AG.y(*it) -= minY;
             }
 
             boundingBox[i] = DPoint(maxX - minX, maxY - minY);
@@ -178,36 +210,42 @@ namespace ogdf
                 AG.y(v) += dy;
             }
         }
-
-        m_lit.init();
     }
 
 
-    bool SpringEmbedderFR::initialize(GraphCopy & G, GraphCopyAttributes & AG)
+    bool SpringEmbedderFR::initialize(const List<node> & nodes, const GraphAttributes & AG)
     {
-        if(G.numberOfNodes() <= 1)
+        const int n = nodes.size();
+        if(n <= 1)
             return false;  // nothing to do
 
-        m_A = 0;
-
         // compute a suitable area (xleft,ysmall), (xright,ybig)
         // zoom the current layout into that area
 
         double w_sum = 0.0, h_sum = 0.0;
         double xmin, xmax, ymin, ymax;
 
-        node v = G.firstNode();
+        m_x.init(n);
+        m_y.init(n);
+
+        node v = nodes.front();
         xmin = xmax = AG.x(v);
         ymin = ymax = AG.y(v);
 
-        forall_nodes(v, G)
+        int k = 0;
+        forall_listiterators(node, it, nodes)
         {
+            v = *it;
+            m_x[k] = AG.x(v);
+            m_y[k] = AG.y(v);
+            ++k;
+
             if(AG.x(v) < xmin) xmin = AG.x(v);
             if(AG.x(v) > xmax) xmax = AG.x(v);
             if(AG.y(v) < ymin) ymin = AG.y(v);
             if(AG.y(v) > ymax) ymax = AG.y(v);
-            w_sum += AG.getWidth(v);
-            h_sum += AG.getHeight(v);
+            w_sum += AG.width(v);
+            h_sum += AG.height(v);
         }
 
         switch(m_scaling)
@@ -232,7 +270,7 @@ namespace ogdf
             }
             else
             {
-                double sqrt_n = sqrt((double)G.numberOfNodes());
+                double sqrt_n = sqrt((double)n);
                 m_xleft  = 0;
                 m_ysmall = 0;
                 m_xright = (w_sum > 0) ? m_scaleFactor * w_sum / sqrt_n : 1;
@@ -242,17 +280,14 @@ namespace ogdf
             double fx = (xmax == xmin) ? 1.0 : m_xright / (xmax - xmin);
             double fy = (ymax == ymin) ? 1.0 : m_ybig   / (ymax - ymin);
             // Adjust coordinates accordingly
-            forall_nodes(v, G)
+            for(k = 0; k < n; ++k)
             {
-                AG.x(v) = m_xleft  + (AG.x(v) - xmin) * fx;
-                AG.y(v) = m_ysmall + (AG.y(v) - ymin) * fy;
+                m_x[k] = m_xleft  + (m_x[k] - xmin) * fx;
+                m_y[k] = m_ysmall + (m_y[k] - ymin) * fy;
             }
         }
 
 
-        m_lit.init(G);
-
-
         m_width  = m_xright - m_xleft;
         m_height = m_ybig - m_ysmall;
 
@@ -264,7 +299,7 @@ namespace ogdf
         m_ty = m_tyNull;
 
         //m_k = sqrt(m_width*m_height / G.numberOfNodes()) / 2;
-        m_k = m_fineness * sqrt(m_width * m_height / G.numberOfNodes());
+        m_k = m_fineness * sqrt(m_width * m_height / n);
         m_k2 = 2 * m_k;
         m_kk = m_k * m_k;
 
@@ -274,117 +309,182 @@ namespace ogdf
 
         m_cF = 1;
 
-        // build  matrix of node lists
+        // the grid has a border of empty cells, so that the 3x3
+        // neighborhood of each non-empty cell exists
         m_xA = int(m_width / m_ki + 1);
         m_yA = int(m_height / m_ki + 1);
-        m_A = new Array2D<List<node>>(-1, m_xA, -1, m_yA);
 
-        forall_nodes(v, G)
-        {
-            double xv = AG.x(v);
-            double yv = AG.y(v);
+        m_xdisp.init(n);
+        m_ydisp.init(n);
+        m_cellOf.init(n);
+        m_cellStart.init((m_xA + 2) * (m_yA + 2) + 1);
+        m_cellNode.init(n);
+        m_cellX.init(n);
+        m_cellY.init(n);
+
+        return true;
+    }
 
-            int i = int((xv - m_xleft) / m_ki);
-            int j = int((yv - m_ysmall) / m_ki);
+
+    // sorts the nodes by cell (counting sort) and copies their
+    // coordinates into contiguous arrays
+    void SpringEmbedderFR::buildCellList()
+    {
+        const int n = m_x.size();
+        const int rowLength = m_xA + 2;
+        const int numCells = rowLength * (m_yA + 2);
+
+        for(int c = 0; c <= numCells; ++c)
+            m_cellStart[c] = 0;
+
+        for(int v = 0; v < n; ++v)
+        {
+            int i = int((m_x[v] - m_xleft) / m_ki);
+            int j = int((m_y[v] - m_ysmall) / m_ki);
 
             OGDF_ASSERT((i < m_xA) && (i > -1))
             OGDF_ASSERT((j < m_yA) && (j > -1))
 
-            m_lit[v] = (*m_A)(i, j).pushFront(v);
+            int c = (j + 1) * rowLength + i + 1;
+            m_cellOf[v] = c;
+            ++m_cellStart[c + 1];
         }
 
-        return true;
+        for(int c = 0; c < numCells; ++c)
+            m_cellStart[c + 1] += m_cellStart[c];
+
+        // m_cellStart[c] is used as insertion position of cell c-1 ...
+        for(int v = 0; v < n; ++v)
+        {
+            int pos = m_cellStart[m_cellOf[v]]++;
+            m_cellNode[pos] = v;
+            m_cellX[pos] = m_x[v];
+            m_cellY[pos] = m_y[v];
+        }
+
+        // ... and afterwards restored
+        for(int c = numCells; c > 0; --c)
+            m_cellStart[c] = m_cellStart[c - 1];
+        m_cellStart[0] = 0;
     }
 
 
-#define FREPULSE(d) ((m_k2 > (d)) ? m_kk/(d) : 0)
+    // computes the repulsive forces of the nodes in cells firstCell,...,lastCell-1;
+    // the 3x3 neighborhood of a cell consists of three contiguous ranges
+    void SpringEmbedderFR::repulsiveForces(int firstCell, int lastCell)
+    {
+        const int rowLength = m_xA + 2;
+        const double limit2 = m_k2 * m_k2;
+
+        for(int c = firstCell; c < lastCell; ++c)
+        {
+            for(int p = m_cellStart[c]; p < m_cellStart[c + 1]; ++p)
+            {
+                const double xv = m_cellX[p];
+                const double yv = m_cellY[p];
+                double xd = 0.0, yd = 0.0;
 
+                for(int r = -rowLength; r <= rowLength; r += rowLength)
+                {
+                    const int last = m_cellStart[c + r + 2];
+                    for(int q = m_cellStart[c + r - 1]; q < last; ++q)
+                    {
+                        if(q == p) continue;
+                        double xdist = xv - m_cellX[q];
+                        double ydist = yv - m_cellY[q];
+                        double dist2 = xdist * xdist + ydist * ydist;
+
+                        // repulsive force m_kk / dist (if dist < 2k) in direction (xdist,ydist) / dist
+                        if(dist2 >= limit2) continue;
+                        if(dist2 < 1e-6)
+                            dist2 = 1e-6;
+                        const double f = m_kk / dist2;
+                        xd += f * xdist;
+                        yd += f * ydist;
+                    }
+                }
 
-    void SpringEmbedderFR::mainStep(GraphCopy & G, GraphCopyAttributes & AG)
+                const int v = m_cellNode[p];
+                m_xdisp[v] = xd;
+                m_ydisp[v] = yd;
+            }
+        }
+    }
+
+
+    void SpringEmbedderFR::repulsiveKernel(int t)
     {
-        //const Graph &G = AG.constGraph();
+        repulsiveForces(m_firstCell[t], m_firstCell[t + 1]);
+    }
 
-        node u, v;
-        edge e;
 
-        NodeArray<double> xdisp(G, 0);
-        NodeArray<double> ydisp(G, 0);
+    void SpringEmbedderFR::mainStep(ThreadTeam<SpringEmbedderFR> & team)
+    {
+        const int n = m_x.size();
 
         // repulsive forces
-        forall_nodes(v, G)
-        {
-            double xv = AG.x(v);
-            double yv = AG.y(v);
+        buildCellList();
+
+        const int numThreads = team.numThreads();
+        const int rowLength = m_xA + 2;
+        const int numCells = rowLength * (m_yA + 2);
 
-            int i = int((xv - m_xleft) / m_ki);
-            int j = int((yv - m_ysmall) / m_ki);
+        if(numThreads == 1)
+            repulsiveForces(rowLength, numCells - rowLength);
 
-            for(int m = -1; m <= 1; m++)
+        else
+        {
+            // split the cells into ranges with about the same number of nodes
+            m_firstCell[0] = rowLength;
+            m_firstCell[numThreads] = numCells - rowLength;
+            int c = rowLength;
+            for(int t = 1; t < numThreads; ++t)
             {
-                for(int n = -1; n <= 1; n++)
-                {
-                    ListIterator<node> it;
-                    for(it = (*m_A)(i + m, j + n).begin(); it.valid(); ++it)
-                    {
-                        u = *it;
-
-                        if(u == v) continue;
-                        double xdist = xv - AG.x(u);
-                        double ydist = yv - AG.y(u);
-                        double dist = sqrt(xdist * xdist + ydist * ydist);
-                        if(dist < 1e-3)
-                            dist = 1e-3;
-                        xdisp[v] += FREPULSE(dist) * xdist / dist;
-                        ydisp[v] += FREPULSE(dist) * ydist / dist;
-                    }
-                }
+                const int minPos = threadRangeBegin(n, t, numThreads);
+                while(m_cellStart[c] < minPos)
+                    ++c;
+                m_firstCell[t] = c;
             }
+
+            team.run(&SpringEmbedderFR::repulsiveKernel);
         }
 
         // attractive forces
-        forall_edges(e, G)
+        for(int e = 0; e < m_source.size(); ++e)
         {
-            node u = e->source();
-            node v = e->target();
-            double xdist = AG.x(v) - AG.x(u);
-            double ydist = AG.y(v) - AG.y(u);
+            int u = m_source[e];
+            int v = m_target[e];
+            double xdist = m_x[v] - m_x[u];
+            double ydist = m_y[v] - m_y[u];
             double dist = sqrt(xdist * xdist + ydist * ydist);
 
-            double f = (u->degree() + v->degree()) / 6.0;
-
-            dist /= f;
+            dist *= m_edgeFactor[e];
 
             double fac = dist / m_k;
 
-            xdisp[v] -= xdist * fac;
-            ydisp[v] -= ydist * fac;
-            xdisp[u] += xdist * fac;
-            ydisp[u] += ydist * fac;
+            m_xdisp[v] -= xdist * fac;
+            m_ydisp[v] -= ydist * fac;
+            m_xdisp[u] += xdist * fac;
+            m_ydisp[u] += ydist * fac;
         }
 
         // noise
         if(m_noise)
         {
-            forall_nodes(v, G)
+            for(int v = 0; v < n; ++v)
             {
-                xdisp[v] *= (double(randomNumber(750, 1250)) / 1000.0);
-                ydisp[v] *= (double(randomNumber(750, 1250)) / 1000.0);
+                m_xdisp[v] *= (double(randomNumber(750, 1250)) / 1000.0);
+                m_ydisp[v] *= (double(randomNumber(750, 1250)) / 1000.0);
             }
         }
 
 
         // preventions
 
-        forall_nodes(v, G)
+        for(int v = 0; v < n; ++v)
         {
-            double xv = AG.x(v);
-            double yv = AG.y(v);
-
-            int i0 = int((xv - m_xleft) / m_ki);
-            int j0 = int((yv - m_ysmall) / m_ki);
-
-            double xd = xdisp[v];
-            double yd = ydisp[v];
+            double xd = m_xdisp[v];
+            double yd = m_ydisp[v];
             double dist = sqrt(xd * xd + yd * yd);
 
             if(dist < 1)
@@ -393,33 +493,14 @@ namespace ogdf
             xd = m_tx * xd / dist;
             yd = m_ty * yd / dist;
 
-            double xp = xv + xd;
-            double yp = yv + yd;
-
-            int i, j;
+            double xp = m_x[v] + xd;
+            double yp = m_y[v] + yd;
 
             if((xp > m_xleft) && (xp < m_xright))
-            {
-                AG.x(v) = xp;
-                i = int((xp - m_xleft) / m_ki);
-            }
-            else
-                i = i0;
+                m_x[v] = xp;
 
             if((yp > m_ysmall) && (yp < m_ybig))
-            {
-                AG.y(v) = yp;
-                j = int((yp - m_ysmall) / m_ki);
-            }
-            else
-                j = j0;
-
-            if((i != i0) || (j != j0))
-            {
-                OGDF_ASSERT(m_lit[v].valid());
-
-                (*m_A)(i0, j0).moveToFront(m_lit[v], (*m_A)(i, j));
-            }
+                m_y[v] = yp;
         }
 
         m_tx = m_txNull / mylog2(m_cF);
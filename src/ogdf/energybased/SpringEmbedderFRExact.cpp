@@ -46,27 +46,277 @@
 #include <ogdf/basic/GraphCopyAttributes.h>
 #include <ogdf/basic/simple_graph_alg.h>
 
+#include <ogdf/basic/SIMD.h>
+#include <ogdf/internal/basic/intrinsics.h>
+#include <ogdf/basic/ThreadTeam.h>
+
 #ifdef _OPENMP
 #include <omp.h>
 #endif
 
-#ifdef OGDF_SSE3_EXTENSIONS
-#include <ogdf/internal/basic/intrinsics.h>
-#endif
-
 
 namespace ogdf
 {
 
+    //---------------------------------------------------------
+    // kernels for repulsive forces
+    //---------------------------------------------------------
+
+    // All kernels compute for v = begin,...,end-1
+    //   disp[v] = c_rep * sum_u w[u] * (p[v]-p[u]) / max(minDistSquare, |p[v]-p[u]|^2),
+    // where u runs over all nPadded entries of the arrays x, y and w. nPadded is a
+    // multiple of 16 and the padding entries have weight 0; since neither the padding
+    // nor v itself contribute to the sum, the loops need no special cases.
+
+    template<class T>
+    static void repulsionKernel(
+        const T* x, const T* y, const T* w, int nPadded, int begin, int end,
+        T minDistSquare, double c_rep, double* disp_x, double* disp_y)
+    {
+        for(int v = begin; v < end; ++v)
+        {
+            double sum_x = 0, sum_y = 0;
+
+            for(int u = 0; u < nPadded; ++u)
+            {
+                T delta_x = x[v] - x[u];
+                T delta_y = y[v] - y[u];
+
+                T distSquare = max(minDistSquare, delta_x * delta_x + delta_y * delta_y);
+
+                T t = w[u] / distSquare;
+                sum_x += delta_x * t;
+                sum_y += delta_y * t;
+            }
+
+            disp_x[v] = sum_x * c_rep;
+            disp_y[v] = sum_y * c_rep;
+        }
+    }
+
+
+#ifdef OGDF_AVX2_EXTENSIONS
+    OGDF_TARGET_AVX2 static double horizontalSum_avx2(__m256d a)
+    {
+        __m128d s = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+    }
+
+
+    OGDF_TARGET_AVX2 static double horizontalSum_avx2(__m256 a)
+    {
+        __m128 s = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+        s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+        return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1)));
+    }
+
+
+    OGDF_TARGET_AVX2 static void repulsionKernel_avx2(
+        const double* x, const double* y, const double* w, int nPadded, int begin, int end,
+        double minDistSquare, double c_rep, double* disp_x, double* disp_y)
+    {
+        const __m256d mm_minDistSquare = _mm256_set1_pd(minDistSquare);
+
+        for(int v = begin; v < end; ++v)
+        {
+            const __m256d mm_xv = _mm256_set1_pd(x[v]);
+            const __m256d mm_yv = _mm256_set1_pd(y[v]);
+            __m256d mm_disp_xv = _mm256_setzero_pd();
+            __m256d mm_disp_yv = _mm256_setzero_pd();
+
+            for(int u = 0; u < nPadded; u += 4)
+            {
+                __m256d mm_delta_x = _mm256_sub_pd(mm_xv, _mm256_loadu_pd(x + u));
+                __m256d mm_delta_y = _mm256_sub_pd(mm_yv, _mm256_loadu_pd(y + u));
+
+                __m256d mm_distSquare = _mm256_max_pd(mm_minDistSquare,
+                    _mm256_fmadd_pd(mm_delta_x, mm_delta_x, _mm256_mul_pd(mm_delta_y, mm_delta_y)));
+
+                __m256d mm_t = _mm256_div_pd(_mm256_loadu_pd(w + u), mm_distSquare);
+                mm_disp_xv = _mm256_fmadd_pd(mm_delta_x, mm_t, mm_disp_xv);
+                mm_disp_yv = _mm256_fmadd_pd(mm_delta_y, mm_t, mm_disp_yv);
+            }
+
+            disp_x[v] = horizontalSum_avx2(mm_disp_xv) * c_rep;
+            disp_y[v] = horizontalSum_avx2(mm_disp_yv) * c_rep;
+        }
+    }
+
+
+    OGDF_TARGET_AVX2 static void repulsionKernel_avx2(
+        const float* x, const float* y, const float* w, int nPadded, int begin, int end,
+        float minDistSquare, double c_rep, double* disp_x, double* disp_y)
+    {
+        const __m256 mm_minDistSquare = _mm256_set1_ps(minDistSquare);
+
+        for(int v = begin; v < end; ++v)
+        {
+            const __m256 mm_xv = _mm256_set1_ps(x[v]);
+            const __m256 mm_yv = _mm256_set1_ps(y[v]);
+            __m256 mm_disp_xv = _mm256_setzero_ps();
+            __m256 mm_disp_yv = _mm256_setzero_ps();
+
+            for(int u = 0; u < nPadded; u += 8)
+            {
+                __m256 mm_delta_x = _mm256_sub_ps(mm_xv, _mm256_loadu_ps(x + u));
+                __m256 mm_delta_y = _mm256_sub_ps(mm_yv, _mm256_loadu_ps(y + u));
+
+                __m256 mm_distSquare = _mm256_max_ps(mm_minDistSquare,
+                    _mm256_fmadd_ps(mm_delta_x, mm_delta_x, _mm256_mul_ps(mm_delta_y, mm_delta_y)));
+
+                __m256 mm_t = _mm256_div_ps(_mm256_loadu_ps(w + u), mm_distSquare);
+                mm_disp_xv = _mm256_fmadd_ps(mm_delta_x, mm_t, mm_disp_xv);
+                mm_disp_yv = _mm256_fmadd_ps(mm_delta_y, mm_t, mm_disp_yv);
+            }
+
+            disp_x[v] = horizontalSum_avx2(mm_disp_xv) * c_rep;
+            disp_y[v] = horizontalSum_avx2(mm_disp_yv) * c_rep;
+        }
+    }
+#endif
+
+
+#ifdef OGDF_AVX512_EXTENSIONS
+    OGDF_TARGET_AVX512 static void repulsionKernel_avx512(
+        const double* x, const double* y, const double* w, int nPadded, int begin, int end,
+        double minDistSquare, double c_rep, double* disp_x, double* disp_y)
+    {
+        const __m512d mm_minDistSquare = _mm512_set1_pd(minDistSquare);
+
+        for(int v = begin; v < end; ++v)
+        {
+            const __m512d mm_xv = _mm512_set1_pd(x[v]);
+            const __m512d mm_yv = _mm512_set1_pd(y[v]);
+            __m512d mm_disp_xv = _mm512_setzero_pd();
+            __m512d mm_disp_yv = _mm512_setzero_pd();
+
+            for(int u = 0; u < nPadded; u += 8)
+            {
+                __m512d mm_delta_x = _mm512_sub_pd(mm_xv, _mm512_loadu_pd(x + u));
+                __m512d mm_delta_y = _mm512_sub_pd(mm_yv, _mm512_loadu_pd(y + u));
+
+                __m512d mm_distSquare = _mm512_max_pd(mm_minDistSquare,
+                    _mm512_fmadd_pd(mm_delta_x, mm_delta_x, _mm512_mul_pd(mm_delta_y, mm_delta_y)));
+
+                __m512d mm_t = _mm512_div_pd(_mm512_loadu_pd(w + u), mm_distSquare);
+                mm_disp_xv = _mm512_fmadd_pd(mm_delta_x, mm_t, mm_disp_xv);
+                mm_disp_yv = _mm512_fmadd_pd(mm_delta_y, mm_t, mm_disp_yv);
+            }
+
+            disp_x[v] = _mm512_reduce_add_pd(mm_disp_xv) * c_rep;
+            disp_y[v] = _mm512_reduce_add_pd(mm_disp_yv) * c_rep;
+        }
+    }
+
+
+    OGDF_TARGET_AVX512 static void repulsionKernel_avx512(
+        const float* x, const float* y, const float* w, int nPadded, int begin, int end,
+        float minDistSquare, double c_rep, double* disp_x, double* disp_y)
+    {
+        const __m512 mm_minDistSquare = _mm512_set1_ps(minDistSquare);
+
+        for(int v = begin; v < end; ++v)
+        {
+            const __m512 mm_xv = _mm512_set1_ps(x[v]);
+            const __m512 mm_yv = _mm512_set1_ps(y[v]);
+            __m512 mm_disp_xv = _mm512_setzero_ps();
+            __m512 mm_disp_yv = _mm512_setzero_ps();
+
+            for(int u = 0; u < nPadded; u += 16)
+            {
+                __m512 mm_delta_x = _mm512_sub_ps(mm_xv, _mm512_loadu_ps(x + u));
+                __m512 mm_delta_y = _mm512_sub_ps(mm_yv, _mm512_loadu_ps(y + u));
+
+                __m512 mm_distSquare = _mm512_max_ps(mm_minDistSquare,
+                    _mm512_fmadd_ps(mm_delta_x, mm_delta_x, _mm512_mul_ps(mm_delta_y, mm_delta_y)));
+
+                __m512 mm_t = _mm512_div_ps(_mm512_loadu_ps(w + u), mm_distSquare);
+                mm_disp_xv = _mm512_fmadd_ps(mm_delta_x, mm_t, mm_disp_xv);
+                mm_disp_yv = _mm512_fmadd_ps(mm_delta_y, mm_t, mm_disp_yv);
+            }
+
+            disp_x[v] = _mm512_reduce_add_ps(mm_disp_xv) * c_rep;
+            disp_y[v] = _mm512_reduce_add_ps(mm_disp_yv) * c_rep;
+        }
+    }
+#endif
+
+
+    //! The kernels for repulsive forces in double and single precision.
+    template<class T>
+    struct RepulsionKernel
+    {
+        typedef void (*Function)(const T*, const T*, const T*, int, int, int, T, double, double*, double*);
+
+        static SIMDKernel<Function> s_kernel;
+    };
+
+    template<class T>
+    SIMDKernel<typename RepulsionKernel<T>::Function> RepulsionKernel<T>::s_kernel =
+        SIMDKernel<typename RepulsionKernel<T>::Function>(repulsionKernel<T>)
+#ifdef OGDF_AVX2_EXTENSIONS
+        .add(simdAVX2, repulsionKernel_avx2)
+#endif
+#ifdef OGDF_AVX512_EXTENSIONS
+        .add(simdAVX512, repulsionKernel_avx512)
+#endif
+        ;
+
+
+    //! Calls the kernel for repulsive forces on a range of nodes for every thread.
+    template<class T>
+    class RepulsionTask
+    {
+    public:
+        RepulsionTask(const T* x, const T* y, const T* w, int n, int nPadded,
+                      T minDistSquare, double c_rep, double* disp_x, double* disp_y, int numThreads)
+            : m_x(x), m_y(y), m_w(w), m_n(n), m_nPadded(nPadded), m_minDistSquare(minDistSquare),
+              m_c_rep(c_rep), m_disp_x(disp_x), m_disp_y(disp_y), m_numThreads(numThreads),
+              m_kernel(RepulsionKernel<T>::s_kernel.get()) { }
+
+        void kernel(int t)
+        {
+            if(t >= m_numThreads)
+                return;
+            const int begin = threadRangeBegin(m_n, t, m_numThreads);
+            const int end   = threadRangeBegin(m_n, t + 1, m_numThreads);
+
+            m_kernel(m_x, m_y, m_w, m_nPadded, begin, end, m_minDistSquare, m_c_rep, m_disp_x, m_disp_y);
+        }
+
+    private:
+        const T* m_x;
+        const T* m_y;
+        const T* m_w;
+        int m_n, m_nPadded;
+        T m_minDistSquare;
+        double m_c_rep;
+        double* m_disp_x;
+        double* m_disp_y;
+        int m_numThreads;
+        typename RepulsionKernel<T>::Function m_kernel;
+    };
+
+
+    //---------------------------------------------------------
+    // SpringEmbedderFRExact
+    //---------------------------------------------------------
+
     SpringEmbedderFRExact::ArrayGraph::ArrayGraph(GraphAttributes & ga) : m_ga(&ga), m_mapNode(ga.constGraph())
     {
         const Graph & G = ga.constGraph();
         m_numNodes = m_numEdges = 0;
 
+        m_numPaddedNodes = 0;
+
         m_orig = 0;
         m_src = m_tgt = 0;
         m_x = m_y = 0;
         m_nodeWeight = 0;
+        m_xf = m_yf = 0;
+        m_nodeWeightf = 0;
+        m_mobility = 0;
+        m_warmStart = 0;
         m_useNodeWeight = false;
 
         // compute connected components of G
@@ -89,6 +339,10 @@ namespace ogdf
         System::alignedMemoryFree(m_x);
         System::alignedMemoryFree(m_y);
         System::alignedMemoryFree(m_nodeWeight);
+        System::alignedMemoryFree(m_xf);
+        System::alignedMemoryFree(m_yf);
+        System::alignedMemoryFree(m_nodeWeightf);
+        System::alignedMemoryFree(m_mobility);
     }
 
 
@@ -100,14 +354,32 @@ namespace ogdf
         System::alignedMemoryFree(m_x);
         System::alignedMemoryFree(m_y);
         System::alignedMemoryFree(m_nodeWeight);
+        System::alignedMemoryFree(m_xf);
+        System::alignedMemoryFree(m_yf);
+        System::alignedMemoryFree(m_nodeWeightf);
+        System::alignedMemoryFree(m_mobility);
+        m_mobility = 0;
 
         m_numNodes = m_nodesInCC[i].size();
+        m_numPaddedNodes = (m_numNodes + 15) & ~15;
         m_numEdges = 0;
 
-        m_orig       = (node*)   System::alignedMemoryAlloc16(m_numNodes * sizeof(node));
-        m_x          = (double*) System::alignedMemoryAlloc16(m_numNodes * sizeof(double));
-        m_y          = (double*) System::alignedMemoryAlloc16(m_numNodes * sizeof(double));
-        m_nodeWeight = (double*) System::alignedMemoryAlloc16(m_numNodes * sizeof(double));
+        m_orig        = (node*)   System::alignedMemoryAlloc16(m_numNodes * sizeof(node));
+        m_x           = (double*) System::alignedMemoryAlloc16(m_numPaddedNodes * sizeof(double));
+        m_y           = (double*) System::alignedMemoryAlloc16(m_numPaddedNodes * sizeof(double));
+        m_nodeWeight  = (double*) System::alignedMemoryAlloc16(m_numPaddedNodes * sizeof(double));
+        m_xf          = (float*)  System::alignedMemoryAlloc16(m_numPaddedNodes * sizeof(float));
+        m_yf          = (float*)  System::alignedMemoryAlloc16(m_numPaddedNodes * sizeof(float));
+        m_nodeWeightf = (float*)  System::alignedMemoryAlloc16(m_numPaddedNodes * sizeof(float));
+        if(m_warmStart != 0)
+            m_mobility = (double*) System::alignedMemoryAlloc16(m_numNodes * sizeof(double));
+
+        // padding nodes do not exert forces
+        for(int k = m_numNodes; k < m_numPaddedNodes; ++k)
+        {
+            m_x[k] = m_y[k] = m_nodeWeight[k] = 0.0;
+            m_xf[k] = m_yf[k] = m_nodeWeightf[k] = 0.0f;
+        }
 
         int j = 0;
         SListConstIterator<node> it;
@@ -125,6 +397,9 @@ namespace ogdf
                 m_nodeWeight[j] = (m_ga->attributes() & GraphAttributes::nodeWeight) ? m_ga->weight(v) : 1.0;
             else
                 m_nodeWeight[j] = 1.0;
+            m_nodeWeightf[j] = float(m_nodeWeight[j]);
+            if(m_mobility != 0)
+                m_mobility[j] = m_warmStart->mobility(v);
             adjEntry adj;
             forall_adj(adj, v)
             if(v->index() < adj->twinNode()->index())
@@ -174,6 +449,20 @@ namespace ogdf
         m_useNodeWeight = false;
         m_checkConvergence = true;
         m_convTolerance = 0.01; //fraction of ideal edge length below which convergence is achieved
+        m_numberOfThreads = 1;
+        m_singlePrecision = false;
+        m_warmStart = 0;
+        m_pMonitor = 0;
+    }
+
+
+    void SpringEmbedderFRExact::callIncremental(GraphAttributes & AG, const WarmStart & ws)
+    {
+        OGDF_ASSERT(ws.graphOf() == &AG.constGraph())
+
+        m_warmStart = &ws;
+        call(AG);
+        m_warmStart = 0;
     }
 
 
@@ -183,30 +472,43 @@ namespace ogdf
         if(G.empty())
             return;
 
+        if(m_pMonitor != 0)
+            m_pMonitor->start();
+
         // all edges straight-line
         AG.clearAllBends();
 
         ArrayGraph component(AG);
         component.m_useNodeWeight = m_useNodeWeight;
+        component.m_warmStart = m_warmStart;
 
         EdgeArray<edge> auxCopy(G);
         Array<DPoint> boundingBox(component.numberOfCCs());
 
-        int i;
+        // the threads of the repulsive forces are kept alive for all components
+        int i, maxNodes = 0;
+        for(i = 0; i < component.numberOfCCs(); ++i)
+            maxNodes = max(maxNodes, component.nodesInCC(i).size());
+        KernelTeam team(repulsionThreads(maxNodes));
+
         for(i = 0; i < component.numberOfCCs(); ++i)
         {
             component.initCC(i);
 
             if(component.numberOfNodes() >= 2)
             {
-                initialize(component);
+                if(m_warmStart != 0)
+                    initializeIncremental(component);
+                else
+                    initialize(component);
 
 #ifdef OGDF_SSE3_EXTENSIONS
-                if(System::cpuSupports(cpufSSE3))
+                // the SSE3 variant is only used if no wider kernel can be used
+                if(SIMD::level() == simdSSE3 && m_numberOfThreads == 1 && !m_singlePrecision && m_warmStart == 0 && m_pMonitor == 0)
                     mainStep_sse3(component);
                 else
 #endif
-                    mainStep(component);
+                    mainStep(component, team);
             }
 
             double minX, maxX, minY, maxY;
@@ -225,6 +527,10 @@ namespace ogdf
                 if(AG.y(v) + AG.height(v) / 2 > maxY) maxY = AG.y(v) + AG.height(v) / 2;
             }
 
+            // an incremental call keeps the arrangement of the components
+            if(m_warmStart != 0)
+                continue;
+
             minX -= m_minDistCC;
             minY -= m_minDistCC;
 
@@ -238,6 +544,9 @@ namespace ogdf
             boundingBox[i] = DPoint(maxX - minX, maxY - minY);
         }
 
+        if(m_warmStart != 0)
+            return;
+
         Array<DPoint> offset(component.numberOfCCs());
         TileToRowsCCPacker packer;
         packer.call(boundingBox, offset, m_pageRatio);
@@ -308,6 +617,37 @@ namespace ogdf
     }
 
 
+    void SpringEmbedderFRExact::initializeIncremental(ArrayGraph & component)
+    {
+        // the layout is kept; the start temperature is derived from the affected
+        // region like in initialize(), i.e., from the larger of its current extent
+        // and the side length of an area of n_A*k^2 (n_A = affected nodes)
+        double xmin = 0, xmax = 0, ymin = 0, ymax = 0;
+        int numAffected = 0;
+        for(int v = 0; v < component.numberOfNodes(); ++v)
+        {
+            if(component.m_mobility[v] < 1.0)
+                continue;
+            if(numAffected++ == 0)
+            {
+                xmin = xmax = component.m_x[v];
+                ymin = ymax = component.m_y[v];
+            }
+            else
+            {
+                xmin = min(xmin, component.m_x[v]);
+                xmax = max(xmax, component.m_x[v]);
+                ymin = min(ymin, component.m_y[v]);
+                ymax = max(ymax, component.m_y[v]);
+            }
+        }
+
+        // components without affected nodes are not changed at all
+        double extent = max(sqrt(double(numAffected)) * m_idealEdgeLength, max(xmax - xmin, ymax - ymin));
+        m_txNull = m_tyNull = (numAffected > 0) ? extent / 4.0 : 0.0;
+    }
+
+
     void SpringEmbedderFRExact::cool(double & tx, double & ty, int & cF)
     {
         switch(m_coolingFunction)
@@ -326,7 +666,7 @@ namespace ogdf
     }
 
 
-    void SpringEmbedderFRExact::mainStep(ArrayGraph & C)
+    void SpringEmbedderFRExact::mainStep(ArrayGraph & C, KernelTeam & team)
     {
         const int    n       = C.numberOfNodes();
         const double k       = m_idealEdgeLength;
@@ -343,7 +683,27 @@ namespace ogdf
         double ty = m_tyNull;
         int cF = 1;
 
-        bool converged = (m_iterations == 0);
+        const int iterations = (m_warmStart != 0) ? m_warmStart->iterations(m_iterations) : m_iterations;
+        const double* mobility = C.m_mobility;
+
+        // in an incremental call, nodes outside the affected region stay within
+        // maxFrozenDist of their initial position
+        double* x0 = 0;
+        double* y0 = 0;
+        double maxFrozenDist = 0;
+        if(mobility != 0)
+        {
+            x0 = (double*) System::alignedMemoryAlloc16(n * sizeof(double));
+            y0 = (double*) System::alignedMemoryAlloc16(n * sizeof(double));
+            for(int v = 0; v < n; ++v)
+            {
+                x0[v] = C.m_x[v];
+                y0[v] = C.m_y[v];
+            }
+            maxFrozenDist = m_warmStart->frozenMobility() * k;
+        }
+
+        bool converged = (iterations == 0) || (m_pMonitor != 0 && m_pMonitor->timeLimitExceeded());
         int itCount = 1;
 
         // Loop until either maximum number of iterations reached or
@@ -353,28 +713,7 @@ namespace ogdf
             if(m_checkConvergence) converged = true;
             // repulsive forces
 
-            #pragma omp parallel for
-            for(int v = 0; v < n; ++v)
-            {
-                disp_x[v] = disp_y[v] = 0;
-
-                for(int u = 0; u < n; ++u)
-                {
-                    if(u == v) continue;
-
-                    double delta_x = C.m_x[v] - C.m_x[u];
-                    double delta_y = C.m_y[v] - C.m_y[u];
-
-                    double distSquare = max(minDistSquare, delta_x * delta_x + delta_y * delta_y);
-
-                    double t = C.m_nodeWeight[u] / distSquare;
-                    disp_x[v] += delta_x * t;
-                    disp_y[v] += delta_y * t;
-                }
-
-                disp_x[v] *= c_rep;
-                disp_y[v] *= c_rep;
-            }
+            computeRepulsiveForces(C, minDistSquare, c_rep, disp_x, disp_y, team);
 
             // attractive forces
 
@@ -403,25 +742,91 @@ namespace ogdf
                 double dist = max(minDist, sqrt(disp_x[v] * disp_x[v] + disp_y[v] * disp_y[v]));
                 double xdisplace = disp_x[v] / dist * min(dist, tx);
                 double ydisplace = disp_y[v] / dist * min(dist, ty);
+                if(mobility != 0 && mobility[v] < 1.0)
+                {
+                    xdisplace *= mobility[v];
+                    ydisplace *= mobility[v];
+
+                    // clamp the cumulative displacement
+                    double dx = C.m_x[v] + xdisplace - x0[v];
+                    double dy = C.m_y[v] + ydisplace - y0[v];
+                    double distSq = dx * dx + dy * dy;
+                    if(distSq > maxFrozenDist * maxFrozenDist)
+                    {
+                        double f = maxFrozenDist / sqrt(distSq);
+                        xdisplace = x0[v] + dx * f - C.m_x[v];
+                        ydisplace = y0[v] + dy * f - C.m_y[v];
+                    }
+                }
                 double eucdistsq = xdisplace * xdisplace + ydisplace * ydisplace;
                 double threshold = m_convTolerance * m_idealEdgeLength;
                 if(eucdistsq > threshold * threshold)
                     converged = false;
                 C.m_x[v] += xdisplace;
                 C.m_y[v] += ydisplace;
+                disp_x[v] = xdisplace;
+                disp_y[v] = ydisplace;
+            }
+
+            if(m_pMonitor != 0)
+            {
+                double energy = 0, maxDistSq = 0;
+                for(int v = 0; v < n; ++v)
+                {
+                    double distSq = disp_x[v] * disp_x[v] + disp_y[v] * disp_y[v];
+                    energy += distSq;
+                    maxDistSq = max(maxDistSq, distSq);
+                }
+                if(m_pMonitor->report(energy / kSquare, sqrt(maxDistSq) / k))
+                    converged = true;
             }
 
             cool(tx, ty, cF);
             //}//if
             itCount++;
-            converged = (itCount > m_iterations || converged);
+            converged = (itCount > iterations || converged);
         }//while not converged
 
         System::alignedMemoryFree(disp_x);
         System::alignedMemoryFree(disp_y);
+        System::alignedMemoryFree(x0);
+        System::alignedMemoryFree(y0);
     }//mainstep
 
 
+    void SpringEmbedderFRExact::computeRepulsiveForces(
+        ArrayGraph & C,
+        double minDistSquare,
+        double c_rep,
+        double* disp_x,
+        double* disp_y,
+        KernelTeam & team)
+    {
+        const int n       = C.numberOfNodes();
+        const int nPadded = C.numberOfPaddedNodes();
+        const int numThreads = min(team.numThreads(), repulsionThreads(n));
+
+        if(m_singlePrecision)
+        {
+            for(int v = 0; v < n; ++v)
+            {
+                C.m_xf[v] = float(C.m_x[v]);
+                C.m_yf[v] = float(C.m_y[v]);
+            }
+
+            RepulsionTask<float> task(C.m_xf, C.m_yf, C.m_nodeWeightf, n, nPadded,
+                                      float(minDistSquare), c_rep, disp_x, disp_y, numThreads);
+            team.run(&task, &RepulsionTask<float>::kernel);
+        }
+        else
+        {
+            RepulsionTask<double> task(C.m_x, C.m_y, C.m_nodeWeight, n, nPadded,
+                                       minDistSquare, c_rep, disp_x, disp_y, numThreads);
+            team.run(&task, &RepulsionTask<double>::kernel);
+        }
+    }
+
+
     void SpringEmbedderFRExact::mainStep_sse3(ArrayGraph & C)
     {
         //#if (defined(OGDF_ARCH_X86) || defined(OGDF_ARCH_X64)) && !(defined(__GNUC__) && !defined(__SSE3__))
@@ -605,7 +1010,8 @@ namespace ogdf
         System::alignedMemoryFree(disp_y);
 
 #else
-        mainStep(C);
+        KernelTeam team(1);
+        mainStep(C, team);
 #endif
     }
 
@@ -42,6 +42,9 @@
 
 #include <ogdf/energybased/SpringEmbedderKK.h>
 #include <ogdf/basic/SList.h>
+#include <ogdf/basic/SIMD.h>
+#include <ogdf/internal/basic/intrinsics.h>
+#include <ogdf/basic/ThreadTeam.h>
 
 #ifdef OGDF_DEBUG
 #include <ogdf/basic/simple_graph_alg.h>
@@ -54,12 +57,400 @@ namespace ogdf
     const double SpringEmbedderKK::desMinLength = 0.0001;
     const int SpringEmbedderKK::maxVal = numeric_limits<int>::max();
 
+
+    //---------------------------------------------------------
+    // kernels for the partial derivatives
+    //---------------------------------------------------------
+
+    // The kernels get the positions x, y of all nodes and the row of node m in the
+    // matrices of spring strengths k and lengths l; they only consider the nodes
+    // j = begin,...,end-1. The sums must not include m itself.
+
+    // Adds the contributions of the nodes j to the partial derivatives
+    // (dE/dx_m, dE/dy_m) of m at (xm, ym) (eq. 7 and 8 in paper) to sum_x, sum_y.
+    static void gradientKernel(
+        const double* x, const double* y, const double* k, const double* l,
+        double xm, double ym, int begin, int end, double & sum_x, double & sum_y)
+    {
+        double sx = 0, sy = 0;
+        for(int j = begin; j < end; ++j)
+        {
+            double x_diff = xm - x[j];
+            double y_diff = ym - y[j];
+            double t = l[j] / sqrt(x_diff * x_diff + y_diff * y_diff);
+            sx += k[j] * (x_diff - t * x_diff);
+            sy += k[j] * (y_diff - t * y_diff);
+        }
+        sum_x += sx;
+        sum_y += sy;
+    }
+
+
+    // Adds the contributions of the nodes j to the entries dE/dx dx, dE/dx dy and
+    // dE/dy dy of the Jacobian of m at (xm, ym) to jac[0], jac[1] and jac[2].
+    static void jacobianKernel(
+        const double* x, const double* y, const double* k, const double* l,
+        double xm, double ym, int begin, int end, double* jac)
+    {
+        double dxdx = 0, dxdy = 0, dydy = 0;
+        for(int j = begin; j < end; ++j)
+        {
+            double x_diff = xm - x[j];
+            double y_diff = ym - y[j];
+            double distSquare = x_diff * x_diff + y_diff * y_diff;
+            double t = k[j] * l[j] / (distSquare * sqrt(distSquare));
+            dxdx += k[j] - t * y_diff * y_diff;
+            dxdy += t * x_diff * y_diff;
+            dydy += k[j] - t * x_diff * x_diff;
+        }
+        jac[0] += dxdx;
+        jac[1] += dxdy;
+        jac[2] += dydy;
+    }
+
+
+    // Updates the partial derivatives dx[j], dy[j] of the nodes j after m has been
+    // moved from (xOld, yOld) to (xNew, yNew).
+    static void updateKernel(
+        const double* x, const double* y, const double* k, const double* l,
+        double xOld, double yOld, double xNew, double yNew, int begin, int end,
+        double* dx, double* dy)
+    {
+        for(int j = begin; j < end; ++j)
+        {
+            double xo = x[j] - xOld, yo = y[j] - yOld;
+            double xn = x[j] - xNew, yn = y[j] - yNew;
+            double to = l[j] / sqrt(xo * xo + yo * yo);
+            double tn = l[j] / sqrt(xn * xn + yn * yn);
+            dx[j] += k[j] * ((xn - tn * xn) - (xo - to * xo));
+            dy[j] += k[j] * ((yn - tn * yn) - (yo - to * yo));
+        }
+    }
+
+
+#ifdef OGDF_AVX2_EXTENSIONS
+    OGDF_TARGET_AVX2 static double horizontalSum_avx2(__m256d a)
+    {
+        __m128d s = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+    }
+
+
+    OGDF_TARGET_AVX2 static void gradientKernel_avx2(
+        const double* x, const double* y, const double* k, const double* l,
+        double xm, double ym, int begin, int end, double & sum_x, double & sum_y)
+    {
+        const __m256d mm_xm = _mm256_set1_pd(xm);
+        const __m256d mm_ym = _mm256_set1_pd(ym);
+        __m256d mm_sx = _mm256_setzero_pd();
+        __m256d mm_sy = _mm256_setzero_pd();
+
+        int j = begin;
+        for(; j + 4 <= end; j += 4)
+        {
+            __m256d mm_x_diff = _mm256_sub_pd(mm_xm, _mm256_loadu_pd(x + j));
+            __m256d mm_y_diff = _mm256_sub_pd(mm_ym, _mm256_loadu_pd(y + j));
+            __m256d mm_dist = _mm256_sqrt_pd(
+                _mm256_fmadd_pd(mm_x_diff, mm_x_diff, _mm256_mul_pd(mm_y_diff, mm_y_diff)));
+            __m256d mm_t = _mm256_div_pd(_mm256_loadu_pd(l + j), mm_dist);
+            __m256d mm_k = _mm256_loadu_pd(k + j);
+            mm_sx = _mm256_fmadd_pd(mm_k, _mm256_fnmadd_pd(mm_t, mm_x_diff, mm_x_diff), mm_sx);
+            mm_sy = _mm256_fmadd_pd(mm_k, _mm256_fnmadd_pd(mm_t, mm_y_diff, mm_y_diff), mm_sy);
+        }
+
+        sum_x += horizontalSum_avx2(mm_sx);
+        sum_y += horizontalSum_avx2(mm_sy);
+        gradientKernel(x, y, k, l, xm, ym, j, end, sum_x, sum_y);
+    }
+
+
+    OGDF_TARGET_AVX2 static void jacobianKernel_avx2(
+        const double* x, const double* y, const double* k, const double* l,
+        double xm, double ym, int begin, int end, double* jac)
+    {
+        const __m256d mm_xm = _mm256_set1_pd(xm);
+        const __m256d mm_ym = _mm256_set1_pd(ym);
+        __m256d mm_dxdx = _mm256_setzero_pd();
+        __m256d mm_dxdy = _mm256_setzero_pd();
+        __m256d mm_dydy = _mm256_setzero_pd();
+
+        int j = begin;
+        for(; j + 4 <= end; j += 4)
+        {
+            __m256d mm_x_diff = _mm256_sub_pd(mm_xm, _mm256_loadu_pd(x + j));
+            __m256d mm_y_diff = _mm256_sub_pd(mm_ym, _mm256_loadu_pd(y + j));
+            __m256d mm_distSquare =
+                _mm256_fmadd_pd(mm_x_diff, mm_x_diff, _mm256_mul_pd(mm_y_diff, mm_y_diff));
+            __m256d mm_k = _mm256_loadu_pd(k + j);
+            __m256d mm_t = _mm256_div_pd(_mm256_mul_pd(mm_k, _mm256_loadu_pd(l + j)),
+                _mm256_mul_pd(mm_distSquare, _mm256_sqrt_pd(mm_distSquare)));
+            mm_dxdx = _mm256_add_pd(mm_dxdx,
+                _mm256_fnmadd_pd(_mm256_mul_pd(mm_t, mm_y_diff), mm_y_diff, mm_k));
+            mm_dxdy = _mm256_fmadd_pd(_mm256_mul_pd(mm_t, mm_x_diff), mm_y_diff, mm_dxdy);
+            mm_dydy = _mm256_add_pd(mm_dydy,
+                _mm256_fnmadd_pd(_mm256_mul_pd(mm_t, mm_x_diff), mm_x_diff, mm_k));
+        }
+
+        jac[0] += horizontalSum_avx2(mm_dxdx);
+        jac[1] += horizontalSum_avx2(mm_dxdy);
+        jac[2] += horizontalSum_avx2(mm_dydy);
+        jacobianKernel(x, y, k, l, xm, ym, j, end, jac);
+    }
+
+
+    OGDF_TARGET_AVX2 static void updateKernel_avx2(
+        const double* x, const double* y, const double* k, const double* l,
+        double xOld, double yOld, double xNew, double yNew, int begin, int end,
+        double* dx, double* dy)
+    {
+        const __m256d mm_xOld = _mm256_set1_pd(xOld);
+        const __m256d mm_yOld = _mm256_set1_pd(yOld);
+        const __m256d mm_xNew = _mm256_set1_pd(xNew);
+        const __m256d mm_yNew = _mm256_set1_pd(yNew);
+
+        int j = begin;
+        for(; j + 4 <= end; j += 4)
+        {
+            __m256d mm_x = _mm256_loadu_pd(x + j);
+            __m256d mm_y = _mm256_loadu_pd(y + j);
+            __m256d mm_l = _mm256_loadu_pd(l + j);
+            __m256d mm_k = _mm256_loadu_pd(k + j);
+
+            __m256d mm_xo = _mm256_sub_pd(mm_x, mm_xOld);
+            __m256d mm_yo = _mm256_sub_pd(mm_y, mm_yOld);
+            __m256d mm_xn = _mm256_sub_pd(mm_x, mm_xNew);
+            __m256d mm_yn = _mm256_sub_pd(mm_y, mm_yNew);
+            __m256d mm_to = _mm256_div_pd(mm_l,
+                _mm256_sqrt_pd(_mm256_fmadd_pd(mm_xo, mm_xo, _mm256_mul_pd(mm_yo, mm_yo))));
+            __m256d mm_tn = _mm256_div_pd(mm_l,
+                _mm256_sqrt_pd(_mm256_fmadd_pd(mm_xn, mm_xn, _mm256_mul_pd(mm_yn, mm_yn))));
+
+            __m256d mm_ddx = _mm256_sub_pd(_mm256_fnmadd_pd(mm_tn, mm_xn, mm_xn),
+                                           _mm256_fnmadd_pd(mm_to, mm_xo, mm_xo));
+            __m256d mm_ddy = _mm256_sub_pd(_mm256_fnmadd_pd(mm_tn, mm_yn, mm_yn),
+                                           _mm256_fnmadd_pd(mm_to, mm_yo, mm_yo));
+            _mm256_storeu_pd(dx + j, _mm256_fmadd_pd(mm_k, mm_ddx, _mm256_loadu_pd(dx + j)));
+            _mm256_storeu_pd(dy + j, _mm256_fmadd_pd(mm_k, mm_ddy, _mm256_loadu_pd(dy + j)));
+        }
+
+        updateKernel(x, y, k, l, xOld, yOld, xNew, yNew, j, end, dx, dy);
+    }
+#endif
+
+
+    typedef void (*GradientFunction)(const double*, const double*, const double*, const double*,
+                                     double, double, int, int, double &, double &);
+    typedef void (*JacobianFunction)(const double*, const double*, const double*, const double*,
+                                     double, double, int, int, double*);
+    typedef void (*UpdateFunction)(const double*, const double*, const double*, const double*,
+                                   double, double, double, double, int, int, double*, double*);
+
+    static SIMDKernel<GradientFunction> s_gradientKernel = SIMDKernel<GradientFunction>(gradientKernel)
+#ifdef OGDF_AVX2_EXTENSIONS
+        .add(simdAVX2, gradientKernel_avx2)
+#endif
+        ;
+
+    static SIMDKernel<JacobianFunction> s_jacobianKernel = SIMDKernel<JacobianFunction>(jacobianKernel)
+#ifdef OGDF_AVX2_EXTENSIONS
+        .add(simdAVX2, jacobianKernel_avx2)
+#endif
+        ;
+
+    static SIMDKernel<UpdateFunction> s_updateKernel = SIMDKernel<UpdateFunction>(updateKernel)
+#ifdef OGDF_AVX2_EXTENSIONS
+        .add(simdAVX2, updateKernel_avx2)
+#endif
+        ;
+
+
+    //---------------------------------------------------------
+    // KKSolver
+    //---------------------------------------------------------
+
+    //! The node positions and partial derivatives of the Kamada-Kawai energy.
+    /**
+     * Nodes are identified by their rows in the matrices of lengths and spring
+     * strengths, which must be symmetric (row m is read instead of column m).
+     * The computations involving all nodes are distributed among a team of
+     * threads that is kept alive until the solver is destroyed, since the
+     * derivatives of all nodes are updated after every move of a single node.
+     */
+    class KKSolver
+    {
+    public:
+        KKSolver(const DistanceMatrix<double> & oLength, const DistanceMatrix<double> & sstrength, int numThreads)
+            : m_length(&oLength), m_strength(&sstrength), m_n(oLength.numberOfNodes()),
+              m_x(m_n), m_y(m_n), m_dx(m_n), m_dy(m_n),
+              // every thread gets at least MIN_NODES_PER_THREAD nodes, otherwise the
+              // synchronization after every move costs more than it saves
+              m_team(this, max(1, min(numThreads, m_n / MIN_NODES_PER_THREAD))),
+              m_gradient(s_gradientKernel.get()), m_jacobian(s_jacobianKernel.get()),
+              m_update(s_updateKernel.get())
+        {
+            m_best.init(0, m_team.numThreads() - 1, -1);
+            m_maxDelta.init(0, m_team.numThreads() - 1, 0.0);
+        }
+
+        double* x()
+        {
+            return &m_x[0];
+        }
+        double* y()
+        {
+            return &m_y[0];
+        }
+        double dx(int m) const
+        {
+            return m_dx[m];
+        }
+        double dy(int m) const
+        {
+            return m_dy[m];
+        }
+
+        //! Computes the partial derivatives of all nodes; returns the node with the largest \a delta.
+        int computeDerivatives(double & delta)
+        {
+            m_team.run(&KKSolver::derivativesTask);
+            return bestNode(0, 0.0, delta);
+        }
+
+        //! Recomputes the partial derivatives of node \a m; returns their norm.
+        double computeDerivative(int m)
+        {
+            const double* k = m_strength->row(m);
+            const double* l = m_length->row(m);
+            double sum_x = 0, sum_y = 0;
+            m_gradient(&m_x[0], &m_y[0], k, l, m_x[m], m_y[m], 0, m, sum_x, sum_y);
+            m_gradient(&m_x[0], &m_y[0], k, l, m_x[m], m_y[m], m + 1, m_n, sum_x, sum_y);
+            m_dx[m] = sum_x;
+            m_dy[m] = sum_y;
+            return sqrt(sum_x * sum_x + sum_y * sum_y);
+        }
+
+        //! Computes the entries dE/dx dx, dE/dx dy and dE/dy dy of the Jacobian of node \a m.
+        void computeJacobian(int m, double* jac)
+        {
+            const double* k = m_strength->row(m);
+            const double* l = m_length->row(m);
+            jac[0] = jac[1] = jac[2] = 0;
+            m_jacobian(&m_x[0], &m_y[0], k, l, m_x[m], m_y[m], 0, m, jac);
+            m_jacobian(&m_x[0], &m_y[0], k, l, m_x[m], m_y[m], m + 1, m_n, jac);
+        }
+
+        //! Updates the partial derivatives after node \a m has moved from (\a xOld, \a yOld).
+        /**
+         * @param delta is the norm of the derivatives of \a m and is set to the
+         *        largest norm of all nodes.
+         * @return the first node with the largest norm, or \a m if no node has a larger norm.
+         */
+        int update(int m, double xOld, double yOld, double & delta)
+        {
+            m_m = m;
+            m_xOld = xOld;
+            m_yOld = yOld;
+            const double dx = m_dx[m], dy = m_dy[m];
+            m_team.run(&KKSolver::updateTask);
+            m_dx[m] = dx;
+            m_dy[m] = dy;
+            return bestNode(m, delta, delta);
+        }
+
+    private:
+        static const int MIN_NODES_PER_THREAD = 512;
+
+        const DistanceMatrix<double>* m_length;
+        const DistanceMatrix<double>* m_strength;
+        int m_n;
+        std::vector<double> m_x, m_y;   //!< positions
+        std::vector<double> m_dx, m_dy; //!< partial derivatives
+
+        ThreadTeam<KKSolver> m_team;
+        Array<int> m_best;         //!< the node with the largest norm found by each thread
+        Array<double> m_maxDelta;  //!< its norm
+
+        int m_m;                   //!< the moved node (taskUpdate)
+        double m_xOld, m_yOld;     //!< its previous position
+
+        GradientFunction m_gradient;
+        JacobianFunction m_jacobian;
+        UpdateFunction m_update;
+
+        //! Returns the range of nodes of thread \a t.
+        void threadRange(int t, int & begin, int & end) const
+        {
+            // the ranges start at multiples of 8, so the SIMD kernels split them
+            // into vectors in the same way for every number of threads
+            const int numBlocks = (m_n + 7) / 8;
+            begin = min(m_n, 8 * threadRangeBegin(numBlocks, t, m_team.numThreads()));
+            end   = min(m_n, 8 * threadRangeBegin(numBlocks, t + 1, m_team.numThreads()));
+        }
+
+        //! Kernel computing the derivatives of the nodes of thread \a t.
+        void derivativesTask(int t)
+        {
+            int begin, end;
+            threadRange(t, begin, end);
+            for(int i = begin; i < end; ++i)
+                computeDerivative(i);
+            searchBestNode(t, begin, end);
+        }
+
+        //! Kernel updating the derivatives of the nodes of thread \a t after m_m has moved.
+        void updateTask(int t)
+        {
+            int begin, end;
+            threadRange(t, begin, end);
+            // the derivatives of m itself are garbage afterwards and restored by update()
+            const int m = m_m;
+            m_update(&m_x[0], &m_y[0], m_strength->row(m), m_length->row(m),
+                     m_xOld, m_yOld, m_x[m], m_y[m], begin, end, &m_dx[0], &m_dy[0]);
+            searchBestNode(t, begin, end);
+        }
+
+        //! Searches the first node with the largest norm among the nodes of thread \a t.
+        void searchBestNode(int t, int begin, int end)
+        {
+            int best = -1;
+            double maxDelta = 0.0;
+            for(int i = begin; i < end; ++i)
+            {
+                double delta = sqrt(m_dx[i] * m_dx[i] + m_dy[i] * m_dy[i]);
+                if(delta > maxDelta)
+                {
+                    best = i;
+                    maxDelta = delta;
+                }
+            }
+            m_best[t] = best;
+            m_maxDelta[t] = maxDelta;
+        }
+
+        //! Returns the first node whose norm is larger than \a delta0 (or \a best0), like a sequential scan.
+        int bestNode(int best0, double delta0, double & delta) const
+        {
+            int best = best0;
+            delta = delta0;
+            for(int t = 0; t < m_team.numThreads(); ++t)
+            {
+                if(m_best[t] >= 0 && m_maxDelta[t] > delta)
+                {
+                    best = m_best[t];
+                    delta = m_maxDelta[t];
+                }
+            }
+            return best;
+        }
+    };
+
+
     void SpringEmbedderKK::initialize(
         GraphAttributes & GA,
         NodeArray<dpair> & partialDer,
         const EdgeArray<double> & eLength,
-        NodeArray<NodeArray<double>> & oLength,
-        NodeArray<NodeArray<double>> & sstrength,
+        DistanceMatrix<double> & oLength,
+        DistanceMatrix<double> & sstrength,
         double & maxDist,
         bool simpleBFS)
     {
@@ -73,9 +464,6 @@ namespace ogdf
         if(!m_useLayout)
             shufflePositions(GA);
 
-        //the shortest path lengths
-        forall_nodes(v, G) oLength[v].init(G, numeric_limits<double>::max());
-
         //-------------------------------------
         //computes shortest path distances d_ij
         //-------------------------------------
@@ -87,7 +475,7 @@ namespace ogdf
             //      double timeUsed;
             //      usedTime(timeUsed);
             //#endif
-            maxDist = allpairsspBFS(G, oLength);
+            bfs_SPAP(G, oLength, 1.0, m_numberOfThreads);
 
             //#ifdef OGDF_DEBUG
             //      timeUsed = usedTime(timeUsed);
@@ -98,10 +486,16 @@ namespace ogdf
         {
             EdgeArray<double> adaptedLength(G);
             adaptLengths(G, GA, eLength, adaptedLength);
-            //we use simply the BFM n times or Floyd instead, leading to cubic runtime
-            //TODO experimentally compare speed, also with bintree dijkstra
-            maxDist = allpairssp(G, adaptedLength, oLength, numeric_limits<double>::max());
+            //we use Dijkstra from every node
+            dijkstra_SPAP(G, oLength, adaptedLength, m_numberOfThreads);
+            //the sums along a path and its reversal may differ in the last bits,
+            //but mainStep needs symmetric matrices
+            const int n = oLength.numberOfNodes();
+            for(int i = 0; i < n; i++)
+                for(int j = i + 1; j < n; j++)
+                    oLength(i, j) = oLength(j, i) = min(oLength(i, j), oLength(j, i));
         }
+        maxDist = maxDistance(oLength);
         //------------------------------------
         //computes original spring length l_ij
         //------------------------------------
@@ -154,27 +548,26 @@ namespace ogdf
         // Having L we can compute the original lengths l_ij
         // Computes spring strengths k_ij
         //--------------------------------------------------
-        node w;
+        const int n = oLength.numberOfNodes();
         double dij;
-        forall_nodes(v, G)
+        sstrength.init(G);
+        for(int i = 0; i < n; i++)
         {
-            sstrength[v].init(G);
-            forall_nodes(w, G)
+            double* length = oLength.row(i);
+            double* strength = sstrength.row(i);
+            for(int j = 0; j < n; j++)
             {
-                dij = oLength[v][w];
-                if(dij == numeric_limits<double>::max())
+                dij = length[j];
+                if(dij == DistanceMatrix<double>::infinity())
                 {
-                    sstrength[v][w] = minVal;
+                    strength[j] = minVal;
                 }
                 else
                 {
-                    oLength[v][w] = L * dij;
-                    if(v == w) sstrength[v][w] = 1.0;
+                    length[j] = L * dij;
+                    if(i == j) strength[j] = 1.0;
                     else
-                        sstrength[v][w] = m_K / (dij * dij);
-
-
-
+                        strength[j] = m_K / (dij * dij);
                 }
             }
         }
@@ -183,37 +576,33 @@ namespace ogdf
 
     void SpringEmbedderKK::mainStep(GraphAttributes & GA,
                                     NodeArray<dpair> & partialDer,
-                                    NodeArray<NodeArray<double>> & oLength,
-                                    NodeArray<NodeArray<double>> & sstrength,
+                                    const DistanceMatrix<double> & oLength,
+                                    const DistanceMatrix<double> & sstrength,
                                     const double maxDist)
     {
         const Graph & G = GA.constGraph();
+        const int n = oLength.numberOfNodes();
         node v;
 
 #ifdef OGDF_DEBUG
-        NodeArray<int> nodeCounts(G, 0);
         int nodeCount = 0; //number of moved nodes
 #endif
-        // Now we compute delta_m, we search for the node with max value
-        double delta_m = 0.0f;
-        double delta_v;
-        node best_m = G.firstNode();
-
-        // Compute the partial derivatives first
-        forall_nodes(v, G)
+        // positions and partial derivatives are stored per row of the matrices
+        KKSolver solver(oLength, sstrength, m_numberOfThreads);
+        double* x = solver.x();
+        double* y = solver.y();
+        for(int i = 0; i < n; i++)
         {
-            dpair parder = computeParDers(v, GA, sstrength, oLength);
-            partialDer[v] = parder;
-            //delta_m is sqrt of squares of partial derivatives
-            delta_v = sqrt(parder.x1() * parder.x1() + parder.x2() * parder.x2());
-
-            if(delta_v > delta_m)
-            {
-                best_m = v;
-                delta_m = delta_v;
-            }
+            v = oLength.nodeAt(i);
+            x[i] = GA.x(v);
+            y[i] = GA.y(v);
         }
 
+        // Compute the partial derivatives first, then we search for the
+        // node best_m with max value delta_m
+        double delta_m;
+        int best_m = solver.computeDerivatives(delta_m);
+
         int globalItCount, localItCount;
         if(m_computeMaxIt)
         {
@@ -230,49 +619,23 @@ namespace ogdf
         while(globalItCount-- > 0 && !finished(delta_m))
         {
 #ifdef OGDF_DEBUG
-            //      cout <<"G: "<<globalItCount <<"\n";
-            //      cout <<"New iteration on "<<best_m->index()<<"\n";
             nodeCount++;
-            nodeCounts[best_m]++;
 #endif
             // The contribution best_m makes to the partial derivatives of
-            // each vertex.
-            NodeArray<dpair> p_partials(G);
-            forall_nodes(v, G)
-            {
-                p_partials[v] = computeParDer(v, best_m, GA, sstrength, oLength);
-            }
+            // each vertex is updated from its position before the move.
+            const double xOld = x[best_m], yOld = y[best_m];
 
             localItCount = 0;
             do
             {
-#ifdef OGDF_DEBUG
-                //          cout <<"  New local iteration\n";
-                //          cout <<"   L: "<<localItCount <<"\n";
-#endif
                 // Compute the 4 elements of the Jacobian
-                double dE_dx_dx = 0.0f, dE_dx_dy = 0.0f, dE_dy_dx = 0.0f, dE_dy_dy = 0.0f;
-                forall_nodes(v, G)
-                {
-                    if(v != best_m)
-                    {
-                        double x_diff = GA.x(best_m) - GA.x(v);
-                        double y_diff = GA.y(best_m) - GA.y(v);
-                        double dist = sqrt(x_diff * x_diff + y_diff * y_diff);
-                        double dist3 = dist * dist * dist;
-                        OGDF_ASSERT(dist3 != 0.0);
-                        double k_mi = sstrength[best_m][v];
-                        double l_mi = oLength[best_m][v];
-                        dE_dx_dx += k_mi * (1 - (l_mi * y_diff * y_diff) / dist3);
-                        dE_dx_dy += k_mi * l_mi * x_diff * y_diff / dist3;
-                        dE_dy_dx += k_mi * l_mi * x_diff * y_diff / dist3;
-                        dE_dy_dy += k_mi * (1 - (l_mi * x_diff * x_diff) / dist3);
-                    }
-                }
+                double jac[3];
+                solver.computeJacobian(best_m, jac);
+                double dE_dx_dx = jac[0], dE_dx_dy = jac[1], dE_dy_dx = jac[1], dE_dy_dy = jac[2];
 
                 // Solve for delta_x and delta_y
-                double dE_dx = partialDer[best_m].x1();
-                double dE_dy = partialDer[best_m].x2();
+                double dE_dx = solver.dx(best_m);
+                double dE_dy = solver.dy(best_m);
 
                 double delta_x =
                     (dE_dx_dy * dE_dy - dE_dy_dy * dE_dx)
@@ -282,53 +645,26 @@ namespace ogdf
                     (dE_dx_dx * dE_dy - dE_dy_dx * dE_dx)
                     / (dE_dy_dx * dE_dx_dy - dE_dx_dx * dE_dy_dy);
 
-
                 // Move p by (delta_x, delta_y)
-#ifdef OGDF_DEBUG
-                // cout <<"   x"<< delta_x<<"\n";
-                // cout <<"   y" <<delta_y<<"\n";
-#endif
-                GA.x(best_m) += delta_x;
-                GA.y(best_m) += delta_y;
+                x[best_m] += delta_x;
+                y[best_m] += delta_y;
 
                 // Recompute partial derivatives and delta_p
-                dpair deriv = computeParDers(best_m, GA, sstrength, oLength);
-                partialDer[best_m] = deriv;
-
-                delta_m =
-                    sqrt(deriv.x1() * deriv.x1() + deriv.x2() * deriv.x2());
+                delta_m = solver.computeDerivative(best_m);
             }
             while(localItCount-- > 0 && !finishedNode(delta_m));
 
             // Select new best_m by updating each partial derivative and delta
-            node old_p = best_m;
-            forall_nodes(v, G)
-            {
-                dpair old_deriv_p = p_partials[v];
-                dpair old_p_partial =
-                    computeParDer(v, old_p, GA, sstrength, oLength);
-                dpair deriv = partialDer[v];
-
-                deriv.x1() += old_p_partial.x1() - old_deriv_p.x1();
-                deriv.x2() += old_p_partial.x2() - old_deriv_p.x2();
-
-                partialDer[v] = deriv;
-                double delta = sqrt(deriv.x1() * deriv.x1() + deriv.x2() * deriv.x2());
-
-                if(delta > delta_m)
-                {
-                    best_m = v;
-                    delta_m = delta;
-                }
-            }
+            best_m = solver.update(best_m, xOld, yOld, delta_m);
         }//while
-#ifdef OGDF_DEBUG
-        //  cout << "NodeCount: "<<nodeCount<<"\n";
-        //  forall_nodes(v, G)
-        //  {
-        //      cout<<"Counts "<<v->index()<<": "<<nodeCounts[v]<<"\n";
-        //  }
-#endif
+
+        for(int i = 0; i < n; i++)
+        {
+            v = oLength.nodeAt(i);
+            GA.x(v) = x[i];
+            GA.y(v) = y[i];
+            partialDer[v] = dpair(solver.dx(i), solver.dy(i));
+        }
     }//mainStep
 
 
@@ -337,8 +673,8 @@ namespace ogdf
         const Graph & G = GA.constGraph();
         NodeArray<dpair> partialDer(G); //stores the partial derivative per node
         double maxDist; //maximum distance between nodes
-        NodeArray<NodeArray<double>> oLength(G);//first distance, then original length
-        NodeArray<NodeArray<double>> sstrength(G);//the spring strength
+        DistanceMatrix<double> oLength;//first distance, then original length
+        DistanceMatrix<double> sstrength;//the spring strength
 
         //only for debugging
         OGDF_ASSERT(isConnected(G));
@@ -403,181 +739,22 @@ namespace ogdf
 
 
 
-    // Compute contribution of vertex u to the first partial
-    // derivatives (dE/dx_m, dE/dy_m) (for vertex m) (eq. 7 and 8 in paper)
-    SpringEmbedderKK::dpair SpringEmbedderKK::computeParDer(
-        node m,
-        node u,
-        GraphAttributes & GA,
-        NodeArray<NodeArray<double>> & ss,
-        NodeArray<NodeArray<double>> & dist)
-    {
-        dpair result(0.0, 0.0);
-        if(m != u)
-        {
-            double x_diff = GA.x(m) - GA.x(u);
-            double y_diff = GA.y(m) - GA.y(u);
-            double distance = sqrt(x_diff * x_diff + y_diff * y_diff);
-            result.x1() = (ss[m][u]) * (x_diff - (dist[m][u]) * x_diff / distance);
-            result.x2() = (ss[m][u]) * (y_diff - (dist[m][u]) * y_diff / distance);
-        }
-
-        return result;
-    }
-
-
-    //compute partial derivative for v
-    SpringEmbedderKK::dpair SpringEmbedderKK::computeParDers(node v,
-            GraphAttributes & GA,
-            NodeArray<NodeArray<double>> & ss,
-            NodeArray<NodeArray<double>> & dist)
-    {
-        node u;
-        dpair result(0.0, 0.0);
-        forall_nodes(u, GA.constGraph())
-        {
-            dpair deriv = computeParDer(v, u, GA, ss, dist);
-            result.x1() += deriv.x1();
-            result.x2() += deriv.x2();
-        }
-
-        return result;
-    }
-
-
-    /**
-     * Initialise the original estimates from nodes and edges.
-     */
-
-    //we could speed this up by not using nested NodeArrays and
-    //by not doing the fully symmetrical computation on undirected graphs
-    //All Pairs Shortest Path Floyd, initializes the whole matrix
-    //returns maximum distance. Does not detect negative cycles (lead to neg. values on diagonal)
-    //threshold is the value for the distance of non-adjacent nodes, distance has to be
-    //initialized with
-    double SpringEmbedderKK::allpairssp(const Graph & G, const EdgeArray<double> & eLengths, NodeArray<NodeArray<double>> & distance,
-                                        const double threshold)
+    //returns the maximum finite distance
+    double SpringEmbedderKK::maxDistance(const DistanceMatrix<double> & distance)
     {
-        node v;
-        edge e;
-        double maxDist = -threshold;
-
-        forall_nodes(v, G)
-        {
-            distance[v][v] = 0.0f;
-        }
-
-        //TODO: Experimentally compare this against
-        // all nodes and incident edges (memory access) on huge graphs
-        forall_edges(e, G)
-        {
-            distance[e->source()][e->target()] = eLengths[e];
-            distance[e->target()][e->source()] = eLengths[e];
-        }
-
-        ///**
-        // * And run the main loop of the algorithm.
-        // */
-        node u, w;
-        forall_nodes(v, G)
-        {
-            forall_nodes(u, G)
-            {
-                forall_nodes(w, G)
-                {
-                    if((distance[u][v] < threshold) && (distance[v][w] < threshold))
-                    {
-                        distance[u][w] = min(distance[u][w], distance[u][v] + distance[v][w]);
-                        //distance[w][u] = distance[u][w]; //is done anyway afterwards
-                    }
-                    if(distance[u][w] < threshold)
-                        maxDist = max(maxDist, distance[u][w]);
-                }
-            }
-        }
-        //debug output
-        //#ifdef OGDF_DEBUG
-        //  forall_nodes(v, G)
-        //  {
-        //      if (distance[v][v] < 0.0) cerr << "\n###Error in shortest path computation###\n\n";
-        //  }
-        //  cout << "Maxdist: "<<maxDist<<"\n";
-        //  forall_nodes(u, G)
-        //  {
-        //  forall_nodes(w, G)
-        //  {
-        ////        cout << "Distance " << u->index() << " -> "<<w->index()<<" "<<distance[u][w]<<"\n";
-        //  }
-        //  }
-        //#endif
-        return maxDist;
-    }//allpairssp
-
-
-    //the same without weights, i.e. all pairs shortest paths with BFS
-    //Runs in time |V|²
-    //for compatibility, distances are double
-    double SpringEmbedderKK::allpairsspBFS(const Graph & G, NodeArray<NodeArray<double>> & distance)
-    {
-        node v;
+        const int n = distance.numberOfNodes();
         double maxDist = 0;
-
-        forall_nodes(v, G)
+        for(int i = 0; i < n; i++)
         {
-            distance[v][v] = 0.0f;
-        }
-
-        v = G.firstNode();
-
-        //start in each node once
-        while(v != 0)
-        {
-            //do a bfs
-            NodeArray<bool> mark(G, true);
-            SListPure<node> bfs;
-            bfs.pushBack(v);
-            mark[v] = false;
-
-            while(!bfs.empty())
+            const double* row = distance.row(i);
+            for(int j = 0; j < n; j++)
             {
-                node w = bfs.popFrontRet();
-                edge e;
-                double d = distance[v][w] + 1.0f;
-                forall_adj_edges(e, w)
-                {
-                    node u = e->opposite(w);
-                    if(mark[u])
-                    {
-                        mark[u] = false;
-                        bfs.pushBack(u);
-                        distance[v][u] = d;
-                        maxDist = max(maxDist, d);
-                    }
-                }
-            }//while
-
-            v = v->succ();
-        }//while
-        //check for negative cycles
-        forall_nodes(v, G)
-        {
-            if(distance[v][v] < 0.0) cerr << "\n###Error in shortest path computation###\n\n";
+                if(row[j] != DistanceMatrix<double>::infinity())
+                    maxDist = max(maxDist, row[j]);
+            }
         }
-
-        //debug output
-        //#ifdef OGDF_DEBUG
-        //  node u, w;
-        //  cout << "Maxdist: "<<maxDist<<"\n";
-        //  forall_nodes(u, G)
-        //  {
-        //  forall_nodes(w, G)
-        //  {
-        ////        cout << "Distance " << u->index() << " -> "<<w->index()<<" "<<distance[u][w]<<"\n";
-        //  }
-        //  }
-        //#endif
         return maxDist;
-    }//allpairsspBFS
+    }//maxDistance
 
 
     void SpringEmbedderKK::scale(GraphAttributes & GA)
@@ -42,6 +42,9 @@
  ***************************************************************/
 
 #include <ogdf/energybased/StressMinimization.h>
+#include <ogdf/basic/ThreadTeam.h>
+#include <algorithm>
+#include <queue>
 
 
 namespace ogdf
@@ -51,9 +54,484 @@ namespace ogdf
 
     const int StressMinimization::DEFAULT_NUMBER_OF_PIVOTS = 50;
 
+    const int StressMinimization::DEFAULT_NUMBER_OF_SPARSE_PIVOTS = 100;
+
+
+    // moves a coordinate from pos towards target by the given fraction
+    static inline double moveTowards(double pos, double target, double mobility)
+    {
+        return (mobility == 1.0) ? target : pos + mobility * (target - pos);
+    }
+
+
+    //! Data and parallel kernels of the sparse stress model.
+    class SparseStress
+    {
+    public:
+        enum Phase { phCountNeighbors, phFillNeighbors, phRegions, phWeights, phIterate };
+
+        SparseStress(const GraphAttributes & GA, const EdgeArray<double> & length, int numThreads)
+            : m_GA(GA), m_numThreads(numThreads), m_team(this, numThreads)
+        {
+            const Graph & G = GA.constGraph();
+            m_n = G.numberOfNodes();
+            m_node.init(m_n);
+            m_index.init(G);
+            int i = 0;
+            node v;
+            forall_nodes(v, G)
+            {
+                m_index[v] = i;
+                m_node[i++] = v;
+            }
+
+            // adjacency in compressed form
+            m_adjBegin.init(m_n + 1);
+            m_adj.init(2 * G.numberOfEdges());
+            m_adjLength.init(2 * G.numberOfEdges());
+            int k = 0;
+            for(i = 0; i < m_n; i++)
+            {
+                m_adjBegin[i] = k;
+                adjEntry adj;
+                forall_adj(adj, m_node[i])
+                {
+                    m_adj[k] = m_index[adj->twinNode()];
+                    m_adjLength[k++] = length[adj->theEdge()];
+                }
+            }
+            m_adjBegin[m_n] = k;
+
+            m_stamp.init(0, numThreads - 1);
+            m_dist.init(0, numThreads - 1);
+            m_stress.init(0, numThreads - 1);
+            m_moved.init(0, numThreads - 1);
+            m_norm.init(0, numThreads - 1);
+            m_maxMove.init(0, numThreads - 1);
+        }
+
+        //! Computes the exact terms of all nodes within \a hops hops.
+        void computeNeighborhoods(int hops)
+        {
+            m_hops = hops;
+            m_nbrBegin.init(m_n + 1);
+            run(phCountNeighbors);
+            __int64 total = 0;
+            for(int i = 0; i < m_n; i++)
+            {
+                int count = m_nbrBegin[i];
+                m_nbrBegin[i] = int(total);
+                total += count;
+                if(total > numeric_limits<int>::max())
+                    OGDF_THROW(InsufficientMemoryException);
+            }
+            m_nbrBegin[m_n] = int(total);
+            m_nbr.init(total);
+            m_nbrDist.init(total);
+            run(phFillNeighbors);
+        }
+
+        //! Chooses \a numPivots pivots by max-min distance and computes their terms.
+        void computePivots(int numPivots, bool uniform, double infinityDistance)
+        {
+            // the terms of all nodes and pivots must fit into an Array
+            m_k = numPivots;
+            if((__int64)m_n * m_k > numeric_limits<int>::max())
+                m_k = max(1, numeric_limits<int>::max() / m_n);
+            m_pivot.init(m_k);
+            m_pivotDist.init(m_n * m_k);
+            m_pivotWeight.init(m_n * m_k);
+
+            Array<double> dist(m_n);
+            Array<double> minDist(0, m_n - 1, numeric_limits<double>::infinity());
+            int next = 0;
+            for(int p = 0; p < m_k; p++)
+            {
+                m_pivot[p] = next;
+                singleSource(next, uniform, dist);
+                next = 0;
+                for(int i = 0; i < m_n; i++)
+                {
+                    double d = dist[i];
+                    if(d == numeric_limits<double>::infinity())
+                        d = infinityDistance;
+                    m_pivotDist[i * m_k + p] = float(d);
+                    minDist[i] = min(minDist[i], dist[i]);
+                    if(minDist[i] > minDist[next])
+                        next = i;
+                }
+            }
+
+            // the region of a pivot consists of the nodes closest to it
+            m_region.init(m_n);
+            run(phRegions);
+            m_regionBegin.init(0, m_k, 0);
+            for(int i = 0; i < m_n; i++)
+                m_regionBegin[m_region[i] + 1]++;
+            for(int p = 0; p < m_k; p++)
+                m_regionBegin[p + 1] += m_regionBegin[p];
+            m_regionDist.init(m_n);
+            Array<int> pos(m_k);
+            for(int p = 0; p < m_k; p++)
+                pos[p] = m_regionBegin[p];
+            for(int i = 0; i < m_n; i++)
+            {
+                int p = m_region[i];
+                m_regionDist[pos[p]++] = m_pivotDist[i * m_k + p];
+            }
+            for(int p = 0; p < m_k; p++)
+                std::sort(m_regionDist.begin() + m_regionBegin[p], m_regionDist.begin() + m_regionBegin[p + 1]);
+
+            run(phWeights);
+            m_regionDist.init();
+            m_regionBegin.init();
+            m_region.init();
+        }
+
+        //! Sets the positions from \a GA.
+        void getPositions(bool threeD)
+        {
+            m_threeD = threeD;
+            for(int d = 0; d < 3; d++)
+            {
+                m_pos[d].assign(m_n, 0.0);
+                m_newPos[d].assign(m_n, 0.0);
+            }
+            for(int i = 0; i < m_n; i++)
+            {
+                m_pos[0][i] = m_GA.x(m_node[i]);
+                m_pos[1][i] = m_GA.y(m_node[i]);
+                if(threeD)
+                    m_pos[2][i] = m_GA.z(m_node[i]);
+            }
+        }
+
+        //! Writes the positions to \a GA.
+        void setPositions(GraphAttributes & GA) const
+        {
+            for(int i = 0; i < m_n; i++)
+            {
+                GA.x(m_node[i]) = m_pos[0][i];
+                GA.y(m_node[i]) = m_pos[1][i];
+                if(m_threeD)
+                    GA.z(m_node[i]) = m_pos[2][i];
+            }
+        }
+
+        //! Scales the moves of all nodes by their mobility in \a ws.
+        void setMobility(const WarmStart & ws)
+        {
+            m_mobility.init(m_n);
+            for(int i = 0; i < m_n; i++)
+                m_mobility[i] = ws.mobility(m_node[i]);
+        }
+
+        //! Performs one majorization step; returns the stress of the previous positions.
+        double iterate(const bool fix[3])
+        {
+            for(int d = 0; d < 3; d++)
+                m_fix[d] = fix[d];
+            run(phIterate);
+            double stress = 0, moved = 0, norm = 0, maxMove = 0;
+            for(int t = 0; t < m_numThreads; t++)
+            {
+                stress += m_stress[t];
+                moved += m_moved[t];
+                norm += m_norm[t];
+                maxMove = max(maxMove, m_maxMove[t]);
+            }
+            m_relativeMove = (norm > 0) ? sqrt(moved) / sqrt(norm) : 0;
+            m_maxMoveLength = sqrt(maxMove);
+            for(int d = 0; d < 3; d++)
+                m_pos[d].swap(m_newPos[d]);
+            return stress;
+        }
+
+        //! Returns the relative movement of the last iteration.
+        double relativeMove() const
+        {
+            return m_relativeMove;
+        }
+
+        //! Returns the maximum move of a node in the last iteration.
+        double maxMove() const
+        {
+            return m_maxMoveLength;
+        }
+
+        void kernel(int t)
+        {
+            const int begin = threadRangeBegin(m_n, t, m_numThreads);
+            const int end = threadRangeBegin(m_n, t + 1, m_numThreads);
+            switch(m_phase)
+            {
+            case phCountNeighbors:
+            case phFillNeighbors:
+                for(int i = begin; i < end; i++)
+                    neighborhood(t, i);
+                break;
+            case phRegions:
+                for(int i = begin; i < end; i++)
+                {
+                    const float* d = m_pivotDist.begin() + i * m_k;
+                    int best = 0;
+                    for(int p = 1; p < m_k; p++)
+                        if(d[p] < d[best])
+                            best = p;
+                    m_region[i] = best;
+                }
+                break;
+            case phWeights:
+                for(int i = begin; i < end; i++)
+                    pivotWeights(i);
+                break;
+            case phIterate:
+                iterate(t, begin, end);
+                break;
+            }
+        }
+
+    private:
+        void run(Phase phase)
+        {
+            m_phase = phase;
+            m_team.run(&SparseStress::kernel);
+        }
+
+        // distances from node s by BFS (uniform lengths) or Dijkstra
+        void singleSource(int s, bool uniform, Array<double> & dist) const
+        {
+            dist.fill(numeric_limits<double>::infinity());
+            dist[s] = 0;
+            if(uniform)
+            {
+                Array<int> queue(m_n);
+                int head = 0, tail = 0;
+                queue[tail++] = s;
+                while(head < tail)
+                {
+                    int u = queue[head++];
+                    for(int k = m_adjBegin[u]; k < m_adjBegin[u + 1]; k++)
+                    {
+                        int w = m_adj[k];
+                        if(dist[w] == numeric_limits<double>::infinity())
+                        {
+                            dist[w] = dist[u] + m_adjLength[k];
+                            queue[tail++] = w;
+                        }
+                    }
+                }
+            }
+            else
+            {
+                std::priority_queue<std::pair<double, int>, std::vector<std::pair<double, int>>, std::greater<std::pair<double, int>>> heap;
+                heap.push(std::pair<double, int>(0.0, s));
+                while(!heap.empty())
+                {
+                    std::pair<double, int> top = heap.top();
+                    heap.pop();
+                    int u = top.second;
+                    if(top.first > dist[u])
+                        continue;
+                    for(int k = m_adjBegin[u]; k < m_adjBegin[u + 1]; k++)
+                    {
+                        int w = m_adj[k];
+                        double d = top.first + m_adjLength[k];
+                        if(d < dist[w])
+                        {
+                            dist[w] = d;
+                            heap.push(std::pair<double, int>(d, w));
+                        }
+                    }
+                }
+            }
+        }
+
+        // the nodes within m_hops hops of node i; the distance of a node is the
+        // length of the shortest path found by the hop-limited search (exact for
+        // uniform lengths and for the adjacent nodes)
+        void neighborhood(int t, int i)
+        {
+            Array<double> & dist = m_dist[t];
+            if(dist.size() != m_n)
+                dist.init(0, m_n - 1, numeric_limits<double>::infinity());
+            std::vector<int> frontier(1, i), next, found;
+            dist[i] = 0;
+            for(int h = 0; h < m_hops && !frontier.empty(); h++)
+            {
+                next.clear();
+                for(size_t f = 0; f < frontier.size(); f++)
+                {
+                    int u = frontier[f];
+                    for(int k = m_adjBegin[u]; k < m_adjBegin[u + 1]; k++)
+                    {
+                        int w = m_adj[k];
+                        double d = dist[u] + m_adjLength[k];
+                        if(dist[w] == numeric_limits<double>::infinity())
+                        {
+                            next.push_back(w);
+                            found.push_back(w);
+                        }
+                        if(d < dist[w] && w != i)
+                            dist[w] = d;
+                    }
+                }
+                frontier.swap(next);
+            }
+
+            if(m_phase == phCountNeighbors)
+                m_nbrBegin[i] = (int)found.size();
+            else
+            {
+                int k = m_nbrBegin[i];
+                for(size_t f = 0; f < found.size(); f++)
+                {
+                    m_nbr[k] = found[f];
+                    m_nbrDist[k++] = float(dist[found[f]]);
+                }
+            }
+
+            dist[i] = numeric_limits<double>::infinity();
+            for(size_t f = 0; f < found.size(); f++)
+                dist[found[f]] = numeric_limits<double>::infinity();
+        }
+
+        // w_ip = s / d_ip^2, where s is the number of nodes in the region of p
+        // whose distance to p is at most d_ip / 2
+        void pivotWeights(int i)
+        {
+            for(int p = 0; p < m_k; p++)
+            {
+                float d = m_pivotDist[i * m_k + p];
+                float w = 0;
+                if(d > 0)
+                {
+                    const float* first = m_regionDist.begin() + m_regionBegin[p];
+                    const float* last = m_regionDist.begin() + m_regionBegin[p + 1];
+                    int s = int(std::upper_bound(first, last, d / 2) - first);
+                    w = float(s) / (d * d);
+                }
+                m_pivotWeight[i * m_k + p] = w;
+            }
+        }
+
+        // adds the term of node j with desired distance d and weight w to the new position of i
+        inline void addTerm(int i, int j, double d, double w, double* newPos, double & totalWeight, double & stress) const
+        {
+            double diff[3], dist = 0;
+            for(int c = 0; c < 3; c++)
+            {
+                diff[c] = m_pos[c][i] - m_pos[c][j];
+                dist += diff[c] * diff[c];
+            }
+            dist = sqrt(dist);
+            for(int c = 0; c < 3; c++)
+            {
+                double vote = m_pos[c][j];
+                if(dist != 0)
+                    vote += d * diff[c] / dist;
+                newPos[c] += w * vote;
+            }
+            totalWeight += w;
+            stress += w * (d - dist) * (d - dist);
+        }
+
+        void iterate(int t, int begin, int end)
+        {
+            Array<int> & stamp = m_stamp[t];
+            if(stamp.size() != m_n)
+                stamp.init(0, m_n - 1, -1);
+
+            double stress = 0, moved = 0, norm = 0, maxMove = 0;
+            for(int i = begin; i < end; i++)
+            {
+                double newPos[3] = { 0, 0, 0 };
+                double totalWeight = 0;
+
+                for(int k = m_nbrBegin[i]; k < m_nbrBegin[i + 1]; k++)
+                {
+                    int j = m_nbr[k];
+                    double d = m_nbrDist[k];
+                    stamp[j] = i;
+                    if(d > 0)
+                        addTerm(i, j, d, 1 / (d * d), newPos, totalWeight, stress);
+                }
+
+                const float* pd = m_pivotDist.begin() + i * m_k;
+                const float* pw = m_pivotWeight.begin() + i * m_k;
+                for(int p = 0; p < m_k; p++)
+                {
+                    int j = m_pivot[p];
+                    if(j != i && stamp[j] != i && pw[p] > 0)
+                        addTerm(i, j, pd[p], pw[p], newPos, totalWeight, stress);
+                }
+
+                const double mobility = (m_mobility.size() > 0) ? m_mobility[i] : 1.0;
+                double move = 0;
+                for(int c = 0; c < 3; c++)
+                {
+                    double pos = m_pos[c][i];
+                    if(totalWeight != 0 && !m_fix[c] && (c < 2 || m_threeD))
+                        pos = moveTowards(pos, newPos[c] / totalWeight, mobility);
+                    m_newPos[c][i] = pos;
+                    move += (pos - m_pos[c][i]) * (pos - m_pos[c][i]);
+                    norm += m_pos[c][i] * m_pos[c][i];
+                }
+                moved += move;
+                maxMove = max(maxMove, move);
+            }
+            m_stress[t] = stress / 2;
+            m_moved[t] = moved;
+            m_norm[t] = norm;
+            m_maxMove[t] = maxMove;
+        }
+
+        const GraphAttributes & m_GA;
+        int m_n;
+        Array<node> m_node;
+        NodeArray<int> m_index;
+
+        Array<int> m_adjBegin;
+        Array<int> m_adj;
+        Array<double> m_adjLength;
+
+        int m_hops;
+        Array<int> m_nbrBegin;    //!< exact terms of node i are m_nbrBegin[i],...,m_nbrBegin[i+1]-1
+        Array<int> m_nbr;
+        Array<float> m_nbrDist;
+
+        int m_k;
+        Array<int> m_pivot;
+        Array<float> m_pivotDist;   //!< distance of node i to pivot p at i * m_k + p
+        Array<float> m_pivotWeight; //!< weight of the term of node i and pivot p at i * m_k + p
+        Array<int> m_region;
+        Array<int> m_regionBegin;
+        Array<float> m_regionDist;
+
+        bool m_threeD;
+        bool m_fix[3];
+        std::vector<double> m_pos[3];
+        std::vector<double> m_newPos[3];
+        Array<double> m_mobility;   //!< scaling factors of the moves (empty if not incremental)
+        double m_relativeMove;
+        double m_maxMoveLength;
+
+        Phase m_phase;
+        int m_numThreads;
+        ThreadTeam<SparseStress> m_team; //!< kept alive for all phases and iterations
+        Array<Array<int>> m_stamp;     //!< per thread
+        Array<Array<double>> m_dist;   //!< per thread
+        Array<double> m_stress;        //!< per thread
+        Array<double> m_moved;         //!< per thread
+        Array<double> m_norm;          //!< per thread
+        Array<double> m_maxMove;       //!< per thread
+    };
+
 
     void StressMinimization::call(GraphAttributes & GA)
     {
+        if(m_pMonitor != 0)
+            m_pMonitor->start();
         const Graph & G = GA.constGraph();
         // if the graph has at most one node nothing to do
         if(G.numberOfNodes() <= 1)
@@ -72,9 +550,12 @@ namespace ogdf
             OGDF_THROW(PreconditionViolatedException);
             return;
         }
-        NodeArray<NodeArray<double>> shortestPathMatrix(G);
-        NodeArray<NodeArray<double>> weightMatrix(G);
-        initMatrices(G, shortestPathMatrix, weightMatrix);
+        if(m_sparseStress)
+        {
+            callSparse(GA);
+            return;
+        }
+        DistanceMatrix<double> shortestPathMatrix;
         // if the edge costs are defined by the attribute copy it to an array and
         // construct the proper shortest path matrix
         if(m_hasEdgeCostsAttribute)
@@ -84,22 +565,39 @@ namespace ogdf
                 OGDF_THROW(PreconditionViolatedException);
                 return;
             }
-            m_avgEdgeCosts = dijkstra_SPAP(GA, shortestPathMatrix);
+            m_avgEdgeCosts = dijkstra_SPAP(GA, shortestPathMatrix, m_numberOfThreads);
             // compute shortest path all pairs
         }
         else
         {
             m_avgEdgeCosts = m_edgeCosts;
-            bfs_SPAP(G, shortestPathMatrix, m_edgeCosts);
+            bfs_SPAP(G, shortestPathMatrix, m_edgeCosts, m_numberOfThreads);
         }
-        call(GA, shortestPathMatrix, weightMatrix);
+        call(GA, shortestPathMatrix);
+    }
+
+
+    void StressMinimization::callIncremental(GraphAttributes & GA, const WarmStart & ws)
+    {
+        OGDF_ASSERT(ws.graphOf() == &GA.constGraph())
+
+        const bool hasInitialLayout = m_hasInitialLayout;
+        const int numberOfIterations = m_numberOfIterations;
+        m_hasInitialLayout = true;
+        m_numberOfIterations = ws.iterations(m_numberOfIterations);
+        m_warmStart = &ws;
+
+        call(GA);
+
+        m_warmStart = 0;
+        m_numberOfIterations = numberOfIterations;
+        m_hasInitialLayout = hasInitialLayout;
     }
 
 
     void StressMinimization::call(
         GraphAttributes & GA,
-        NodeArray<NodeArray<double>> & shortestPathMatrix,
-        NodeArray<NodeArray<double>> & weightMatrix)
+        DistanceMatrix<double> & shortestPathMatrix)
     {
         // compute the initial layout if necessary
         if(!m_hasInitialLayout)
@@ -107,18 +605,16 @@ namespace ogdf
             computeInitialLayout(GA);
         }
         const Graph & G = GA.constGraph();
-        // replace infinity distances by sqrt(n) and compute weights.
+        // replace infinity distances by sqrt(n).
         // Note isConnected is only true during calls triggered by the
         // ComponentSplitterLayout.
         if(!m_componentLayout && !isConnected(G))
         {
-            replaceInfinityDistances(G.numberOfNodes() - 1, shortestPathMatrix,
+            replaceInfinityDistances(shortestPathMatrix,
                                      m_avgEdgeCosts * sqrt((double)(G.numberOfNodes())));
         }
-        // calculate the weights
-        calcWeights(G, G.numberOfNodes() - 1, shortestPathMatrix, weightMatrix);
-        // minimize the stress
-        minimizeStress(GA, shortestPathMatrix, weightMatrix);
+        // minimize the stress; the weights w_ij = d_ij^-2 are computed on the fly
+        minimizeStress(GA, shortestPathMatrix);
     }
 
 
@@ -128,6 +624,7 @@ namespace ogdf
         pivMDS->setNumberOfPivots(DEFAULT_NUMBER_OF_PIVOTS);
         pivMDS->useEdgeCostsAttribute(m_hasEdgeCostsAttribute);
         pivMDS->setEdgeCosts(m_edgeCosts);
+        pivMDS->setNumberOfThreads(m_numberOfThreads);
         if(!m_componentLayout)
         {
             // the graph might be disconnected therefore we need
@@ -146,79 +643,51 @@ namespace ogdf
 
 
     void StressMinimization::replaceInfinityDistances(
-        const int dimension,
-        NodeArray<NodeArray<double>> & shortestPathMatrix,
+        DistanceMatrix<double> & shortestPathMatrix,
         double newVal)
     {
-        for(int i = 0; i < dimension; i++)
+        const int n = shortestPathMatrix.numberOfNodes();
+        for(int i = 0; i < n; i++)
         {
-            for(int j = i + 1; j <= dimension; j++)
+            double* row = shortestPathMatrix.row(i);
+            for(int j = 0; j < n; j++)
             {
-                if(isinf(shortestPathMatrix[i][j]))
+                if(isinf(row[j]))
                 {
-                    shortestPathMatrix[i][j] = newVal;
-                    shortestPathMatrix[j][i] = newVal;
+                    row[j] = newVal;
                 }
             }
         }
     }
 
 
-    void StressMinimization::calcWeights(
-        const Graph & G,
-        const int dimension,
-        NodeArray<NodeArray<double>> & shortestPathMatrix,
-        NodeArray<NodeArray<double>> & weightMatrix)
-    {
-        node v, w;
-        forall_nodes(v, G)
-        {
-            forall_nodes(w, G)
-            {
-                if(v != w)
-                {
-                    // w_ij = d_ij^-2
-                    weightMatrix[v][w] = 1
-                                         / (shortestPathMatrix[v][w] * shortestPathMatrix[v][w]);
-                }
-            }
-        }
-
-        /*for (int i = 0; i < dimension; i++) {
-            for (int j = i + 1; j <= dimension; j++) {
-                // w_ij = d_ij^-2
-                weightMatrix[i][j] = 1
-                        / (shortestPathMatrix[i][j] * shortestPathMatrix[i][j]);
-                weightMatrix[j][i] = weightMatrix[i][j];
-            }
-        }*/
-    }
-
-
     double StressMinimization::calcStress(
         const GraphAttributes & GA,
-        NodeArray<NodeArray<double>> & shortestPathMatrix,
-        NodeArray<NodeArray<double>> & weightMatrix)
+        const DistanceMatrix<double> & shortestPathMatrix)
     {
+        const int n = shortestPathMatrix.numberOfNodes();
+        const bool threeD = (GA.attributes() & GraphAttributes::threeD) != 0;
         double stress = 0;
-        node v;
-        node w;
-        for(v = GA.constGraph().firstNode(); v != 0; v = v->succ())
+        for(int i = 0; i < n; i++)
         {
-            for(w = v->succ(); w != 0; w = w->succ())
+            node v = shortestPathMatrix.nodeAt(i);
+            const double* row = shortestPathMatrix.row(i);
+            for(int j = i + 1; j < n; j++)
             {
+                node w = shortestPathMatrix.nodeAt(j);
                 double xDiff = GA.x(v) - GA.x(w);
                 double yDiff = GA.y(v) - GA.y(w);
                 double zDiff = 0.0;
-                if(GA.attributes() & GraphAttributes::threeD)
+                if(threeD)
                 {
                     zDiff = GA.z(v) - GA.z(w);
                 }
                 double dist = sqrt(xDiff * xDiff + yDiff * yDiff + zDiff * zDiff);
                 if(dist != 0)
                 {
-                    stress += weightMatrix[v][w] * (shortestPathMatrix[v][w] - dist)
-                              * (shortestPathMatrix[v][w] - dist);//
+                    // w_ij = d_ij^-2
+                    double diff = row[j] - dist;
+                    stress += diff * diff / (row[j] * row[j]);
                 }
             }
         }
@@ -260,8 +729,7 @@ namespace ogdf
 
     void StressMinimization::minimizeStress(
         GraphAttributes & GA,
-        NodeArray<NodeArray<double>> & shortestPathMatrix,
-        NodeArray<NodeArray<double>> & weightMatrix)
+        const DistanceMatrix<double> & shortestPathMatrix)
     {
         const Graph & G = GA.constGraph();
         int numberOfPerformedIterations = 0;
@@ -271,7 +739,7 @@ namespace ogdf
 
         if(m_terminationCriterion == STRESS)
         {
-            curStress = calcStress(GA, shortestPathMatrix, weightMatrix);
+            curStress = calcStress(GA, shortestPathMatrix);
         }
 
         NodeArray<double> newX;
@@ -285,6 +753,7 @@ namespace ogdf
             if(GA.attributes() & GraphAttributes::threeD)
                 newZ.init(G);
         }
+        bool stopped = false;
         do
         {
             if(m_terminationCriterion == POSITION_DIFFERENCE)
@@ -293,24 +762,27 @@ namespace ogdf
                     copyLayout(GA, newX, newY, newZ);
                 else copyLayout(GA, newX, newY);
             }
-            nextIteration(GA, shortestPathMatrix, weightMatrix);
+            double maxMoveSq;
+            double stress = nextIteration(GA, shortestPathMatrix, maxMoveSq);
+            if(m_pMonitor != 0)
+                stopped = m_pMonitor->report(stress, sqrt(maxMoveSq) / m_avgEdgeCosts);
             if(m_terminationCriterion == STRESS)
             {
                 prevStress = curStress;
-                curStress = calcStress(GA, shortestPathMatrix, weightMatrix);
+                curStress = calcStress(GA, shortestPathMatrix);
             }
         }
-        while(!finished(GA, ++numberOfPerformedIterations, newX, newY, prevStress, curStress));
+        while(!finished(GA, ++numberOfPerformedIterations, newX, newY, prevStress, curStress) && !stopped);
 
         Logger::slout() << "Iteration count:\t" << numberOfPerformedIterations
-                        << "\tStress:\t" << calcStress(GA, shortestPathMatrix, weightMatrix) << endl;
+                        << "\tStress:\t" << calcStress(GA, shortestPathMatrix) << endl;
     }
 
 
-    void StressMinimization::nextIteration(
+    double StressMinimization::nextIteration(
         GraphAttributes & GA,
-        NodeArray<NodeArray<double>> & shortestPathMatrix,
-        NodeArray<NodeArray<double>> & weights)
+        const DistanceMatrix<double> & shortestPathMatrix,
+        double & maxMoveSq)
     {
         double newXCoord;
         double newYCoord;
@@ -328,22 +800,27 @@ namespace ogdf
         double zDiff;
         node v;
         node w;
-        const Graph & G = GA.constGraph();
+        const int n = shortestPathMatrix.numberOfNodes();
+        double stress = 0.0;
+        maxMoveSq = 0.0;
 
-        forall_nodes(v, G)
+        for(int i = 0; i < n; i++)
         {
+            v = shortestPathMatrix.nodeAt(i);
+            const double* row = shortestPathMatrix.row(i);
             newXCoord = 0.0;
             newYCoord = 0.0;
             newZCoord = 0.0;
             double & currXCoord = GA.x(v);
             double & currYCoord = GA.y(v);
             totalWeight = 0;
-            forall_nodes(w, G)
+            for(int j = 0; j < n; j++)
             {
-                if(v == w)
+                if(i == j)
                 {
                     continue;
                 }
+                w = shortestPathMatrix.nodeAt(j);
                 // calculate euclidean distance between both points
                 xDiff = currXCoord - GA.x(w);
                 yDiff = currYCoord - GA.y(w);
@@ -351,10 +828,11 @@ namespace ogdf
                     zDiff = GA.z(v) - GA.z(w);
                 else zDiff = 0.0;
                 euclideanDist = sqrt(xDiff * xDiff + yDiff * yDiff + zDiff * zDiff);
-                // get the weight
-                weight = weights[v][w];
                 // get the desired distance
-                desDistance = shortestPathMatrix[v][w];
+                desDistance = row[j];
+                // get the weight w_ij = d_ij^-2
+                weight = 1 / (desDistance * desDistance);
+                stress += weight * (desDistance - euclideanDist) * (desDistance - euclideanDist);
                 // reset the voted x coordinate
                 voteX = 0.0;
                 // if x is not fixed
@@ -404,23 +882,32 @@ namespace ogdf
             // update the positions
             if(totalWeight != 0)
             {
+                const bool threeD = (GA.attributes() & GraphAttributes::threeD) != 0;
+                const double prevX = currXCoord, prevY = currYCoord, prevZ = threeD ? GA.z(v) : 0.0;
+                const double mobility = (m_warmStart != 0) ? m_warmStart->mobility(v) : 1.0;
                 if(!m_fixXCoords)
                 {
-                    currXCoord = newXCoord / totalWeight;
+                    currXCoord = moveTowards(currXCoord, newXCoord / totalWeight, mobility);
                 }
                 if(!m_fixYCoords)
                 {
-                    currYCoord = newYCoord / totalWeight;
+                    currYCoord = moveTowards(currYCoord, newYCoord / totalWeight, mobility);
                 }
                 if(GA.attributes() & GraphAttributes::threeD)
                 {
                     if(!m_fixZCoords)
                     {
-                        GA.z(v) = newZCoord / totalWeight;
+                        GA.z(v) = moveTowards(GA.z(v), newZCoord / totalWeight, mobility);
                     }
                 }
+                double moveSq = (currXCoord - prevX) * (currXCoord - prevX) + (currYCoord - prevY) * (currYCoord - prevY);
+                if(threeD)
+                    moveSq += (GA.z(v) - prevZ) * (GA.z(v) - prevZ);
+                maxMoveSq = max(maxMoveSq, moveSq);
             }
         }
+        // every pair has been counted twice
+        return stress / 2;
     }
 
 
@@ -466,18 +953,81 @@ namespace ogdf
     }
 
 
-    void StressMinimization::initMatrices(const Graph & G,
-                                          NodeArray<NodeArray<double>> & shortestPathMatrix,
-                                          NodeArray<NodeArray<double>> & weightMatrix)
+    void StressMinimization::callSparse(GraphAttributes & GA)
     {
-        node v;
-        // init shortest path matrix by infinity distances
-        forall_nodes(v, G)
+        const Graph & G = GA.constGraph();
+        EdgeArray<double> length(G, m_edgeCosts);
+        if(m_hasEdgeCostsAttribute)
         {
-            shortestPathMatrix[v].init(G, std::numeric_limits<double>::infinity());
-            shortestPathMatrix[v][v] = 0;
-            weightMatrix[v].init(G, 0);
+            if(!(GA.attributes() & GraphAttributes::edgeDoubleWeight))
+            {
+                OGDF_THROW(PreconditionViolatedException);
+                return;
+            }
+            m_avgEdgeCosts = 0;
+            edge e;
+            forall_edges(e, G)
+            {
+                length[e] = GA.doubleWeight(e);
+                m_avgEdgeCosts += length[e];
+            }
+            if(G.numberOfEdges() > 0)
+                m_avgEdgeCosts /= G.numberOfEdges();
         }
+        else
+        {
+            m_avgEdgeCosts = m_edgeCosts;
+        }
+
+        // compute the initial layout if necessary
+        if(!m_hasInitialLayout)
+        {
+            computeInitialLayout(GA);
+        }
+
+        const int numThreads = max(1, min(m_numberOfThreads, G.numberOfNodes() / 1000));
+        SparseStress sparse(GA, length, numThreads);
+        if(m_warmStart != 0)
+            sparse.setMobility(*m_warmStart);
+        sparse.computeNeighborhoods(m_sparseNeighborhood);
+        // distances between components as in the full model
+        sparse.computePivots(min(m_numberOfSparsePivots, G.numberOfNodes()), !m_hasEdgeCostsAttribute,
+                             m_avgEdgeCosts * sqrt((double)(G.numberOfNodes())));
+
+        const bool threeD = (GA.attributes() & GraphAttributes::threeD) != 0;
+        const bool fix[3] = { m_fixXCoords, m_fixYCoords, m_fixZCoords };
+        sparse.getPositions(threeD);
+
+        int numberOfPerformedIterations = 0;
+        double prevStress = numeric_limits<double>::max();
+        double curStress = numeric_limits<double>::max();
+        bool done = false;
+        while(!done)
+        {
+            prevStress = curStress;
+            curStress = sparse.iterate(fix);
+            ++numberOfPerformedIterations;
+
+            done = numberOfPerformedIterations == m_numberOfIterations;
+            if(m_pMonitor != 0)
+                done = m_pMonitor->report(curStress, sparse.maxMove() / m_avgEdgeCosts) || done;
+            switch(m_terminationCriterion)
+            {
+            case POSITION_DIFFERENCE:
+                done = done || sparse.relativeMove() < EPSILON;
+                break;
+            case STRESS:
+                // the stress of the previous positions is returned
+                done = done || curStress == 0 || prevStress - curStress < prevStress * EPSILON;
+                break;
+            default:
+                break;
+            }
+        }
+        sparse.setPositions(GA);
+
+        Logger::slout() << "Iteration count:\t" << numberOfPerformedIterations
+                        << "\tSparse stress:\t" << curStress << endl;
     }
 
 }
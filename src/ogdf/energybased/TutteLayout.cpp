@@ -41,18 +41,277 @@
  ***************************************************************/
 
 #include <ogdf/energybased/TutteLayout.h>
-
-
-#ifdef USE_COIN
-
 #include <ogdf/basic/Math.h>
 #include <ogdf/basic/GraphCopyAttributes.h>
 #include <ogdf/basic/extended_graph_alg.h>
+#include <ogdf/basic/Thread.h>
+#include <ogdf/basic/Barrier.h>
 
 
 namespace ogdf
 {
 
+    //---------------------------------------------------------
+    // TutteCGSolver
+    // Jacobi-preconditioned conjugate gradient method for the
+    // system (D - A) x = b with two right hand sides, where D
+    // contains the degrees and A the adjacencies of the free
+    // nodes. All vectors store x and y interleaved.
+    //---------------------------------------------------------
+
+    class TutteCGSolver
+    {
+    public:
+        TutteCGSolver(
+            const Array<int> & rowStart,
+            const Array<int> & column,
+            const Array<double> & diag,
+            const Array<double> & rhs,
+            Array<double> & coord,
+            double tolerance,
+            int maxIterations,
+            int numThreads)
+            : m_rowStart(rowStart), m_column(column), m_diag(diag), m_rhs(rhs), m_x(coord),
+              m_r(rhs.size()), m_z(rhs.size()), m_p(rhs.size()), m_q(rhs.size()),
+              m_tolerance(tolerance), m_maxIterations(maxIterations),
+              m_numThreads(numThreads), m_partial(0, 6 * numThreads - 1, 0.0),
+              m_pBarrier(numThreads > 1 ? new Barrier(numThreads) : 0),
+              m_converged(false) { }
+
+        ~TutteCGSolver()
+        {
+            delete m_pBarrier;
+        }
+
+        //! Runs the solver with all threads; returns true if it converged.
+        bool solve();
+
+    private:
+        class Worker : public Thread
+        {
+        public:
+            Worker(TutteCGSolver* pSolver, int t) : m_pSolver(pSolver), m_t(t) { }
+
+        protected:
+            void doWork()
+            {
+                m_pSolver->run(m_t);
+            }
+
+        private:
+            TutteCGSolver* m_pSolver;
+            int m_t;
+        };
+
+        const Array<int> & m_rowStart;
+        const Array<int> & m_column;
+        const Array<double> & m_diag;
+        const Array<double> & m_rhs;
+        Array<double> & m_x;
+
+        Array<double> m_r, m_z, m_p, m_q;
+
+        double m_tolerance;
+        int m_maxIterations;
+        int m_numThreads;
+
+        //! partial sums of the threads; thread t uses entries 6t,...,6t+5
+        Array<double> m_partial;
+        Barrier* m_pBarrier;
+
+        bool m_converged;
+
+        void sync()
+        {
+            if(m_pBarrier) m_pBarrier->threadSync();
+        }
+
+        //! sums up the partial sums with offset \a k (in the same order in all threads)
+        /**
+         * Offsets 0 and 2 are used for the residuals, offset 4 for p^T A p
+         * (and the right hand side initially); since p^T A p is written in
+         * a different phase, one barrier per phase suffices.
+         */
+        void sumPartial(int k, double & sx, double & sy) const
+        {
+            sx = sy = 0.0;
+            for(int t = 0; t < m_numThreads; ++t)
+            {
+                sx += m_partial[6 * t + k];
+                sy += m_partial[6 * t + k + 1];
+            }
+        }
+
+        void run(int t);
+    };
+
+
+    bool TutteCGSolver::solve()
+    {
+        Array<Worker*> worker(1, m_numThreads - 1);
+        for(int t = 1; t < m_numThreads; ++t)
+        {
+            worker[t] = new Worker(this, t);
+            worker[t]->start();
+        }
+
+        run(0);
+
+        for(int t = 1; t < m_numThreads; ++t)
+        {
+            worker[t]->join();
+            delete worker[t];
+        }
+
+        return m_converged;
+    }
+
+
+    // executed by each thread t on its range of rows; all threads take
+    // the same decisions since they compute the same global sums
+    void TutteCGSolver::run(int t)
+    {
+        const int n     = m_diag.size();
+        const int first = (int)((__int64)n * t / m_numThreads);
+        const int last  = (int)((__int64)n * (t + 1) / m_numThreads);
+        double* part = &m_partial[6 * t];
+
+        // r = b - A x, z = D^-1 r, p = z
+        double rzx = 0.0, rzy = 0.0, bbx = 0.0, bby = 0.0, rrx = 0.0, rry = 0.0;
+        for(int i = first; i < last; ++i)
+        {
+            double ax = m_diag[i] * m_x[2 * i], ay = m_diag[i] * m_x[2 * i + 1];
+            for(int k = m_rowStart[i]; k < m_rowStart[i + 1]; ++k)
+            {
+                ax -= m_x[2 * m_column[k]];
+                ay -= m_x[2 * m_column[k] + 1];
+            }
+
+            const double bx = m_rhs[2 * i], by = m_rhs[2 * i + 1];
+            const double rx = bx - ax, ry = by - ay;
+            m_r[2 * i] = rx;
+            m_r[2 * i + 1] = ry;
+            m_p[2 * i]     = m_z[2 * i]     = rx / m_diag[i];
+            m_p[2 * i + 1] = m_z[2 * i + 1] = ry / m_diag[i];
+
+            rzx += rx * m_z[2 * i];
+            rzy += ry * m_z[2 * i + 1];
+            rrx += rx * rx;
+            rry += ry * ry;
+            bbx += bx * bx;
+            bby += by * by;
+        }
+        part[0] = rzx;
+        part[1] = rzy;
+        part[2] = rrx;
+        part[3] = rry;
+        part[4] = bbx;
+        part[5] = bby;
+
+        sync();
+        sumPartial(0, rzx, rzy);
+        sumPartial(2, rrx, rry);
+        sumPartial(4, bbx, bby);
+
+        const double tol2 = m_tolerance * m_tolerance;
+        const double limitX = tol2 * max(bbx, 1.0), limitY = tol2 * max(bby, 1.0);
+
+        bool doneX = (rrx <= limitX), doneY = (rry <= limitY);
+
+        for(int it = 0; it < m_maxIterations && !(doneX && doneY); ++it)
+        {
+            sync(); // all threads have read the partial sums
+
+            // q = A p
+            double pqx = 0.0, pqy = 0.0;
+            for(int i = first; i < last; ++i)
+            {
+                double qx = m_diag[i] * m_p[2 * i], qy = m_diag[i] * m_p[2 * i + 1];
+                for(int k = m_rowStart[i]; k < m_rowStart[i + 1]; ++k)
+                {
+                    qx -= m_p[2 * m_column[k]];
+                    qy -= m_p[2 * m_column[k] + 1];
+                }
+                m_q[2 * i] = qx;
+                m_q[2 * i + 1] = qy;
+                pqx += m_p[2 * i] * qx;
+                pqy += m_p[2 * i + 1] * qy;
+            }
+            part[4] = pqx;
+            part[5] = pqy;
+
+            sync();
+            sumPartial(4, pqx, pqy);
+            const double alphaX = (doneX || pqx <= 0.0) ? 0.0 : rzx / pqx;
+            const double alphaY = (doneY || pqy <= 0.0) ? 0.0 : rzy / pqy;
+
+            // x += alpha p, r -= alpha q, z = D^-1 r
+            double rznx = 0.0, rzny = 0.0;
+            rrx = rry = 0.0;
+            for(int i = first; i < last; ++i)
+            {
+                m_x[2 * i]     += alphaX * m_p[2 * i];
+                m_x[2 * i + 1] += alphaY * m_p[2 * i + 1];
+                const double rx = (m_r[2 * i]     -= alphaX * m_q[2 * i]);
+                const double ry = (m_r[2 * i + 1] -= alphaY * m_q[2 * i + 1]);
+                m_z[2 * i]     = rx / m_diag[i];
+                m_z[2 * i + 1] = ry / m_diag[i];
+
+                rznx += rx * m_z[2 * i];
+                rzny += ry * m_z[2 * i + 1];
+                rrx  += rx * rx;
+                rry  += ry * ry;
+            }
+            part[0] = rznx;
+            part[1] = rzny;
+            part[2] = rrx;
+            part[3] = rry;
+
+            sync();
+            sumPartial(0, rznx, rzny);
+            sumPartial(2, rrx, rry);
+
+            doneX = doneX || rrx <= limitX || alphaX == 0.0;
+            doneY = doneY || rry <= limitY || alphaY == 0.0;
+
+            // p = z + beta p
+            const double betaX = (rzx > 0.0) ? rznx / rzx : 0.0;
+            const double betaY = (rzy > 0.0) ? rzny / rzy : 0.0;
+            for(int i = first; i < last; ++i)
+            {
+                m_p[2 * i]     = m_z[2 * i]     + betaX * m_p[2 * i];
+                m_p[2 * i + 1] = m_z[2 * i + 1] + betaY * m_p[2 * i + 1];
+            }
+
+            rzx = rznx;
+            rzy = rzny;
+        }
+
+        if(t == 0)
+            m_converged = doneX && doneY;
+    }
+
+
+    bool TutteLayout::solveCG(
+        const Array<int> & rowStart,
+        const Array<int> & column,
+        const Array<double> & diag,
+        const Array<double> & rhs,
+        Array<double> & coord) const
+    {
+        const int n = diag.size();
+
+        // additional threads only pay off for large systems
+        const int minRowsPerThread = 8192;
+        const int numThreads = max(1, min(m_maxThreads, n / minRowsPerThread));
+        const int maxIter = (m_maxIterations > 0) ? m_maxIterations : 2 * n + 100;
+
+        TutteCGSolver cg(rowStart, column, diag, rhs, coord, m_tolerance, maxIter, numThreads);
+        return cg.solve();
+    }
+
+
+#ifdef USE_COIN
 
     // solves a system of linear equations with a linear solver for optimization problems.
     // I'm sorry but there is no Gauss-Algorithm (or some numerical stuff) in OGDF...
@@ -96,9 +355,21 @@ namespace ogdf
     }
 
 
+#endif
+
+
     TutteLayout::TutteLayout()
     {
         m_bbox = DRect(0.0, 0.0, 250.0, 250.0);
+
+        m_solver        = stConjugateGradient;
+        m_tolerance     = 1e-8;
+        m_maxIterations = 0;
+#ifdef OGDF_MEMORY_POOL_NTS
+        m_maxThreads = 1;
+#else
+        m_maxThreads = System::numberOfProcessors();
+#endif
     }
 
 
@@ -294,7 +565,6 @@ namespace ogdf
         List<DPoint> & fixedPositions)
     {
         node v, w;
-        edge e;
 
         const Graph & G = AG.constGraph();
         GraphCopy GC(G);
@@ -334,62 +604,128 @@ namespace ogdf
         forall_listiterators(node, it, otherNodes) ind[*it] = i++;
 
         int n = otherNodes.size();           // #other nodes
-        Array<double> coord(n);              // coordinates (first x then y)
-        Array<double> rhs(n);                // right hand side
-        double oneOverD = 0.0;
-
-        CoinPackedMatrix A(false, 0, 0);     // equations
-        A.setDimensions(n, n);
+        Array<double> coord(2 * n);          // coordinates (x and y interleaved)
+        bool solved = false;
 
-        // initialize non-zero entries in matrix A
-        forall_listiterators(node, it, otherNodes)
+        if(m_solver == stConjugateGradient)
         {
-            oneOverD = (double)(1.0 / ((*it)->degree()));
-            forall_adj_edges(e, *it)
+            // build the system in compressed sparse row format:
+            // deg(v) * v - sum of free neighbors w = sum of fixed neighbors w
+            Array<int> rowStart(n + 1);
+            ArrayBuffer<int> column(2 * GC.numberOfEdges());
+            Array<double> diag(n);
+            Array<double> rhs(0, 2 * n - 1, 0.0);
+
+            forall_listiterators(node, it, otherNodes)
             {
-                // get second node of e
-                w = (*it == e->source()) ? e->target() : e->source();
-                if(!fixed[w])
+                const int i = ind[*it];
+                rowStart[i] = column.size();
+
+                int deg = 0;
+                adjEntry adj;
+                forall_adj(adj, *it)
                 {
-                    A.modifyCoefficient(ind[*it], ind[w], oneOverD);
+                    w = adj->twinNode();
+                    if(w == *it) continue; // self-loops do not contribute
+
+                    ++deg;
+                    if(fixed[w])
+                    {
+                        rhs[2 * i]     += AGC.x(w);
+                        rhs[2 * i + 1] += AGC.y(w);
+                    }
+                    else
+                        column.push(ind[w]);
                 }
+
+                // isolated nodes are placed at the origin
+                diag[i] = (deg > 0) ? deg : 1;
+
+                coord[2 * i] = coord[2 * i + 1] = 0.0;
+            }
+            rowStart[n] = column.size();
+
+            Array<int> columnArray;
+            column.compactCopy(columnArray);
+
+            solved = solveCG(rowStart, columnArray, diag, rhs, coord);
+
+            forall_listiterators(node, it, otherNodes)
+            {
+                AGC.x(*it) = coord[2 * ind[*it]];
+                AGC.y(*it) = coord[2 * ind[*it] + 1];
             }
-            A.modifyCoefficient(ind[*it], ind[*it], -1);
         }
 
-        // compute right hand side for x coordinates
-        forall_listiterators(node, it, otherNodes)
+        // fall back to the LP solver
+        if(!solved)
         {
-            rhs[ind[*it]] = 0;
-            oneOverD = (double)(1.0 / ((*it)->degree()));
-            forall_adj_edges(e, *it)
+#ifdef USE_COIN
+            edge e;
+            Array<double> rhs(n);                // right hand side
+            double oneOverD = 0.0;
+
+            CoinPackedMatrix A(false, 0, 0);     // equations
+            A.setDimensions(n, n);
+
+            // initialize non-zero entries in matrix A
+            forall_listiterators(node, it, otherNodes)
             {
-                // get second node of e
-                w = (*it == e->source()) ? e->target() : e->source();
-                if(fixed[w]) rhs[ind[*it]] -= (oneOverD * AGC.x(w));
+                oneOverD = (double)(1.0 / ((*it)->degree()));
+                forall_adj_edges(e, *it)
+                {
+                    // get second node of e
+                    w = (*it == e->source()) ? e->target() : e->source();
+                    if(!fixed[w])
+                    {
+                        A.modifyCoefficient(ind[*it], ind[w], oneOverD);
+                    }
+                }
+                A.modifyCoefficient(ind[*it], ind[*it], -1);
             }
-        }
 
-        // compute x coordinates
-        if(!(solveLP(n, A, rhs, coord))) return false;
-        forall_listiterators(node, it, otherNodes) AGC.x(*it) = coord[ind[*it]];
+            // compute right hand side for x coordinates
+            forall_listiterators(node, it, otherNodes)
+            {
+                rhs[ind[*it]] = 0;
+                oneOverD = (double)(1.0 / ((*it)->degree()));
+                forall_adj_edges(e, *it)
+                {
+                    // get second node of e
+                    w = (*it == e->source()) ? e->target() : e->source();
+                    if(fixed[w]) rhs[ind[*it]] -= (oneOverD * AGC.x(w));
+                }
+            }
 
-        // compute right hand side for y coordinates
-        forall_listiterators(node, it, otherNodes)
-        {
-            rhs[ind[*it]] = 0;
-            oneOverD = (double)(1.0 / ((*it)->degree()));
-            forall_adj_edges(e, *it)
+            // compute x coordinates
+            if(!(solveLP(n, A, rhs, coord))) return false;
+            forall_listiterators(node, it, otherNodes) AGC.x(*it) = coord[ind[*it]];
+
+            // compute right hand side for y coordinates
+            forall_listiterators(node, it, otherNodes)
             {
-                // get second node of e
-                w = (*it == e->source()) ? e->target() : e->source();
-                if(fixed[w]) rhs[ind[*it]] -= (oneOverD * AGC.y(w));
+                rhs[ind[*it]] = 0;
+                oneOverD = (double)(1.0 / ((*it)->degree()));
+                forall_adj_edges(e, *it)
+                {
+                    // get second node of e
+                    w = (*it == e->source()) ? e->target() : e->source();
+                    if(fixed[w]) rhs[ind[*it]] -= (oneOverD * AGC.y(w));
+                }
             }
-        }
 
-        // compute y coordinates
-        if(!(solveLP(n, A, rhs, coord))) return false;
-        forall_listiterators(node, it, otherNodes) AGC.y(*it) = coord[ind[*it]];
+            // compute y coordinates
+            if(!(solveLP(n, A, rhs, coord))) return false;
+            forall_listiterators(node, it, otherNodes) AGC.y(*it) = coord[ind[*it]];
+
+            solved = true;
+#else
+            // without COIN, the input coordinates are left unchanged
+            if(m_solver == stLP)
+                THROW_NO_COIN_EXCEPTION;
+            return false;
+#endif
+        }
 
         // translate coordinates, such that the center lies in
         // the center of the bounding box
@@ -407,8 +743,7 @@ namespace ogdf
             AG.y(GC.original(v)) = AGC.y(v);
         }
 
-        return true;
+        return solved;
     }
-} // end namespace ogdf
 
-#endif
+} // end namespace ogdf
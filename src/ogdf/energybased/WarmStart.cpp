@@ -0,0 +1,257 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Implementation of class WarmStart.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#include <ogdf/energybased/WarmStart.h>
+#include <ogdf/basic/ArrayBuffer.h>
+#include <ogdf/basic/Queue.h>
+
+
+namespace ogdf
+{
+
+    //! Appends the neighbors of \a v that are neither placed nor queued to \a queue.
+    static void queueNeighbors(node v, const NodeArray<bool> & placed, NodeArray<bool> & queued, Queue<node> & queue)
+    {
+        adjEntry adj;
+        forall_adj(adj, v)
+        {
+            node w = adj->twinNode();
+            if(!placed[w] && !queued[w])
+            {
+                queued[w] = true;
+                queue.append(w);
+            }
+        }
+    }
+
+
+    WarmStart::WarmStart()
+    {
+        m_regionRadius = 2;
+        m_frozenMobility = 0.1;
+        m_iterationFraction = 0.2;
+        m_numberOfAffectedNodes = 0;
+    }
+
+
+    int WarmStart::iterations(int fullIterations) const
+    {
+        return max(1, int(ceil(fullIterations * m_iterationFraction)));
+    }
+
+
+    void WarmStart::init(GraphAttributes & GA, const NodeArray<bool> & newNode)
+    {
+        placeNewNodes(GA, newNode);
+        markAffectedRegion(GA.constGraph(), newNode, 0);
+    }
+
+
+    void WarmStart::init(GraphAttributes & GA, const NodeArray<bool> & newNode, const NodeArray<bool> & changed)
+    {
+        placeNewNodes(GA, newNode);
+        markAffectedRegion(GA.constGraph(), newNode, &changed);
+    }
+
+
+    void WarmStart::placeNewNodes(GraphAttributes & GA, const NodeArray<bool> & newNode)
+    {
+        const Graph & G = GA.constGraph();
+        NodeArray<bool> placed(G);
+        ArrayBuffer<node> pending;
+
+        // the bounding box of the previous layout
+        double maxX = 0, minY = 0, maxY = 0;
+        bool first = true;
+        node v;
+        forall_nodes(v, G)
+        {
+            placed[v] = !newNode[v];
+            if(newNode[v])
+                pending.push(v);
+            else if(first)
+            {
+                maxX = GA.x(v);
+                minY = maxY = GA.y(v);
+                first = false;
+            }
+            else
+            {
+                maxX = max(maxX, GA.x(v));
+                minY = min(minY, GA.y(v));
+                maxY = max(maxY, GA.y(v));
+            }
+        }
+        if(pending.empty())
+            return;
+
+        // new nodes are placed relative to the average length of the old edges
+        double length = 0;
+        int numberOfOldEdges = 0;
+        edge e;
+        forall_edges(e, G)
+        {
+            if(placed[e->source()] && placed[e->target()])
+            {
+                double dx = GA.x(e->source()) - GA.x(e->target());
+                double dy = GA.y(e->source()) - GA.y(e->target());
+                length += sqrt(dx * dx + dy * dy);
+                ++numberOfOldEdges;
+            }
+        }
+        if(numberOfOldEdges > 0 && length > 0)
+            length /= numberOfOldEdges;
+        else
+        {
+            double w = LayoutStandards::defaultNodeWidth();
+            double h = LayoutStandards::defaultNodeHeight();
+            length = LayoutStandards::defaultNodeSeparation() + sqrt(w * w + h * h);
+        }
+        if(first)
+            maxX = -length;
+
+        // In every round, the new nodes with placed neighbors are moved to the
+        // barycenter of these neighbors; the random offset separates nodes with
+        // the same neighbors. A node is queued for the next round as soon as a
+        // neighbor has been placed, so every node and edge is handled a constant
+        // number of times. If no node is queued, the next unplaced new node starts
+        // a new component to the right of the drawing.
+        NodeArray<bool> queued(G, false);
+        Queue<node> queue;
+        forall_nodes(v, G)
+            if(placed[v])
+                queueNeighbors(v, placed, queued, queue);
+
+        ArrayBuffer<node> round;
+        int nextSeed = 0;
+        for(;;)
+        {
+            if(queue.empty())
+            {
+                while(nextSeed < pending.size() && placed[pending[nextSeed]])
+                    ++nextSeed;
+                if(nextSeed == pending.size())
+                    break;
+
+                v = pending[nextSeed];
+                maxX += length;
+                GA.x(v) = maxX;
+                GA.y(v) = (minY + maxY) / 2;
+                placed[v] = true;
+                queueNeighbors(v, placed, queued, queue);
+                continue;
+            }
+
+            round.clear();
+            while(!queue.empty())
+            {
+                v = queue.pop();
+                double x = 0, y = 0;
+                int count = 0;
+                adjEntry adj;
+                forall_adj(adj, v)
+                {
+                    node w = adj->twinNode();
+                    if(placed[w])
+                    {
+                        x += GA.x(w);
+                        y += GA.y(w);
+                        ++count;
+                    }
+                }
+                GA.x(v) = x / count + randomDouble(-0.25, 0.25) * length;
+                GA.y(v) = y / count + randomDouble(-0.25, 0.25) * length;
+                round.push(v);
+            }
+
+            for(int i = 0; i < round.size(); ++i)
+            {
+                placed[round[i]] = true;
+                maxX = max(maxX, GA.x(round[i]));
+            }
+            for(int i = 0; i < round.size(); ++i)
+                queueNeighbors(round[i], placed, queued, queue);
+        }
+    }
+
+
+    void WarmStart::markAffectedRegion(const Graph & G, const NodeArray<bool> & newNode, const NodeArray<bool>* pChanged)
+    {
+        m_affected.init(G, false);
+        m_numberOfAffectedNodes = 0;
+
+        // breadth first search from all new and changed nodes
+        ArrayBuffer<node> frontier, next;
+        node v;
+        forall_nodes(v, G)
+        {
+            if(newNode[v] || (pChanged != 0 && (*pChanged)[v]))
+            {
+                m_affected[v] = true;
+                ++m_numberOfAffectedNodes;
+                frontier.push(v);
+            }
+        }
+
+        for(int hop = 0; hop < m_regionRadius && !frontier.empty(); ++hop)
+        {
+            next.clear();
+            for(int i = 0; i < frontier.size(); ++i)
+            {
+                adjEntry adj;
+                forall_adj(adj, frontier[i])
+                {
+                    node w = adj->twinNode();
+                    if(!m_affected[w])
+                    {
+                        m_affected[w] = true;
+                        ++m_numberOfAffectedNodes;
+                        next.push(w);
+                    }
+                }
+            }
+            frontier.clear();
+            for(int i = 0; i < next.size(); ++i)
+                frontier.push(next[i]);
+        }
+    }
+
+} // end namespace ogdf
@@ -41,6 +41,7 @@
  ***************************************************************/
 
 #include <ogdf/energybased/multilevelmixer/EdgeCoverMerger.h>
+#include <ogdf/internal/energybased/ParallelCoarsening.h>
 
 namespace ogdf
 {
@@ -64,34 +65,25 @@ namespace ogdf
         }
 
         NodeArray<bool> nodeMarks(G, false);
-        std::vector<edge> untouchedEdges;
         std::vector<edge> matching;
         std::vector<edge> edgeCover;
         std::vector<edge> rest;
+
+        // maximal matching with random priorities (computed in parallel)
+        NodeArray<edge> mate;
+        ParallelCoarsening::matching(G, mate, levelSeed(level), m_numThreads);
         edge e;
         forall_edges(e, G)
         {
-            untouchedEdges.push_back(e);
-        }
-
-        while(!untouchedEdges.empty())
-        {
-            int rndIndex = randomNumber(0, (int)untouchedEdges.size() - 1);
-            edge randomEdge = untouchedEdges[rndIndex];
-            untouchedEdges[rndIndex] = untouchedEdges.back();
-            untouchedEdges.pop_back();
-
-            node one = randomEdge->source();
-            node two = randomEdge->target();
-            if(!nodeMarks[one] && !nodeMarks[two])
+            if(mate[e->source()] == e)
             {
-                matching.push_back(randomEdge);
-                nodeMarks[one] = true;
-                nodeMarks[two] = true;
+                matching.push_back(e);
+                nodeMarks[e->source()] = true;
+                nodeMarks[e->target()] = true;
             }
             else
             {
-                rest.push_back(randomEdge);
+                rest.push_back(e);
             }
         }
 
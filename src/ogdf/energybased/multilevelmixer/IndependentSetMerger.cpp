@@ -41,10 +41,18 @@
  ***************************************************************/
 
 #include <ogdf/energybased/multilevelmixer/IndependentSetMerger.h>
+#include <ogdf/internal/energybased/ParallelCoarsening.h>
+#include <algorithm>
 
 namespace ogdf
 {
 
+    static bool compareRoots(const std::pair<int, node> & a, const std::pair<int, node> & b)
+    {
+        return a.first < b.first;
+    }
+
+
     IndependentSetMerger::IndependentSetMerger()
         : m_base(2.f)
     {
@@ -59,31 +67,16 @@ namespace ogdf
         std::vector<std::vector<node>> levelNodes;
         Graph & G = MLG.getGraph();
 
-        // calc MIS
-        NodeArray<bool> nodeMarks(G, false);
-        std::vector<node> IScandidates;
+        // calc MIS (with random priorities, computed in parallel)
+        NodeArray<bool> inMIS;
+        ParallelCoarsening::independentSet(G, inMIS, 1, levelSeed(0), m_numThreads);
+        levelNodes.push_back(std::vector<node>());
         node v;
         forall_nodes(v, G)
         {
-            IScandidates.push_back(v);
-        }
-        levelNodes.push_back(std::vector<node>());
-        while(!IScandidates.empty())
-        {
-            // select random node
-            int index = randomNumber(0, (int)IScandidates.size() - 1);
-            node ISnode = IScandidates[index];
-            IScandidates[index] = IScandidates.back();
-            IScandidates.pop_back();
-
-            if(!nodeMarks[ISnode])
+            if(inMIS[v])
             {
-                adjEntry adj;
-                forall_adj(adj, ISnode)
-                {
-                    nodeMarks[adj->twinNode()] = true;
-                }
-                levelNodes[0].push_back(ISnode);
+                levelNodes[0].push_back(v);
             }
         }
 
@@ -192,13 +185,7 @@ namespace ogdf
             return false;
         }
 
-        std::map<node, node> parents;
-        node v;
-        forall_nodes(v, G)
-        {
-            parents[v] = 0;
-        }
-
+        NodeArray<node> parents(G, 0);
         std::vector<node> mergeOrder;
         NodeArray<bool> seen(G, false);
         std::vector<node> stacks[2];
@@ -238,25 +225,26 @@ namespace ogdf
             }
         }
 
+        // merges into the same parent are collapsed consecutively
+        std::vector<std::pair<int, node>> rootOrder;
         for(std::vector<node>::iterator i = mergeOrder.begin(); i != mergeOrder.end(); i++)
         {
-            node mergeNode = *i;
-            node parent = mergeNode;
+            node parent = *i;
             while(parents[parent] != parent)
             {
                 parent = parents[parent];
             }
+            rootOrder.push_back(std::pair<int, node>(parent->index(), *i));
+        }
+        std::stable_sort(rootOrder.begin(), rootOrder.end(), compareRoots);
 
-            NodeMerge* NM = new NodeMerge(level);
-            bool ret = MLG.changeNode(NM, parent, MLG.radius(parent), mergeNode);
-            OGDF_ASSERT(ret);
-            MLG.moveEdgesToParent(NM, mergeNode, parent, true, m_adjustEdgeLengths);
-            ret = MLG.postMerge(NM, mergeNode);
-            if(!ret)
-            {
-                delete NM;
-            }
+        std::vector<NodeCollapse> merges;
+        for(std::vector<std::pair<int, node>>::iterator i = rootOrder.begin(); i != rootOrder.end(); i++)
+        {
+            node parent = MLG.getNode(i->first);
+            merges.push_back(NodeCollapse(i->second, parent, MLG.radius(parent), new NodeMerge(level)));
         }
+        MLG.collapse(merges, m_adjustEdgeLengths);
 
         return true;
     }
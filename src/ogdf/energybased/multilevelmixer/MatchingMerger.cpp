@@ -41,6 +41,7 @@
  ***************************************************************/
 
 #include <ogdf/energybased/multilevelmixer/MatchingMerger.h>
+#include <ogdf/internal/energybased/ParallelCoarsening.h>
 
 namespace ogdf
 {
@@ -67,90 +68,46 @@ namespace ogdf
             return false;
         }
 
-        NodeArray<bool> nodeMarks(G, false);
-        std::vector<edge> matching;
-        std::vector<node> candidates;
-
-        node v;
-        forall_nodes(v, G)
-        {
-            candidates.push_back(v);
-        }
-
-        while(!candidates.empty())
+        // maximal matching with random priorities (computed in parallel);
+        // if selected by mass, edges between light nodes are preferred
+        EdgeArray<double> mergedMass;
+        edge e;
+        if(m_selectByMass)
         {
-            int rndIndex = randomNumber(0, (int)candidates.size() - 1);
-            node one = candidates[rndIndex];
-            candidates[rndIndex] = candidates.back();
-            candidates.pop_back();
-
-            if(nodeMarks[one])
+            mergedMass.init(G);
+            forall_edges(e, G)
             {
-                continue;
+                mergedMass[e] = double(m_mass[e->source()]) + double(m_mass[e->target()]);
             }
-            nodeMarks[one] = true;
+        }
+        NodeArray<edge> mate;
+        ParallelCoarsening::matching(G, mate, levelSeed(level), m_numThreads, m_selectByMass ? &mergedMass : 0);
 
-            std::vector<node> candNeighbors;
-            std::vector<edge> candEdges;
-            adjEntry adj;
-            unsigned int minMass = numeric_limits<unsigned int>::max();
-            forall_adj(adj, one)
-            {
-                node cand = adj->twinNode();
-                if(!nodeMarks[cand] && (!m_selectByMass || m_mass[cand] <= minMass))
-                {
-                    if(m_selectByMass && m_mass[cand] < minMass)
-                    {
-                        minMass = m_mass[cand];
-                        candNeighbors.clear();
-                        candEdges.clear();
-                    }
-                    candNeighbors.push_back(cand);
-                    candEdges.push_back(adj->theEdge());
-                }
-            }
-            if(candNeighbors.empty())
+        std::vector<NodeCollapse> merges;
+        forall_edges(e, G)
+        {
+            if(mate[e->source()] != e)
             {
                 continue;
             }
-            int index = randomNumber(0, int(candNeighbors.size()) - 1);
-            nodeMarks[candNeighbors[index]] = true;
-            matching.push_back(candEdges[index]);
-        }
-
-        while(!matching.empty())
-        {
-            edge matchingEdge = matching.back();
-            matching.pop_back();
-
-            node mergeNode;
-            node parent;
 
             // choose high degree node as parent!
-            mergeNode = matchingEdge->source();
-            parent = matchingEdge->target();
+            node mergeNode = e->source();
+            node parent = e->target();
             if(mergeNode->degree() > parent->degree())
             {
-                mergeNode = matchingEdge->target();
-                parent = matchingEdge->source();
+                mergeNode = e->target();
+                parent = e->source();
             }
 
-            NodeMerge* NM = new NodeMerge(level);
-            bool ret = MLG.changeNode(NM, parent, MLG.radius(parent), mergeNode);
-            OGDF_ASSERT(ret);
             if(m_selectByMass)
             {
                 m_mass[parent] = m_mass[parent] + m_mass[mergeNode];
             }
-            MLG.moveEdgesToParent(NM, mergeNode, parent, true, m_adjustEdgeLengths);
-            ret = MLG.postMerge(NM, mergeNode);
-            if(!ret)
-            {
-                delete NM;
-            }
+            merges.push_back(NodeCollapse(mergeNode, parent, MLG.radius(parent), new NodeMerge(level)));
         }
 
-        return true;
+        return MLG.collapse(merges, m_adjustEdgeLengths) > 0;
     }
 
 
@@ -47,6 +47,7 @@
 #include <ogdf/energybased/multilevelmixer/BarycenterPlacer.h>
 #include <ogdf/energybased/FastMultipoleEmbedder.h>
 #include <ogdf/energybased/SpringEmbedderFR.h>
+#include <ogdf/basic/Stopwatch.h>
 #include <time.h>
 
 #ifdef OGDF_MMM_LEVEL_OUTPUTS
@@ -89,6 +90,15 @@ namespace ogdf
 
         m_errorCode = ercNone;
         clock_t time = clock();
+        StopwatchWallClock watch;
+        watch.start();
+        const int finestNodes = G.numberOfNodes();
+
+        // the measured throughput of the one-level and the final layout calls (for the time limit)
+        double layoutSeconds = 0;
+        double layoutNodes = 0;
+        double finalSeconds = 0;
+        double finalNodes = 0;
         if((m_multilevelBuilder.valid() == false || m_initialPlacement.valid() == false) && m_oneLevelLayoutModule.valid() == false)
         {
             OGDF_THROW(AlgorithmFailureException);
@@ -143,9 +153,25 @@ namespace ogdf
             {
                 if(m_oneLevelLayoutModule.valid())
                 {
-                    for(int i = 1; i <= m_times; i++)
+                    int times = m_times;
+                    if(isTimeLimit())
+                    {
+                        double remaining = m_timeLimit - watch.milliSeconds() / 1000.0;
+                        double levelPerNode = (layoutNodes > 0) ? layoutSeconds / layoutNodes : -1;
+                        double finalPerNode = levelPerNode;
+                        if(m_finalLayoutModule.valid())
+                            finalPerNode = (finalNodes > 0) ? finalSeconds / finalNodes : -1;
+                        times = repeatsWithinTimeLimit(G.numberOfNodes(), MLG.getLevel(), finestNodes,
+                                                       remaining, levelPerNode, finalPerNode);
+                        if(times == 0 && m_times > 0)
+                            m_errorCode = ercTimeLimit;
+                    }
+                    for(int i = 1; i <= times; i++)
                     {
+                        __int64 t = watch.milliSeconds();
                         m_oneLevelLayoutModule.get().call(MLG.getGraphAttributes());
+                        layoutSeconds += (watch.milliSeconds() - t) / 1000.0;
+                        layoutNodes += G.numberOfNodes();
                     }
                 }
 
@@ -181,9 +207,39 @@ namespace ogdf
         {
             LayoutModule & lastLayoutModule = (m_finalLayoutModule.valid() != 0 ? m_finalLayoutModule.get() : m_oneLevelLayoutModule.get());
 
+            // with a time limit, the calls are decided one by one to use up the remaining time
             for(int i = 1; i <= m_times; i++)
             {
+                if(isTimeLimit())
+                {
+                    double remaining = m_timeLimit - watch.milliSeconds() / 1000.0;
+                    double finalPerNode = -1;
+                    if(m_finalLayoutModule.valid())
+                    {
+                        if(finalNodes > 0)
+                            finalPerNode = finalSeconds / finalNodes;
+                    }
+                    else if(layoutNodes > 0)
+                        finalPerNode = layoutSeconds / layoutNodes;
+                    if(repeatsWithinTimeLimit(G.numberOfNodes(), 0, finestNodes, remaining, finalPerNode, finalPerNode) == 0)
+                    {
+                        if(i == 1)
+                            m_errorCode = ercTimeLimit;
+                        break;
+                    }
+                }
+                __int64 t = watch.milliSeconds();
                 lastLayoutModule.call(MLG.getGraphAttributes());
+                if(m_finalLayoutModule.valid())
+                {
+                    finalSeconds += (watch.milliSeconds() - t) / 1000.0;
+                    finalNodes += G.numberOfNodes();
+                }
+                else
+                {
+                    layoutSeconds += (watch.milliSeconds() - t) / 1000.0;
+                    layoutNodes += G.numberOfNodes();
+                }
             }
         }
 
@@ -191,4 +247,45 @@ namespace ogdf
     }
 
 
+    int ModularMultilevelMixer::repeatsWithinTimeLimit(
+        int n,
+        int level,
+        int finestNodes,
+        double remaining,
+        double levelSecondsPerNode,
+        double finalSecondsPerNode) const
+    {
+        if(remaining <= 0)
+            return 0;
+
+        // without measurements, a single call determines the throughput
+        const double secondsPerNode = (level > 0) ? levelSecondsPerNode : finalSecondsPerNode;
+        if(secondsPerNode < 0)
+            return min(1, m_times);
+
+        // a level gets a call whenever a single call fits into the remaining time
+        const double secondsPerCall = n * secondsPerNode;
+        if(secondsPerCall > remaining)
+            return 0;
+        if(level == 0)
+            return int(min(double(m_times), max(1.0, floor(remaining / secondsPerCall))));
+
+        // the numbers of nodes of this and the finer intermediate levels are
+        // estimated by a geometric series from n up to the number of nodes of
+        // the finest level, whose layout is estimated separately
+        double work = double(n) * level;
+        if(finestNodes > n)
+        {
+            double ratio = pow(double(finestNodes) / n, 1.0 / level);
+            work = (finestNodes - n) / (ratio - 1);
+        }
+        if(finalSecondsPerNode < 0)
+            finalSecondsPerNode = levelSecondsPerNode;
+        double secondsPerRound = work * levelSecondsPerNode + finestNodes * finalSecondsPerNode;
+        if(secondsPerRound <= 0)
+            return m_times;
+        return int(min(double(m_times), max(1.0, floor(remaining / secondsPerRound))));
+    }
+
+
 } // namespace ogdf
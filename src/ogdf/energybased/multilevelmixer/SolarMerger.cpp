@@ -41,6 +41,7 @@
  ***************************************************************/
 
 #include <ogdf/energybased/multilevelmixer/SolarMerger.h>
+#include <ogdf/internal/energybased/ParallelCoarsening.h>
 
 namespace ogdf
 {
@@ -63,159 +64,69 @@ namespace ogdf
     }
 
 
-    std::vector<node> SolarMerger::selectSuns(MultilevelGraph & MLG)
+    std::vector<node> SolarMerger::selectSuns(MultilevelGraph & MLG, __uint32 seed)
     {
         Graph & G = MLG.getGraph();
         std::vector<node> suns;
-        std::vector<node> candidates;
 
+        // suns are a maximal set of nodes with pairwise distance at least 3 (computed in
+        // parallel); if not simple, suns with a small system mass are preferred
+        NodeArray<double> systemMass;
         node v;
-        forall_nodes(v, G)
+        if(!m_sunSelectionSimple)
         {
-            candidates.push_back(v);
+            systemMass.init(G);
+            forall_nodes(v, G)
+            {
+                systemMass[v] = calcSystemMass(v);
+            }
         }
+        NodeArray<bool> isSun;
+        ParallelCoarsening::independentSet(G, isSun, 2, seed, m_numThreads, m_sunSelectionSimple ? 0 : &systemMass);
 
-        if(m_sunSelectionSimple)
+        forall_nodes(v, G)
         {
-            while(!candidates.empty())
+            if(!isSun[v])
             {
-                // select random node
-                int index = randomNumber(0, (int)candidates.size() - 1);
-                node sun = candidates[index];
-                candidates[index] = candidates.back();
-                candidates.pop_back();
-                if(m_celestial[sun] != 0)
-                {
-                    continue;
-                }
-                bool hasForeignPlanet = false;
-                adjEntry adj;
-                forall_adj(adj, sun)
-                {
-                    if(m_celestial[adj->twinNode()] != 0)
-                    {
-                        hasForeignPlanet = true;
-                        break;
-                    }
-                }
-                if(hasForeignPlanet)
-                {
-                    continue;
-                }
-                // mark node as sun
-                m_celestial[sun] = 1;
-                suns.push_back(sun);
-                // mark neighbours as planet
-                forall_adj(adj, sun)
-                {
-                    m_celestial[adj->twinNode()] = 2;
-                    m_orbitalCenter[adj->twinNode()] = sun;
-                    m_distanceToOrbit[adj->twinNode()] = MLG.weight(adj->theEdge());
-                }
+                continue;
             }
-        }
-        else
-        {
-            while(!candidates.empty())
+            // mark node as sun
+            m_celestial[v] = 1;
+            suns.push_back(v);
+            // mark neighbours as planet
+            adjEntry adj;
+            forall_adj(adj, v)
             {
-                std::vector<std::pair<node, int>> sunCandidates;
-                int i = 1;
-                int n = 10;
-                while(i <= n && !candidates.empty())
-                {
-                    // select random node
-                    int index = randomNumber(0, (int)candidates.size() - 1);
-                    node rndNode = candidates[index];
-                    candidates[index] = candidates.back();
-                    candidates.pop_back();
-                    if(m_celestial[rndNode] != 0)
-                    {
-                        continue;
-                    }
-                    bool hasForeignPlanet = false;
-                    adjEntry adj;
-                    forall_adj(adj, rndNode)
-                    {
-                        if(m_celestial[adj->twinNode()] != 0)
-                        {
-                            hasForeignPlanet = true;
-                            break;
-                        }
-                    }
-                    if(hasForeignPlanet)
-                    {
-                        continue;
-                    }
-                    unsigned int mass = calcSystemMass(rndNode);
-                    sunCandidates.push_back(std::pair<node, int>(rndNode, mass));
-                    i++;
-                }
-                if(sunCandidates.empty())
-                {
-                    continue;
-                }
-
-                node minNode = sunCandidates.front().first;
-                unsigned int minMass = sunCandidates.front().second;
-                // select sun with smalles mass from sunCandidates
-                for(std::vector<std::pair<node, int>>::iterator i = sunCandidates.begin();
-                        i != sunCandidates.end(); i++)
-                {
-                    node nod = (*i).first;
-                    unsigned int mass = (*i).second;
-                    if(mass < minMass)
-                    {
-                        minMass = mass;
-                        minNode = nod;
-                    }
-                }
-
-                for(std::vector<std::pair<node, int>>::iterator i = sunCandidates.begin();
-                        i != sunCandidates.end(); i++)
-                {
-                    node temp = (*i).first;
-                    if(temp == minNode)
-                    {
-                        continue;
-                    }
-                    candidates.push_back(temp);
-                }
-
-                // mark node as sun
-                m_celestial[minNode] = 1;
-                suns.push_back(minNode);
-                // mark neighbours as planet
-                adjEntry adj;
-                forall_adj(adj, minNode)
-                {
-                    m_celestial[adj->twinNode()] = 2;
-                    m_orbitalCenter[adj->twinNode()] = minNode;
-                    m_distanceToOrbit[adj->twinNode()] = MLG.weight(adj->theEdge());
-                }
+                m_celestial[adj->twinNode()] = 2;
+                m_orbitalCenter[adj->twinNode()] = v;
+                m_distanceToOrbit[adj->twinNode()] = MLG.weight(adj->theEdge());
             }
         }
 
+        // every other node is a moon of the adjacent planet with the smallest priority
         forall_nodes(v, G)
         {
             if(m_celestial[v] == 0)
             {
                 m_celestial[v] = 3;
                 adjEntry adj;
-                std::vector<adjEntry> planets;
-                node planet;
+                adjEntry planetAdj = 0;
+                __uint32 minPriority = 0;
                 forall_adj(adj, v)
                 {
-                    planet = adj->twinNode();
-                    if(m_celestial[planet] == 2)
+                    if(m_celestial[adj->twinNode()] == 2)
                     {
-                        planets.push_back(adj);
+                        __uint32 priority = ParallelCoarsening::priority(seed, adj->theEdge()->index());
+                        if(planetAdj == 0 || priority < minPriority)
+                        {
+                            planetAdj = adj;
+                            minPriority = priority;
+                        }
                     }
                 }
-                OGDF_ASSERT(planets.size() > 0);
-                int index = randomNumber(0, (int)planets.size() - 1);
-                planet = planets[index]->twinNode();
-                m_orbitalCenter[v] = planet;
-                m_distanceToOrbit[v] = MLG.weight(planets[index]->theEdge());
+                OGDF_ASSERT(planetAdj != 0);
+                m_orbitalCenter[v] = planetAdj->twinNode();
+                m_distanceToOrbit[v] = MLG.weight(planetAdj->theEdge());
             }
         }
 
@@ -372,7 +283,7 @@ namespace ogdf
         m_celestial.init(G, 0);
         m_interSystemPaths.clear();
 
-        std::vector<node> suns = selectSuns(MLG);
+        std::vector<node> suns = selectSuns(MLG, levelSeed(level));
 
         if(suns.empty())
         {
@@ -381,13 +292,19 @@ namespace ogdf
 
         findInterSystemPaths(G, MLG);
 
+        std::vector<NodeCollapse> merges;
         for(std::vector<node>::iterator i = suns.begin(); i != suns.end(); i++)
         {
-            if(!collapsSolarSystem(MLG, *i, level))
+            if(!collapsSolarSystem(MLG, *i, level, merges))
             {
+                MLG.collapse(merges, m_adjustEdgeLengths);
                 return false;
             }
         }
+        if(MLG.collapse(merges, m_adjustEdgeLengths) == 0)
+        {
+            return false;
+        }
 
         NodeMerge* lastMerge = MLG.getLastMerge();
         edge e;
@@ -415,10 +332,8 @@ namespace ogdf
     }
 
 
-    bool SolarMerger::collapsSolarSystem(MultilevelGraph & MLG, node sun, int level)
+    bool SolarMerger::collapsSolarSystem(MultilevelGraph & MLG, node sun, int level, std::vector<NodeCollapse> & merges)
     {
-        bool retVal = false;
-
         std::vector<node> systemNodes;
         unsigned int mass = 0;
         if(m_massAsNodeRadius || !m_sunSelectionSimple)
@@ -463,46 +378,24 @@ namespace ogdf
             m_mass[sun] = mass;
         }
 
-        for(std::vector<node>::iterator i = systemNodes.begin(); i != systemNodes.end(); i++)
+        double radius = MLG.radius(sun);
+        if(m_massAsNodeRadius)
         {
-            node mergeNode = *i;
-
-            if(MLG.getNode(sun->index()) != sun
-                    || MLG.getNode(mergeNode->index()) != mergeNode)
-            {
-                return false;
-            }
+            radius = sqrt((float)m_mass[sun]) * m_radius[sun];
+        }
 
+        for(std::vector<node>::iterator i = systemNodes.begin(); i != systemNodes.end(); i++)
+        {
             NodeMerge* NM = new NodeMerge(level);
-            std::vector<PathData> positions = m_pathDistances[mergeNode];
+            std::vector<PathData> & positions = m_pathDistances[*i];
             for(std::vector<PathData>::iterator j = positions.begin(); j != positions.end(); j++)
             {
                 NM->m_position.push_back(std::pair<int, double>((*j).targetSun, (*j).length));
             }
-
-            bool ret;
-            if(i == systemNodes.begin() && m_massAsNodeRadius)
-            {
-                ret = MLG.changeNode(NM, sun, sqrt((float)m_mass[sun]) * m_radius[sun], mergeNode);
-            }
-            else
-            {
-                ret = MLG.changeNode(NM, sun, MLG.radius(sun), mergeNode);
-            }
-            OGDF_ASSERT(ret);
-            MLG.moveEdgesToParent(NM, mergeNode, sun, true, m_adjustEdgeLengths);
-            ret = MLG.postMerge(NM, mergeNode);
-            if(!ret)
-            {
-                delete NM;
-            }
-            else
-            {
-                retVal = true;
-            }
+            merges.push_back(NodeCollapse(*i, sun, radius, NM));
         }
 
-        return retVal;
+        return !systemNodes.empty();
     }
 
 } // namespace ogdf
@@ -43,6 +43,7 @@
 
 #include "numexcept.h"
 #include <ogdf/basic/basic.h>
+#include <ogdf/basic/Math.h>
 
 #define epsilon 0.1
 #define POS_SMALL_DOUBLE 1e-300
@@ -131,6 +132,31 @@ namespace ogdf
     }
 
 
+    __uint32 numexcept::hashIndices(int i, int j)
+    {
+        __uint32 h = __uint32(i) * 2654435761u ^ (__uint32(j) + 0x9e3779b9u + (__uint32(i) << 6));
+        h ^= h >> 16;
+        h *= 0x85ebca6bu;
+        h ^= h >> 13;
+        return h;
+    }
+
+
+    DPoint numexcept::choose_distinct_point_in_radius_epsilon(DPoint old_pos, int i, int j)
+    {
+        // hash i and j to two numbers in [0,1)
+        __uint32 h = hashIndices(i, j);
+        double angle = 2 * Math::pi * double(h & 0xffff) / 65536.0;
+        double radius = 0.5 + 0.5 * double(h >> 16) / 65536.0;
+
+        // like choose_distinct_random_point_in_disque: mindist is epsilon
+        DPoint new_point;
+        new_point.m_x = old_pos.m_x + epsilon * epsilon * radius * cos(angle);
+        new_point.m_y = old_pos.m_y + epsilon * epsilon * radius * sin(angle);
+        return new_point;
+    }
+
+
     bool numexcept::f_rep_near_machine_precision(double distance, DPoint & force)
     {
         const double  POS_BIG_LIMIT =    POS_BIG_DOUBLE   *  1e-190;
@@ -166,6 +192,35 @@ namespace ogdf
     }
 
 
+    bool numexcept::f_rep_near_machine_precision(double distance, DPoint & force, int i, int j)
+    {
+        const double  POS_BIG_LIMIT =    POS_BIG_DOUBLE   *  1e-190;
+        const double  POS_SMALL_LIMIT =  POS_SMALL_DOUBLE *  1e190;
+
+        if(distance <= POS_BIG_LIMIT && distance >= POS_SMALL_LIMIT)
+            return false;
+
+        // hash i and j to two numbers in (0,1) and two signs
+        __uint32 h = hashIndices(i, j);
+        double randx = (double(h & 0x7fff) + 1) / 32770.0;
+        double randy = (double((h >> 15) & 0x7fff) + 1) / 32770.0;
+        double sign_x = (h & 0x40000000u) ? -1.0 : 1.0;
+        double sign_y = (h & 0x80000000u) ? -1.0 : 1.0;
+
+        if(distance > POS_BIG_LIMIT)
+        {
+            force.m_x = POS_SMALL_LIMIT * (1 + randx) * sign_x;
+            force.m_y = POS_SMALL_LIMIT * (1 + randy) * sign_y;
+        }
+        else
+        {
+            force.m_x = POS_BIG_LIMIT * randx * sign_x;
+            force.m_y = POS_BIG_LIMIT * randy * sign_y;
+        }
+        return true;
+    }
+
+
     bool numexcept::f_near_machine_precision(double distance, DPoint & force)
     {
         const double  POS_BIG_LIMIT =    POS_BIG_DOUBLE   *  1e-190;
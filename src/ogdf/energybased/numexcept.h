@@ -79,12 +79,22 @@ namespace ogdf
         //radius epsilon = 0.1 is computed.
         DPoint choose_distinct_random_point_in_radius_epsilon(DPoint old_pos);
 
+        //A point (distinct from old_pos) on the disque around old_pos with radius
+        //epsilon = 0.1 is computed; the point only depends on old_pos, i and j, so
+        //that the function yields reproducible results when called concurrently.
+        DPoint choose_distinct_point_in_radius_epsilon(DPoint old_pos, int i, int j);
+
         //If distance has a value near the machine precision the repulsive force calculation
         //is not possible (calculated values exceed the machine accuracy) in this cases
         //true is returned and force is set to a reasonable value that does
         //not cause problems; Else false is returned and force keeps unchanged.
         bool f_rep_near_machine_precision(double distance, DPoint & force);
 
+        //Like f_rep_near_machine_precision(distance,force), but the force only depends
+        //on distance, i and j, so that the function yields reproducible results when
+        //called concurrently.
+        bool f_rep_near_machine_precision(double distance, DPoint & force, int i, int j);
+
         //If distance has a value near the machine precision the (attractive)force
         //calculation is not possible (calculated values exceed the machine accuracy) in
         //this cases true is returned and force is set to a reasonable value that does
@@ -95,6 +105,10 @@ namespace ogdf
         //insufficient in functions well_seperated and bordering of NMM)
         bool nearly_equal(double a, double b);
 
+    private:
+        //Hashes i and j to a 32 bit number.
+        static __uint32 hashIndices(int i, int j);
+
     };
 
 }//namespace ogdf
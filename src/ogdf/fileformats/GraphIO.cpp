@@ -78,6 +78,12 @@ namespace ogdf
     }
 
 
+    OutputBuffer & GraphIO::indent(OutputBuffer & out, int depth)
+    {
+        return out.fill(s_indentChar, s_indentWidth * depth);
+    }
+
+
     //---------------------------------------------------------
     // Graph: GML format
     //---------------------------------------------------------
@@ -48,7 +48,8 @@ namespace ogdf
 
 
     // begin of GML file
-    static void write_gml_header(ostream & os, bool directed)
+    template<class OS>
+    static void write_gml_header(OS & os, bool directed)
     {
         os << "Creator \"ogdf::GraphIO::writeGML\"\n";
         os << "graph [\n";
@@ -57,7 +58,8 @@ namespace ogdf
 
 
     // end of GML file
-    static void write_gml_footer(ostream & os)
+    template<class OS>
+    static void write_gml_footer(OS & os)
     {
         os << "]\n"; // graph
     }
@@ -89,7 +91,8 @@ namespace ogdf
 
     const int c_maxLengthPerLine = 200;
 
-    static void writeLongString(ostream & os, const string & str)
+    template<class OS>
+    static void writeLongString(OS & os, const string & str)
     {
         os << "\"";
 
@@ -133,45 +136,43 @@ namespace ogdf
         "none", "last", "first", "both"
     };
 
-    // write graph structure with attributes
-    static void write_gml_graph(const GraphAttributes & A, ostream & os, NodeArray<int> & index)
+    // write graph structure with attributes; only attributes in attr are written
+    template<class OS>
+    static void write_gml_graph(const GraphAttributes & A, long attr, OS & os, NodeArray<int> & index)
     {
         const Graph & G = A.constGraph();
         int nextId = 0;
 
-        os.setf(ios::showpoint);
-        os.precision(10);
-
         node v;
         forall_nodes(v, G)
         {
             GraphIO::indent(os, 1) << "node [\n";
             GraphIO::indent(os, 2) << "id " << (index[v] = nextId++) << "\n";
 
-            if(A.attributes() & GraphAttributes::nodeTemplate)
+            if(attr & GraphAttributes::nodeTemplate)
             {
                 GraphIO::indent(os, 2) << "template ";
                 writeLongString(os, A.templateNode(v));
                 os << "\n";
             }
-            if(A.attributes() & GraphAttributes::nodeLabel)
+            if(attr & GraphAttributes::nodeLabel)
             {
                 GraphIO::indent(os, 2) << "label ";
                 writeLongString(os, A.label(v));
                 os << "\n";
             }
-            if(A.attributes() & GraphAttributes::nodeWeight)
+            if(attr & GraphAttributes::nodeWeight)
             {
                 GraphIO::indent(os, 2) << "weight "  << A.weight(v) << "\n";
             }
-            if(A.attributes() & GraphAttributes::nodeGraphics)
+            if(attr & GraphAttributes::nodeGraphics)
             {
                 GraphIO::indent(os, 2) << "graphics [\n";
                 GraphIO::indent(os, 3) << "x " << A.x(v) << "\n";
                 GraphIO::indent(os, 3) << "y " << A.y(v) << "\n";
                 GraphIO::indent(os, 3) << "w " << A.width(v) << "\n";
                 GraphIO::indent(os, 3) << "h " << A.height(v) << "\n";
-                if(A.attributes() & GraphAttributes::nodeStyle)
+                if(attr & GraphAttributes::nodeStyle)
                 {
                     GraphIO::indent(os, 3) << "fill \"" << A.fillColor(v) << "\"\n";
                     GraphIO::indent(os, 3) << "line \"" << A.strokeColor(v) << "\"\n";
@@ -241,27 +242,27 @@ namespace ogdf
             GraphIO::indent(os, 2) << "source " << index[e->source()] << "\n";
             GraphIO::indent(os, 2) << "target " << index[e->target()] << "\n";
 
-            if(A.attributes() & GraphAttributes::edgeLabel)
+            if(attr & GraphAttributes::edgeLabel)
             {
                 GraphIO::indent(os, 2) << "label ";
                 writeLongString(os, A.label(e));
                 os << "\n";
             }
-            if(A.attributes() & GraphAttributes::edgeType)
+            if(attr & GraphAttributes::edgeType)
                 GraphIO::indent(os, 2) << "generalization " << A.type(e) << "\n";
 
-            if(A.attributes() & GraphAttributes::edgeSubGraphs)
+            if(attr & GraphAttributes::edgeSubGraphs)
                 GraphIO::indent(os, 2) << "subgraph " << A.subGraphBits(e) << "\n";
 
-            if(A.attributes() & GraphAttributes::edgeGraphics)
+            if(attr & GraphAttributes::edgeGraphics)
             {
                 GraphIO::indent(os, 2) << "graphics [\n";
 
                 GraphIO::indent(os, 3) << "type \"line\"\n";
 
-                if(A.attributes() & GraphAttributes::edgeType)
+                if(attr & GraphAttributes::edgeType)
                 {
-                    if(A.attributes() & GraphAttributes::edgeArrow)
+                    if(attr & GraphAttributes::edgeArrow)
                     {
                         int ae = (int)A.arrowType(e);
                         if(0 <= ae && ae < 4)
@@ -290,13 +291,13 @@ namespace ogdf
                     }
                 }
 
-                if(A.attributes() & GraphAttributes::edgeStyle)
+                if(attr & GraphAttributes::edgeStyle)
                 {
                     GraphIO::indent(os, 3) << "stipple "   << A.strokeType(e) << "\n";
                     GraphIO::indent(os, 3) << "lineWidth " << A.strokeWidth(e) << "\n";
                 }
 
-                if(A.attributes() & GraphAttributes::edgeDoubleWeight)
+                if(attr & GraphAttributes::edgeDoubleWeight)
                 {
                     GraphIO::indent(os, 3) << "weight " << A.doubleWeight(e) << "\n";
                 }
@@ -332,7 +333,7 @@ namespace ogdf
                 }//bends
 
                 //output width and color
-                if((A.attributes() & GraphAttributes::edgeStyle))
+                if((attr & GraphAttributes::edgeStyle))
                     GraphIO::indent(os, 3) << "fill \"" << A.strokeColor(e) << "\"\n";
 
                 GraphIO::indent(os, 2) << "]\n"; // graphics
@@ -466,21 +467,47 @@ namespace ogdf
     // write GraphAttributes
     bool GraphIO::writeGML(const GraphAttributes & A, ostream & os)
     {
+        os.setf(ios::showpoint);
+        os.precision(10);
+
         write_gml_header(os, A.directed());
         NodeArray<int> index(A.constGraph());
-        write_gml_graph(A, os, index);
+        write_gml_graph(A, A.attributes(), os, index);
         write_gml_footer(os);
 
         return true;
     }
 
 
+    // write GraphAttributes (fast writer, selected attributes only)
+    bool GraphIO::writeGML(const GraphAttributes & A, OutputBuffer & out, long attributes)
+    {
+        write_gml_header(out, A.directed());
+        NodeArray<int> index(A.constGraph());
+        write_gml_graph(A, A.attributes() & attributes, out, index);
+        write_gml_footer(out);
+
+        out.flush();
+        return out.good();
+    }
+
+
+    bool GraphIO::writeGML(const GraphAttributes & A, ostream & os, long attributes)
+    {
+        OutputBuffer out(os);
+        return writeGML(A, out, attributes);
+    }
+
+
     // write ClusterGraphAttributes
     bool GraphIO::writeGML(const ClusterGraphAttributes & A, ostream & os)
     {
+        os.setf(ios::showpoint);
+        os.precision(10);
+
         write_gml_header(os, A.directed());
         NodeArray<int> index(A.constGraph());
-        write_gml_graph(A, os, index);
+        write_gml_graph(A, A.attributes(), os, index);
         write_gml_footer(os);
 
         int nextClusterIndex = 0;
@@ -48,7 +48,8 @@ namespace ogdf
 {
 
 
-    static inline void writeGraphMLHeader(std::ostream & out)
+    template<class OS>
+    static inline void writeGraphMLHeader(OS & out)
     {
         const std::string xmlns = "http://graphml.graphdrawing.org/xmlns";
         out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
@@ -59,14 +60,16 @@ namespace ogdf
     }
 
 
-    static inline void writeGraphMLFooter(std::ostream & out)
+    template<class OS>
+    static inline void writeGraphMLFooter(OS & out)
     {
         out << "</graphml>\n";
     }
 
 
+    template<class OS>
     static inline void defineGraphMLAttribute(
-        std::ostream & out,
+        OS & out,
         const std::string & kind, const std::string & name, const std::string & type)
     {
         GraphIO::indent(out, 1) << "<key "
@@ -77,7 +80,8 @@ namespace ogdf
     }
 
 
-    static inline void defineGraphMLAttributes(std::ostream & out, long attributes)
+    template<class OS>
+    static inline void defineGraphMLAttributes(OS & out, long attributes)
     {
         using namespace graphml;
 
@@ -178,9 +182,9 @@ namespace ogdf
     }
 
 
-    template <typename T>
+    template <typename OS, typename T>
     static inline void writeGraphMLAttribute(
-        std::ostream & out, int depth,
+        OS & out, int depth,
         const std::string & name, const T & value)
     {
         GraphIO::indent(out, depth) << "<data key=\"" << name << "\">"
@@ -211,15 +215,56 @@ namespace ogdf
     }
 
 
+    // write bend points as list (stream version)
+    static inline void writeGraphMLBends(
+        std::ostream & out, int depth, const DPolyline & bends)
+    {
+        std::stringstream sstream; // For code consistency.
+
+        forall_listiterators(DPoint, it, bends)
+        {
+            const DPoint & p = *it;
+            sstream << p.m_x << " " << p.m_y << " ";
+        }
+
+        // Call to GA.bends(e).length() causes a "Segmentation fault".
+        const std::string str = sstream.str();
+        if(str.length() > 0)
+        {
+            writeGraphMLAttribute(
+                out, depth,
+                toString(graphml::a_edgeBends), sstream.str());
+        }
+    }
+
+
+    // write bend points as list (fast writer version)
+    static inline void writeGraphMLBends(
+        OutputBuffer & out, int depth, const DPolyline & bends)
+    {
+        if(bends.empty())
+            return;
+
+        GraphIO::indent(out, depth) << "<data key=\"" << toString(graphml::a_edgeBends) << "\">";
+        forall_listiterators(DPoint, it, bends)
+        {
+            const DPoint & p = *it;
+            out << p.m_x << ' ' << p.m_y << ' ';
+        }
+        out << "</data>\n";
+    }
+
+
+    template<class OS>
     static inline void writeGraphMLNode(
-        std::ostream & out, int depth,
-        const GraphAttributes & GA, const node & v)
+        OS & out, int depth,
+        const GraphAttributes & GA, long attributes, const node & v)
     {
         using namespace graphml;
 
         // Use attribute id if avaliable, node index if not.
         GraphIO::indent(out, depth++) << "<node id=\"";
-        if(GA.attributes() & GraphAttributes::nodeId)
+        if(attributes & GraphAttributes::nodeId)
         {
             out << GA.idNode(v);
         }
@@ -229,12 +274,12 @@ namespace ogdf
         }
         out << "\">\n";
 
-        if(GA.attributes() & GraphAttributes::nodeLabel && GA.label(v) != "")
+        if(attributes & GraphAttributes::nodeLabel && GA.label(v) != "")
         {
             writeGraphMLAttribute(out, depth, toString(a_nodeLabel), GA.label(v));
         }
 
-        if(GA.attributes() & GraphAttributes::nodeGraphics)
+        if(attributes & GraphAttributes::nodeGraphics)
         {
             writeGraphMLAttribute(out, depth, toString(a_x), GA.x(v));
             writeGraphMLAttribute(out, depth, toString(a_y), GA.y(v));
@@ -249,12 +294,12 @@ namespace ogdf
                 toString(a_shape), toString(GA.shape(v)));
         }
 
-        if(GA.attributes() & GraphAttributes::threeD)
+        if(attributes & GraphAttributes::threeD)
         {
             writeGraphMLAttribute(out, depth, toString(a_z), GA.z(v));
         }
 
-        if(GA.attributes() & GraphAttributes::nodeStyle)
+        if(attributes & GraphAttributes::nodeStyle)
         {
             const Color & col = GA.fillColor(v);
             writeGraphMLAttribute(
@@ -272,14 +317,14 @@ namespace ogdf
                 toString(a_nodeStroke), GA.strokeColor(v));
         }
 
-        if(GA.attributes() & GraphAttributes::nodeType)
+        if(attributes & GraphAttributes::nodeType)
         {
             writeGraphMLAttribute(
                 out, depth,
                 toString(a_nodeType), toString(GA.type(v)));
         }
 
-        if(GA.attributes() & GraphAttributes::nodeTemplate &&
+        if(attributes & GraphAttributes::nodeTemplate &&
                 GA.templateNode(v).length() > 0)
         {
             writeGraphMLAttribute(
@@ -287,7 +332,7 @@ namespace ogdf
                 toString(a_template), GA.templateNode(v));
         }
 
-        if(GA.attributes() & GraphAttributes::nodeWeight)
+        if(attributes & GraphAttributes::nodeWeight)
         {
             writeGraphMLAttribute(out, depth, toString(a_nodeWeight), GA.weight(v));
         }
@@ -296,9 +341,10 @@ namespace ogdf
     }
 
 
+    template<class OS>
     static inline void writeGraphMLEdge(
-        std::ostream & out, int depth,
-        const GraphAttributes & GA, const edge & e)
+        OS & out, int depth,
+        const GraphAttributes & GA, long attributes, const edge & e)
     {
         using namespace graphml;
 
@@ -310,52 +356,37 @@ namespace ogdf
                                       << "target=\"" << t->index() << "\""
                                       << ">\n";
 
-        if(GA.attributes() & GraphAttributes::edgeLabel && GA.label(e) != "")
+        if(attributes & GraphAttributes::edgeLabel && GA.label(e) != "")
         {
             writeGraphMLAttribute(out, depth, toString(a_edgeLabel), GA.label(e));
         }
 
-        if(GA.attributes() & GraphAttributes::edgeDoubleWeight)
+        if(attributes & GraphAttributes::edgeDoubleWeight)
         {
             writeGraphMLAttribute(
                 out, depth,
                 toString(a_edgeWeight), GA.doubleWeight(e));
         }
-        else if(GA.attributes() & GraphAttributes::edgeIntWeight)
+        else if(attributes & GraphAttributes::edgeIntWeight)
         {
             writeGraphMLAttribute(
                 out, depth,
                 toString(a_edgeWeight), GA.intWeight(e));
         }
 
-        if(GA.attributes() & GraphAttributes::edgeGraphics)
+        if(attributes & GraphAttributes::edgeGraphics)
         {
-            std::stringstream sstream; // For code consistency.
-
-            forall_listiterators(DPoint, it, GA.bends(e))
-            {
-                const DPoint & p = *it;
-                sstream << p.m_x << " " << p.m_y << " ";
-            }
-
-            // Call to GA.bends(e).length() causes a "Segmentation fault".
-            const std::string str = sstream.str();
-            if(str.length() > 0)
-            {
-                writeGraphMLAttribute(
-                    out, depth,
-                    toString(a_edgeBends), sstream.str());
-            }
+            writeGraphMLBends(out, depth, GA.bends(e));
         }
 
-        if(GA.attributes() & GraphAttributes::edgeType)
+        if(attributes & GraphAttributes::edgeType)
         {
             writeGraphMLAttribute(
                 out, depth,
                 toString(a_edgeType), toString(GA.type(e)));
         }
 
-        if(GA.attributes() & GraphAttributes::edgeArrow)
+        if(attributes & GraphAttributes::edgeArrow)
         {
             const EdgeArrow & arrow = GA.arrowType(e);
             if(arrow != eaUndefined)
@@ -366,14 +397,14 @@ namespace ogdf
             }
         }
 
-        if(GA.attributes() & GraphAttributes::edgeStyle)
+        if(attributes & GraphAttributes::edgeStyle)
         {
             writeGraphMLAttribute(
                 out, depth,
                 toString(a_edgeStroke), GA.strokeColor(e));
         }
 
-        if(GA.attributes() & GraphAttributes::edgeSubGraphs)
+        if(attributes & GraphAttributes::edgeSubGraphs)
         {
             const __uint32 mask = GA.subGraphBits(e);
 
@@ -382,7 +413,7 @@ namespace ogdf
             {
                 if((1 << sg) & mask)
                 {
-                    writeGraphMLAttribute(out, depth, toString(a_edgeSubGraph), sg);
+                    writeGraphMLAttribute(out, depth, toString(a_edgeSubGraph), int(sg));
                 }
             }
         }
@@ -453,7 +484,7 @@ namespace ogdf
 
         for(ListConstIterator<node> nit = c->nBegin(); nit.valid(); nit++)
         {
-            writeGraphMLNode(out, depth, CA, *nit);
+            writeGraphMLNode(out, depth, CA, CA.attributes(), *nit);
         }
 
         // There should be no attributes for root cluster.
@@ -566,13 +597,13 @@ namespace ogdf
         node v;
         forall_nodes(v, G)
         {
-            writeGraphMLNode(out, 2, GA, v);
+            writeGraphMLNode(out, 2, GA, GA.attributes(), v);
         }
 
         edge e;
         forall_edges(e, G)
         {
-            writeGraphMLEdge(out, 2, GA, e);
+            writeGraphMLEdge(out, 2, GA, GA.attributes(), e);
         }
 
         GraphIO::indent(out, 1) << "</graph>\n";
@@ -582,6 +613,45 @@ namespace ogdf
     }
 
 
+    bool GraphIO::writeGraphML(const GraphAttributes & GA, OutputBuffer & out, long attributes)
+    {
+        const Graph & G = GA.constGraph();
+        const long attr = GA.attributes() & attributes;
+
+        writeGraphMLHeader(out);
+        defineGraphMLAttributes(out, attr);
+        GraphIO::indent(out, 1) << "<graph "
+                                << "id=\"G\" "
+                                << "edgedefault=\"" << (GA.directed() ? "directed" : "undirected") << "\""
+                                << ">\n";
+
+        node v;
+        forall_nodes(v, G)
+        {
+            writeGraphMLNode(out, 2, GA, attr, v);
+        }
+
+        edge e;
+        forall_edges(e, G)
+        {
+            writeGraphMLEdge(out, 2, GA, attr, e);
+        }
+
+        GraphIO::indent(out, 1) << "</graph>\n";
+        writeGraphMLFooter(out);
+
+        out.flush();
+        return out.good();
+    }
+
+
+    bool GraphIO::writeGraphML(const GraphAttributes & GA, std::ostream & out, long attributes)
+    {
+        OutputBuffer buffer(out);
+        return writeGraphML(GA, buffer, attributes);
+    }
+
+
     bool GraphIO::writeGraphML(const ClusterGraphAttributes & CA, std::ostream & out)
     {
         const Graph & G = CA.constGraph();
@@ -599,7 +669,7 @@ namespace ogdf
         edge e;
         forall_edges(e, G)
         {
-            writeGraphMLEdge(out, 2, CA, e);
+            writeGraphMLEdge(out, 2, CA, CA.attributes(), e);
         }
 
         GraphIO::indent(out, 1) << "</graph>\n";
@@ -0,0 +1,521 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Implementation of class OgmlStreamParser.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#include <ogdf/fileformats/OgmlStreamParser.h>
+#include <ogdf/fileformats/Ogml.h>
+#include <ogdf/basic/Logger.h>
+
+
+namespace ogdf
+{
+
+    OgmlStreamParser::OgmlStreamParser() :
+        m_pScanner(0), m_pG(0), m_pCG(0), m_structureRead(false)
+    { }
+
+
+    OgmlStreamParser::~OgmlStreamParser()
+    {
+        cleanup();
+    }
+
+
+    bool OgmlStreamParser::error(const char* msg) const
+    {
+        Logger::slout() << "ERROR: " << msg;
+        if(m_pScanner != 0)
+            Logger::slout() << " (line " << m_pScanner->getInputFileLineCounter() << ")";
+        Logger::slout() << " in OgmlStreamParser!\n";
+        return false;
+    }
+
+
+    void OgmlStreamParser::cleanup()
+    {
+        m_frames.clear();
+
+        m_slots.clear();
+        m_idSlots.init();
+        m_pendingEdges.init();
+
+        m_pScanner = 0;
+    }
+
+
+    // ***********************************************************
+    //
+    // r e a d     m e t h o d
+    //
+    // ***********************************************************
+    bool OgmlStreamParser::doRead(
+        istream & is,
+        Graph & G,
+        ClusterGraph* pCG)
+    {
+        G.clear();
+        if(pCG != 0)
+        {
+            pCG->clear();
+            pCG->init(G);
+        }
+
+        m_pG  = &G;
+        m_pCG = pCG;
+        m_structureRead = false;
+
+        bool result;
+        try
+        {
+            XmlScanner scanner(is);
+            m_pScanner = &scanner;
+
+            result = parse();
+            if(result && !m_structureRead)
+                result = error("No structure element found!");
+        }
+        catch(InsufficientMemoryException &)
+        {
+            result = error("Insufficient memory!");
+        }
+        catch(std::bad_alloc &)
+        {
+            result = error("Insufficient memory!");
+        }
+
+        cleanup();
+        return result;
+    }
+
+
+    // ***********************************************************
+    //
+    // t o k e n     l o o p
+    //
+    // ***********************************************************
+    //
+    // This is the state machine of XmlParser::parse(), but instead of
+    // building a tree it reports the start and end of each element to
+    // startElement() and endElement().
+    bool OgmlStreamParser::parse()
+    {
+        for(; ;)
+        {
+            XmlToken token = m_pScanner->getNextToken();
+            if(token == endOfFile)
+                break;
+
+            // Expect "<", otherwise failure
+            if(token != openingBracket)
+                return error("Opening Bracket expected!");
+
+            token = m_pScanner->getNextToken();
+
+            // XML header line <? ... ?>
+            if(token == questionMark)
+            {
+                if(!m_pScanner->skipUntil('?'))
+                    return error("Could not find the matching '?'!");
+                if(m_pScanner->getNextToken() != closingBracket)
+                    return error("Closing Bracket expected!");
+                continue;
+            }
+
+            // comment <!-- ... --> or preamble <! ... >
+            if(token == exclamationMark)
+            {
+                if((m_pScanner->getNextToken() != minus) ||
+                        (m_pScanner->getNextToken() != minus))
+                {
+                    if(!m_pScanner->skipUntilMatchingClosingBracket())
+                        return error("Could not find closing comment bracket!");
+                    continue;
+                }
+
+                bool endOfCommentFound = false;
+                while(!endOfCommentFound)
+                {
+                    if(!m_pScanner->skipUntil('-', true))
+                        return error("Closing --> of comment not found!");
+
+                    // the next characters must be -> (one minus is already consumed)
+                    if((m_pScanner->getNextToken() == minus) &&
+                            (m_pScanner->getNextToken() == closingBracket))
+                    {
+                        endOfCommentFound = true;
+                    }
+                }
+                continue;
+            }
+
+            // closing tag </name>
+            if(token == slash)
+            {
+                if(m_pScanner->getNextToken() != identifier)
+                    return error("Identifier expected!");
+                if(m_frames.empty() || m_frames.back().m_name != m_pScanner->getCurrentTokenString())
+                    return error("Wrong closing tag!");
+                if(m_pScanner->getNextToken() != closingBracket)
+                    return error("Closing Bracket expected!");
+                if(!endElement())
+                    return false;
+                continue;
+            }
+
+            // opening tag <name attr="value" ... > or <name ... />
+            if(token != identifier)
+                return error("Identifier expected!");
+
+            string name(m_pScanner->getCurrentTokenString());
+
+            m_attrNames.clear();
+            m_attrValues.clear();
+            token = m_pScanner->getNextToken();
+            while(token == identifier)
+            {
+                m_attrNames.push_back(m_pScanner->getCurrentTokenString());
+
+                if(m_pScanner->getNextToken() != equalSign)
+                    return error("Equal Sign expected!");
+
+                token = m_pScanner->getNextToken();
+                if(token != quotedValue && token != identifier && token != attributeValue)
+                    return error("No valid attribute value!");
+                m_attrValues.push_back(m_pScanner->getCurrentTokenString());
+
+                token = m_pScanner->getNextToken();
+            }
+
+            if(!startElement(name))
+                return false;
+
+            if(token == slash)
+            {
+                if(m_pScanner->getNextToken() != closingBracket)
+                    return error("Closing Bracket expected!");
+                if(!endElement())
+                    return false;
+                continue;
+            }
+
+            if(token != closingBracket)
+                return error("Closing Bracket expected!");
+
+            // text content, e.g. <A> lalala </A>, is skipped
+            token = m_pScanner->testNextToken();
+            if(token != openingBracket && token != endOfFile)
+            {
+                if(!m_pScanner->readStringUntil('<'))
+                    return error("Unexpected end of file!");
+            }
+        }
+
+        if(!m_frames.empty())
+            return error("Unexpected end of file!");
+
+        return true;
+    }
+
+
+    // ***********************************************************
+    //
+    // e l e m e n t     e v e n t s
+    //
+    // ***********************************************************
+    bool OgmlStreamParser::startElement(const string & name)
+    {
+        const int parent = int(m_frames.size()) - 1;
+
+        Frame f;
+        f.m_name = name;
+
+        if(parent < 0)
+        {
+            if(name != Ogml::s_tagNames[Ogml::t_ogml])
+                return error("Expecting root tag \"ogml\"!");
+            f.m_kind = ekOgml;
+        }
+        else
+        {
+            switch(m_frames[parent].m_kind)
+            {
+            case ekOgml:
+                if(name == Ogml::s_tagNames[Ogml::t_graph])
+                    f.m_kind = ekGraph;
+                break;
+
+            case ekGraph:
+                if(name == Ogml::s_tagNames[Ogml::t_structure])
+                    f.m_kind = ekStructure;
+                break;
+
+            case ekStructure:
+            case ekNode:
+                if(name == Ogml::s_tagNames[Ogml::t_node])
+                    f.m_kind = ekNode;
+                else if(name == Ogml::s_tagNames[Ogml::t_edge])
+                    f.m_kind = ekEdge;
+                break;
+
+            case ekEdge:
+                if(name == Ogml::s_tagNames[Ogml::t_source])
+                    f.m_kind = ekSource;
+                else if(name == Ogml::s_tagNames[Ogml::t_target])
+                    f.m_kind = ekTarget;
+                break;
+
+            default:
+                break;
+            }
+        }
+
+        switch(f.m_kind)
+        {
+        case ekNode:
+            {
+                const string* id = attribute(Ogml::a_id);
+                if(id == 0)
+                    return error("Node without id!");
+
+                f.m_slot = slot(*id);
+                if(m_idSlots[f.m_slot].m_defined)
+                    return error("Id of node is not unique!");
+                m_idSlots[f.m_slot].m_defined = true;
+
+                // a node containing nodes represents a cluster
+                if(m_frames[parent].m_kind == ekNode)
+                    makeHierarchical(m_frames[parent], parent);
+            }
+            break;
+
+        case ekSource:
+        case ekTarget:
+            {
+                const string* idRef = attribute(Ogml::a_nodeIdRef);
+                if(idRef == 0)
+                    return error("Source or target without idRef!");
+
+                Frame & e = m_frames[parent];
+                ++e.m_numEnds;
+                (f.m_kind == ekSource ? e.m_src : e.m_tgt) = slot(*idRef);
+            }
+            break;
+
+        default:
+            break;
+        }
+
+        m_frames.push_back(f);
+        return true;
+    }
+
+
+    bool OgmlStreamParser::endElement()
+    {
+        const int index = int(m_frames.size()) - 1;
+        Frame & f = m_frames[index];
+
+        bool result = true;
+        switch(f.m_kind)
+        {
+        case ekNode:
+            closeNode(f, index);
+            break;
+
+        case ekEdge:
+            result = closeEdge(f);
+            break;
+
+        case ekStructure:
+            result = resolvePendingEdges();
+            m_structureRead = true;
+            break;
+
+        default:
+            break;
+        }
+
+        m_frames.pop_back();
+        return result;
+    }
+
+
+    const string* OgmlStreamParser::attribute(int attrId) const
+    {
+        const string & name = Ogml::s_attributeNames[attrId];
+        for(size_t i = 0; i < m_attrNames.size(); ++i)
+        {
+            if(m_attrNames[i] == name)
+                return &m_attrValues[i];
+        }
+        return 0;
+    }
+
+
+    // ***********************************************************
+    //
+    // i d s
+    //
+    // ***********************************************************
+    int OgmlStreamParser::slot(const string & id)
+    {
+        HashElement<string, int>* it = m_slots.lookup(id);
+        if(it != 0)
+            return it->info();
+
+        int s = m_idSlots.size();
+        m_idSlots.push(IdSlot());
+        m_slots.fastInsert(id, s);
+        return s;
+    }
+
+
+    // Returns the cluster of the innermost hierarchical node enclosing
+    // the element at position frameIndex.
+    cluster OgmlStreamParser::enclosingCluster(int frameIndex) const
+    {
+        for(int i = frameIndex - 1; i >= 0 && m_frames[i].m_kind == ekNode; --i)
+        {
+            if(m_frames[i].m_cluster != 0)
+                return m_frames[i].m_cluster;
+        }
+        return m_pCG->rootCluster();
+    }
+
+
+    // ***********************************************************
+    //
+    // n o d e s ,   c l u s t e r s   a n d   e d g e s
+    //
+    // ***********************************************************
+    void OgmlStreamParser::makeHierarchical(Frame & f, int frameIndex)
+    {
+        if(f.m_hierarchical)
+            return;
+        f.m_hierarchical = true;
+
+        if(m_pCG != 0)
+        {
+            f.m_cluster = m_pCG->newCluster(enclosingCluster(frameIndex));
+            m_idSlots[f.m_slot].m_c = f.m_cluster;
+        }
+    }
+
+
+    void OgmlStreamParser::closeNode(Frame & f, int frameIndex)
+    {
+        // hierarchical nodes are clusters (created when the first child was read)
+        if(f.m_hierarchical)
+            return;
+
+        node v = m_pG->newNode();
+        m_idSlots[f.m_slot].m_v = v;
+
+        if(m_pCG != 0)
+        {
+            cluster c = enclosingCluster(frameIndex);
+            if(c != m_pCG->rootCluster())
+                m_pCG->reassignNode(v, c);
+        }
+    }
+
+
+    bool OgmlStreamParser::closeEdge(const Frame & f)
+    {
+        if(f.m_numEnds != 2 || f.m_src < 0 || f.m_tgt < 0)
+        {
+            Logger::slout(Logger::LL_MINOR) << "WARNING: hyperedges are temporarily not supported! Discarding edge.\n";
+            return true;
+        }
+
+        const IdSlot & src = m_idSlots[f.m_src];
+        const IdSlot & tgt = m_idSlots[f.m_tgt];
+
+        if(src.m_v != 0 && tgt.m_v != 0)
+        {
+            newEdge(f.m_src, f.m_tgt);
+            return true;
+        }
+
+        if(src.m_c != 0 || tgt.m_c != 0)
+        {
+            Logger::slout(Logger::LL_MINOR) << "WARNING: edge relation between graph elements of none type node " <<
+                                            "are temporarily not supported!\n";
+            return true;
+        }
+
+        // forward reference
+        m_pendingEdges.push(PendingEdge(f.m_src, f.m_tgt));
+        return true;
+    }
+
+
+    void OgmlStreamParser::newEdge(int src, int tgt)
+    {
+        m_pG->newEdge(m_idSlots[src].m_v, m_idSlots[tgt].m_v);
+    }
+
+
+    bool OgmlStreamParser::resolvePendingEdges()
+    {
+        for(int i = 0; i < m_pendingEdges.size(); ++i)
+        {
+            const PendingEdge & pe = m_pendingEdges[i];
+            const IdSlot & src = m_idSlots[pe.m_src];
+            const IdSlot & tgt = m_idSlots[pe.m_tgt];
+
+            if(!src.m_defined || !tgt.m_defined)
+                return error("Edge refers to an undefined node!");
+
+            if(src.m_v == 0 || tgt.m_v == 0)
+            {
+                Logger::slout(Logger::LL_MINOR) << "WARNING: edge relation between graph elements of none type node " <<
+                                                "are temporarily not supported!\n";
+                continue;
+            }
+
+            newEdge(pe.m_src, pe.m_tgt);
+        }
+
+        m_pendingEdges.init();
+        return true;
+    }
+
+}//end namespace ogdf
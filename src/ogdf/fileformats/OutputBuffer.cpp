@@ -0,0 +1,223 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Implementation of class OutputBuffer.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+
+#include <ogdf/fileformats/OutputBuffer.h>
+#include <cstdio>
+
+
+namespace ogdf
+{
+
+    // powers of ten that fit into 64 bits
+    static const __uint64 s_pow10[20] =
+    {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+        100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+        10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+        100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+    };
+
+
+    OutputBuffer::OutputBuffer(int capacity) :
+        m_pOs(0), m_capacity(max(capacity, 64)), m_pos(0), m_precision(10)
+    {
+        m_buffer = new char[m_capacity];
+    }
+
+
+    OutputBuffer::OutputBuffer(ostream & os, int capacity) :
+        m_pOs(&os), m_capacity(max(capacity, 64)), m_pos(0), m_precision(10)
+    {
+        m_buffer = new char[m_capacity];
+    }
+
+
+    OutputBuffer::~OutputBuffer()
+    {
+        flush();
+        delete [] m_buffer;
+    }
+
+
+    void OutputBuffer::attach(ostream & os)
+    {
+        flush();
+        m_pOs = &os;
+    }
+
+
+    void OutputBuffer::detach()
+    {
+        flush();
+        m_pOs = 0;
+    }
+
+
+    void OutputBuffer::flush()
+    {
+        if(m_pos > 0 && m_pOs != 0)
+            m_pOs->write(m_buffer, m_pos);
+        m_pos = 0;
+    }
+
+
+    OutputBuffer & OutputBuffer::fill(char c, int n)
+    {
+        while(n > 0)
+        {
+            if(m_pos == m_capacity) flush();
+            int k = min(n, m_capacity - m_pos);
+            memset(m_buffer + m_pos, c, k);
+            m_pos += k;
+            n -= k;
+        }
+        return *this;
+    }
+
+
+    OutputBuffer & OutputBuffer::write(const char* str, int n)
+    {
+        while(n > 0)
+        {
+            if(m_pos == m_capacity) flush();
+            int k = min(n, m_capacity - m_pos);
+            memcpy(m_buffer + m_pos, str, k);
+            m_pos += k;
+            str += k;
+            n -= k;
+        }
+        return *this;
+    }
+
+
+    OutputBuffer & OutputBuffer::writeUnsigned(__uint64 u)
+    {
+        char digits[24];
+        int n = 0;
+        do
+        {
+            digits[23 - n++] = char('0' + u % 10);
+            u /= 10;
+        }
+        while(u != 0);
+
+        return write(digits + 24 - n, n);
+    }
+
+
+    OutputBuffer & OutputBuffer::writeDouble(double d)
+    {
+        if(d != d)
+            return write("nan", 3);
+
+        if(d < 0)
+        {
+            put('-');
+            d = -d;
+        }
+
+        if(d == 0.0)
+            return write("0.0", 3);
+
+        if(d > numeric_limits<double>::max())
+            return write("inf", 3);
+
+        // very large and very small numbers are rare in drawings;
+        // we use the C library for them
+        if(d >= 1e15 || d < 1e-4)
+        {
+            char str[32];
+            int n = sprintf(str, "%.*e", m_precision - 1, d);
+            for(int i = 0; i < n; ++i)
+                if(str[i] == ',') str[i] = '.';
+            return write(str, n);
+        }
+
+        __uint64 intPart = __uint64(d);
+
+        // number of fractional digits required for m_precision significant digits
+        int fracDigits = m_precision;
+        if(intPart != 0)
+        {
+            int intDigits = 1;
+            while(intDigits < 16 && intPart >= s_pow10[intDigits])
+                ++intDigits;
+            fracDigits = max(m_precision - intDigits, 0);
+        }
+        else
+        {
+            // leading zeros after the decimal point are not significant
+            for(double t = d; t < 0.1; t *= 10)
+                ++fracDigits;
+        }
+
+        __uint64 scale = s_pow10[fracDigits];
+        __uint64 fracPart = __uint64((d - double(intPart)) * double(scale) + 0.5);
+        if(fracPart >= scale)
+        {
+            ++intPart;
+            fracPart -= scale;
+        }
+
+        writeUnsigned(intPart);
+        if(fracDigits == 0)
+            return write(".0", 2);
+        put('.');
+
+        // strip trailing zeros, but keep at least one fractional digit
+        int n = fracDigits;
+        while(n > 1 && fracPart % 10 == 0)
+        {
+            fracPart /= 10;
+            --n;
+        }
+
+        char digits[24];
+        for(int i = n - 1; i >= 0; --i)
+        {
+            digits[i] = char('0' + fracPart % 10);
+            fracPart /= 10;
+        }
+        return write(digits, n);
+    }
+
+
+} // end namespace ogdf
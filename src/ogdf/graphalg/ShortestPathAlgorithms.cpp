@@ -42,6 +42,8 @@
 
 #include <ogdf/graphalg/ShortestPathAlgorithms.h>
 #include <ogdf/graphalg/Dijkstra.h>
+#include <ogdf/basic/Thread.h>
+#include <queue>
 
 namespace ogdf
 {
@@ -139,4 +141,235 @@ namespace ogdf
         }
     }
 
+
+    //! Single source shortest paths from all nodes of a graph, computed by several threads.
+    /**
+     * The graph is copied into arrays, so the threads do not access the graph
+     * (or create node arrays). Thread t computes the rows t, t+T, t+2T, ...
+     * of the matrix, where T is the number of threads.
+     */
+    template<class T>
+    class ParallelSPAP
+    {
+    public:
+        //! Prepares the computation; edge costs are \a edgeCosts or, if 0, uniform.
+        ParallelSPAP(const Graph & G, DistanceMatrix<T> & distance, const EdgeArray<double>* edgeCosts)
+            : m_distance(distance)
+        {
+            distance.init(G);
+            m_n = G.numberOfNodes();
+            m_adjBegin.init(0, m_n, 0);
+            m_adj.init(2 * G.numberOfEdges());
+            if(edgeCosts != 0)
+                m_cost.init(2 * G.numberOfEdges());
+            int k = 0;
+            for(int i = 0; i < m_n; i++)
+            {
+                m_adjBegin[i] = k;
+                adjEntry adj;
+                forall_adj(adj, distance.nodeAt(i))
+                {
+                    if(edgeCosts != 0)
+                        m_cost[k] = (*edgeCosts)[adj->theEdge()];
+                    m_adj[k++] = distance.index(adj->twinNode());
+                }
+            }
+            m_adjBegin[m_n] = k;
+        }
+
+        //! Runs BFS from all nodes; a path with h edges has length h * \a edgeCosts (at most \a maxValue).
+        void bfs(double edgeCosts, double maxValue, int numThreads)
+        {
+            m_uniformCosts = edgeCosts;
+            m_maxValue = maxValue;
+            m_dijkstra = false;
+            run(numThreads);
+        }
+
+        //! Runs Dijkstra's algorithm from all nodes.
+        void dijkstra(int numThreads)
+        {
+            m_dijkstra = true;
+            run(numThreads);
+        }
+
+    private:
+        class Worker : public Thread
+        {
+        public:
+            Worker(ParallelSPAP* pSPAP, int t, int numThreads) : m_pSPAP(pSPAP), m_t(t), m_numThreads(numThreads) { }
+
+            void doWork()
+            {
+                m_pSPAP->work(m_t, m_numThreads);
+            }
+
+        private:
+            ParallelSPAP* m_pSPAP;
+            int m_t;
+            int m_numThreads;
+        };
+
+        void run(int numThreads)
+        {
+            numThreads = max(1, min(numThreads, m_n / 64));
+            Array<Worker*> worker(1, numThreads - 1);
+            for(int t = 1; t < numThreads; t++)
+            {
+                worker[t] = new Worker(this, t, numThreads);
+                worker[t]->start();
+            }
+            work(0, numThreads);
+            for(int t = 1; t < numThreads; t++)
+            {
+                worker[t]->join();
+                delete worker[t];
+            }
+        }
+
+        void work(int t, int numThreads)
+        {
+            Array<int> queue(max(1, m_n));
+            Array<double> dist(0, max(1, m_n) - 1, numeric_limits<double>::infinity());
+            for(int s = t; s < m_n; s += numThreads)
+            {
+                if(m_dijkstra)
+                    dijkstra(s, dist, queue);
+                else
+                    bfs(s, queue);
+            }
+        }
+
+        void bfs(int s, Array<int> & queue)
+        {
+            // reached nodes are marked with 0 in the row; their distance is set when
+            // they are dequeued, since the queue contains the levels one after another
+            T* row = m_distance.row(s);
+            int head = 0, tail = 0, levelEnd = 1;
+            int hops = 0;
+            T value = T(0);
+            queue[tail++] = s;
+            while(head < tail)
+            {
+                if(head == levelEnd)
+                {
+                    ++hops;
+                    value = T(min(hops * m_uniformCosts, m_maxValue));
+                    levelEnd = tail;
+                }
+                int u = queue[head++];
+                for(int k = m_adjBegin[u]; k < m_adjBegin[u + 1]; k++)
+                {
+                    int w = m_adj[k];
+                    if(row[w] == DistanceMatrix<T>::infinity() && w != s)
+                    {
+                        queue[tail++] = w;
+                        row[w] = T(0);
+                    }
+                }
+                row[u] = value;
+            }
+        }
+
+        void dijkstra(int s, Array<double> & dist, Array<int> & reached)
+        {
+            typedef std::pair<double, int> Entry;
+            std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+            int numReached = 0;
+            dist[s] = 0;
+            reached[numReached++] = s;
+            heap.push(Entry(0.0, s));
+            while(!heap.empty())
+            {
+                Entry top = heap.top();
+                heap.pop();
+                int u = top.second;
+                if(top.first > dist[u])
+                    continue;
+                for(int k = m_adjBegin[u]; k < m_adjBegin[u + 1]; k++)
+                {
+                    int w = m_adj[k];
+                    double d = top.first + m_cost[k];
+                    if(d < dist[w])
+                    {
+                        if(dist[w] == numeric_limits<double>::infinity())
+                            reached[numReached++] = w;
+                        dist[w] = d;
+                        heap.push(Entry(d, w));
+                    }
+                }
+            }
+
+            T* row = m_distance.row(s);
+            for(int i = 0; i < numReached; i++)
+            {
+                int w = reached[i];
+                row[w] = T(dist[w]);
+                dist[w] = numeric_limits<double>::infinity();
+            }
+        }
+
+        DistanceMatrix<T> & m_distance;
+        int m_n;
+        Array<int> m_adjBegin; //!< the neighbors of row i are m_adj[m_adjBegin[i]],...,m_adj[m_adjBegin[i+1]-1]
+        Array<int> m_adj;
+        Array<double> m_cost;  //!< the costs of the edges to the neighbors
+        double m_uniformCosts;
+        double m_maxValue;
+        bool m_dijkstra;
+    };
+
+
+    void bfs_SPAP(const Graph & G, DistanceMatrix<double> & distance,
+                  double edgeCosts, int numThreads)
+    {
+        ParallelSPAP<double> spap(G, distance, 0);
+        spap.bfs(edgeCosts, numeric_limits<double>::max(), numThreads);
+    }
+
+    void bfs_SPAP(const Graph & G, DistanceMatrix<float> & distance,
+                  double edgeCosts, int numThreads)
+    {
+        ParallelSPAP<float> spap(G, distance, 0);
+        spap.bfs(edgeCosts, numeric_limits<float>::max(), numThreads);
+    }
+
+    void bfs_SPAP(const Graph & G, DistanceMatrix<__uint16> & hops, int numThreads)
+    {
+        ParallelSPAP<__uint16> spap(G, hops, 0);
+        spap.bfs(1.0, DistanceMatrix<__uint16>::infinity() - 1, numThreads);
+    }
+
+    double dijkstra_SPAP(const GraphAttributes & GA,
+                         DistanceMatrix<double> & shortestPathMatrix, int numThreads)
+    {
+        const Graph & G = GA.constGraph();
+        EdgeArray<double> edgeCosts(G);
+        edge e;
+        double avgCosts = 0;
+        forall_edges(e, G)
+        {
+            edgeCosts[e] = GA.doubleWeight(e);
+            avgCosts += edgeCosts[e];
+        }
+        dijkstra_SPAP(G, shortestPathMatrix, edgeCosts, numThreads);
+        return avgCosts / G.numberOfEdges();
+    }
+
+    void dijkstra_SPAP(const Graph & G,
+                       DistanceMatrix<double> & shortestPathMatrix,
+                       const EdgeArray<double> & edgeCosts, int numThreads)
+    {
+        ParallelSPAP<double> spap(G, shortestPathMatrix, &edgeCosts);
+        spap.dijkstra(numThreads);
+    }
+
+    void dijkstra_SPAP(const Graph & G,
+                       DistanceMatrix<float> & shortestPathMatrix,
+                       const EdgeArray<double> & edgeCosts, int numThreads)
+    {
+        ParallelSPAP<float> spap(G, shortestPathMatrix, &edgeCosts);
+        spap.dijkstra(numThreads);
+    }
+
 }
@@ -40,6 +40,8 @@
 
 #include <ogdf/misclayout/BertaultLayout.h>
 #include <ogdf/basic/Math.h>
+#include <ogdf/basic/ArrayBuffer.h>
+#include <ogdf/basic/ThreadTeam.h>
 #include <algorithm>
 #include <math.h>
 #include <stdlib.h>
@@ -48,368 +50,647 @@
 namespace ogdf
 {
 
-    BertaultLayout::BertaultLayout()
+    //! Parallel iteration of BertaultLayout using a uniform grid over the nodes and edge segments.
+    class BertaultKernel
     {
-        req_length = 0;
-        iter_no = 0;
-        impred = false;
-    }
+    public:
+        BertaultKernel(GraphAttributes & AG, double reqLength, double limit, const Array2D<bool>* pSurr, int numThreads)
+            : m_AG(AG), m_reqLength(reqLength), m_limit(limit), m_pSurr(pSurr), m_team(this, numThreads)
+        {
+            const Graph & G = AG.constGraph();
+            m_n = G.numberOfNodes();
+            m_m = G.numberOfEdges();
+            m_node.init(m_n);
+            m_x.init(m_n);
+            m_y.init(m_n);
+            m_fx.init(m_n);
+            m_fy.init(m_n);
+            m_R.init(9 * m_n);
+            m_cell.init(m_n);
+            NodeArray<int> index(G);
+            int k = 0;
+            node v;
+            forall_nodes(v, G)
+            {
+                index[v] = k;
+                m_node[k] = v;
+                m_x[k] = AG.x(v);
+                m_y[k++] = AG.y(v);
+            }
 
-    BertaultLayout::BertaultLayout(double length, int number)
-    {
-        req_length = length;
-        iter_no = number;
-        impred = false;
-    }
+            m_src.init(m_m);
+            m_tgt.init(m_m);
+            m_edgeId.init(m_m);
+            EdgeArray<int> edgeIndex(G);
+            k = 0;
+            edge e;
+            forall_edges(e, G)
+            {
+                edgeIndex[e] = k;
+                m_src[k] = index[e->source()];
+                m_tgt[k] = index[e->target()];
+                m_edgeId[k++] = e->index();
+            }
 
-    BertaultLayout::BertaultLayout(int number)
-    {
-        req_length = 0;
-        iter_no = number;
-        impred = false;
-    }
+            // adjacency in compressed form
+            m_adjBegin.init(m_n + 1);
+            m_adjNode.init(2 * m_m);
+            m_adjEdge.init(2 * m_m);
+            k = 0;
+            for(int i = 0; i < m_n; i++)
+            {
+                m_adjBegin[i] = k;
+                adjEntry adj;
+                forall_adj(adj, m_node[i])
+                {
+                    m_adjNode[k] = index[adj->twinNode()];
+                    m_adjEdge[k++] = edgeIndex[adj->theEdge()];
+                }
+            }
+            m_adjBegin[m_n] = k;
+
+            m_stamp.init(0, m_team.numThreads() - 1);
+            m_query.init(0, m_team.numThreads() - 1, 0);
+            m_forceEdge.init(0, m_team.numThreads() - 1);
+            m_force.init(0, m_team.numThreads() - 1);
+            m_counterFx.init(m_n);
+            m_counterFy.init(m_n);
+            m_counterR.init(0, m_team.numThreads() - 1);
+            for(int t = 0; t < m_team.numThreads(); t++)
+            {
+                m_stamp[t].init(0, m_m - 1, 0);
+                m_counterR[t].init(9 * m_n);
+            }
+        }
 
-    BertaultLayout::~BertaultLayout()
-    {
-    }
+        //! Performs one iteration.
+        void iterate()
+        {
+            buildGrid();
+            m_team.run(&BertaultKernel::forcesKernel);
+            sumCounterForces();
+            m_team.run(&BertaultKernel::zonesKernel);
+            m_team.run(&BertaultKernel::moveKernel);
+        }
 
-    void BertaultLayout::call(GraphAttributes & AG)
-    {
-        const Graph & G = AG.constGraph();
-        if(G.numberOfNodes() == 0)
-            return;
-        if((AG.attributes() & GraphAttributes::nodeGraphics) == 0)
-            return;
-        if((AG.attributes() & GraphAttributes::edgeGraphics) != 0)
-            AG.clearAllBends();
-        if(iter_no == 0)
-            iter_no = G.numberOfNodes() * 10;
-        if(req_length == 0)
+        //! Writes the positions to the graph attributes.
+        void setPositions() const
         {
-            edge e;
-            forall_edges(e, G)
+            for(int i = 0; i < m_n; i++)
             {
-                node a = e->source();
-                node b = e->target();
-                req_length += sqrt((AG.x(a) - AG.x(b)) * (AG.x(a) - AG.x(b)) + (AG.y(a) - AG.y(b)) * (AG.y(a) - AG.y(b)));
+                m_AG.x(m_node[i]) = m_x[i];
+                m_AG.y(m_node[i]) = m_y[i];
             }
-            req_length = req_length / (G.numberOfEdges());
         }
-        limit = 4 * req_length;             // can be changed... this value is taken in the research paper
-        F_x.init(G);
-        F_y.init(G);
-        sect.init(G);
 
-        //impred=true;
-
-        if(impred)
-            preprocess(AG);
+    private:
+        // the section (1,...,8) containing the vector (dx,dy)
+        static int section(double dx, double dy)
+        {
+            if(dx >= 0)
+            {
+                if(dy >= 0)
+                    return (dx >= dy) ? 1 : 2;
+                return (dx >= -dy) ? 8 : 7;
+            }
+            if(dy >= 0)
+                return (-dx >= dy) ? 4 : 3;
+            return (-dx >= -dy) ? 5 : 6;
+        }
 
-        for(int k = 0; k < iter_no; k++)
+        // limits the radii of the sections first,...,last (modulo 8) of node i in R to r
+        static void limitSections(Array<double> & radii, int i, int first, int last, double r)
         {
-            node v;
-            forall_nodes(v, G)
+            double* R = radii.begin() + 9 * i;
+            for(int s = first; s <= last; s++)
             {
-                //initialise everything
-                F_x[v] = 0;
-                F_y[v] = 0;
-                sect[v].initialize();
-                /*     int i;
-                 for(i=1;i<9;i++)
-                 {
-                     cout << sect[v].R[i];
-                     cout << " ";
-                 }
-                 cout << "\n";*/
+                int num = 1 + ((s - 1) % 8);
+                if(num <= 0)
+                    num += 8;
+                R[num] = min(R[num], r);
+            }
+        }
 
+        // computes the projection (ix,iy) of node v on the line through edge e;
+        // returns true if it lies on the edge
+        bool project(int v, int e, double & ix, double & iy) const
+        {
+            const int a = m_src[e], b = m_tgt[e];
+            double m = (m_y[a] - m_y[b]) / (m_x[a] - m_x[b]);   //slope of edge
+            double n = -1 / m;                                  //slope of a perpendicular
+            double c = m_y[a] - m * m_x[a];                     //y=mx+c for edge
+            double d = m_y[v] - n * m_x[v];                     //y=nx+d for the perpendicular
+            ix = (d - c) / (m - n);
+            iy = m * ix + c;
+            return ((ix <= m_x[a] && ix >= m_x[b]) || (ix >= m_x[a] && ix <= m_x[b]))
+                   && ((iy <= m_y[a] && iy >= m_y[b]) || (iy >= m_y[a] && iy <= m_y[b]));
+        }
+
+        // true if edge e exerts a force on node v (see ImPrEd)
+        bool surrounds(int v, int e) const
+        {
+            return m_pSurr == 0 || (*m_pSurr)(m_node[v]->index(), m_edgeId[e]);
+        }
+
+        // adds the force of the edge with projection (ix,iy) on node v to (fx,fy) with the given sign
+        void edgeForce(int v, double ix, double iy, double sign, double & fx, double & fy) const
+        {
+            double dist = sqrt((m_x[v] - ix) * (m_x[v] - ix) + (m_y[v] - iy) * (m_y[v] - iy));
+            if(dist <= m_limit && dist > 0)
+            {
+                fx += sign * (m_limit - dist) * (m_limit - dist) * (m_x[v] - ix) / dist;
+                fy += sign * (m_limit - dist) * (m_limit - dist) * (m_y[v] - iy) / dist;
             }
+        }
 
-            forall_nodes(v, G)
+        //---------------------------------- grid ----------------------------------
+
+        int colOf(double x) const
+        {
+            double c = (x - m_ox) / m_h;
+            if(!(c > 0))
+                return 0;
+            return (c >= m_cols) ? m_cols - 1 : int(c);
+        }
+
+        int rowOf(double y) const
+        {
+            double r = (y - m_oy) / m_h;
+            if(!(r > 0))
+                return 0;
+            return (r >= m_rows) ? m_rows - 1 : int(r);
+        }
+
+        // the columns c0,...,c1 of row r containing the points within distance rho of
+        // the segment (x1,y1)-(x2,y2); returns false if there are none
+        bool segmentColumns(int r, double x1, double y1, double x2, double y2, double rho, int & c0, int & c1) const
+        {
+            // the outer rows contain everything beyond the grid
+            double y0 = (r == 0) ? -numeric_limits<double>::infinity() : m_oy + r * m_h - rho - m_eps;
+            double yEnd = (r == m_rows - 1) ? numeric_limits<double>::infinity() : m_oy + (r + 1) * m_h + rho + m_eps;
+            double t0 = 0, t1 = 1;
+            double dy = y2 - y1;
+            if(dy != 0)
             {
-                node j;
-                //calculate total node-node repulsive force
-                forall_nodes(j, G)
-                {
-                    if(j != v)
-                        f_Node_Repulsive(&v, &j, AG);
-                }
+                double a = (y0 - y1) / dy, b = (yEnd - y1) / dy;
+                if(a > b)
+                    std::swap(a, b);
+                t0 = max(t0, a);
+                t1 = min(t1, b);
+                if(t0 > t1)
+                    return false;
+            }
+            else if(y1 < y0 || y1 > yEnd)
+                return false;
+            double xa = x1 + t0 * (x2 - x1), xb = x1 + t1 * (x2 - x1);
+            if(xa > xb)
+                std::swap(xa, xb);
+            c0 = colOf(xa - rho - m_eps);
+            c1 = colOf(xb + rho + m_eps);
+            return true;
+        }
 
-                //calculate total node-node attractive force
-                adjEntry adj;
-                forall_adj(adj, v)
+        // assigns the edges to the cells of the grid they pass through
+        void buildGrid()
+        {
+            double minX = numeric_limits<double>::max(), maxX = -minX;
+            double minY = minX, maxY = maxX;
+            for(int i = 0; i < m_n; i++)
+            {
+                if(m_x[i] < minX) minX = m_x[i];
+                if(m_x[i] > maxX) maxX = m_x[i];
+                if(m_y[i] < minY) minY = m_y[i];
+                if(m_y[i] > maxY) maxY = m_y[i];
+            }
+            if(!(minX <= maxX))
+                minX = maxX = 0;
+            if(!(minY <= maxY))
+                minY = maxY = 0;
+
+            // cells of the size of the force range, but not more than about 2(n+m) cells
+            const double maxCells = 2.0 * (m_n + m_m);
+            const double w = maxX - minX, h = maxY - minY;
+            m_h = max(m_limit, max(sqrt(w * h / maxCells), max(w, h) / maxCells));
+            if(!(m_h > 0) || m_h == numeric_limits<double>::infinity())
+                m_h = 1;
+            m_ox = minX;
+            m_oy = minY;
+            m_cols = (int)min(maxCells, w / m_h) + 1;
+            m_rows = (int)min(maxCells, h / m_h) + 1;
+            m_eps = 1e-9 * m_h;
+            const int numCells = m_cols * m_rows;
+
+            // the nodes
+            m_nodeCellBegin.init(0, numCells, 0);
+            for(int i = 0; i < m_n; i++)
+            {
+                m_cell[i] = rowOf(m_y[i]) * m_cols + colOf(m_x[i]);
+                m_nodeCellBegin[m_cell[i] + 1]++;
+            }
+            for(int c = 0; c < numCells; c++)
+                m_nodeCellBegin[c + 1] += m_nodeCellBegin[c];
+            m_nodeCellEntry.init(max(1, m_n));
+            Array<int> pos(numCells);
+            for(int c = 0; c < numCells; c++)
+                pos[c] = m_nodeCellBegin[c];
+            for(int i = 0; i < m_n; i++)
+                m_nodeCellEntry[pos[m_cell[i]]++] = i;
+
+            // the edges are assigned to all cells they pass through
+            m_edgeCellBegin.init(0, numCells, 0);
+            for(int pass = 0; pass < 2; pass++)
+            {
+                if(pass == 1)
                 {
-                    node ad = adj->twinNode();
-                    f_Node_Attractive(&v, &ad, AG);
+                    for(int c = 0; c < numCells; c++)
+                        m_edgeCellBegin[c + 1] += m_edgeCellBegin[c];
+                    m_edgeCellEntry.init(max(1, m_edgeCellBegin[numCells]));
+                    for(int c = 0; c < numCells; c++)
+                        pos[c] = m_edgeCellBegin[c];
                 }
-                //calculate total node-edge repulsive force
-                edge e;
-                forall_edges(e, G)
+                for(int e = 0; e < m_m; e++)
                 {
-                    if(e->target() != v && e->source() != v)
+                    const int a = m_src[e], b = m_tgt[e];
+                    int r0 = rowOf(min(m_y[a], m_y[b]) - m_eps), r1 = rowOf(max(m_y[a], m_y[b]) + m_eps);
+                    for(int r = r0; r <= r1; r++)
                     {
-
-                        compute_I(&v, &e, AG);          //computes the projection
-
-                        if(i_On_Edge(&e, AG))       //computes if projection is on the edge
+                        int c0, c1;
+                        if(!segmentColumns(r, m_x[a], m_y[a], m_x[b], m_y[b], 0, c0, c1))
+                            continue;
+                        for(int c = c0; c <= c1; c++)
                         {
-                            if((!impred) || surr(v->index(), e->index()) == 1)
-                            {
-                                f_Edge(&v, &e, AG);
-                            }
-                            r_Calc_On_Edge(&v, &e, AG);                 // updates values of section radii
+                            if(pass == 0)
+                                m_edgeCellBegin[r * m_cols + c + 1]++;
+                            else
+                                m_edgeCellEntry[pos[r * m_cols + c]++] = e;
                         }
-                        else
+                    }
+                }
+            }
+        }
+
+        // collects the edges passing through the cells within distance rho of node v
+        void edgesNear(int t, int v, double rho, ArrayBuffer<int> & edges)
+        {
+            edges.clear();
+            Array<int> & stamp = m_stamp[t];
+            if(m_query[t] == numeric_limits<int>::max())
+            {
+                stamp.fill(0);
+                m_query[t] = 0;
+            }
+            const int query = ++m_query[t];
+            const int c0 = colOf(m_x[v] - rho - m_eps), c1 = colOf(m_x[v] + rho + m_eps);
+            const int r0 = rowOf(m_y[v] - rho - m_eps), r1 = rowOf(m_y[v] + rho + m_eps);
+            for(int r = r0; r <= r1; r++)
+                for(int c = c0; c <= c1; c++)
+                {
+                    const int cell = r * m_cols + c;
+                    for(int k = m_edgeCellBegin[cell]; k < m_edgeCellBegin[cell + 1]; k++)
+                    {
+                        int e = m_edgeCellEntry[k];
+                        if(stamp[e] != query)
                         {
-                            r_Calc_Outside_Edge(&v, &e, AG);            // updates values of section radii
+                            stamp[e] = query;
+                            if(m_src[e] != v && m_tgt[e] != v)
+                                edges.push(e);
                         }
-
                     }
                 }
-            }
+        }
 
-            forall_nodes(v, G)
+        // collects the nodes in the cells within distance rho of edge e (except its end nodes)
+        void nodesNear(int e, double rho, ArrayBuffer<int> & nodes) const
+        {
+            nodes.clear();
+            const int a = m_src[e], b = m_tgt[e];
+            int r0 = rowOf(min(m_y[a], m_y[b]) - rho - m_eps), r1 = rowOf(max(m_y[a], m_y[b]) + rho + m_eps);
+            for(int r = r0; r <= r1; r++)
             {
-                /*   cout << "F_x : ";
-                cout << F_x[v];
-
-                cout << "   F_y : ";
-                cout << F_y[v];
-                cout << "\n";
-                */
-                //moves the nodes according to forces
-                move(&v, AG);
-                /*
-                cout << "move_x : ";
-                cout << F_x[v];
-
-                cout << "   move_y : ";
-                cout << F_y[v];
-                cout << "\n";
-
-                int i;
-                for(i=1;i<9;i++)
+                int c0, c1;
+                if(!segmentColumns(r, m_x[a], m_y[a], m_x[b], m_y[b], rho, c0, c1))
+                    continue;
+                for(int c = c0; c <= c1; c++)
                 {
-                    cout << sect[v].R[i];
-                    cout << " ";
+                    const int cell = r * m_cols + c;
+                    for(int k = m_nodeCellBegin[cell]; k < m_nodeCellBegin[cell + 1]; k++)
+                    {
+                        int w = m_nodeCellEntry[k];
+                        if(w != a && w != b)
+                            nodes.push(w);
+                    }
                 }
-                cout << "\n\n";*/
             }
         }
 
-    }
-
+        //--------------------------------- kernels --------------------------------
 
-    void BertaultLayout::f_Node_Repulsive(node* v, node* j, GraphAttributes & AG)
-    {
-        double dist = sqrt((AG.x(*v) - AG.x(*j)) * (AG.x(*v) - AG.x(*j)) + (AG.y(*v) - AG.y(*j)) * (AG.y(*v) - AG.y(*j)));
-        (F_x)[*v] += ((req_length) / dist) * ((req_length) / dist) * (AG.x(*v) - AG.x(*j));
-        (F_y)[*v] += ((req_length) / dist) * ((req_length) / dist) * (AG.y(*v) - AG.y(*j));
-    }
+        // the total force on every node and the radii of its zones due to the pairs
+        // of a node and an edge within the force range
+        void forcesKernel(int t)
+        {
+            const int begin = threadRangeBegin(m_n, t, m_team.numThreads());
+            const int end = threadRangeBegin(m_n, t + 1, m_team.numThreads());
+
+            // the node-edge forces and the zones of the end nodes of the edges found by this thread
+            ArrayBuffer<int> & forceEdge = m_forceEdge[t];
+            ArrayBuffer<DPoint> & force = m_force[t];
+            Array<double> & counterR = m_counterR[t];
+            forceEdge.clear();
+            force.clear();
+            counterR.fill(numeric_limits<double>::max());
+
+            ArrayBuffer<int> candidates;
+            for(int v = begin; v < end; v++)
+            {
+                double fx = 0, fy = 0;
+                for(int s = 0; s < 9; s++)
+                    m_R[9 * v + s] = numeric_limits<double>::max();
 
-    void BertaultLayout::f_Node_Attractive(node* v, node* j, GraphAttributes & AG)
-    {
-        double dist = sqrt((AG.x(*v) - AG.x(*j)) * (AG.x(*v) - AG.x(*j)) + (AG.y(*v) - AG.y(*j)) * (AG.y(*v) - AG.y(*j)));
-        (F_x)[*v] += (-(dist / req_length) * (AG.x(*v) - AG.x(*j)));
-        (F_y)[*v] += (-(dist / req_length) * (AG.y(*v) - AG.y(*j)));
-    }
+                //node-node repulsive forces
+                for(int j = 0; j < m_n; j++)
+                {
+                    if(j == v)
+                        continue;
+                    double dist = sqrt((m_x[v] - m_x[j]) * (m_x[v] - m_x[j]) + (m_y[v] - m_y[j]) * (m_y[v] - m_y[j]));
+                    fx += (m_reqLength / dist) * (m_reqLength / dist) * (m_x[v] - m_x[j]);
+                    fy += (m_reqLength / dist) * (m_reqLength / dist) * (m_y[v] - m_y[j]);
+                }
 
-    void BertaultLayout::compute_I(node* v, edge* e, GraphAttributes & AG)
-    {
-        node a = (*e)->source();
-        node b = (*e)->target();
-        double m = (AG.y(a) - AG.y(b)) / (AG.x(a) - AG.x(b));   //slope of edge
-        double n = -1 / m;                                  //slope of a perpendicular
-        double c = AG.y(a) - m * (AG.x(a));                     //y=mx+c for edge
-        double d = AG.y(*v) - n * (AG.x(*v));                   //y=nx+d for the perpendicular
-        i.x = (d - c) / (m - n);                                //solve for x
-        i.y = m * i.x + c;                                      //solve for y
-    }
+                //node-node attractive forces
+                for(int k = m_adjBegin[v]; k < m_adjBegin[v + 1]; k++)
+                {
+                    int j = m_adjNode[k];
+                    double dist = sqrt((m_x[v] - m_x[j]) * (m_x[v] - m_x[j]) + (m_y[v] - m_y[j]) * (m_y[v] - m_y[j]));
+                    fx += -(dist / m_reqLength) * (m_x[v] - m_x[j]);
+                    fy += -(dist / m_reqLength) * (m_y[v] - m_y[j]);
+                }
 
-    bool BertaultLayout::i_On_Edge(edge* e, GraphAttributes & AG)
-    {
-        node a = (*e)->source();
-        node b = (*e)->target();
-        return ((i.x <= AG.x(a) && i.x >= AG.x(b)) || (i.x >= AG.x(a) && i.x <= AG.x(b))) && ((i.y <= AG.y(a) && i.y >= AG.y(b)) || (i.y >= AG.y(a) && i.y <= AG.y(b))); // x and y coordinates of i must be in between that of a and b
-    }
+                //node-edge forces of the edges close to v and the zones of v and the
+                //end nodes of the edges
+                double ix, iy;
+                edgesNear(t, v, m_limit, candidates);
+                for(int k = 0; k < candidates.size(); k++)
+                {
+                    int e = candidates[k];
+                    const int a = m_src[e], b = m_tgt[e];
+                    if(project(v, e, ix, iy))
+                    {
+                        if(surrounds(v, e))
+                        {
+                            double gx = 0, gy = 0;
+                            edgeForce(v, ix, iy, 1, gx, gy);
+                            fx += gx;
+                            fy += gy;
+                            forceEdge.push(e);
+                            force.push(DPoint(gx, gy));
+                        }
+                        int s = section(ix - m_x[v], iy - m_y[v]);
+                        double dist = sqrt((ix - m_x[v]) * (ix - m_x[v]) + (iy - m_y[v]) * (iy - m_y[v]));
+                        limitSections(m_R, v, s - 2, s + 2, dist / 3);
+                        limitSections(counterR, a, s + 2, s + 6, dist / 3);
+                        limitSections(counterR, b, s + 2, s + 6, dist / 3);
+                    }
+                    else
+                    {
+                        double dav = sqrt((m_x[v] - m_x[a]) * (m_x[v] - m_x[a]) + (m_y[v] - m_y[a]) * (m_y[v] - m_y[a]));
+                        double dbv = sqrt((m_x[v] - m_x[b]) * (m_x[v] - m_x[b]) + (m_y[v] - m_y[b]) * (m_y[v] - m_y[b]));
+                        limitSections(m_R, v, 1, 8, min(dav, dbv) / 3);
+                        limitSections(counterR, a, 1, 8, dav / 3);
+                        limitSections(counterR, b, 1, 8, dbv / 3);
+                    }
+                }
 
-    void BertaultLayout::f_Edge(node* v, edge* e, GraphAttributes & AG)
-    {
-        double dist = sqrt((AG.x(*v) - i.x) * (AG.x(*v) - i.x) + (AG.y(*v) - i.y) * (AG.y(*v) - i.y));
-        if(dist <= limit && dist > 0)
-        {
-            double fx = (limit - dist) * (limit - dist) * (AG.x(*v) - i.x) / dist;
-            double fy = (limit - dist) * (limit - dist) * (AG.y(*v) - i.y) / dist;
-            (F_x)[*v] += fx;
-            (F_y)[*v] += fy;
-            node a = (*e)->source();
-            node b = (*e)->target();
-            (F_x)[a] -= fx;
-            (F_y)[a] -= fy;
-            (F_x)[b] -= fx;
-            (F_y)[b] -= fy;
+                m_fx[v] = fx;
+                m_fy[v] = fy;
+            }
         }
-    }
 
-    void BertaultLayout::r_Calc_On_Edge(node* v, edge* e, GraphAttributes & AG)
-    {
-        node a = (*e)->source();
-        node b = (*e)->target();
-        int s = 0;
-        double x_diff = i.x - AG.x(*v);
-        double y_diff = i.y - AG.y(*v);
-
-        //determines the section in which the line-segment (v,i) lies
-        if(x_diff >= 0)
+        // sums the counter forces on the end nodes of the edges in the order of the
+        // nodes exerting them, so that the sums do not depend on the number of threads
+        void sumCounterForces()
         {
-            if(y_diff >= 0)
+            m_counterFx.fill(0);
+            m_counterFy.fill(0);
+            for(int t = 0; t < m_team.numThreads(); t++)
             {
-                if(x_diff >= y_diff)
-                    s = 1;
-                else
-                    s = 2;
+                const ArrayBuffer<int> & forceEdge = m_forceEdge[t];
+                const ArrayBuffer<DPoint> & force = m_force[t];
+                for(int k = 0; k < forceEdge.size(); k++)
+                {
+                    const int e = forceEdge[k];
+                    m_counterFx[m_src[e]] -= force[k].m_x;
+                    m_counterFy[m_src[e]] -= force[k].m_y;
+                    m_counterFx[m_tgt[e]] -= force[k].m_x;
+                    m_counterFy[m_tgt[e]] -= force[k].m_y;
+                }
             }
-            else
+        }
+
+        // the move of every node, i.e., its force limited to the radius of the zone in
+        // its direction; a pair of a node and an edge limits a zone of the node only
+        // to a third of their distance or more, so the pairs within the force range
+        // determine the zones up to a third of the range; longer moves are checked
+        // against the pairs within distance rho, doubling rho until the radius of the
+        // section of the move is at most rho/3 or rho is at least three times the move
+        void zonesKernel(int t)
+        {
+            const int begin = threadRangeBegin(m_n, t, m_team.numThreads());
+            const int end = threadRangeBegin(m_n, t + 1, m_team.numThreads());
+            const int numThreads = m_team.numThreads();
+            const double maxRho = m_h * (m_cols + m_rows);
+            ArrayBuffer<int> candidates;
+            for(int v = begin; v < end; v++)
             {
-                if(x_diff >= -(y_diff))
-                    s = 8;
-                else
-                    s = 7;
+                // add the counter forces and the zones found by all threads
+                double fx = m_fx[v] + m_counterFx[v], fy = m_fy[v] + m_counterFy[v];
+                const int s = section(fx, fy);
+                double radius = m_R[9 * v + s];
+                for(int u = 0; u < numThreads; u++)
+                    radius = min(radius, m_counterR[u][9 * v + s]);
+                double mov_mag = sqrt(fx * fx + fy * fy);
+
+                double rho = m_limit;
+                while(3 * radius > rho && rho < 3 * mov_mag && rho <= maxRho)
+                {
+                    rho = min(2 * rho, 3 * mov_mag * (1 + 1e-6));
+                    limitZones(t, v, rho, candidates);
+                    radius = min(radius, m_R[9 * v + s]);
+                }
+
+                if(radius < mov_mag)
+                {
+                    fx = (fx / mov_mag) * radius;
+                    fy = (fy / mov_mag) * radius;
+                }
+                m_fx[v] = fx;
+                m_fy[v] = fy;
             }
         }
-        else
+
+        // limits the radii of the zones of node v by the pairs within distance rho
+        void limitZones(int t, int v, double rho, ArrayBuffer<int> & candidates)
         {
-            if(y_diff >= 0)
+            double ix, iy;
+
+            //v is the node
+            edgesNear(t, v, rho, candidates);
+            for(int k = 0; k < candidates.size(); k++)
             {
-                if(-(x_diff) >= y_diff)
-                    s = 4;
+                int e = candidates[k];
+                const int a = m_src[e], b = m_tgt[e];
+                if(project(v, e, ix, iy))
+                {
+                    int s = section(ix - m_x[v], iy - m_y[v]);
+                    double dist = sqrt((ix - m_x[v]) * (ix - m_x[v]) + (iy - m_y[v]) * (iy - m_y[v]));
+                    limitSections(m_R, v, s - 2, s + 2, dist / 3);
+                }
                 else
-                    s = 3;
+                {
+                    double dav = sqrt((m_x[v] - m_x[a]) * (m_x[v] - m_x[a]) + (m_y[v] - m_y[a]) * (m_y[v] - m_y[a]));
+                    double dbv = sqrt((m_x[v] - m_x[b]) * (m_x[v] - m_x[b]) + (m_y[v] - m_y[b]) * (m_y[v] - m_y[b]));
+                    limitSections(m_R, v, 1, 8, min(dav, dbv) / 3);
+                }
             }
-            else
+
+            //v is an end node of the edge
+            for(int k = m_adjBegin[v]; k < m_adjBegin[v + 1]; k++)
             {
-                if(-(x_diff) >= -(y_diff))
-                    s = 5;
-                else
-                    s = 6;
+                int e = m_adjEdge[k];
+                nodesNear(e, rho, candidates);
+                for(int l = 0; l < candidates.size(); l++)
+                {
+                    int w = candidates[l];
+                    if(project(w, e, ix, iy))
+                    {
+                        int s = section(ix - m_x[w], iy - m_y[w]);
+                        double dist = sqrt((ix - m_x[w]) * (ix - m_x[w]) + (iy - m_y[w]) * (iy - m_y[w]));
+                        limitSections(m_R, v, s + 2, s + 6, dist / 3);
+                    }
+                    else
+                    {
+                        double dvw = sqrt((m_x[w] - m_x[v]) * (m_x[w] - m_x[v]) + (m_y[w] - m_y[v]) * (m_y[w] - m_y[v]));
+                        limitSections(m_R, v, 1, 8, dvw / 3);
+                    }
+                }
             }
         }
 
-        OGDF_ASSERT(s != 0);        //section>=1
-        double max_radius = (sqrt(x_diff * x_diff + y_diff * y_diff)) / 3;
-
-        //cout << "node:" << (*v)->index() << "edge:" << (*e)->index() << "between" << a->index() << "and" << b->index() << "INSIDE\nsection:" << s << "x_a:" << AG.x(a) << "x_b:" << AG.x(b) << "y_a:" << AG.y(a) << "y_b:" << AG.y(b) << "i_x:" << i.x << "i_y:" << i.y << "dist_v-i:" << max_radius*3 << "\n\n" ;
-
-        //  if(max_radius>=0)
-        //{
-        int r, num;
-        //determines which sections should have their values changed
-        for(r = s - 2; r <= (s + 2); r++)
+        // moves every node by its move
+        void moveKernel(int t)
         {
-            num = 1 + ((r - 1) % 8);
-            if(num <= 0)
-                num += 8;
-            (sect)[*v].R[num] = min((sect)[*v].R[num], max_radius);
-        }
-        for(r = s + 2; r <= (s + 6); r++)
-        {
-            num = 1 + ((r - 1) % 8);
-            if(num <= 0)
-                num += 8;
-            (sect)[a].R[num] = min((sect)[a].R[num], max_radius);
-            (sect)[b].R[num] = min((sect)[b].R[num], max_radius);
-        }
-        //}
-        /*int i;
-        for(i=1;i<9;i++)
-        {
-            cout << sect[*v].R[i];
-            cout << " ";
+            const int begin = threadRangeBegin(m_n, t, m_team.numThreads());
+            const int end = threadRangeBegin(m_n, t + 1, m_team.numThreads());
+            for(int v = begin; v < end; v++)
+            {
+                m_x[v] += m_fx[v];
+                m_y[v] += m_fy[v];
+            }
         }
-        cout << "\n";*/
-    }
+
+        GraphAttributes & m_AG;
+        const double m_reqLength;
+        const double m_limit;
+        const Array2D<bool>* m_pSurr; //!< the surrounding edges (0 if not ImPrEd)
+
+        int m_n;
+        int m_m;
+        Array<node> m_node;
+        Array<double> m_x, m_y;     //!< positions
+        Array<double> m_fx, m_fy;   //!< forces
+        Array<double> m_R;          //!< radii of the sections 1,...,8 of node i at 9 * i + s
+        Array<ArrayBuffer<int>> m_forceEdge; //!< per thread, the edges exerting the node-edge forces m_force
+        Array<ArrayBuffer<DPoint>> m_force;
+        Array<double> m_counterFx, m_counterFy; //!< the counter forces on the end nodes of the edges
+        Array<Array<double>> m_counterR; //!< per thread, the radii of the zones due to the edges of a node
+        Array<int> m_src, m_tgt;
+        Array<int> m_edgeId;        //!< the indices of the edges in the graph
+        Array<int> m_adjBegin;
+        Array<int> m_adjNode;
+        Array<int> m_adjEdge;
+
+        double m_ox, m_oy;          //!< lower left corner of the grid
+        double m_h;                 //!< cell size
+        double m_eps;               //!< tolerance for rounding errors
+        int m_cols, m_rows;
+        Array<int> m_cell;          //!< the cell of each node
+        Array<int> m_nodeCellBegin; //!< nodes of cell c are m_nodeCellEntry[m_nodeCellBegin[c]],...
+        Array<int> m_nodeCellEntry;
+        Array<int> m_edgeCellBegin; //!< edges passing through cell c are m_edgeCellEntry[m_edgeCellBegin[c]],...
+        Array<int> m_edgeCellEntry;
+
+        Array<Array<int>> m_stamp;  //!< per thread, marks the edges found by the current query
+        Array<int> m_query;         //!< per thread, number of the current query
+
+        ThreadTeam<BertaultKernel> m_team;
+    };
 
 
-    void BertaultLayout::r_Calc_Outside_Edge(node* v, edge* e, GraphAttributes & AG)
+    BertaultLayout::BertaultLayout()
     {
-        node a = (*e)->source();
-        node b = (*e)->target();
-        double dav = sqrt((AG.x(*v) - AG.x(a)) * (AG.x(*v) - AG.x(a)) + (AG.y(*v) - AG.y(a)) * (AG.y(*v) - AG.y(a)));
-        double dbv = sqrt((AG.x(*v) - AG.x(b)) * (AG.x(*v) - AG.x(b)) + (AG.y(*v) - AG.y(b)) * (AG.y(*v) - AG.y(b)));
-        //cout << "node:" << (*v)->index() << "edge:" << (*e)->index() << "between" << a->index() << "and" << b->index() << "OUTSIDE\ndist_v_a:" << dav << "dist_v_b:" << dbv << "\n\n" ;
-
-        int r;
-        for(r = 1; r <= 8; r++)
-        {
-            (sect)[*v].R[r] = min((sect)[*v].R[r], min(dav, dbv) / 3);
-            (sect)[a].R[r] = min((sect)[a].R[r], dav / 3);
-            (sect)[b].R[r] = min((sect)[b].R[r], dbv / 3);
-        }
+        req_length = 0;
+        iter_no = 0;
+        impred = false;
+        m_numberOfThreads = 1;
+    }
 
-        /*int i;
-        for(i=1;i<9;i++)
-        {
-            cout << sect[*v].R[i];
-            cout << " ";
-        }
-        cout << "\n";*/
+    BertaultLayout::BertaultLayout(double length, int number)
+    {
+        req_length = length;
+        iter_no = number;
+        impred = false;
+        m_numberOfThreads = 1;
     }
 
-    void BertaultLayout::move(node* v, GraphAttributes & AG)
+    BertaultLayout::BertaultLayout(int number)
     {
-        int s = 0;
-        double x_diff = (F_x)[*v];
-        double y_diff = (F_y)[*v];
+        req_length = 0;
+        iter_no = number;
+        impred = false;
+        m_numberOfThreads = 1;
+    }
 
-        //determines the section in which the node has to move
-        if(x_diff >= 0)
-        {
-            if(y_diff >= 0)
-            {
-                if(x_diff >= y_diff)
-                    s = 1;
-                else
-                    s = 2;
-            }
-            else
-            {
-                if(x_diff >= -(y_diff))
-                    s = 8;
-                else
-                    s = 7;
-            }
-        }
-        else
+    BertaultLayout::~BertaultLayout()
+    {
+    }
+
+    void BertaultLayout::call(GraphAttributes & AG)
+    {
+        const Graph & G = AG.constGraph();
+        if(G.numberOfNodes() == 0)
+            return;
+        if((AG.attributes() & GraphAttributes::nodeGraphics) == 0)
+            return;
+        if((AG.attributes() & GraphAttributes::edgeGraphics) != 0)
+            AG.clearAllBends();
+        if(iter_no == 0)
+            iter_no = G.numberOfNodes() * 10;
+        if(req_length == 0)
         {
-            if(y_diff >= 0)
-            {
-                if(-(x_diff) >= y_diff)
-                    s = 4;
-                else
-                    s = 3;
-            }
-            else
+            edge e;
+            forall_edges(e, G)
             {
-                if(-(x_diff) >= -(y_diff))
-                    s = 5;
-                else
-                    s = 6;
+                node a = e->source();
+                node b = e->target();
+                req_length += sqrt((AG.x(a) - AG.x(b)) * (AG.x(a) - AG.x(b)) + (AG.y(a) - AG.y(b)) * (AG.y(a) - AG.y(b)));
             }
+            req_length = req_length / (G.numberOfEdges());
         }
+        limit = 4 * req_length;             // can be changed... this value is taken in the research paper
 
-        OGDF_ASSERT(s != 0);
+        //impred=true;
 
-        double mov_mag = sqrt((x_diff * x_diff) + (y_diff * y_diff)); // the length of the move
-        if((sect)[*v].R[s] < mov_mag)                               // if move is greater than zone(section) radius
-        {
-            // magnitudes of forces are normalised so that the length becomes equal to the radius
-            (F_x)[*v] = ((F_x)[*v] / mov_mag) * (sect)[*v].R[s];            // and the move will now take the node on the arc of that section
-            (F_y)[*v] = ((F_y)[*v] / mov_mag) * (sect)[*v].R[s];
-        }
-        //moves the node
-        AG.x(*v) += (F_x)[*v];
-        AG.y(*v) += (F_y)[*v];
+        if(impred)
+            preprocess(AG);
+
+        const int numThreads = max(1, min(m_numberOfThreads, G.numberOfNodes() / 100));
+        BertaultKernel kernel(AG, req_length, limit, impred ? &surr : 0, numThreads);
+        for(int k = 0; k < iter_no; k++)
+            kernel.iterate();
+        kernel.setPositions();
     }
 
+
     void BertaultLayout::initPositions(GraphAttributes & AG, char c)
     {
         if((AG.attributes() & GraphAttributes::nodeGraphics) == 0 && (c == 'c' || c == 'm' || c == 'r'))
@@ -478,11 +759,6 @@ namespace ogdf
 
                             AG.x(v) = r * cs;
                             AG.y(v) = r * sn;
-                            /*  if((AG.x(v)*AG.x(v)+AG.y(v)*AG.y(v))!=r*r)
-                            {
-                                cout << (AG.x(v)*AG.x(v)+AG.y(v)*AG.y(v))-(r*r);
-                                cout << "\n";
-                            }*/
                         }
                         else if(c == 'm')
                         {
@@ -556,7 +832,6 @@ namespace ogdf
         int i;
         //List< node > list;
 
-        //cout << numCC <<"\n";
 
         List<CCElement*> forest;
         Array<CCElement> Carr(numCC);
@@ -573,16 +848,6 @@ namespace ogdf
             int rootnum = 0, flag = 0;
             while(rootnum < forest.size())
             {
-                /* //CCElement *Croot=&(**(forest.get(rootnum)));
-                cout << "Children of " << (**(forest.get(rootnum))).num <<"bfor calling :\n";
-                int k;
-                for(k=0;k<(**(forest.get(rootnum))).child.size();k++)
-                {
-                    cout << (*((**(forest.get(rootnum))).child.get(k)))->num << "\n";
-                }
-                cout << "Inserting " << (*new1).num << " into " << (**(forest.get(rootnum))).num << "\n";
-                //*/
-
                 int retv = insert(new1, &(**(forest.get(rootnum))), AG1, PG);
                 if(retv == 2)
                 {
@@ -593,7 +858,6 @@ namespace ogdf
                 {
                     (**(forest.get(rootnum))).root = false;
                     //ListIterator<CCElement> l((*(forest.get(rootnum))));
-                    //cout << (**forest.get(rootnum)).num << " deleted\n";
                     forest.del(forest.get(rootnum));
                     rootnum--;
                 }
@@ -606,39 +870,11 @@ namespace ogdf
                 (*new1).root = true;
 
                 forest.pushBack(&(*new1));
-                /*
-                cout << (*new1).num << " is a root now " << "\nChildren of " << (*new1).num << ":\n";
-                int j;
-                for(j=0;j<(*new1).child.size();j++)
-                {
-                    cout << (*((*new1).child.get(j)))->num << "\n";
-                }
-                //*/
             }
         }
 
         // Uncomment below statements to see output... for debugging use
 
-
-        //cout << "forest size : " << forest.size();
-        /*
-            for(i=0;i<forest.size();i++)
-            {
-                cout << "\nRoot : " << i <<"\n";
-                compute(*forest.get(i),PG,AG1,G1);
-            }
-        //*/
-
-        /*
-            forall_nodes(v,G)
-            {
-                forall_edges(e,G)
-                {
-                    cout<< surr(v->index(),e->index()) <<" ";
-                }
-                cout << "\n";
-            }
-            //*/
         /*
             node n=G.chooseNode();
             AG.fillColor(n)="RED";
@@ -693,7 +929,6 @@ namespace ogdf
 
                     if(xinc * yinc < 0 && ainc * binc < 0)
                     {
-                        //cout << "edge " << e->index() << " and edge " << i->index() << " between nodes " << a->index() << " and " << b->index() << " and nodes " << x->index() << " and " << y->index() << "\n";
                         int temp = AG.intWeight(e);
                         edge enew = G.split(e);
                         node nnew = enew->source();
@@ -719,13 +954,6 @@ namespace ogdf
         if(contface != -1)
         {
             int flag = 0, i;
-            /*
-                cout << "Children of " << (*element).num <<"bfor :\n";
-                for(i=0;i<(*element).child.size();i++)
-                {
-                    cout << (*((*element).child.get(i)))->num << "\n";
-                }
-            //*/
             if((*element).child.size() != 0)
             {
 
@@ -734,7 +962,6 @@ namespace ogdf
                     CCElement* child = &(**((*element).child.get(i)));
                     if(child->faceNum == contface)
                     {
-                        //cout << "Gonna insert " << (*new1).num << " in " << child->num << "\n";
 
                         int retv = insert(new1, child, PAG, PG);
                         if(retv == 2)
@@ -755,20 +982,6 @@ namespace ogdf
                 (*new1).parent = &(*element);
                 (*new1).faceNum = contface;
                 (*element).child.pushBack(&(*new1));
-                /*
-                  cout << (*new1).num << " is child of " << new1->parent->num << "\nChildren of " << (*element).num << ":\n";
-                  for(i=0;i<(*element).child.size();i++)
-                  {
-                      cout << (*((*element).child.get(i)))->num << "\n";
-                  }
-
-                  cout << "Children of " << (*new1).num <<" ("<< (*new1).child.size() <<"):\n";
-                  for(i=0;i<(*new1).child.size();i++)
-                  {
-                      cout << (*((*new1).child.get(i)))->num << "\n";
-                  }
-                //*/
-
             }
             return 2;
         }
@@ -785,18 +998,6 @@ namespace ogdf
                 (*element).faceNum = contface;
                 (*element).parent = new1;
                 (*new1).child.pushBack(element);
-
-                /*
-                cout << "Pushed " << (*element).num << " into " << (*new1).num << "\n";
-
-                cout << (*new1).num << " is parent of " << (*element).num << "\nChildren of " << (*new1).num << ":\n";
-
-                int i;
-                for(i=0;i<(*new1).child.size();i++)
-                {
-                    cout << (**((*new1).child.get(i))).num << "\n";
-                }
-                //*/
                 return 1;
             }
             else
@@ -818,11 +1019,8 @@ namespace ogdf
         double yc = PAG.y(PG.original(v));
         double xc = PAG.x(PG.original(v));
 
-        //cout << "Number of edges in " << new1->num << " is " << PG.numberOfEdges() << "\n";
 
         PG.initCC(element->num);
-        //cout << "Number of edges in " << element->num << " is " << PG.numberOfEdges() << "\n";
-        //cout << "Chosen " << xc;
         ConstCombinatorialEmbedding E(PG);
         E.computeFaces();
         face f;
@@ -853,7 +1051,6 @@ namespace ogdf
 
             if(crossings % 2 != 0)
             {
-                //cout << "yo";
                 return f->index();
             }
         }
@@ -871,7 +1068,6 @@ namespace ogdf
         face f;
         forall_faces(f, E)
         {
-            //cout<<"yeah";
             adjEntry adj;
             forall_face_adj(adj, f)
             {
@@ -886,11 +1082,9 @@ namespace ogdf
                 node v = G1.original(PG.original(ver));
                 node v2 = G1.original(PG.original(ver2));
 
-                //cout << v->index() << "\n";
                 adjEntry adj1 = f->firstAdj(), adj3 = adj1;
                 do
                 {
-                    //cout<<"lala\n";
                     if(!dum)
                         surr(v->index(), AG1.intWeight(PG.original(adj3->theEdge()))) = true;
                     if(!dum2)
@@ -950,7 +1144,6 @@ namespace ogdf
                 PG.initCC(num);
             }
         }
-        //cout << num <<" Done\n";
 
         int i;
         for(i = 0; i < element->child.size(); i++)
@@ -995,21 +1188,18 @@ namespace ogdf
 
                     if(((xinc * yinc < 0 && ainc * binc < 0) || (xinc * yinc == 0 && ainc * binc < 0) || (xinc * yinc < 0 && ainc * binc == 0)))
                     {
-                        // cout << "edge " << e->index() << " and edge " << i->index() << " between nodes " << a->index() << " and " << b->index() << " and nodes " << x->index() << " and " << y->index() << "\n";
                         crossings++;
                     }
                     else
                     {
                         if(m == m2 && c == c2 && distax < d && distay < d && distbx < d && distby < d)
                         {
-                            //cout << "edge " << e->index() << " and edge " << i->index() << " between nodes " << a->index() << " and " << b->index() << " and nodes " << x->index() << " and " << y->index() << "OVERLAP\n";
                             crossings += 2;
                         }
                     }
                 }
                 else if(m == m2 && c == c2 && distax < d && distay < d && distbx < d && distby < d && ((a != y && b != x && b != y) || (a != x && b != x && b != y) || (a != y && a != x && b != y) || (a != y && a != x && b != x)))
                 {
-                    //cout << "edge " << e->index() << " and edge " << i->index() << " between nodes " << a->index() << " and " << b->index() << " and nodes " << x->index() << " and " << y->index() << "OVERLAP\n";
                     crossings += 1;
                 }
 
@@ -1038,10 +1228,6 @@ namespace ogdf
             stdev += (el[e] - mean) * (el[e] - mean);
         }
         stdev = sqrt(stdev / (G.numberOfEdges())) / mean;
-        /* cout << "\n";
-        cout << "mean : ";
-        cout << mean;
-        cout << "\n";*/
         return stdev;
     }
 
@@ -1089,11 +1275,9 @@ namespace ogdf
             for(i = 0; i < rows; i++)
                 for(j = 0; j < columns; j++)
                 {
-                    //  cout << box(i,j);
                     stdev += ((double)(box(i, j)) - mean) * ((double)(box(i, j)) - mean);
                 }
 
-            // cout << "\n";
             stdev = sqrt(stdev / (rows * columns)) / mean;
             return stdev;
         }
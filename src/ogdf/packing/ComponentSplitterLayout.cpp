@@ -59,6 +59,7 @@ namespace ogdf
         m_packer.set(new TileToRowsCCPacker);
         m_targetRatio = 1.f;
         m_border = 30;
+        m_reuseIsomorphic = false;
     }
 
 
@@ -89,6 +90,9 @@ namespace ogdf
             forall_nodes(v, G)
             nodesInCC[componentNumber[v]].pushBack(v);
 
+            // components isomorphic to a previous one reuse its layout
+            findIsomorphicComponents(GA);
+
             // Create copies of the connected components and corresponding
             // GraphAttributes
             GraphCopy GC;
@@ -98,6 +102,9 @@ namespace ogdf
 
             for(int i = 0; i < m_numberOfComponents; i++)
             {
+                if(m_shapeOf[i] != i)
+                    continue;
+
                 GC.initByNodes(nodesInCC[i], auxCopy);
                 GraphAttributes cGA(GC, GA.attributes());
                 //copy information into copy GA
@@ -135,17 +142,556 @@ namespace ogdf
                 }
             }
 
+            // copy the layouts of isomorphic components; node sizes agree
+            // by construction of the classes, and bends are not transferred
+            // (just as for the representatives above)
+            for(int i = 0; i < m_numberOfComponents; i++)
+            {
+                if(m_shapeOf[i] == i)
+                    continue;
+
+                ListConstIterator<node> it;
+                for(it = nodesInCC[i].begin(); it.valid(); ++it)
+                {
+                    node w = m_twin[*it];
+                    GA.x(*it) = GA.x(w);
+                    GA.y(*it) = GA.y(w);
+                    if(GA.attributes() & GraphAttributes::threeD)
+                    {
+                        GA.z(*it) = GA.z(w);
+                    }
+                }
+            }
 
             // rotate component drawings and call the packer
             reassembleDrawings(GA);
             // free
             nodesInCC.init();
+            m_shapeOf.init();
+            m_twin.init();
 
         }//if valid
 
     }
 
 
+    //-----------------
+    // isomorphic components
+
+    namespace
+    {
+
+        // Finds isomorphic connected components. Trees are identified by
+        // canonical codes (AHU encoding rooted at a center), all other
+        // components by an invariant followed by a bounded backtracking search.
+        class ComponentShapes
+        {
+            const GraphAttributes & m_GA;
+            const Graph & m_G;
+            const Array<List<node>> & m_nodesInCC;
+            Array<int> & m_shapeOf;
+            NodeArray<node> & m_twin;
+            bool m_weights; // compare edge weights?
+
+            NodeArray<int>      m_label;     // id of the size of a node
+            NodeArray<int>      m_code;      // code of the subtree rooted at a node
+            NodeArray<adjEntry> m_parentAdj; // adjacency entry pointing to the parent
+            NodeArray<node>     m_map;       // partial isomorphism (backtracking)
+            NodeArray<bool>     m_used;      // image nodes of m_map
+
+            Hashing<string, int> m_ids;      // codes of node labels and subtrees
+            Hashing<int, int>    m_treeRep;  // code of a tree -> representative component
+            Hashing<string, List<int>> m_buckets; // invariant -> representative components
+            Array<List<node>>    m_canonical; // canonical node order of representative trees
+
+            ArrayBuffer<node> m_order;  // nodes of the current component in search order
+            ArrayBuffer<int>  m_parentPos; // position of the BFS parent in m_order
+            long m_steps; // remaining steps of the backtracking search
+
+            // compares nodes by their subtree codes
+            class CodeComparer
+            {
+                const NodeArray<int> & m_code;
+            public:
+                CodeComparer(const NodeArray<int> & code) : m_code(code) { }
+                bool less(node v, node w) const
+                {
+                    return m_code[v] < m_code[w];
+                }
+            };
+
+            int id(const string & key)
+            {
+                return m_ids.insertByNeed(key, m_ids.size())->info();
+            }
+
+            static void append(string & key, const void* p, size_t n)
+            {
+                key.append(static_cast<const char*>(p), n);
+            }
+
+            int rootedTreeCode(node root, const ArrayBuffer<node> & bfs);
+            void bfsOrder(node root, ArrayBuffer<node> & bfs);
+            void canonicalOrder(node root, List<node> & order);
+            node treeRoot(int c);
+
+            void countEdges(node v, node w, int & out, int & in, double & weight) const;
+            int adjacentEdgesToMapped(node v, bool image) const;
+            bool consistent(node a, node b);
+            bool extend(int k);
+            bool findIsomorphism(int c, int r);
+
+        public:
+            ComponentShapes(
+                const GraphAttributes & GA,
+                const Array<List<node>> & nodesInCC,
+                Array<int> & shapeOf,
+                NodeArray<node> & twin) :
+                m_GA(GA), m_G(GA.constGraph()), m_nodesInCC(nodesInCC), m_shapeOf(shapeOf), m_twin(twin),
+                m_weights((GA.attributes() & GraphAttributes::edgeDoubleWeight) != 0), m_steps(0) { }
+
+            void run();
+        };
+
+
+        // BFS from root; sets m_parentAdj
+        void ComponentShapes::bfsOrder(node root, ArrayBuffer<node> & bfs)
+        {
+            bfs.clear();
+            bfs.push(root);
+            m_parentAdj[root] = 0;
+
+            for(int i = 0; i < bfs.size(); ++i)
+            {
+                node v = bfs[i];
+                adjEntry adj;
+                forall_adj(adj, v)
+                {
+                    node w = adj->twinNode();
+                    if(w != root && m_parentAdj[w] == 0)
+                    {
+                        m_parentAdj[w] = adj->twin();
+                        bfs.push(w);
+                    }
+                }
+            }
+        }
+
+
+        int ComponentShapes::rootedTreeCode(node root, const ArrayBuffer<node> & bfs)
+        {
+            ArrayBuffer<int> children;
+
+            for(int i = bfs.size(); i-- > 0;)
+            {
+                node v = bfs[i];
+                adjEntry toParent = m_parentAdj[v];
+
+                children.clear();
+                adjEntry adj;
+                forall_adj(adj, v)
+                {
+                    if(adj != toParent)
+                        children.push(m_code[adj->twinNode()]);
+                }
+                children.quicksort();
+
+                // key: node label, direction and weight of the parent edge, children
+                string key;
+                int dir = 2;
+                double weight = 0.0;
+                if(toParent != 0)
+                {
+                    edge e = toParent->theEdge();
+                    dir = (e->source() == v) ? 1 : 0;
+                    if(m_weights) weight = m_GA.doubleWeight(e);
+                }
+                append(key, &m_label[v], sizeof(int));
+                append(key, &dir, sizeof(int));
+                append(key, &weight, sizeof(double));
+                for(int j = 0; j < children.size(); ++j)
+                    append(key, &children[j], sizeof(int));
+
+                m_code[v] = id(key);
+            }
+
+            return m_code[root];
+        }
+
+
+        // DFS order with children sorted by their codes; isomorphic trees with
+        // equal root codes get corresponding orders
+        void ComponentShapes::canonicalOrder(node root, List<node> & order)
+        {
+            CodeComparer comp(m_code);
+            ArrayBuffer<node> stack, children;
+            stack.push(root);
+
+            while(!stack.empty())
+            {
+                node v = stack.popRet();
+                order.pushBack(v);
+
+                children.clear();
+                adjEntry adj;
+                forall_adj(adj, v)
+                {
+                    if(adj != m_parentAdj[v])
+                        children.push(adj->twinNode());
+                }
+                children.quicksort(comp);
+
+                for(int j = children.size(); j-- > 0;)
+                    stack.push(children[j]);
+            }
+        }
+
+
+        // returns the center of tree component c with the smaller code and
+        // leaves m_code and m_parentAdj rooted at that center
+        node ComponentShapes::treeRoot(int c)
+        {
+            const List<node> & nodes = m_nodesInCC[c];
+
+            // peel off leaves until at most two nodes remain
+            NodeArray<int> & deg = m_code; // reused as degree counter
+            ArrayBuffer<node> layer, next;
+            ListConstIterator<node> it;
+            for(it = nodes.begin(); it.valid(); ++it)
+            {
+                deg[*it] = (*it)->degree();
+                if(deg[*it] <= 1) layer.push(*it);
+            }
+
+            int remaining = nodes.size();
+            while(remaining > 2)
+            {
+                next.clear();
+                for(int i = 0; i < layer.size(); ++i)
+                {
+                    --remaining;
+                    adjEntry adj;
+                    forall_adj(adj, layer[i])
+                    {
+                        node w = adj->twinNode();
+                        if(--deg[w] == 1) next.push(w);
+                    }
+                }
+                layer.clear();
+                for(int i = 0; i < next.size(); ++i)
+                    layer.push(next[i]);
+            }
+
+            ArrayBuffer<node> bfs;
+            node root = layer[0];
+            for(it = nodes.begin(); it.valid(); ++it)
+                m_parentAdj[*it] = 0;
+            bfsOrder(root, bfs);
+            int code = rootedTreeCode(root, bfs);
+
+            if(layer.size() == 2)
+            {
+                node other = layer[1];
+                for(it = nodes.begin(); it.valid(); ++it)
+                    m_parentAdj[*it] = 0;
+                bfsOrder(other, bfs);
+                if(rootedTreeCode(other, bfs) <= code)
+                    return other;
+
+                for(it = nodes.begin(); it.valid(); ++it)
+                    m_parentAdj[*it] = 0;
+                bfsOrder(root, bfs);
+                rootedTreeCode(root, bfs);
+            }
+
+            return root;
+        }
+
+
+        // counts the edges v->w and w->v and sums up their weights
+        void ComponentShapes::countEdges(node v, node w, int & out, int & in, double & weight) const
+        {
+            out = in = 0;
+            weight = 0.0;
+
+            adjEntry adj;
+            forall_adj(adj, v)
+            {
+                if(adj->twinNode() != w) continue;
+                edge e = adj->theEdge();
+
+                // a self-loop has two adjacency entries at v
+                if(v == w && adj != e->adjSource()) continue;
+
+                if(e->source() == v) ++out;
+                else ++in;
+                if(m_weights) weight += m_GA.doubleWeight(e);
+            }
+        }
+
+
+        // number of edges between v and the mapped nodes (or their images)
+        int ComponentShapes::adjacentEdgesToMapped(node v, bool image) const
+        {
+            int count = 0;
+            adjEntry adj;
+            forall_adj(adj, v)
+            {
+                node w = adj->twinNode();
+                if(image ? m_used[w] : (m_map[w] != 0))
+                    ++count;
+            }
+            return count;
+        }
+
+
+        bool ComponentShapes::consistent(node a, node b)
+        {
+            if(m_used[b] || m_label[a] != m_label[b]
+                    || a->indeg() != b->indeg() || a->outdeg() != b->outdeg())
+                return false;
+
+            // edges to already mapped nodes (and self-loops) must correspond
+            adjEntry adj;
+            forall_adj(adj, a)
+            {
+                node u = adj->twinNode();
+                node mu = (u == a) ? b : m_map[u];
+                if(mu == 0) continue;
+
+                int outA, inA, outB, inB;
+                double wA, wB;
+                countEdges(a, u, outA, inA, wA);
+                countEdges(b, mu, outB, inB, wB);
+                if(outA != outB || inA != inB || wA != wB)
+                    return false;
+            }
+
+            return adjacentEdgesToMapped(a, false) == adjacentEdgesToMapped(b, true);
+        }
+
+
+        bool ComponentShapes::extend(int k)
+        {
+            if(k == m_order.size())
+                return true;
+
+            // candidates are the neighbors of the image of the BFS parent
+            node a = m_order[k];
+            node p = m_map[m_order[m_parentPos[k]]];
+            adjEntry adj;
+            forall_adj(adj, p)
+            {
+                if(--m_steps < 0)
+                    return false;
+
+                node b = adj->twinNode();
+                if(!consistent(a, b))
+                    continue;
+
+                m_map[a] = b;
+                m_used[b] = true;
+                if(extend(k + 1))
+                    return true;
+                m_map[a] = 0;
+                m_used[b] = false;
+
+                if(m_steps < 0)
+                    return false;
+            }
+
+            return false;
+        }
+
+
+        // tries to find an isomorphism from component c to component r
+        // (stored in m_map); components have equal invariants
+        bool ComponentShapes::findIsomorphism(int c, int r)
+        {
+            const List<node> & nodesA = m_nodesInCC[c];
+            const List<node> & nodesB = m_nodesInCC[r];
+
+            // BFS order of component c; every node except the first one
+            // has a neighbor before it
+            m_order.clear();
+            m_parentPos.clear();
+            node first = nodesA.front();
+            m_order.push(first);
+            m_parentPos.push(-1);
+            m_used[first] = true; // temporarily used as visited flag on c
+            for(int i = 0; i < m_order.size(); ++i)
+            {
+                adjEntry adj;
+                forall_adj(adj, m_order[i])
+                {
+                    node w = adj->twinNode();
+                    if(!m_used[w])
+                    {
+                        m_used[w] = true;
+                        m_order.push(w);
+                        m_parentPos.push(i);
+                    }
+                }
+            }
+            for(int i = 0; i < m_order.size(); ++i)
+                m_used[m_order[i]] = false;
+
+            m_steps = 10000 + 100L * nodesA.size();
+            bool found = false;
+
+            ListConstIterator<node> it;
+            for(it = nodesB.begin(); !found && it.valid() && m_steps >= 0; ++it)
+            {
+                if(!consistent(first, *it))
+                    continue;
+
+                m_map[first] = *it;
+                m_used[*it] = true;
+                found = extend(1);
+                if(!found)
+                {
+                    m_map[first] = 0;
+                    m_used[*it] = false;
+                }
+            }
+
+            if(found)
+            {
+                for(ListConstIterator<node> itA = nodesA.begin(); itA.valid(); ++itA)
+                    m_twin[*itA] = m_map[*itA];
+            }
+
+            // reset the partial mapping
+            for(ListConstIterator<node> itA = nodesA.begin(); itA.valid(); ++itA)
+                m_map[*itA] = 0;
+            for(it = nodesB.begin(); it.valid(); ++it)
+                m_used[*it] = false;
+
+            return found;
+        }
+
+
+        void ComponentShapes::run()
+        {
+            const int numCC = m_nodesInCC.size();
+
+            m_label    .init(m_G);
+            m_code     .init(m_G, 0);
+            m_parentAdj.init(m_G, 0);
+            m_map      .init(m_G, 0);
+            m_used     .init(m_G, false);
+            m_canonical.init(numCC);
+
+            node v;
+            forall_nodes(v, m_G)
+            {
+                string key("s");
+                double w = m_GA.width(v), h = m_GA.height(v);
+                append(key, &w, sizeof(double));
+                append(key, &h, sizeof(double));
+                m_label[v] = id(key);
+            }
+
+            // number of edges per component
+            NodeArray<int> component(m_G);
+            Array<int> numEdges(numCC);
+            for(int c = 0; c < numCC; ++c)
+            {
+                numEdges[c] = 0;
+                for(ListConstIterator<node> it = m_nodesInCC[c].begin(); it.valid(); ++it)
+                    component[*it] = c;
+            }
+            edge e;
+            forall_edges(e, m_G)
+                ++numEdges[component[e->source()]];
+
+            ArrayBuffer<int> signature;
+
+            for(int c = 0; c < numCC; ++c)
+            {
+                const List<node> & nodes = m_nodesInCC[c];
+                m_shapeOf[c] = c;
+
+                if(numEdges[c] == nodes.size() - 1)
+                {
+                    // tree: canonical code of the tree rooted at its center
+                    node root = treeRoot(c);
+                    int code = m_code[root];
+
+                    HashElement<int, int>* rep = m_treeRep.lookup(code);
+                    if(rep == 0)
+                    {
+                        m_treeRep.fastInsert(code, c);
+                        canonicalOrder(root, m_canonical[c]);
+                        continue;
+                    }
+
+                    int r = rep->info();
+                    List<node> order;
+                    canonicalOrder(root, order);
+
+                    ListConstIterator<node> itR = m_canonical[r].begin();
+                    for(ListConstIterator<node> it = order.begin(); it.valid(); ++it, ++itR)
+                        m_twin[*it] = *itR;
+                    m_shapeOf[c] = r;
+                }
+                else
+                {
+                    // invariant: sizes, numbers of edges and sorted node signatures
+                    signature.clear();
+                    ListConstIterator<node> it;
+                    for(it = nodes.begin(); it.valid(); ++it)
+                    {
+                        string key("d");
+                        int x[3] = { m_label[*it], (*it)->indeg(), (*it)->outdeg() };
+                        append(key, x, sizeof(x));
+                        signature.push(id(key));
+                    }
+                    signature.quicksort();
+
+                    string key("g");
+                    int sizes[2] = { nodes.size(), numEdges[c] };
+                    append(key, sizes, sizeof(sizes));
+                    for(int j = 0; j < signature.size(); ++j)
+                        append(key, &signature[j], sizeof(int));
+
+                    List<int> & reps = m_buckets.insertByNeed(key, List<int>())->info();
+                    ListConstIterator<int> itR;
+                    for(itR = reps.begin(); itR.valid(); ++itR)
+                    {
+                        if(findIsomorphism(c, *itR))
+                        {
+                            m_shapeOf[c] = *itR;
+                            break;
+                        }
+                    }
+
+                    if(m_shapeOf[c] == c)
+                        reps.pushBack(c);
+                }
+            }
+        }
+
+    } // end namespace
+
+
+    void ComponentSplitterLayout::findIsomorphicComponents(const GraphAttributes & GA)
+    {
+        m_shapeOf.init(m_numberOfComponents);
+        m_twin.init(GA.constGraph());
+
+        if(!m_reuseIsomorphic)
+        {
+            for(int c = 0; c < m_numberOfComponents; ++c)
+                m_shapeOf[c] = c;
+            return;
+        }
+
+        ComponentShapes shapes(GA, nodesInCC, m_shapeOf, m_twin);
+        shapes.run();
+    }
+
+
     //-----------------
     // geometry helpers
 
@@ -0,0 +1,354 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Tests for the compact graph attributes and other basic data structures
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+#include "gtest/gtest.h"
+#include <ogdf/basic/graph_generators.h>
+#include <ogdf/basic/CompactGraphAttributes.h>
+#include <ogdf/basic/LayoutCache.h>
+#include <ogdf/energybased/FastMultipoleEmbedder.h>
+#include <ogdf/basic/SIMD.h>
+
+using namespace ogdf;
+
+
+TEST(StringTableTest, InternAndLookup)
+{
+    StringTable table;
+    EXPECT_EQ(1, table.size());
+    EXPECT_EQ(0, table.intern(""));
+
+    const int a = table.intern("n12");
+    const int b = table.intern("n21");
+    EXPECT_NE(a, b);
+    EXPECT_EQ(a, table.intern("n12"));
+    EXPECT_EQ(b, table.lookup("n21"));
+    EXPECT_EQ(-1, table.lookup("n3"));
+    EXPECT_EQ("n12", table[a]);
+
+    // the strings must survive the reallocations of the table
+    for(int i = 0; i < 1000; ++i)
+        table.intern(to_string(i));
+    EXPECT_EQ("n21", table[b]);
+    EXPECT_EQ(1003, table.size());
+
+    StringTable copy(table);
+    EXPECT_EQ(table.size(), copy.size());
+    EXPECT_EQ(a, copy.lookup("n12"));
+    EXPECT_EQ("999", copy[copy.size() - 1]);
+
+    table.clear();
+    EXPECT_EQ(1, table.size());
+    EXPECT_EQ(-1, table.lookup("n12"));
+}
+
+
+TEST(CompactGraphAttributesTest, Transfer)
+{
+    Graph G;
+    randomSimpleGraph(G, 50, 100);
+
+    GraphAttributes GA(G, GraphAttributes::nodeGraphics | GraphAttributes::nodeLabel
+                       | GraphAttributes::edgeGraphics | GraphAttributes::edgeLabel);
+    node v;
+    edge e;
+    forall_nodes(v, G)
+    {
+        GA.x(v) = v->index() * 0.5;
+        GA.y(v) = -v->index();
+        GA.width(v) = 10 + v->index() % 3;
+        GA.label(v) = "n" + to_string(v->index() % 7);
+    }
+    forall_edges(e, G)
+    {
+        GA.label(e) = (e->index() % 2 == 0) ? "even" : "odd";
+    }
+
+    CompactGraphAttributes CGA(G, GraphAttributes::nodeGraphics | GraphAttributes::nodeLabel
+                               | GraphAttributes::edgeGraphics | GraphAttributes::edgeLabel);
+    EXPECT_EQ(long(GraphAttributes::nodeGraphics | GraphAttributes::nodeLabel | GraphAttributes::edgeLabel),
+              CGA.attributes());
+    CGA.transferFrom(GA);
+
+    // the empty string, 7 node labels and 2 edge labels
+    EXPECT_EQ(10, CGA.stringTable().size());
+    forall_nodes(v, G)
+    {
+        EXPECT_FLOAT_EQ(float(GA.x(v)), CGA.x(v));
+        EXPECT_FLOAT_EQ(float(GA.y(v)), CGA.y(v));
+        EXPECT_FLOAT_EQ(float(GA.width(v)), CGA.width(v));
+        EXPECT_EQ(GA.label(v), CGA.label(v));
+        EXPECT_EQ(CGA.x(v), CGA.coordinateData()[2 * v->index()]);
+        EXPECT_EQ(CGA.y(v), CGA.coordinateData()[2 * v->index() + 1]);
+    }
+
+    GraphAttributes GA2(G, GraphAttributes::nodeGraphics | GraphAttributes::nodeLabel | GraphAttributes::edgeLabel);
+    CGA.transferTo(GA2);
+    forall_nodes(v, G)
+    {
+        EXPECT_DOUBLE_EQ(GA.x(v), GA2.x(v));
+        EXPECT_DOUBLE_EQ(GA.height(v), GA2.height(v));
+        EXPECT_EQ(GA.label(v), GA2.label(v));
+    }
+    forall_edges(e, G)
+    {
+        EXPECT_EQ(GA.label(e), GA2.label(e));
+    }
+}
+
+
+TEST(CompactGraphAttributesTest, FastMultipoleEmbedder)
+{
+    Graph G;
+    randomSimpleGraph(G, 200, 400);
+
+    CompactGraphAttributes CGA(G);
+    FastMultipoleEmbedder fme;
+    fme.setNumIterations(50);
+    fme.call(CGA);
+
+    const DRect box = CGA.boundingBox();
+    EXPECT_GT(box.width(), 0);
+    EXPECT_GT(box.height(), 0);
+    node v;
+    forall_nodes(v, G)
+    {
+        EXPECT_TRUE(CGA.x(v) == CGA.x(v) && CGA.y(v) == CGA.y(v));
+    }
+}
+
+
+// places the nodes on a line and adds one bend to every edge
+class LineLayout : public LayoutModule
+{
+public:
+    int m_calls;
+    double m_distance;
+
+    LineLayout() : m_calls(0), m_distance(1.0) { }
+
+    void call(GraphAttributes & GA)
+    {
+        ++m_calls;
+        int i = 0;
+        node v;
+        forall_nodes(v, GA.constGraph())
+        {
+            GA.x(v) = m_distance * i++;
+            GA.y(v) = 0;
+        }
+        if(!(GA.attributes() & GraphAttributes::edgeGraphics))
+            return;
+        edge e;
+        forall_edges(e, GA.constGraph())
+        {
+            GA.bends(e).clear();
+            GA.bends(e).pushBack(DPoint(GA.x(e->source()), 1.0));
+        }
+    }
+};
+
+
+TEST(LayoutCacheTest, SaveLoadRoundTrip)
+{
+    Graph G;
+    randomSimpleGraph(G, 20, 40);
+    GraphAttributes GA(G, GraphAttributes::nodeGraphics | GraphAttributes::edgeGraphics);
+
+    LineLayout* pLayout = new LineLayout;
+    LayoutCache cache;
+    cache.setLayoutModule(pLayout, "line");
+    cache.call(GA);
+    EXPECT_EQ(0, cache.hits());
+    EXPECT_EQ(1, cache.misses());
+
+    std::stringstream ss;
+    ASSERT_TRUE(cache.save(ss));
+
+    LineLayout* pLayout2 = new LineLayout;
+    LayoutCache cache2;
+    cache2.setLayoutModule(pLayout2, "line");
+    ASSERT_TRUE(cache2.load(ss));
+    EXPECT_EQ(1, cache2.size());
+
+    GraphAttributes GA2(G, GraphAttributes::nodeGraphics | GraphAttributes::edgeGraphics);
+    cache2.call(GA2);
+    EXPECT_EQ(1, cache2.hits());
+    EXPECT_EQ(0, pLayout2->m_calls);
+
+    node v;
+    forall_nodes(v, G)
+    {
+        EXPECT_EQ(GA.x(v), GA2.x(v));
+        EXPECT_EQ(GA.y(v), GA2.y(v));
+    }
+    edge e;
+    forall_edges(e, G)
+    {
+        ASSERT_EQ(1, GA2.bends(e).size());
+        EXPECT_EQ(GA.bends(e).front().m_x, GA2.bends(e).front().m_x);
+    }
+}
+
+
+TEST(LayoutCacheTest, RejectCorruptStream)
+{
+    Graph G;
+    randomSimpleGraph(G, 10, 15);
+    GraphAttributes GA(G, GraphAttributes::nodeGraphics | GraphAttributes::edgeGraphics);
+
+    LayoutCache cache;
+    cache.setLayoutModule(new LineLayout, "line");
+    cache.call(GA);
+
+    std::stringstream ss;
+    ASSERT_TRUE(cache.save(ss));
+    const string data = ss.str();
+
+    // the bend ranges start behind magic number, entry count, key length,
+    // key, fingerprint, n, m, coordinates, number of bends and bend flag
+    const size_t bendStart = 8 + 4 + 4 + 4 + 8 + 4 + 4 + 2 * 8 * 10 + 4 + 4;
+    ASSERT_LT(bendStart + 8, data.size());
+
+    string corrupt = data;
+    const __int32 invalid = 1000000;
+    memcpy(&corrupt[bendStart + 4], &invalid, sizeof(invalid));
+    std::istringstream is1(corrupt);
+    LayoutCache cache1;
+    EXPECT_FALSE(cache1.load(is1));
+    EXPECT_EQ(0, cache1.size());
+
+    std::istringstream is2(data.substr(0, data.size() - 4));
+    LayoutCache cache2;
+    EXPECT_FALSE(cache2.load(is2));
+
+    std::istringstream is3("OGDFLYC0");
+    EXPECT_FALSE(cache2.load(is3));
+}
+
+
+TEST(LayoutCacheTest, RejectHugeCounts)
+{
+    Graph G;
+    randomSimpleGraph(G, 10, 15);
+    GraphAttributes GA(G, GraphAttributes::nodeGraphics | GraphAttributes::edgeGraphics);
+
+    LayoutCache cache;
+    cache.setLayoutModule(new LineLayout, "line");
+    cache.call(GA);
+
+    std::stringstream ss;
+    ASSERT_TRUE(cache.save(ss));
+    const string data = ss.str();
+
+    // key length, n, m and the number of bends of the first entry
+    const size_t keyLength = 8 + 4;
+    const size_t numNodes = keyLength + 4 + 4 + 8;
+    const size_t numEdges = numNodes + 4;
+    const size_t numBends = numEdges + 4 + 2 * 8 * 10;
+    const size_t offsets[] = { keyLength, numNodes, numEdges, numBends };
+    const __int32 values[] = { 0x7ffffff0, numeric_limits<__int32>::max() };
+
+    for(int i = 0; i < 4; ++i)
+    {
+        for(int j = 0; j < 2; ++j)
+        {
+            string corrupt = data;
+            memcpy(&corrupt[offsets[i]], &values[j], sizeof(__int32));
+            std::istringstream is(corrupt);
+            LayoutCache cache2;
+            EXPECT_FALSE(cache2.load(is)) << "offset " << offsets[i] << ", value " << values[j];
+            EXPECT_EQ(0, cache2.size());
+        }
+    }
+}
+
+
+TEST(LayoutCacheTest, MissAfterOptionChange)
+{
+    Graph G;
+    randomSimpleGraph(G, 10, 15);
+    GraphAttributes GA(G, GraphAttributes::nodeGraphics);
+
+    LineLayout* pLayout = new LineLayout;
+    LayoutCache cache;
+    cache.setLayoutModule(pLayout, "line distance=1");
+    cache.call(GA);
+    cache.call(GA);
+    EXPECT_EQ(1, cache.hits());
+    EXPECT_EQ(1, pLayout->m_calls);
+
+    pLayout->m_distance = 2.0;
+    cache.setModuleKey("line distance=2");
+    cache.call(GA);
+    EXPECT_EQ(1, cache.hits());
+    EXPECT_EQ(2, pLayout->m_calls);
+    EXPECT_EQ(2.0, GA.x(G.firstNode()->succ()));
+}
+
+
+static int scalarVariant() { return simdScalar; }
+static int sse2Variant() { return simdSSE2; }
+static int avx2Variant() { return simdAVX2; }
+
+TEST(SIMDKernelTest, Selection)
+{
+    typedef int (*Function)();
+    SIMDKernel<Function> kernel = SIMDKernel<Function>(scalarVariant)
+        .add(simdSSE2, sse2Variant)
+        .add(simdAVX2, avx2Variant);
+
+    const SIMDLevel supported = SIMD::maxLevel(simdAVX512);
+    for(int l = simdScalar; l < simdNumberOfLevels; ++l)
+    {
+        SIMDLevel level = SIMD::maxLevel(SIMDLevel(l));
+        EXPECT_EQ(min(l, int(supported)), int(level));
+
+        // the variant of the highest level not exceeding the selected level
+        int expected = (level >= simdAVX2) ? simdAVX2 : ((level >= simdSSE2) ? simdSSE2 : simdScalar);
+        EXPECT_EQ(expected, int(kernel.selectedLevel()));
+        EXPECT_EQ(expected, kernel.get()());
+    }
+    SIMD::maxLevel(simdAVX512);
+
+    SIMDLevel level;
+    EXPECT_TRUE(SIMD::fromName(SIMD::name(simdAVX2), level));
+    EXPECT_EQ(simdAVX2, level);
+    EXPECT_FALSE(SIMD::fromName("mmx", level));
+}
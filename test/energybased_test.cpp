@@ -0,0 +1,1113 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Tests for the energy-based layout algorithms.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+#include "gtest/gtest.h"
+#include <ogdf/basic/graph_generators.h>
+#include <ogdf/energybased/TutteLayout.h>
+#include <ogdf/energybased/SpringEmbedderFR.h>
+#include <ogdf/energybased/FMMMLayout.h>
+#include <ogdf/energybased/SpringEmbedderFRExact.h>
+#include <ogdf/energybased/SpringEmbedderKK.h>
+#include <ogdf/energybased/PivotMDS.h>
+#include <ogdf/energybased/FastMultipoleEmbedder.h>
+#include <ogdf/energybased/StressMinimization.h>
+#include <ogdf/energybased/GEMLayout.h>
+#include <ogdf/energybased/DavidsonHarelLayout.h>
+#include <ogdf/energybased/IterationMonitor.h>
+#include <ogdf/energybased/multilevelmixer/ModularMultilevelMixer.h>
+#include <ogdf/basic/Stopwatch.h>
+#include <ogdf/graphalg/ShortestPathAlgorithms.h>
+#include <ogdf/basic/SIMD.h>
+#include <ogdf/internal/energybased/ParallelCoarsening.h>
+#include <ogdf/internal/energybased/Planarity.h>
+#include <ogdf/internal/energybased/NMM.h>
+#include <ogdf/basic/simple_graph_alg.h>
+
+using namespace ogdf;
+
+
+// a wheel: a cycle of k nodes and a hub adjacent to all of them
+static node wheelGraph(Graph & G, int k, List<node> & rim)
+{
+    G.clear();
+    rim.clear();
+    node hub = G.newNode();
+    for(int i = 0; i < k; ++i)
+    {
+        rim.pushBack(G.newNode());
+        G.newEdge(hub, rim.back());
+    }
+    node u = rim.back();
+    forall_listiterators(node, it, rim)
+    {
+        G.newEdge(u, *it);
+        u = *it;
+    }
+    return hub;
+}
+
+
+TEST(TutteLayoutTest, Barycenter)
+{
+    Graph G;
+    List<node> rim;
+    node hub = wheelGraph(G, 8, rim);
+    GraphAttributes GA(G);
+
+    TutteLayout tutte;
+    tutte.call(GA, rim);
+
+    DPoint center;
+    forall_listiterators(node, it, rim)
+        center = center + DPoint(GA.x(*it), GA.y(*it));
+    center = DPoint(center.m_x / rim.size(), center.m_y / rim.size());
+    EXPECT_NEAR(center.m_x, GA.x(hub), 1e-6);
+    EXPECT_NEAR(center.m_y, GA.y(hub), 1e-6);
+}
+
+
+#ifndef USE_COIN
+TEST(TutteLayoutTest, KeepCoordinatesIfNotConverged)
+{
+    Graph G;
+    planarTriconnectedGraph(G, 200, 500);
+    GraphAttributes GA(G);
+    node v;
+    forall_nodes(v, G)
+    {
+        GA.x(v) = v->index();
+        GA.y(v) = -v->index();
+    }
+
+    TutteLayout tutte;
+    tutte.maxIterations(1);
+    tutte.tolerance(1e-14);
+    tutte.call(GA);
+
+    forall_nodes(v, G)
+    {
+        EXPECT_EQ(double(v->index()), GA.x(v));
+        EXPECT_EQ(double(-v->index()), GA.y(v));
+    }
+}
+#endif
+
+
+TEST(SpringEmbedderFRTest, ThreadsGiveSameLayout)
+{
+    Graph G;
+    randomSimpleGraph(G, 8000, 16000);
+    GraphAttributes GA1(G), GA2(G);
+    node v;
+    forall_nodes(v, G)
+    {
+        GA1.x(v) = GA2.x(v) = randomDouble(0, 1000);
+        GA1.y(v) = GA2.y(v) = randomDouble(0, 1000);
+    }
+
+    SpringEmbedderFR fr;
+    fr.iterations(20);
+    fr.noise(false);
+    fr.maxThreads(1);
+    fr.call(GA1);
+    fr.maxThreads(3);
+    fr.call(GA2);
+
+    forall_nodes(v, G)
+    {
+        EXPECT_EQ(GA1.x(v), GA2.x(v));
+        EXPECT_EQ(GA1.y(v), GA2.y(v));
+    }
+}
+
+
+TEST(FMMMLayoutTest, ThreadsGiveSameLayout)
+{
+    Graph G;
+    randomSimpleGraph(G, 3000, 6000);
+    GraphAttributes GA1(G), GA2(G);
+
+    FMMMLayout fmmm;
+    fmmm.randSeed(7);
+    // with a single thread, the sequential algorithm is used
+    fmmm.numberOfThreads(2);
+    fmmm.call(GA1);
+    fmmm.numberOfThreads(5);
+    fmmm.call(GA2);
+
+    node v;
+    forall_nodes(v, G)
+    {
+        EXPECT_EQ(GA1.x(v), GA2.x(v));
+        EXPECT_EQ(GA1.y(v), GA2.y(v));
+    }
+}
+
+
+// the repulsive forces of NMM with tree construction way treeConstruction on
+// the nodes of G at the positions in A (within the box [0,1000]^2); the centers
+// of the cells are moved randomly, so the random generator is reset
+static void nmmForces(const Graph & G, NodeArray<NodeAttributes> & A,
+                      FMMMLayout::ReducedTreeConstruction treeConstruction, int numThreads, NodeArray<DPoint> & F)
+{
+    srand(17);
+    KernelTeam team(numThreads);
+    NMM nm;
+    nm.make_initialisations(G, 1000, DPoint(0, 0), 25, 4, treeConstruction, FMMMLayout::scfIteratively);
+    nm.thread_team(&team);
+    nm.calculate_repulsive_forces(G, A, F);
+    nm.deallocate_memory();
+}
+
+// sum of |F[v] - exact[v]| relative to the sum of |exact[v]|
+static double relativeForceError(const Graph & G, const NodeArray<DPoint> & F, const NodeArray<DPoint> & exact)
+{
+    double error = 0, norm = 0;
+    node v;
+    forall_nodes(v, G)
+    {
+        error += (F[v] - exact[v]).norm();
+        norm += exact[v].norm();
+    }
+    return error / norm;
+}
+
+TEST(FMMMLayoutTest, LinearQuadTreeForces)
+{
+    Graph G;
+    randomSimpleGraph(G, 3000, 6000);
+    NodeArray<NodeAttributes> A(G);
+    node v;
+    forall_nodes(v, G)
+        A[v].set_position(DPoint(randomDouble(100, 900), randomDouble(100, 900)));
+
+    NodeArray<DPoint> exact(G);
+    FruchtermanReingold fr;
+    fr.make_initialisations(1000, DPoint(0, 0), 2);
+    fr.calculate_exact_repulsive_forces(G, A, exact);
+
+    NodeArray<DPoint> subtree(G), linear(G), linearParallel(G);
+    nmmForces(G, A, FMMMLayout::rtcSubtreeBySubtree, 1, subtree);
+    nmmForces(G, A, FMMMLayout::rtcLinear, 1, linear);
+    nmmForces(G, A, FMMMLayout::rtcLinear, 4, linearParallel);
+
+    // the linear tree approximates the forces as well as the pointer based tree
+    const double subtreeError = relativeForceError(G, subtree, exact);
+    const double linearError = relativeForceError(G, linear, exact);
+    EXPECT_LT(subtreeError, 1e-2);
+    EXPECT_LT(linearError, 2 * subtreeError + 1e-6);
+
+    forall_nodes(v, G)
+    {
+        EXPECT_EQ(linear[v].m_x, linearParallel[v].m_x);
+        EXPECT_EQ(linear[v].m_y, linearParallel[v].m_y);
+    }
+}
+
+
+TEST(FMMMLayoutTest, LinearQuadTreeLayout)
+{
+    Graph G;
+    randomSimpleGraph(G, 2000, 4000);
+    makeConnected(G);
+    GraphAttributes GA1(G), GA2(G), GA3(G);
+
+    // with a single thread, the sequential algorithm is used
+    FMMMLayout fmmm;
+    fmmm.randSeed(7);
+    fmmm.numberOfThreads(2);
+    fmmm.nmTreeConstruction(FMMMLayout::rtcSubtreeBySubtree);
+    fmmm.call(GA1);
+    fmmm.nmTreeConstruction(FMMMLayout::rtcLinear);
+    fmmm.call(GA2);
+    fmmm.numberOfThreads(5);
+    fmmm.call(GA3);
+
+    // the drawings have similar edge lengths relative to their size
+    double length[2] = { 0, 0 }, deviation[2] = { 0, 0 };
+    const GraphAttributes* layout[2] = { &GA1, &GA2 };
+    for(int i = 0; i < 2; i++)
+    {
+        edge e;
+        forall_edges(e, G)
+            length[i] += DPoint(layout[i]->x(e->source()), layout[i]->y(e->source()))
+                         .distance(DPoint(layout[i]->x(e->target()), layout[i]->y(e->target())));
+        length[i] /= G.numberOfEdges();
+        forall_edges(e, G)
+        {
+            double l = DPoint(layout[i]->x(e->source()), layout[i]->y(e->source()))
+                       .distance(DPoint(layout[i]->x(e->target()), layout[i]->y(e->target())));
+            deviation[i] += fabs(l - length[i]) / length[i];
+        }
+        deviation[i] /= G.numberOfEdges();
+    }
+    EXPECT_LT(deviation[1], 1.2 * deviation[0]);
+
+    node v;
+    forall_nodes(v, G)
+    {
+        EXPECT_EQ(GA2.x(v), GA3.x(v));
+        EXPECT_EQ(GA2.y(v), GA3.y(v));
+    }
+}
+
+
+TEST(SpringEmbedderFRExactTest, ThreadsGiveSameLayout)
+{
+    // a sparse graph with several components, so the thread team is used
+    // for more than one layout
+    Graph G;
+    randomSimpleGraph(G, 1600, 2000);
+
+    GraphAttributes GA1(G), GA2(G);
+    node v;
+    forall_nodes(v, G)
+    {
+        GA1.x(v) = GA2.x(v) = randomDouble(0, 1000);
+        GA1.y(v) = GA2.y(v) = randomDouble(0, 1000);
+    }
+
+    SpringEmbedderFRExact fr;
+    fr.iterations(20);
+    fr.noise(false);
+    fr.numberOfThreads(1);
+    fr.call(GA1);
+    fr.numberOfThreads(4);
+    fr.call(GA2);
+
+    forall_nodes(v, G)
+    {
+        EXPECT_EQ(GA1.x(v), GA2.x(v));
+        EXPECT_EQ(GA1.y(v), GA2.y(v));
+    }
+}
+
+
+// Runs layout on G for each supported SIMD level and compares the result with
+// the layout computed by the scalar kernels; the tolerance is relative to the
+// size of the scalar layout.
+static void compareSIMDLevels(LayoutModule & layout, const Graph & G, double tolerance)
+{
+    GraphAttributes GA(G);
+    node v;
+
+    SIMD::maxLevel(simdScalar);
+    srand(17);
+    forall_nodes(v, G)
+    {
+        GA.x(v) = randomDouble(0, 100);
+        GA.y(v) = randomDouble(0, 100);
+    }
+    NodeArray<DPoint> initial(G);
+    forall_nodes(v, G)
+        initial[v] = DPoint(GA.x(v), GA.y(v));
+    layout.call(GA);
+
+    NodeArray<DPoint> scalar(G);
+    double xmin = GA.x(G.firstNode()), xmax = xmin;
+    double ymin = GA.y(G.firstNode()), ymax = ymin;
+    forall_nodes(v, G)
+    {
+        scalar[v] = DPoint(GA.x(v), GA.y(v));
+        xmin = min(xmin, GA.x(v));
+        xmax = max(xmax, GA.x(v));
+        ymin = min(ymin, GA.y(v));
+        ymax = max(ymax, GA.y(v));
+    }
+    const double eps = tolerance * max(xmax - xmin, ymax - ymin);
+
+    SIMDLevel supported = SIMD::maxLevel(simdAVX512);
+    for(int l = simdSSE2; l <= supported; ++l)
+    {
+        SCOPED_TRACE(SIMD::name(SIMDLevel(l)));
+        SIMD::maxLevel(SIMDLevel(l));
+        srand(17);
+        forall_nodes(v, G)
+        {
+            GA.x(v) = initial[v].m_x;
+            GA.y(v) = initial[v].m_y;
+        }
+        layout.call(GA);
+
+        forall_nodes(v, G)
+        {
+            EXPECT_NEAR(scalar[v].m_x, GA.x(v), eps);
+            EXPECT_NEAR(scalar[v].m_y, GA.y(v), eps);
+        }
+    }
+    SIMD::maxLevel(simdAVX512);
+}
+
+
+TEST(SIMDKernelTest, SpringEmbedderFRExactRepulsion)
+{
+    Graph G;
+    randomSimpleGraph(G, 300, 600);
+    makeConnected(G);
+
+    SpringEmbedderFRExact fr;
+    fr.iterations(10);
+    fr.noise(false);
+    compareSIMDLevels(fr, G, 1e-6);
+}
+
+
+TEST(SIMDKernelTest, SpringEmbedderKKGradient)
+{
+    Graph G;
+    randomSimpleGraph(G, 100, 200);
+    makeConnected(G);
+
+    SpringEmbedderKK kk;
+    kk.setUseLayout(true);
+    kk.setNumberOfThreads(1);
+    kk.computeMaxIterations(false);
+    kk.setMaxGlobalIterations(20);
+    compareSIMDLevels(kk, G, 1e-6);
+}
+
+
+TEST(SIMDKernelTest, PivotMDSDotProduct)
+{
+    Graph G;
+    randomSimpleGraph(G, 500, 1000);
+    makeConnected(G);
+
+    PivotMDS pmds;
+    pmds.setNumberOfThreads(1);
+    compareSIMDLevels(pmds, G, 1e-6);
+}
+
+
+TEST(SIMDKernelTest, FastMultipoleEmbedderM2L)
+{
+    Graph G;
+    randomSimpleGraph(G, 500, 1000);
+    makeConnected(G);
+
+    FastMultipoleEmbedder fme;
+    fme.setNumberOfThreads(1);
+    fme.setRandomize(false);
+    fme.setNumIterations(20);
+    compareSIMDLevels(fme, G, 1e-6);
+}
+
+
+// checks that the nodes in inSet have pairwise distance larger than distance
+// and that every other node is within distance of a node in inSet
+static void checkIndependentSet(const Graph & G, const NodeArray<bool> & inSet, int distance)
+{
+    node v;
+    forall_nodes(v, G)
+    {
+        // nodes within distance of v (without v)
+        NodeArray<bool> near(G, false);
+        adjEntry adj;
+        forall_adj(adj, v)
+        {
+            node u = adj->twinNode();
+            near[u] = true;
+            if(distance > 1)
+            {
+                adjEntry adj2;
+                forall_adj(adj2, u)
+                    near[adj2->twinNode()] = true;
+            }
+        }
+        near[v] = false;
+
+        bool covered = inSet[v];
+        node u;
+        forall_nodes(u, G)
+        {
+            if(!near[u] || !inSet[u])
+                continue;
+            EXPECT_FALSE(inSet[v]) << "nodes " << v->index() << " and " << u->index();
+            covered = true;
+        }
+        EXPECT_TRUE(covered) << "node " << v->index();
+    }
+}
+
+
+TEST(ParallelCoarseningTest, IndependentSet)
+{
+    Graph G;
+    randomSimpleGraph(G, 300, 900);
+
+    for(int distance = 1; distance <= 2; ++distance)
+    {
+        NodeArray<bool> inSet;
+        ParallelCoarsening::independentSet(G, inSet, distance, 42, 1);
+        checkIndependentSet(G, inSet, distance);
+
+        NodeArray<double> key(G);
+        node v;
+        forall_nodes(v, G)
+            key[v] = -v->degree();
+        ParallelCoarsening::independentSet(G, inSet, distance, 42, 1, &key);
+        checkIndependentSet(G, inSet, distance);
+    }
+}
+
+
+TEST(ParallelCoarseningTest, IndependentSetThreads)
+{
+    Graph G;
+    randomSimpleGraph(G, 8000, 24000);
+
+    for(int distance = 1; distance <= 2; ++distance)
+    {
+        NodeArray<bool> inSet1, inSet4;
+        ParallelCoarsening::independentSet(G, inSet1, distance, 7, 1);
+        ParallelCoarsening::independentSet(G, inSet4, distance, 7, 4);
+        node v;
+        forall_nodes(v, G)
+            EXPECT_EQ(inSet1[v], inSet4[v]);
+    }
+}
+
+
+TEST(ParallelCoarseningTest, IndependentSetStar)
+{
+    // a round must not take time quadratic in the degree of the hub
+    Graph G;
+    node hub = G.newNode();
+    for(int i = 0; i < 100000; ++i)
+        G.newEdge(hub, G.newNode());
+
+    NodeArray<bool> inSet;
+    ParallelCoarsening::independentSet(G, inSet, 2, 3, 4);
+    int size = 0;
+    node v;
+    forall_nodes(v, G)
+        if(inSet[v])
+            ++size;
+    EXPECT_EQ(1, size);
+}
+
+
+// stress of the layout with the graph distances, after optimal scaling,
+// divided by the number of pairs
+static double normalizedStress(const GraphAttributes & GA)
+{
+    const Graph & G = GA.constGraph();
+    DistanceMatrix<double> dist;
+    bfs_SPAP(G, dist, 1.0);
+
+    double sum1 = 0, sum2 = 0;
+    const int n = G.numberOfNodes();
+    for(int i = 0; i < n; ++i)
+        for(int j = i + 1; j < n; ++j)
+        {
+            node u = dist.nodeAt(i), v = dist.nodeAt(j);
+            double e = DPoint(GA.x(u), GA.y(u)).distance(DPoint(GA.x(v), GA.y(v)));
+            sum1 += e / dist(i, j);
+            sum2 += e * e / (dist(i, j) * dist(i, j));
+        }
+    const double scale = sum1 / sum2;
+
+    double stress = 0;
+    for(int i = 0; i < n; ++i)
+        for(int j = i + 1; j < n; ++j)
+        {
+            node u = dist.nodeAt(i), v = dist.nodeAt(j);
+            double e = scale * DPoint(GA.x(u), GA.y(u)).distance(DPoint(GA.x(v), GA.y(v)));
+            stress += (e - dist(i, j)) * (e - dist(i, j)) / (dist(i, j) * dist(i, j));
+        }
+    return stress / (n * (n - 1) / 2);
+}
+
+
+TEST(StressMinimizationTest, SparseStress)
+{
+    Graph G;
+    gridGraph(G, 20, 20, false, false);
+    GraphAttributes GA(G);
+
+    StressMinimization full;
+    full.call(GA);
+    const double fullStress = normalizedStress(GA);
+
+    StressMinimization sparse;
+    sparse.useSparseStress(true);
+    sparse.setNumberOfSparsePivots(20);
+    sparse.call(GA);
+    const double sparseStress = normalizedStress(GA);
+    EXPECT_LT(sparseStress, 2 * fullStress + 1e-3);
+
+    // more pivots than nodes
+    sparse.setNumberOfSparsePivots(100000);
+    sparse.setNumberOfThreads(2);
+    sparse.call(GA);
+    node v;
+    forall_nodes(v, G)
+    {
+        EXPECT_TRUE(GA.x(v) == GA.x(v));
+        EXPECT_TRUE(GA.y(v) == GA.y(v));
+    }
+    EXPECT_LT(normalizedStress(GA), 2 * fullStress + 1e-3);
+}
+
+
+TEST(StressMinimizationTest, SparseStressThreadsGiveSameLayout)
+{
+    // at least 1000 nodes per thread are used
+    Graph G;
+    gridGraph(G, 60, 60, false, false);
+    GraphAttributes GA1(G), GA2(G);
+
+    StressMinimization sparse;
+    sparse.useSparseStress(true);
+    sparse.setNumberOfSparsePivots(50);
+    sparse.setIterations(30);
+    sparse.setNumberOfThreads(1);
+    sparse.call(GA1);
+    sparse.setNumberOfThreads(3);
+    sparse.call(GA2);
+
+    node v;
+    forall_nodes(v, G)
+    {
+        EXPECT_EQ(GA1.x(v), GA2.x(v));
+        EXPECT_EQ(GA1.y(v), GA2.y(v));
+    }
+}
+
+
+TEST(GEMLayoutTest, QuadTree)
+{
+    Graph G;
+    gridGraph(G, 15, 15, false, false);
+    GraphAttributes GA(G);
+
+    // GEM starts from the given layout
+    NodeArray<DPoint> initial(G);
+    node v;
+    forall_nodes(v, G)
+        initial[v] = DPoint(randomDouble(0, 100), randomDouble(0, 100));
+
+    forall_nodes(v, G)
+    {
+        GA.x(v) = initial[v].m_x;
+        GA.y(v) = initial[v].m_y;
+    }
+    GEMLayout gem;
+    gem.call(GA);
+    const double exactStress = normalizedStress(GA);
+
+    forall_nodes(v, G)
+    {
+        GA.x(v) = initial[v].m_x;
+        GA.y(v) = initial[v].m_y;
+    }
+    gem.useQuadTree(true);
+    gem.call(GA);
+    EXPECT_LT(normalizedStress(GA), 2 * exactStress + 1e-2);
+}
+
+
+// number of edges crossing e, counted by testing all pairs of edges
+static int bruteForceCrossings(const GraphAttributes & GA, edge e)
+{
+    if(e->isSelfLoop())
+        return 0;
+    DLine l(DPoint(GA.x(e->source()), GA.y(e->source())), DPoint(GA.x(e->target()), GA.y(e->target())));
+    int count = 0;
+    edge f;
+    forall_edges(f, GA.constGraph())
+    {
+        if(f->isSelfLoop() || f->commonNode(e) != 0)
+            continue;
+        DLine m(DPoint(GA.x(f->source()), GA.y(f->source())), DPoint(GA.x(f->target()), GA.y(f->target())));
+        DPoint p;
+        if(l.intersection(m, p))
+            ++count;
+    }
+    return count;
+}
+
+
+static void checkPlanarity(const GraphAttributes & GA, const Planarity & planarity)
+{
+    int sum = 0;
+    edge e;
+    forall_edges(e, GA.constGraph())
+    {
+        const int count = bruteForceCrossings(GA, e);
+        EXPECT_EQ(count, planarity.crossings(e)) << "edge " << e->index();
+        sum += count;
+    }
+    EXPECT_EQ(sum / 2, planarity.energy());
+}
+
+
+// moves random nodes to random positions in [0,range]^2 (integral if integral is set)
+static void testPlanarityMoves(Graph & G, double range, bool integral)
+{
+    GraphAttributes GA(G);
+    node v;
+    forall_nodes(v, G)
+    {
+        GA.x(v) = integral ? randomNumber(0, int(range)) : randomDouble(0, range);
+        GA.y(v) = integral ? randomNumber(0, int(range)) : randomDouble(0, range);
+    }
+
+    Planarity planarity(GA);
+    planarity.computeEnergy();
+    checkPlanarity(GA, planarity);
+
+    Array<node> nodes(G.numberOfNodes());
+    int j = 0;
+    forall_nodes(v, G)
+        nodes[j++] = v;
+    for(int i = 0; i < 200; ++i)
+    {
+        v = nodes[randomNumber(0, nodes.size() - 1)];
+        DPoint p = integral
+                   ? DPoint(randomNumber(0, int(range)), randomNumber(0, int(range)))
+                   : DPoint(randomDouble(0, range), randomDouble(0, range));
+        double energy = planarity.computeCandidateEnergy(v, p);
+        if(i % 3 != 0)
+        {
+            planarity.candidateTaken();
+            EXPECT_EQ(energy, planarity.energy());
+        }
+        if(i % 20 == 0)
+            checkPlanarity(GA, planarity);
+    }
+    checkPlanarity(GA, planarity);
+}
+
+
+TEST(PlanarityTest, CrossingsOfRandomLayouts)
+{
+    srand(11);
+    Graph G;
+    randomSimpleGraph(G, 60, 150);
+    G.newEdge(G.firstNode(), G.firstNode());
+    testPlanarityMoves(G, 1000.0, false);
+}
+
+
+TEST(PlanarityTest, CrossingsOfDegenerateLayouts)
+{
+    // small integer coordinates yield collinear and overlapping edges,
+    // edges through nodes and coinciding nodes
+    srand(12);
+    Graph G;
+    randomSimpleGraph(G, 40, 100);
+    testPlanarityMoves(G, 6.0, true);
+}
+
+
+TEST(DavidsonHarelLayoutTest, IllegalBatchParameters)
+{
+    DavidsonHarel dh;
+    EXPECT_THROW(dh.setBatchSize(0), AlgorithmFailureException);
+    EXPECT_THROW(dh.setNumberOfThreads(0), AlgorithmFailureException);
+
+    DavidsonHarelLayout layout;
+    EXPECT_THROW(layout.setBatchSize(0), AlgorithmFailureException);
+    EXPECT_THROW(layout.setNumberOfThreads(0), AlgorithmFailureException);
+}
+
+
+TEST(DavidsonHarelLayoutTest, MoreThreadsThanCandidates)
+{
+    srand(13);
+    Graph G;
+    randomSimpleGraph(G, 30, 60);
+    GraphAttributes GA(G);
+
+    DavidsonHarelLayout layout;
+    layout.setSpeed(DavidsonHarelLayout::sppFast);
+    layout.setPlanarityWeight(100.0);
+    layout.setBatchSize(4);
+    layout.setNumberOfThreads(16);
+    layout.call(GA);
+
+    node v;
+    forall_nodes(v, G)
+    {
+        EXPECT_TRUE(GA.x(v) == GA.x(v));
+        EXPECT_TRUE(GA.y(v) == GA.y(v));
+    }
+}
+
+
+// average edge length of the edges between nodes that are not new
+static double averageOldEdgeLength(const GraphAttributes & GA, const NodeArray<bool> & newNode)
+{
+    double length = 0;
+    int count = 0;
+    edge e;
+    forall_edges(e, GA.constGraph())
+    {
+        if(newNode[e->source()] || newNode[e->target()])
+            continue;
+        DPoint p(GA.x(e->source()), GA.y(e->source()));
+        length += p.distance(DPoint(GA.x(e->target()), GA.y(e->target())));
+        ++count;
+    }
+    return length / count;
+}
+
+
+// lays out a 500 node graph with L, attaches a chain of 10 new nodes and returns the
+// average and maximum displacement of the nodes outside the affected region in
+// units of the average edge length after an incremental call of L
+template<class LAYOUT>
+static void frozenDisplacement(LAYOUT & L, double & average, double & maximum)
+{
+    srand(14);
+    Graph G;
+    planarConnectedGraph(G, 500, 1000);
+    GraphAttributes GA(G);
+    node v;
+    forall_nodes(v, G)
+    {
+        GA.x(v) = randomDouble(0, 1000);
+        GA.y(v) = randomDouble(0, 1000);
+    }
+    L.call(GA);
+
+    NodeArray<bool> newNode(G, false);
+    node last = G.firstNode();
+    for(int i = 0; i < 10; ++i)
+    {
+        v = G.newNode();
+        newNode[v] = true;
+        G.newEdge(last, v);
+        last = v;
+    }
+    const double length = averageOldEdgeLength(GA, newNode);
+
+    WarmStart ws;
+    ws.init(GA, newNode);
+    NodeArray<DPoint> pos(G);
+    forall_nodes(v, G)
+        pos[v] = DPoint(GA.x(v), GA.y(v));
+
+    L.callIncremental(GA, ws);
+
+    average = maximum = 0;
+    int count = 0;
+    forall_nodes(v, G)
+    {
+        EXPECT_TRUE(GA.x(v) == GA.x(v) && GA.y(v) == GA.y(v));
+        if(ws.isAffected(v))
+            continue;
+        double d = pos[v].distance(DPoint(GA.x(v), GA.y(v))) / length;
+        average += d;
+        maximum = max(maximum, d);
+        ++count;
+    }
+    average /= count;
+}
+
+
+TEST(WarmStartTest, PlaceChain)
+{
+    Graph G;
+    NodeArray<bool> newNode(G, false);
+    node last = G.newNode();
+    node first = last;
+    for(int i = 0; i < 2000; ++i)
+    {
+        node v = G.newNode();
+        G.newEdge(v, last);
+        last = v;
+    }
+    newNode.init(G, true);
+    newNode[first] = false;
+    node isolated = G.newNode();
+    newNode[isolated] = true;
+
+    GraphAttributes GA(G);
+    GA.x(first) = GA.y(first) = 0;
+    WarmStart ws;
+    ws.init(GA, newNode);
+
+    // every chain node is placed next to its predecessor (a quarter of the
+    // default edge length away in each direction)
+    double w = LayoutStandards::defaultNodeWidth();
+    double h = LayoutStandards::defaultNodeHeight();
+    double length = LayoutStandards::defaultNodeSeparation() + sqrt(w * w + h * h);
+    node v;
+    forall_nodes(v, G)
+    {
+        if(v == first || v == isolated)
+            continue;
+        node u = v->firstAdj()->twinNode();
+        EXPECT_LE(DPoint(GA.x(v), GA.y(v)).distance(DPoint(GA.x(u), GA.y(u))), 0.36 * length);
+    }
+    EXPECT_EQ(G.numberOfNodes(), ws.numberOfAffectedNodes());
+    EXPECT_GT(GA.x(isolated), GA.x(first));
+}
+
+
+TEST(WarmStartTest, FrozenNodesSpringEmbedderFRExact)
+{
+    SpringEmbedderFRExact L;
+    double average, maximum;
+    frozenDisplacement(L, average, maximum);
+    EXPECT_LE(average, 0.15);
+    EXPECT_LE(maximum, 0.2);
+}
+
+
+TEST(WarmStartTest, FrozenNodesFMMM)
+{
+    FMMMLayout L;
+    double average, maximum;
+    frozenDisplacement(L, average, maximum);
+    EXPECT_LE(average, 0.15);
+    EXPECT_LE(maximum, 0.2);
+}
+
+
+TEST(WarmStartTest, FrozenNodesFastMultipoleEmbedder)
+{
+    FastMultipoleEmbedder L;
+    double average, maximum;
+    frozenDisplacement(L, average, maximum);
+    EXPECT_LE(average, 0.15);
+}
+
+
+TEST(WarmStartTest, FrozenNodesStressMinimization)
+{
+    StressMinimization L;
+    double average, maximum;
+    frozenDisplacement(L, average, maximum);
+    EXPECT_LE(average, 0.15);
+}
+
+
+// records the reported values
+class RecordingMonitor : public IterationMonitor
+{
+public:
+    List<double> m_displacements;
+    List<double> m_seconds;
+
+protected:
+    void iterationDone(int /* iteration */, double /* energy */, double maxDisplacement, double elapsedSeconds)
+    {
+        m_displacements.pushBack(maxDisplacement);
+        m_seconds.pushBack(elapsedSeconds);
+    }
+};
+
+
+TEST(IterationMonitorTest, Convergence)
+{
+    srand(15);
+    Graph G;
+    planarConnectedGraph(G, 300, 600);
+    GraphAttributes GA(G);
+    node v;
+    forall_nodes(v, G)
+    {
+        GA.x(v) = randomDouble(0, 1000);
+        GA.y(v) = randomDouble(0, 1000);
+    }
+
+    SpringEmbedderFRExact L;
+    L.checkConvergence(false);
+    RecordingMonitor monitor;
+    monitor.tolerance(0.05);
+    L.setIterationMonitor(&monitor);
+    L.call(GA);
+
+    // the algorithm stops right after the first iteration below the tolerance
+    EXPECT_EQ(IterationMonitor::srConverged, monitor.stopReason());
+    EXPECT_EQ(monitor.numberOfIterations(), monitor.m_displacements.size());
+    EXPECT_LT(monitor.numberOfIterations(), L.iterations());
+    EXPECT_LT(monitor.m_displacements.back(), 0.05);
+    monitor.m_displacements.popBack();
+    for(ListConstIterator<double> it = monitor.m_displacements.begin(); it.valid(); ++it)
+        EXPECT_GE(*it, 0.05);
+}
+
+
+TEST(IterationMonitorTest, TimeLimit)
+{
+    srand(16);
+    Graph G;
+    planarConnectedGraph(G, 4000, 8000);
+    GraphAttributes GA(G);
+
+    // the time limit also skips all levels and the postprocessing after it is exceeded
+    FMMMLayout L;
+    RecordingMonitor monitor;
+    monitor.timeLimit(0.05);
+    L.setIterationMonitor(&monitor);
+    L.call(GA);
+
+    EXPECT_EQ(IterationMonitor::srTimeLimit, monitor.stopReason());
+    EXPECT_GE(monitor.m_seconds.back(), 0.05);
+    monitor.m_seconds.popBack();
+    for(ListConstIterator<double> it = monitor.m_seconds.begin(); it.valid(); ++it)
+        EXPECT_LT(*it, 0.05);
+    EXPECT_LT(monitor.elapsedSeconds(), 2.0);
+}
+
+
+TEST(IterationMonitorTest, FMMMReportsAppliedMoves)
+{
+    srand(17);
+    Graph G;
+    planarConnectedGraph(G, 200, 400);
+    GraphAttributes GA(G);
+    FMMMLayout L;
+    L.call(GA);
+
+    // all nodes are frozen and cannot move at all
+    NodeArray<bool> newNode(G, false);
+    WarmStart ws;
+    ws.frozenMobility(0.0);
+    ws.init(GA, newNode);
+
+    RecordingMonitor monitor;
+    L.setIterationMonitor(&monitor);
+    L.callIncremental(GA, ws);
+
+    EXPECT_GT(monitor.numberOfIterations(), 0);
+    for(ListConstIterator<double> it = monitor.m_displacements.begin(); it.valid(); ++it)
+        EXPECT_EQ(0.0, *it);
+}
+
+
+// a layout that takes a fixed wall-clock time per node and records the sizes of the graphs
+class SlowLayout : public LayoutModule
+{
+    double m_secondsPerNode;
+    List<int> & m_calls;
+
+public:
+    SlowLayout(double secondsPerNode, List<int> & calls) : m_secondsPerNode(secondsPerNode), m_calls(calls) { }
+
+    void call(GraphAttributes & GA)
+    {
+        const int n = GA.constGraph().numberOfNodes();
+        m_calls.pushBack(n);
+        StopwatchWallClock watch;
+        watch.start();
+        while(watch.milliSeconds() < 1000.0 * m_secondsPerNode * n) ;
+    }
+};
+
+
+// lays out a 4000 node grid with a time limit; returns the elapsed time
+static double mixerWithTimeLimit(
+    ModularMultilevelMixer & mixer,
+    double timeLimit,
+    ModularMultilevelMixer::erc & errorCode)
+{
+    Graph G;
+    gridGraph(G, 80, 50, false, false);
+    GraphAttributes GA(G);
+    mixer.timeLimit(timeLimit);
+
+    StopwatchWallClock watch;
+    watch.start();
+    mixer.call(GA);
+    errorCode = mixer.errorCode();
+    return watch.milliSeconds() / 1000.0;
+}
+
+
+TEST(ModularMultilevelMixerTest, TimeLimitReachesFinestLevel)
+{
+    // a single call of the finest level takes 0.1 s, all levels together about 0.2 s
+    List<int> calls;
+    ModularMultilevelMixer mixer;
+    mixer.setLevelLayoutModule(new SlowLayout(25e-6, calls));
+    mixer.setLayoutRepeats(20);
+
+    ModularMultilevelMixer::erc errorCode;
+    double seconds = mixerWithTimeLimit(mixer, 1.0, errorCode);
+
+    // every level gets a call, the left over time is spent on the finest level
+    EXPECT_EQ(ModularMultilevelMixer::ercNone, errorCode);
+    int finestCalls = 0;
+    for(ListConstIterator<int> it = calls.begin(); it.valid(); ++it)
+        if(*it == 4000)
+            ++finestCalls;
+    EXPECT_GE(finestCalls, 3);
+    EXPECT_GT(seconds, 0.5);
+    EXPECT_LT(seconds, 1.2);
+}
+
+
+TEST(ModularMultilevelMixerTest, TimeLimitSkipsLevels)
+{
+    // the time limit does not suffice for a call of the finest level
+    List<int> calls;
+    ModularMultilevelMixer mixer;
+    mixer.setLevelLayoutModule(new SlowLayout(25e-6, calls));
+
+    ModularMultilevelMixer::erc errorCode;
+    double seconds = mixerWithTimeLimit(mixer, 0.08, errorCode);
+
+    EXPECT_EQ(ModularMultilevelMixer::ercTimeLimit, errorCode);
+    EXPECT_FALSE(calls.empty());
+    EXPECT_LT(calls.back(), 4000);
+    EXPECT_LT(seconds, 0.2);
+}
+
+
+TEST(ModularMultilevelMixerTest, TimeLimitEstimatesFinalLayout)
+{
+    // the final layout is much cheaper than the level layout and still fits
+    List<int> levelCalls, finalCalls;
+    ModularMultilevelMixer mixer;
+    mixer.setLevelLayoutModule(new SlowLayout(25e-6, levelCalls));
+    mixer.setFinalLayoutModule(new SlowLayout(1e-6, finalCalls));
+    mixer.setLayoutRepeats(5);
+
+    ModularMultilevelMixer::erc errorCode;
+    mixerWithTimeLimit(mixer, 0.2, errorCode);
+
+    EXPECT_FALSE(levelCalls.empty());
+    EXPECT_EQ(5, finalCalls.size());
+}
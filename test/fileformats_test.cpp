@@ -46,6 +46,7 @@
 #include <ogdf/basic/graph_generators.h>
 #include <ogdf/basic/simple_graph_alg.h>
 #include <ogdf/fileformats/GraphIO.h>
+#include <ogdf/fileformats/OgmlStreamParser.h>
 
 // Note: these tests do not do real file testing,
 // all file IO is simulated over a stringstream.
@@ -182,6 +183,98 @@ TEST(FileformatsTest, OgmlReadWritePetersenGraph)
     EXPECT_TRUE(isSameUndirectedGraph(G, Gtest));
 }
 
+TEST(FileformatsTest, OgmlStreamReadClusterGraph)
+{
+    std::stringstream ss;
+    ss <<
+       "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+       "<ogml>\n"
+       "  <graph>\n"
+       "    <structure>\n"
+       "      <edge id=\"e7\">\n"
+       "        <source idRef=\"n3\" />\n"
+       "        <target idRef=\"n5\"></target>\n"
+       "      </edge>\n"
+       "      <node id=\"c1\">\n"
+       "        <node id=\"n3\" />\n"
+       "        <node id=\"c2\">\n"
+       "          <node id=\"n5\" />\n"
+       "        </node>\n"
+       "      </node>\n"
+       "      <node id=\"n3x\" />\n"
+       "      <edge id=\"e8\">\n"
+       "        <source idRef=\"n5\" />\n"
+       "        <target idRef=\"n3x\" />\n"
+       "      </edge>\n"
+       "    </structure>\n"
+       "    <layout>\n"
+       "      <constraints/>\n"
+       "    </layout>\n"
+       "  </graph>\n"
+       "</ogml>\n";
+
+    Graph G;
+    ClusterGraph CG(G);
+    OgmlStreamParser parser;
+    ASSERT_TRUE(parser.read(ss, G, CG));
+    EXPECT_EQ(3, G.numberOfNodes());
+    EXPECT_EQ(2, G.numberOfEdges());
+    EXPECT_EQ(3, CG.numberOfClusters());
+
+    // indices are assigned in the order of creation;
+    // e7 is created after e8 since it has forward references
+    EXPECT_EQ(2, G.maxNodeIndex());
+    EXPECT_EQ(1, G.maxEdgeIndex());
+    edge e = G.lastEdge();
+    cluster c = CG.clusterOf(e->target());
+    EXPECT_NE(CG.rootCluster(), c);
+    EXPECT_NE(CG.rootCluster(), c->parent());
+    EXPECT_EQ(c->parent(), CG.clusterOf(e->source()));
+    EXPECT_EQ(e->target(), G.firstEdge()->source());
+    EXPECT_EQ(CG.rootCluster(), CG.clusterOf(G.firstEdge()->target()));
+}
+
+TEST(FileformatsTest, OgmlStreamReadLargeIds)
+{
+    std::stringstream ss;
+    ss << "<ogml><graph><structure>"
+          "<node id=\"n1000000000\"/>"
+          "<node id=\"n2000000000\"/>"
+          "<edge id=\"e1999999999\"><source idRef=\"n1000000000\"/><target idRef=\"n2000000000\"/></edge>"
+          "</structure></graph></ogml>";
+    Graph G;
+    OgmlStreamParser parser;
+    ASSERT_TRUE(parser.read(ss, G));
+    EXPECT_EQ(2, G.numberOfNodes());
+    EXPECT_EQ(1, G.numberOfEdges());
+    EXPECT_EQ(1, G.maxNodeIndex());
+    EXPECT_EQ(0, G.maxEdgeIndex());
+}
+
+TEST(FileformatsTest, OgmlStreamReadFailUndefinedNode)
+{
+    std::stringstream ss;
+    ss << "<ogml><graph><structure>"
+          "<node id=\"v1\"/>"
+          "<edge id=\"e1\"><source idRef=\"v1\"/><target idRef=\"v2\"/></edge>"
+          "</structure></graph></ogml>";
+    Graph G;
+    OgmlStreamParser parser;
+    EXPECT_FALSE(parser.read(ss, G));
+}
+
+TEST(FileformatsTest, OgmlStreamReadPetersenGraph)
+{
+    Graph G, Gtest;
+    petersenGraph(G, 5, 2);
+    std::ostringstream write;
+    ASSERT_TRUE(GraphIO::writeOGML(G, write));
+    std::istringstream read(write.str());
+    OgmlStreamParser parser;
+    ASSERT_TRUE(parser.read(read, Gtest));
+    EXPECT_TRUE(isSameUndirectedGraph(G, Gtest));
+}
+
 TEST(FileformatsTest, GmlReadWriteEmptyGraph)
 {
     Graph G, Gtest;
@@ -215,6 +308,32 @@ TEST(FileformatsTest, GmlReadWritePetersenGraph)
     EXPECT_TRUE(isSameUndirectedGraph(G, Gtest));
 }
 
+TEST(FileformatsTest, GmlFastWriterPetersenGraph)
+{
+    Graph G, Gtest;
+    petersenGraph(G, 5, 2);
+    GraphAttributes GA(G, GraphAttributes::nodeGraphics | GraphAttributes::nodeLabel);
+    node v;
+    forall_nodes(v, G)
+    {
+        GA.x(v) = 1.25 * v->index();
+        GA.y(v) = -0.5 * v->index();
+        GA.label(v) = "v";
+    }
+    std::ostringstream write;
+    ASSERT_TRUE(GraphIO::writeGML(GA, write, GraphAttributes::nodeGraphics));
+    EXPECT_EQ(std::string::npos, write.str().find("label"));
+    std::istringstream read(write.str());
+    GraphAttributes GAtest(Gtest, GraphAttributes::nodeGraphics);
+    ASSERT_TRUE(GraphIO::readGML(GAtest, Gtest, read));
+    EXPECT_TRUE(isSameUndirectedGraph(G, Gtest));
+    for(node v1 = G.firstNode(), v2 = Gtest.firstNode(); v1; v1 = v1->succ(), v2 = v2->succ())
+    {
+        EXPECT_DOUBLE_EQ(GA.x(v1), GAtest.x(v2));
+        EXPECT_DOUBLE_EQ(GA.y(v1), GAtest.y(v2));
+    }
+}
+
 TEST(FileformatsTest, RomeReadWriteEmptyGraph)
 {
     Graph G, Gtest;
@@ -416,6 +535,21 @@ TEST(FileformatsTest, GraphMLReadWritePetersenGraph)
     EXPECT_TRUE(isSameUndirectedGraph(G, Gtest));
 }
 
+TEST(FileformatsTest, GraphMLFastWriterPetersenGraph)
+{
+    Graph G, Gtest;
+    petersenGraph(G, 5, 2);
+    GraphAttributes GA(G, GraphAttributes::nodeGraphics | GraphAttributes::edgeGraphics);
+    OutputBuffer out;
+    std::ostringstream write;
+    out.attach(write);
+    ASSERT_TRUE(GraphIO::writeGraphML(GA, out, GraphAttributes::nodeGraphics));
+    EXPECT_EQ(std::string::npos, write.str().find("bends"));
+    std::istringstream read(write.str());
+    ASSERT_TRUE(GraphIO::readGraphML(Gtest, read));
+    EXPECT_TRUE(isSameUndirectedGraph(G, Gtest));
+}
+
 TEST(FileformatsTest, DotReadWriteEmptyGraph)
 {
     Graph G, Gtest;
@@ -0,0 +1,157 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Tests for the shortest path algorithms.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+#include "gtest/gtest.h"
+#include <ogdf/basic/graph_generators.h>
+#include <ogdf/graphalg/ShortestPathAlgorithms.h>
+#include <float.h>
+
+using namespace ogdf;
+
+
+// a random graph, a separate cycle with a chord and a node with a self-loop
+static void apspGraph(Graph & G)
+{
+    randomSimpleGraph(G, 40, 70);
+    node first = G.newNode(), u = first;
+    for(int i = 1; i < 12; ++i)
+    {
+        node v = G.newNode();
+        G.newEdge(u, v);
+        u = v;
+    }
+    G.newEdge(u, first);
+    G.newEdge(first, G.lastNode()->pred()->pred()->pred());
+    node v = G.newNode();
+    G.newEdge(v, v);
+}
+
+
+// compares a DistanceMatrix with the legacy matrix (DBL_MAX for unreachable pairs)
+template<class T>
+static void compareDistances(const Graph & G, const NodeArray<NodeArray<double>> & legacy,
+                             const DistanceMatrix<T> & dist, double eps)
+{
+    ASSERT_EQ(G.numberOfNodes(), dist.numberOfNodes());
+    int unreachable = 0;
+    node u, v;
+    forall_nodes(u, G)
+    {
+        EXPECT_EQ(u, dist.nodeAt(dist.index(u)));
+        forall_nodes(v, G)
+        {
+            if(legacy[u][v] == DBL_MAX)
+            {
+                EXPECT_EQ(DistanceMatrix<T>::infinity(), dist(u, v));
+                ++unreachable;
+            }
+            else
+                EXPECT_NEAR(legacy[u][v], double(dist(u, v)), eps);
+        }
+    }
+    EXPECT_GT(unreachable, 0);
+}
+
+
+TEST(ShortestPathTest, BFS)
+{
+    Graph G;
+    apspGraph(G);
+
+    NodeArray<NodeArray<double>> legacy(G);
+    node v;
+    forall_nodes(v, G)
+        legacy[v].init(G, DBL_MAX);
+    bfs_SPAP(G, legacy, 2.5);
+
+    for(int numThreads = 1; numThreads <= 3; numThreads += 2)
+    {
+        DistanceMatrix<double> dist;
+        bfs_SPAP(G, dist, 2.5, numThreads);
+        compareDistances(G, legacy, dist, 0.0);
+
+        DistanceMatrix<float> distFloat;
+        bfs_SPAP(G, distFloat, 2.5, numThreads);
+        compareDistances(G, legacy, distFloat, 1e-5);
+    }
+
+    forall_nodes(v, G)
+        legacy[v].init(G, DBL_MAX);
+    bfs_SPAP(G, legacy, 1.0);
+    DistanceMatrix<__uint16> hops;
+    bfs_SPAP(G, hops, 2);
+    compareDistances(G, legacy, hops, 0.0);
+}
+
+
+TEST(ShortestPathTest, Dijkstra)
+{
+    Graph G;
+    apspGraph(G);
+    GraphAttributes GA(G, GraphAttributes::edgeDoubleWeight);
+    EdgeArray<double> cost(G);
+    edge e;
+    forall_edges(e, G)
+        GA.doubleWeight(e) = cost[e] = randomDouble(0.5, 10);
+
+    NodeArray<NodeArray<double>> legacy(G);
+    node v;
+    forall_nodes(v, G)
+        legacy[v].init(G, DBL_MAX);
+    dijkstra_SPAP(G, legacy, cost);
+
+    for(int numThreads = 1; numThreads <= 3; numThreads += 2)
+    {
+        DistanceMatrix<double> dist;
+        dijkstra_SPAP(G, dist, cost, numThreads);
+        compareDistances(G, legacy, dist, 1e-9);
+
+        DistanceMatrix<float> distFloat;
+        dijkstra_SPAP(G, distFloat, cost, numThreads);
+        compareDistances(G, legacy, distFloat, 1e-4);
+
+        DistanceMatrix<double> distGA;
+        NodeArray<NodeArray<double>> legacyGA(G);
+        forall_nodes(v, G)
+            legacyGA[v].init(G, DBL_MAX);
+        EXPECT_DOUBLE_EQ(dijkstra_SPAP(GA, legacyGA), dijkstra_SPAP(GA, distGA, numThreads));
+        compareDistances(G, legacy, distGA, 1e-9);
+    }
+}
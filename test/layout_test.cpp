@@ -0,0 +1,336 @@
+/*
+ * $Revision$
+ *
+ * last checkin:
+ *   $Author$
+ *   $Date$
+ ***************************************************************/
+
+/** \file
+ * \brief Tests for the layout modules in packing and misc.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.txt in the root directory of the OGDF installation for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * \see  http://www.gnu.org/copyleft/gpl.html
+ ***************************************************************/
+
+#include "gtest/gtest.h"
+#include <ogdf/basic/Math.h>
+#include <ogdf/basic/graph_generators.h>
+#include <ogdf/packing/ComponentSplitterLayout.h>
+#include <ogdf/misclayout/BertaultLayout.h>
+
+using namespace ogdf;
+
+
+//! Places the nodes on a circle and counts its calls.
+class CountingLayout : public LayoutModule
+{
+    int & m_calls;
+
+public:
+    CountingLayout(int & calls) : m_calls(calls) { }
+
+    void call(GraphAttributes & GA)
+    {
+        ++m_calls;
+        const int n = GA.constGraph().numberOfNodes();
+        int i = 0;
+        node v;
+        forall_nodes(v, GA.constGraph())
+        {
+            GA.x(v) = 10.0 * cos(2 * Math::pi * i / n);
+            GA.y(v) = 10.0 * sin(2 * Math::pi * i / n);
+            ++i;
+        }
+    }
+};
+
+
+// three paths with four nodes and one cycle with five nodes
+static void componentsGraph(Graph & G)
+{
+    G.clear();
+    for(int c = 0; c < 3; ++c)
+    {
+        node u = G.newNode();
+        for(int i = 1; i < 4; ++i)
+        {
+            node v = G.newNode();
+            G.newEdge(u, v);
+            u = v;
+        }
+    }
+    node first = G.newNode(), u = first;
+    for(int i = 1; i < 5; ++i)
+    {
+        node v = G.newNode();
+        G.newEdge(u, v);
+        u = v;
+    }
+    G.newEdge(u, first);
+}
+
+
+static double edgeLength(const GraphAttributes & GA, edge e)
+{
+    return DPoint(GA.x(e->source()), GA.y(e->source())).distance(
+        DPoint(GA.x(e->target()), GA.y(e->target())));
+}
+
+
+TEST(ComponentSplitterLayoutTest, ReuseIsDisabledByDefault)
+{
+    Graph G;
+    componentsGraph(G);
+    GraphAttributes GA(G);
+
+    int calls = 0;
+    ComponentSplitterLayout csl;
+    EXPECT_FALSE(csl.reuseIsomorphicComponents());
+    csl.setLayoutModule(new CountingLayout(calls));
+    csl.call(GA);
+    EXPECT_EQ(4, calls);
+}
+
+
+TEST(ComponentSplitterLayoutTest, ReuseIsomorphicComponents)
+{
+    Graph G;
+    componentsGraph(G);
+    GraphAttributes GA(G);
+
+    int calls = 0;
+    ComponentSplitterLayout csl;
+    csl.setReuseIsomorphicComponents(true);
+    csl.setLayoutModule(new CountingLayout(calls));
+    csl.call(GA);
+    EXPECT_EQ(2, calls);
+
+    // the paths are drawn alike: the sorted edge lengths agree
+    List<edge> edges;
+    G.allEdges(edges);
+    Array<double> lengths[3];
+    ListConstIterator<edge> it = edges.begin();
+    for(int c = 0; c < 3; ++c)
+    {
+        lengths[c].init(3);
+        for(int i = 0; i < 3; ++i, ++it)
+            lengths[c][i] = edgeLength(GA, *it);
+        lengths[c].quicksort();
+    }
+    for(int c = 1; c < 3; ++c)
+        for(int i = 0; i < 3; ++i)
+            EXPECT_NEAR(lengths[0][i], lengths[c][i], 1e-6);
+
+    // components with different node sizes are laid out separately
+    GA.width(G.firstNode()) = 100.0;
+    calls = 0;
+    csl.call(GA);
+    EXPECT_EQ(3, calls);
+}
+
+
+
+static DPoint scaled(const DPoint & p, double f)
+{
+    return DPoint(f * p.m_x, f * p.m_y);
+}
+
+// the section (1,...,8) containing the vector (dx,dy)
+static int bertaultSection(double dx, double dy)
+{
+    if(dx >= 0)
+    {
+        if(dy >= 0)
+            return (dx >= dy) ? 1 : 2;
+        return (dx >= -dy) ? 8 : 7;
+    }
+    if(dy >= 0)
+        return (-dx >= dy) ? 4 : 3;
+    return (-dx >= -dy) ? 5 : 6;
+}
+
+// limits the radii of the sections first,...,last (modulo 8) in R to r
+static void bertaultLimit(Array<double> & R, int first, int last, double r)
+{
+    for(int s = first; s <= last; s++)
+    {
+        int num = 1 + ((s + 7) % 8);
+        R[num] = min(R[num], r);
+    }
+}
+
+// one iteration of BertaultLayout (without ImPrEd) evaluating all pairs of a
+// node and an edge
+static void bertaultAllPairs(const Graph & G, NodeArray<DPoint> & P, double reqLength)
+{
+    const double limit = 4 * reqLength;
+    NodeArray<DPoint> F(G, DPoint(0, 0));
+    NodeArray<Array<double>> R(G);
+    node v;
+    forall_nodes(v, G)
+        R[v].init(1, 8, numeric_limits<double>::max());
+
+    forall_nodes(v, G)
+    {
+        node w;
+        forall_nodes(w, G)
+        {
+            if(w == v)
+                continue;
+            double dist = P[v].distance(P[w]);
+            F[v] = F[v] + scaled(P[v] - P[w], (reqLength / dist) * (reqLength / dist));
+        }
+        adjEntry adj;
+        forall_adj(adj, v)
+        {
+            node w = adj->twinNode();
+            F[v] = F[v] - scaled(P[v] - P[w], P[v].distance(P[w]) / reqLength);
+        }
+
+        edge e;
+        forall_edges(e, G)
+        {
+            node a = e->source(), b = e->target();
+            if(a == v || b == v)
+                continue;
+            double m = (P[a].m_y - P[b].m_y) / (P[a].m_x - P[b].m_x);
+            double n = -1 / m;
+            double c = P[a].m_y - m * P[a].m_x;
+            double d = P[v].m_y - n * P[v].m_x;
+            DPoint I((d - c) / (m - n), 0);
+            I.m_y = m * I.m_x + c;
+            bool onEdge = ((I.m_x <= P[a].m_x && I.m_x >= P[b].m_x) || (I.m_x >= P[a].m_x && I.m_x <= P[b].m_x))
+                          && ((I.m_y <= P[a].m_y && I.m_y >= P[b].m_y) || (I.m_y >= P[a].m_y && I.m_y <= P[b].m_y));
+            if(onEdge)
+            {
+                double dist = P[v].distance(I);
+                if(dist <= limit && dist > 0)
+                {
+                    DPoint g = scaled(P[v] - I, (limit - dist) * (limit - dist) / dist);
+                    F[v] = F[v] + g;
+                    F[a] = F[a] - g;
+                    F[b] = F[b] - g;
+                }
+                int s = bertaultSection(I.m_x - P[v].m_x, I.m_y - P[v].m_y);
+                bertaultLimit(R[v], s - 2, s + 2, dist / 3);
+                bertaultLimit(R[a], s + 2, s + 6, dist / 3);
+                bertaultLimit(R[b], s + 2, s + 6, dist / 3);
+            }
+            else
+            {
+                double dav = P[v].distance(P[a]), dbv = P[v].distance(P[b]);
+                bertaultLimit(R[v], 1, 8, min(dav, dbv) / 3);
+                bertaultLimit(R[a], 1, 8, dav / 3);
+                bertaultLimit(R[b], 1, 8, dbv / 3);
+            }
+        }
+    }
+
+    forall_nodes(v, G)
+    {
+        double radius = R[v][bertaultSection(F[v].m_x, F[v].m_y)];
+        double length = F[v].norm();
+        if(radius < length)
+            F[v] = scaled(F[v], radius / length);
+        P[v] = P[v] + F[v];
+    }
+}
+
+
+// a random graph with n nodes and m edges placed randomly in [0,1000]^2
+static void randomDrawing(Graph & G, GraphAttributes & GA, int n, int m)
+{
+    randomSimpleGraph(G, n, m);
+    GA.init(G, GraphAttributes::nodeGraphics | GraphAttributes::edgeGraphics);
+    node v;
+    forall_nodes(v, G)
+    {
+        GA.x(v) = randomDouble(0, 1000);
+        GA.y(v) = randomDouble(0, 1000);
+    }
+}
+
+
+TEST(BertaultLayoutTest, AgreesWithAllPairs)
+{
+    srand(11);
+    Graph G;
+    GraphAttributes GA;
+    randomDrawing(G, GA, 400, 300);
+
+    const double reqLength = 2;
+    const int iterations = 3;
+    NodeArray<DPoint> P(G);
+    node v;
+    forall_nodes(v, G)
+        P[v] = DPoint(GA.x(v), GA.y(v));
+    for(int k = 0; k < iterations; k++)
+        bertaultAllPairs(G, P, reqLength);
+
+    BertaultLayout bl(reqLength, iterations);
+    bl.setNumberOfThreads(4);
+    const int crossings = bl.edgeCrossings(GA);
+    bl.call(GA);
+
+    forall_nodes(v, G)
+    {
+        EXPECT_NEAR(P[v].m_x, GA.x(v), 1e-6 * (1 + fabs(P[v].m_x)));
+        EXPECT_NEAR(P[v].m_y, GA.y(v), 1e-6 * (1 + fabs(P[v].m_y)));
+    }
+
+    // the layout preserves the crossings
+    EXPECT_EQ(crossings, bl.edgeCrossings(GA));
+}
+
+
+TEST(BertaultLayoutTest, ThreadsGiveSameLayout)
+{
+    srand(12);
+    Graph G;
+    GraphAttributes GA1;
+    randomDrawing(G, GA1, 500, 1000);
+    GraphAttributes GA2(G, GraphAttributes::nodeGraphics | GraphAttributes::edgeGraphics);
+    node v;
+    forall_nodes(v, G)
+    {
+        GA2.x(v) = GA1.x(v);
+        GA2.y(v) = GA1.y(v);
+    }
+
+    BertaultLayout bl(20, 10);
+    bl.call(GA1);
+    bl.setNumberOfThreads(5);
+    bl.call(GA2);
+
+    forall_nodes(v, G)
+    {
+        EXPECT_EQ(GA1.x(v), GA2.x(v));
+        EXPECT_EQ(GA1.y(v), GA2.y(v));
+    }
+}